@@ -19,10 +19,12 @@
 
 #include <gflags/gflags.h>
 
+#include "velox/expression/ExprFusion.h"
 #include "velox/functions/Registerer.h"
 #include "velox/functions/lib/CheckedArithmeticImpl.h"
 #include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
 #include "velox/functions/prestosql/ArithmeticImpl.h"
+#include "velox/type/FloatingPointUtil.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 
 DEFINE_int64(fuzzer_seed, 99887766, "Seed for random input dataset generator");
@@ -72,6 +74,24 @@ struct PlusFunction {
   }
 };
 
+template <typename T>
+struct MinusFunction {
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void
+  call(TInput& result, const TInput& a, const TInput& b) {
+    result = functions::minus(a, b);
+  }
+};
+
+template <typename T>
+struct GreaterThanFunction {
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void
+  call(bool& result, const TInput& a, const TInput& b) {
+    result = util::floating_point::NaNAwareGreaterThan<TInput>{}(a, b);
+  }
+};
+
 template <typename T>
 struct CheckedPlusFunction {
   template <typename TInput>
@@ -96,6 +116,15 @@ class SimpleArithmeticBenchmark
     registerFunction<CheckedPlusFunction, int64_t, int64_t, int64_t>(
         {"checked_plus"});
 
+    // Double arithmetic and comparison for the fused expressions.
+    registerFunction<PlusFunction, double, double, double>({"plus"});
+    registerFunction<MinusFunction, double, double, double>({"minus"});
+    registerFunction<GreaterThanFunction, bool, double, double>({"gt"});
+    registerFusableFunction("multiply", FusedOp::kMultiply, TypeKind::DOUBLE);
+    registerFusableFunction("plus", FusedOp::kPlus, TypeKind::DOUBLE);
+    registerFusableFunction("minus", FusedOp::kMinus, TypeKind::DOUBLE);
+    registerFusableFunction("gt", FusedOp::kGt, TypeKind::DOUBLE);
+
     // Set input schema.
     inputType_ = ROW({
         {"a", DOUBLE()},
@@ -149,6 +178,14 @@ class SimpleArithmeticBenchmark
     run(expression, kIterationsLarge, largeRowVector_);
   }
 
+  // Runs 'expression' over the large input with expression fusion enabled or
+  // disabled.
+  void runLargeFusion(const std::string& expression, bool fusionEnabled) {
+    setFusionEnabled(fusionEnabled);
+    runLarge(expression);
+    setFusionEnabled(false);
+  }
+
   // Runs `expression` `times` thousand times.
   size_t
   run(const std::string& expression, size_t times, const RowVectorPtr& input) {
@@ -164,6 +201,12 @@ class SimpleArithmeticBenchmark
   }
 
  private:
+  void setFusionEnabled(bool enabled) {
+    queryCtx_->testingOverrideConfigUnsafe({
+        {core::QueryConfig::kExprFusionEnabled, enabled ? "true" : "false"},
+    });
+  }
+
   TypePtr inputType_;
   RowVectorPtr smallRowVector_;
   RowVectorPtr mediumRowVector_;
@@ -340,6 +383,43 @@ BENCHMARK(plusCheckedLarge) {
   benchmark->runLarge("checked_plus(c, d)");
 }
 
+BENCHMARK_DRAW_LINE();
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(multiplyNestedDeepUnfusedLarge) {
+  benchmark->runLargeFusion(
+      "multiply(multiply(multiply(a, b), a), "
+      "multiply(a, multiply(a, b)))",
+      false);
+}
+
+BENCHMARK_RELATIVE(multiplyNestedDeepFusedLarge) {
+  benchmark->runLargeFusion(
+      "multiply(multiply(multiply(a, b), a), "
+      "multiply(a, multiply(a, b)))",
+      true);
+}
+
+BENCHMARK(arithmeticUnfusedLarge) {
+  benchmark->runLargeFusion(
+      "plus(minus(multiply(a, b), multiply(a, constant)), b)", false);
+}
+
+BENCHMARK_RELATIVE(arithmeticFusedLarge) {
+  benchmark->runLargeFusion(
+      "plus(minus(multiply(a, b), multiply(a, constant)), b)", true);
+}
+
+BENCHMARK(comparisonUnfusedLarge) {
+  benchmark->runLargeFusion(
+      "gt(plus(multiply(a, constant), b), minus(a, half_null))", false);
+}
+
+BENCHMARK_RELATIVE(comparisonFusedLarge) {
+  benchmark->runLargeFusion(
+      "gt(plus(multiply(a, constant), b), minus(a, half_null))", true);
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -49,6 +49,11 @@ DEFINE_int32(
     "Total reads per thread when throughput for a --bytes/--gap/--/gap/"
     "--num_in_run combination");
 DEFINE_string(config, "", "Path of the config file");
+DEFINE_bool(
+    io_uring,
+    false,
+    "Also measure preadvAsync of a local --path with io_uring against the "
+    "executor based implementation");
 
 namespace {
 static bool notEmpty(const char* /*flagName*/, const std::string& value) {
@@ -128,9 +133,23 @@ void ReadBenchmark::initialize() {
   if (FLAGS_seed) {
     rng_.seed(FLAGS_seed);
   }
+  if (FLAGS_io_uring) {
+    ioUring_ = IoUringReader::create();
+    if (ioUring_ == nullptr) {
+      LOG(ERROR) << "--io_uring is set but io_uring is not available";
+      exit(1);
+    }
+    executorFile_ = std::make_unique<LocalReadFile>(
+        FLAGS_path, executor_.get(), !FLAGS_odirect);
+    ioUringFile_ = std::make_unique<LocalReadFile>(
+        FLAGS_path, nullptr, !FLAGS_odirect, ioUring_.get());
+  }
 }
 
 void ReadBenchmark::finalize() {
+  ioUringFile_.reset();
+  executorFile_.reset();
+  ioUring_.reset();
   filesystems::finalizeS3FileSystem();
 }
 
@@ -31,6 +31,7 @@
 
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/file/IoUringReader.h"
 #include "velox/common/time/Timer.h"
 
 DECLARE_string(path);
@@ -41,6 +42,7 @@ DECLARE_bool(odirect);
 DECLARE_int32(bytes);
 DECLARE_int32(gap);
 DECLARE_int32(num_in_run);
+DECLARE_bool(io_uring);
 
 DECLARE_int32(measurement_size);
 DECLARE_string(config);
@@ -237,6 +239,56 @@ class ReadBenchmark {
               << std::endl;
   }
 
+  // Measures the throughput of preadvAsync() on 'file'. The reads are issued
+  // from a single thread with up to 'kMaxAsyncReads' reads in flight.
+  void asyncReads(
+      int32_t size,
+      int32_t gap,
+      int32_t count,
+      int32_t repeats,
+      ReadFile& file,
+      const std::string& label) {
+    clearCache();
+    uint64_t usec = 0;
+    {
+      MicrosecondTimer timer(&usec);
+      const int32_t rangeSize = size * count + gap * (count - 1);
+      std::vector<std::string> buffers(kMaxAsyncReads);
+      std::vector<folly::SemiFuture<uint64_t>> futures;
+      for (auto repeat = 0; repeat < repeats; ++repeat) {
+        const size_t slot = repeat % kMaxAsyncReads;
+        if (futures.size() > slot) {
+          futures[slot].wait();
+        }
+        auto& buffer = buffers[slot];
+        buffer.resize(rangeSize);
+        std::vector<folly::Range<char*>> ranges;
+        for (auto start = 0; start < rangeSize; start += size + gap) {
+          ranges.push_back(folly::Range<char*>(buffer.data() + start, size));
+          if (gap && start + gap < rangeSize) {
+            ranges.push_back(folly::Range<char*>(nullptr, gap));
+          }
+        }
+        const int64_t offset =
+            folly::Random::rand64(rng_) % (fileSize_ - rangeSize);
+        auto future = file.preadvAsync(offset, ranges);
+        if (futures.size() > slot) {
+          futures[slot] = std::move(future);
+        } else {
+          futures.push_back(std::move(future));
+        }
+      }
+      for (auto& future : futures) {
+        future.wait();
+      }
+    }
+    std::cout << fmt::format(
+                     "{} MB/s {}",
+                     (static_cast<float>(count) * size * repeats) / usec,
+                     label)
+              << std::endl;
+  }
+
   void modes(int32_t size, int32_t gap, int32_t count) {
     int repeats =
         std::max<int32_t>(3, (FLAGS_measurement_size) / (size * count));
@@ -253,6 +305,12 @@ class ReadBenchmark {
     randomReads(size, gap, count, repeats, Mode::Pread, true);
     randomReads(size, gap, count, repeats, Mode::Preadv, true);
     randomReads(size, gap, count, repeats, Mode::Multiple, true);
+    if (ioUringFile_ != nullptr) {
+      asyncReads(
+          size, gap, count, repeats, *executorFile_, "preadvAsync executor");
+      asyncReads(
+          size, gap, count, repeats, *ioUringFile_, "preadvAsync io_uring");
+    }
   }
 
   void run();
@@ -260,11 +318,17 @@ class ReadBenchmark {
  protected:
   static constexpr int64_t kRegionSize = 64 << 20; // 64MB
   static constexpr int32_t kWrite = -10000;
+  static constexpr int32_t kMaxAsyncReads = 64;
   // 0 means no op, kWrite means being written, other numbers are reader counts.
   std::string writeBatch_;
   int32_t fd_;
   std::unique_ptr<folly::IOThreadPoolExecutor> executor_;
   std::unique_ptr<ReadFile> readFile_;
+  // Set with --io_uring to compare the executor based preadvAsync() of a
+  // LocalReadFile with the io_uring based one.
+  std::unique_ptr<IoUringReader> ioUring_;
+  std::unique_ptr<ReadFile> executorFile_;
+  std::unique_ptr<ReadFile> ioUringFile_;
   folly::Random::DefaultGenerator rng_;
   int64_t fileSize_;
 
@@ -27,10 +27,14 @@ struct PrefixSortConfig {
   PrefixSortConfig(
       uint32_t _maxNormalizedKeyBytes,
       uint32_t _minNumRows,
-      uint32_t _maxStringPrefixLength)
+      uint32_t _maxStringPrefixLength,
+      bool _radixSortEnabled = false,
+      uint32_t _maxMergeRuns = 0)
       : maxNormalizedKeyBytes(_maxNormalizedKeyBytes),
         minNumRows(_minNumRows),
-        maxStringPrefixLength(_maxStringPrefixLength) {}
+        maxStringPrefixLength(_maxStringPrefixLength),
+        radixSortEnabled(_radixSortEnabled),
+        maxMergeRuns(_maxMergeRuns) {}
 
   /// Maximum bytes that can be used to store normalized keys in prefix-sort
   /// buffer per entry. Same with QueryConfig kPrefixSortNormalizedKeyMaxBytes.
@@ -43,5 +47,15 @@ struct PrefixSortConfig {
   /// Maximum number of bytes to be stored in prefix-sort buffer for a string
   /// column.
   uint32_t maxStringPrefixLength{16};
+
+  /// If true, sorts with radix sort over the prefix-sort buffer when all the
+  /// sort keys are fully stored in the prefix. Same with QueryConfig
+  /// kPrefixSortRadixSortEnabled.
+  bool radixSortEnabled{false};
+
+  /// If not zero, detects the already sorted runs of the input and merges them
+  /// if there are at most this many. Otherwise the input is fully sorted. Same
+  /// with QueryConfig kPrefixSortMaxMergeRuns.
+  uint32_t maxMergeRuns{0};
 };
 } // namespace facebook::velox::common
@@ -28,6 +28,10 @@ class SelectivityInfo {
     numOut_ += numOut;
   }
 
+  /// Returns the time spent per dropped row, i.e. the time per input row
+  /// divided by the fraction of rows dropped. Evaluating filters in
+  /// increasing order of this value minimizes the total time, so that a cheap
+  /// filter runs before a slightly more selective but expensive one.
   float timeToDropValue() const {
     if (numIn_ == numOut_) {
       return timeClocks_;
@@ -35,6 +39,13 @@ class SelectivityInfo {
     return timeClocks_ / static_cast<float>(numIn_ - numOut_);
   }
 
+  /// Adds the rows and time of 'other' to 'this'.
+  void add(const SelectivityInfo& other) {
+    numIn_ += other.numIn_;
+    numOut_ += other.numOut_;
+    timeClocks_ += other.timeClocks_;
+  }
+
   bool operator<(const SelectivityInfo& right) const {
     return timeToDropValue() < right.timeToDropValue();
   }
@@ -72,7 +72,9 @@ struct SpillConfig {
       uint64_t _writerFlushThresholdSize,
       const std::string& _compressionKind,
       std::optional<PrefixSortConfig> _prefixSortConfig = std::nullopt,
-      const std::string& _fileCreateConfig = {});
+      const std::string& _fileCreateConfig = {},
+      bool _rowFormatEnabled = false,
+      uint64_t _readAheadBufferSize = 0);
 
   /// Returns the spilling level with given 'startBitOffset' and
   /// 'numPartitionBits'.
@@ -157,5 +159,14 @@ struct SpillConfig {
 
   /// Custom options passed to velox::FileSystem to create spill WriteFile.
   std::string fileCreateConfig;
+
+  /// If true, sorted spilling from a RowContainer writes the rows in row
+  /// format when the sorting keys support it. See SortRowSpiller.
+  bool rowFormatEnabled{false};
+
+  /// The max bytes of read-ahead buffers when merging spill files. Read-ahead
+  /// runs on 'executor' for file systems without async read. See
+  /// SpillPartition::createOrderedReader().
+  uint64_t readAheadBufferSize{0};
 };
 } // namespace facebook::velox::common
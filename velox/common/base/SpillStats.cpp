@@ -53,7 +53,11 @@ SpillStats::SpillStats(
     uint64_t _spillReadBytes,
     uint64_t _spillReads,
     uint64_t _spillReadTimeNanos,
-    uint64_t _spillDeserializationTimeNanos)
+    uint64_t _spillDeserializationTimeNanos,
+    uint64_t _spillReadAheadHits,
+    uint64_t _spillReadAheadMisses,
+    uint64_t _spillReadAheadWaitTimeNanos,
+    uint64_t _spilledRowFormatRows)
     : spillRuns(_spillRuns),
       spilledInputBytes(_spilledInputBytes),
       spilledBytes(_spilledBytes),
@@ -71,7 +75,11 @@ SpillStats::SpillStats(
       spillReadBytes(_spillReadBytes),
       spillReads(_spillReads),
       spillReadTimeNanos(_spillReadTimeNanos),
-      spillDeserializationTimeNanos(_spillDeserializationTimeNanos) {}
+      spillDeserializationTimeNanos(_spillDeserializationTimeNanos),
+      spillReadAheadHits(_spillReadAheadHits),
+      spillReadAheadMisses(_spillReadAheadMisses),
+      spillReadAheadWaitTimeNanos(_spillReadAheadWaitTimeNanos),
+      spilledRowFormatRows(_spilledRowFormatRows) {}
 
 SpillStats& SpillStats::operator+=(const SpillStats& other) {
   spillRuns += other.spillRuns;
@@ -92,6 +100,10 @@ SpillStats& SpillStats::operator+=(const SpillStats& other) {
   spillReads += other.spillReads;
   spillReadTimeNanos += other.spillReadTimeNanos;
   spillDeserializationTimeNanos += other.spillDeserializationTimeNanos;
+  spillReadAheadHits += other.spillReadAheadHits;
+  spillReadAheadMisses += other.spillReadAheadMisses;
+  spillReadAheadWaitTimeNanos += other.spillReadAheadWaitTimeNanos;
+  spilledRowFormatRows += other.spilledRowFormatRows;
   return *this;
 }
 
@@ -121,6 +133,13 @@ SpillStats SpillStats::operator-(const SpillStats& other) const {
   result.spillReadTimeNanos = spillReadTimeNanos - other.spillReadTimeNanos;
   result.spillDeserializationTimeNanos =
       spillDeserializationTimeNanos - other.spillDeserializationTimeNanos;
+  result.spillReadAheadHits = spillReadAheadHits - other.spillReadAheadHits;
+  result.spillReadAheadMisses =
+      spillReadAheadMisses - other.spillReadAheadMisses;
+  result.spillReadAheadWaitTimeNanos =
+      spillReadAheadWaitTimeNanos - other.spillReadAheadWaitTimeNanos;
+  result.spilledRowFormatRows =
+      spilledRowFormatRows - other.spilledRowFormatRows;
   return result;
 }
 
@@ -154,6 +173,10 @@ bool SpillStats::operator<(const SpillStats& other) const {
   UPDATE_COUNTER(spillReads);
   UPDATE_COUNTER(spillReadTimeNanos);
   UPDATE_COUNTER(spillDeserializationTimeNanos);
+  UPDATE_COUNTER(spillReadAheadHits);
+  UPDATE_COUNTER(spillReadAheadMisses);
+  UPDATE_COUNTER(spillReadAheadWaitTimeNanos);
+  UPDATE_COUNTER(spilledRowFormatRows);
 #undef UPDATE_COUNTER
   VELOX_CHECK(
       !((gtCount > 0) && (ltCount > 0)),
@@ -194,7 +217,11 @@ bool SpillStats::operator==(const SpillStats& other) const {
              spillReadBytes,
              spillReads,
              spillReadTimeNanos,
-             spillDeserializationTimeNanos) ==
+             spillDeserializationTimeNanos,
+             spillReadAheadHits,
+             spillReadAheadMisses,
+             spillReadAheadWaitTimeNanos,
+             spilledRowFormatRows) ==
       std::tie(
              other.spillRuns,
              other.spilledInputBytes,
@@ -213,7 +240,11 @@ bool SpillStats::operator==(const SpillStats& other) const {
              spillReadBytes,
              spillReads,
              spillReadTimeNanos,
-             spillDeserializationTimeNanos);
+             spillDeserializationTimeNanos,
+             other.spillReadAheadHits,
+             other.spillReadAheadMisses,
+             other.spillReadAheadWaitTimeNanos,
+             other.spilledRowFormatRows);
 }
 
 void SpillStats::reset() {
@@ -235,6 +266,10 @@ void SpillStats::reset() {
   spillReads = 0;
   spillReadTimeNanos = 0;
   spillDeserializationTimeNanos = 0;
+  spillReadAheadHits = 0;
+  spillReadAheadMisses = 0;
+  spillReadAheadWaitTimeNanos = 0;
+  spilledRowFormatRows = 0;
 }
 
 std::string SpillStats::toString() const {
@@ -244,7 +279,9 @@ std::string SpillStats::toString() const {
       "spillSortTimeNanos[{}] spillExtractVectorTime[{}] spillSerializationTimeNanos[{}] spillWrites[{}] "
       "spillFlushTimeNanos[{}] spillWriteTimeNanos[{}] maxSpillExceededLimitCount[{}] "
       "spillReadBytes[{}] spillReads[{}] spillReadTimeNanos[{}] "
-      "spillReadDeserializationTimeNanos[{}]",
+      "spillReadDeserializationTimeNanos[{}] spillReadAheadHits[{}] "
+      "spillReadAheadMisses[{}] spillReadAheadWaitTimeNanos[{}] "
+      "spilledRowFormatRows[{}]",
       spillRuns,
       succinctBytes(spilledInputBytes),
       succinctBytes(spilledBytes),
@@ -262,7 +299,11 @@ std::string SpillStats::toString() const {
       succinctBytes(spillReadBytes),
       spillReads,
       succinctNanos(spillReadTimeNanos),
-      succinctNanos(spillDeserializationTimeNanos));
+      succinctNanos(spillDeserializationTimeNanos),
+      spillReadAheadHits,
+      spillReadAheadMisses,
+      succinctNanos(spillReadAheadWaitTimeNanos),
+      spilledRowFormatRows);
 }
 
 void updateGlobalSpillRunStats(uint64_t numRuns) {
@@ -328,6 +369,16 @@ void updateGlobalSpillReadStats(
   statsLocked->spillReadTimeNanos += spillReadTimeNs;
 }
 
+void updateGlobalSpillReadAheadStats(
+    uint64_t readAheadHits,
+    uint64_t readAheadMisses,
+    uint64_t readAheadWaitTimeNs) {
+  auto statsLocked = localSpillStats().wlock();
+  statsLocked->spillReadAheadHits += readAheadHits;
+  statsLocked->spillReadAheadMisses += readAheadMisses;
+  statsLocked->spillReadAheadWaitTimeNanos += readAheadWaitTimeNs;
+}
+
 void updateGlobalSpillMemoryBytes(uint64_t spilledInputBytes) {
   RECORD_METRIC_VALUE(kMetricSpilledInputBytes, spilledInputBytes);
   auto statsLocked = localSpillStats().wlock();
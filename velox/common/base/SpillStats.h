@@ -68,6 +68,15 @@ struct SpillStats {
   uint64_t spillReadTimeNanos{0};
   /// The time spent on deserializing rows read from spilled files.
   uint64_t spillDeserializationTimeNanos{0};
+  /// The number of spill file reads served by a completed read-ahead.
+  uint64_t spillReadAheadHits{0};
+  /// The number of spill file reads which had to wait for a read-ahead in
+  /// progress.
+  uint64_t spillReadAheadMisses{0};
+  /// The time spent on waiting for read-ahead of spilled files.
+  uint64_t spillReadAheadWaitTimeNanos{0};
+  /// The number of rows spilled in row format. See SortRowSpiller.
+  uint64_t spilledRowFormatRows{0};
 
   SpillStats(
       uint64_t _spillRuns,
@@ -87,7 +96,11 @@ struct SpillStats {
       uint64_t _spillReadBytes,
       uint64_t _spillReads,
       uint64_t _spillReadTimeNanos,
-      uint64_t _spillDeserializationTimeNanos);
+      uint64_t _spillDeserializationTimeNanos,
+      uint64_t _spillReadAheadHits = 0,
+      uint64_t _spillReadAheadMisses = 0,
+      uint64_t _spillReadAheadWaitTimeNanos = 0,
+      uint64_t _spilledRowFormatRows = 0);
 
   SpillStats() = default;
 
@@ -154,6 +167,12 @@ void updateGlobalSpillReadStats(
     uint64_t spillReadBytes,
     uint64_t spillRadTimeNs);
 
+/// Updates the read-ahead stats of reading from spilled files.
+void updateGlobalSpillReadAheadStats(
+    uint64_t readAheadHits,
+    uint64_t readAheadMisses,
+    uint64_t readAheadWaitTimeNs);
+
 /// Increments the spill memory bytes.
 void updateGlobalSpillMemoryBytes(uint64_t spilledInputBytes);
 
@@ -42,6 +42,10 @@ TEST(SpillStatsTest, spillStats) {
   stats1.spillReads = 10;
   stats1.spillReadTimeNanos = 100;
   stats1.spillDeserializationTimeNanos = 100;
+  stats1.spillReadAheadHits = 5;
+  stats1.spillReadAheadMisses = 2;
+  stats1.spillReadAheadWaitTimeNanos = 100;
+  stats1.spilledRowFormatRows = 1000;
   ASSERT_FALSE(stats1.empty());
   SpillStats stats2;
   stats2.spillRuns = 100;
@@ -62,6 +66,10 @@ TEST(SpillStatsTest, spillStats) {
   stats2.spillReads = 10;
   stats2.spillReadTimeNanos = 100;
   stats2.spillDeserializationTimeNanos = 100;
+  stats2.spillReadAheadHits = 7;
+  stats2.spillReadAheadMisses = 2;
+  stats2.spillReadAheadWaitTimeNanos = 100;
+  stats2.spilledRowFormatRows = 1011;
   ASSERT_TRUE(stats1 < stats2);
   ASSERT_TRUE(stats1 <= stats2);
   ASSERT_FALSE(stats1 > stats2);
@@ -93,6 +101,10 @@ TEST(SpillStatsTest, spillStats) {
   ASSERT_EQ(delta.spillReads, 0);
   ASSERT_EQ(delta.spillReadTimeNanos, 0);
   ASSERT_EQ(delta.spillDeserializationTimeNanos, 0);
+  ASSERT_EQ(delta.spillReadAheadHits, 2);
+  ASSERT_EQ(delta.spillReadAheadMisses, 0);
+  ASSERT_EQ(delta.spillReadAheadWaitTimeNanos, 0);
+  ASSERT_EQ(delta.spilledRowFormatRows, 11);
   delta = stats1 - stats2;
   ASSERT_EQ(delta.spilledInputBytes, 0);
   ASSERT_EQ(delta.spilledBytes, 0);
@@ -111,6 +123,10 @@ TEST(SpillStatsTest, spillStats) {
   ASSERT_EQ(delta.spillReads, 0);
   ASSERT_EQ(delta.spillReadTimeNanos, 0);
   ASSERT_EQ(delta.spillDeserializationTimeNanos, 0);
+  ASSERT_EQ(delta.spillReadAheadHits, -2);
+  ASSERT_EQ(delta.spillReadAheadMisses, 0);
+  ASSERT_EQ(delta.spillReadAheadWaitTimeNanos, 0);
+  ASSERT_EQ(delta.spilledRowFormatRows, -11);
   stats1.spilledInputBytes = 2060;
   stats1.spilledBytes = 1030;
   stats1.spillReadBytes = 4096;
@@ -131,7 +147,9 @@ TEST(SpillStatsTest, spillStats) {
       "spillSerializationTimeNanos[1.03us] spillWrites[1028] spillFlushTimeNanos[1.03us] "
       "spillWriteTimeNanos[1.03us] maxSpillExceededLimitCount[4] "
       "spillReadBytes[2.00KB] spillReads[10] spillReadTimeNanos[100ns] "
-      "spillReadDeserializationTimeNanos[100ns]");
+      "spillReadDeserializationTimeNanos[100ns] spillReadAheadHits[7] "
+      "spillReadAheadMisses[2] spillReadAheadWaitTimeNanos[100ns] "
+      "spilledRowFormatRows[1011]");
   ASSERT_EQ(
       fmt::format("{}", stats2),
       "spillRuns[100] spilledInputBytes[2.00KB] spilledBytes[1.00KB] "
@@ -141,5 +159,7 @@ TEST(SpillStatsTest, spillStats) {
       "spillFlushTimeNanos[1.03us] spillWriteTimeNanos[1.03us] "
       "maxSpillExceededLimitCount[4] "
       "spillReadBytes[2.00KB] spillReads[10] spillReadTimeNanos[100ns] "
-      "spillReadDeserializationTimeNanos[100ns]");
+      "spillReadDeserializationTimeNanos[100ns] spillReadAheadHits[7] "
+      "spillReadAheadMisses[2] spillReadAheadWaitTimeNanos[100ns] "
+      "spilledRowFormatRows[1011]");
 }
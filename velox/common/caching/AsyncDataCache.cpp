@@ -19,6 +19,10 @@
 #include "velox/common/caching/SsdCache.h"
 #include "velox/common/caching/SsdFile.h"
 
+#include <algorithm>
+#include <shared_mutex>
+#include <thread>
+
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/StatsReporter.h"
@@ -52,7 +56,7 @@ void AsyncDataCacheEntry::setExclusiveToShared(bool ssdSavable) {
   numPins_ = 1;
   std::unique_ptr<folly::SharedPromise<bool>> promise;
   {
-    std::lock_guard<std::mutex> l(shard_->mutex());
+    std::lock_guard<folly::SharedMutex> l(shard_->mutex());
     // Enter the shard's mutex to make sure a promise is not being added during
     // the move.
     promise = std::move(promise_);
@@ -162,13 +166,46 @@ std::unique_ptr<AsyncDataCacheEntry> CacheShard::getFreeEntry() {
   return newEntry;
 }
 
+CachePin CacheShard::tryFindShared(RawFileCacheKey key, uint64_t size) {
+  std::shared_lock l(mutex_);
+  auto it = entryMap_.find(key);
+  if (it == entryMap_.end()) {
+    return CachePin();
+  }
+  auto* foundEntry = it->second;
+  // The first hit on a prefetched entry changes its state and is left to the
+  // exclusive path.
+  if (foundEntry->size() < size || foundEntry->isPrefetch()) {
+    return CachePin();
+  }
+  // Holding 'mutex_' in shared mode excludes eviction and removal, so a
+  // non-exclusive entry can be pinned with a CAS.
+  auto numPins = foundEntry->numPins_.load();
+  do {
+    if (numPins < 0) {
+      return CachePin();
+    }
+  } while (!foundEntry->numPins_.compare_exchange_weak(numPins, numPins + 1));
+  foundEntry->touch();
+  ++eventCounter_;
+  ++numHit_;
+  hitBytes_ += foundEntry->size();
+  CachePin pin;
+  pin.setEntry(foundEntry);
+  return pin;
+}
+
 CachePin CacheShard::findOrCreate(
     RawFileCacheKey key,
     uint64_t size,
     folly::SemiFuture<bool>* wait) {
+  auto sharedPin = tryFindShared(key, size);
+  if (!sharedPin.empty()) {
+    return sharedPin;
+  }
   AsyncDataCacheEntry* entryToInit = nullptr;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::lock_guard<folly::SharedMutex> l(mutex_);
     ++eventCounter_;
     auto it = entryMap_.find(key);
     if (it != entryMap_.end()) {
@@ -235,7 +272,7 @@ CachePin CacheShard::findOrCreate(
 }
 
 void CacheShard::makeEvictable(RawFileCacheKey key) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   auto it = entryMap_.find(key);
   if (it == entryMap_.end()) {
     return;
@@ -244,7 +281,7 @@ void CacheShard::makeEvictable(RawFileCacheKey key) {
 }
 
 bool CacheShard::exists(RawFileCacheKey key) const {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   auto it = entryMap_.find(key);
   if (it != entryMap_.end()) {
     it->second->touch();
@@ -332,7 +369,7 @@ void CoalescedLoad::setEndState(State endState) {
 
 std::unique_ptr<folly::SharedPromise<bool>> CacheShard::removeEntry(
     AsyncDataCacheEntry* entry) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   removeEntryLocked(entry);
   // After the entry is removed from the hash table, a promise can no longer
   // be made. It is safe to move the promise and realize it.
@@ -380,7 +417,7 @@ uint64_t CacheShard::evict(
   int64_t largeEvicted = 0;
   int32_t evictSaveableSkipped = 0;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::lock_guard<folly::SharedMutex> l(mutex_);
     const size_t size = entries_.size();
     if (size == 0) {
       return 0;
@@ -514,7 +551,7 @@ void CacheShard::calibrateThreshold() {
 }
 
 void CacheShard::updateStats(CacheStats& stats) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   for (auto& entry : entries_) {
     if (!entry || !entry->key_.fileNum.hasValue()) {
       ++stats.numEmptyEntries;
@@ -558,7 +595,7 @@ void CacheShard::updateStats(CacheStats& stats) {
 }
 
 void CacheShard::appendSsdSaveable(bool saveAll, std::vector<CachePin>& pins) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   // Do not add entries to a write batch more than maxWriteRatio_. If SSD save
   // is slower than storage read, we must not have a situation where SSD save
   // pins everything and stops reading.
@@ -594,7 +631,7 @@ bool CacheShard::removeFileEntries(
   int64_t pagesRemoved = 0;
   std::vector<memory::Allocation> toFree;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::lock_guard<folly::SharedMutex> l(mutex_);
 
     auto entryIndex = -1;
     for (auto& cacheEntry : entries_) {
@@ -667,8 +704,11 @@ AsyncDataCache::AsyncDataCache(
     : opts_(options),
       allocator_(allocator),
       ssdCache_(std::move(ssdCache)),
+      numShards_(bits::nextPowerOfTwo(
+          opts_.numShards > 0 ? opts_.numShards : kDefaultNumShards)),
+      shardMask_(numShards_ - 1),
       cachedPages_(0) {
-  for (auto i = 0; i < kNumShards; ++i) {
+  for (auto i = 0; i < numShards_; ++i) {
     shards_.push_back(std::make_unique<CacheShard>(this, opts_.maxWriteRatio));
   }
 }
@@ -720,17 +760,17 @@ CachePin AsyncDataCache::findOrCreate(
     RawFileCacheKey key,
     uint64_t size,
     folly::SemiFuture<bool>* wait) {
-  const int shard = std::hash<RawFileCacheKey>()(key) & (kShardMask);
+  const int shard = std::hash<RawFileCacheKey>()(key) & shardMask_;
   return shards_[shard]->findOrCreate(key, size, wait);
 }
 
 void AsyncDataCache::makeEvictable(RawFileCacheKey key) {
-  const int shard = std::hash<RawFileCacheKey>()(key) & (kShardMask);
+  const int shard = std::hash<RawFileCacheKey>()(key) & shardMask_;
   return shards_[shard]->makeEvictable(key);
 }
 
 bool AsyncDataCache::exists(RawFileCacheKey key) const {
-  int shard = std::hash<RawFileCacheKey>()(key) & (kShardMask);
+  int shard = std::hash<RawFileCacheKey>()(key) & shardMask_;
   return shards_[shard]->exists(key);
 }
 
@@ -749,7 +789,17 @@ bool AsyncDataCache::makeSpace(
   // serialize with a mutex because memory arbitration must not be
   // called from inside a global mutex.
 
-  constexpr int32_t kMaxAttempts = kNumShards * 4;
+  // The retry budget does not depend on the number of shards. Each attempt
+  // may sleep waiting for SSD writes and back off, so more shards must not
+  // mean longer stalls.
+  constexpr int32_t kMaxAttempts = 16;
+  // Number of attempts after which eviction also evicts entries that were
+  // recently accessed.
+  const int32_t numPoliteAttempts = std::min(numShards_, kMaxAttempts / 4);
+  // Number of shards visited per attempt. The polite attempts together visit
+  // every shard once, so that no evictable memory is left unvisited before
+  // going to desperate mode, sleeping or backing off.
+  const int32_t numShardsPerAttempt = numShards_ / numPoliteAttempts;
   // Evict at least 1MB even for small allocations to avoid constantly hitting
   // the mutex protected evict loop.
   constexpr int32_t kMinEvictPages = 256;
@@ -807,18 +857,25 @@ bool AsyncDataCache::makeSpace(
       // better rank.
       rank = std::min<int32_t>(rank, numThreadsInAllocate_);
     }
-    ++shardCounter_;
-    int32_t numPagesToAcquire =
-        acquired.numPages() < numPages ? numPages - acquired.numPages() : 0;
-    // Evict from next shard. If we have gone through all shards once
-    // and still have not made the allocation, we go to desperate mode
-    // with 'evictAllUnpinned' set to true.
-    shards_[shardCounter_ & (kShardMask)]->evict(
-        memory::AllocationTraits::pageBytes(
-            std::max<uint64_t>(kMinEvictPages, numPages) * sizeMultiplier),
-        nthAttempt >= kNumShards,
-        numPagesToAcquire,
-        acquired);
+    // Evict from the next shards. If we have gone through all shards once
+    // and still have not made the allocation, we go to desperate mode with
+    // 'evictAllUnpinned' set to true.
+    const uint64_t bytesToFree = memory::AllocationTraits::pageBytes(
+        std::max<uint64_t>(kMinEvictPages, numPages) * sizeMultiplier);
+    uint64_t evictedBytes = 0;
+    for (auto i = 0; i < numShardsPerAttempt; ++i) {
+      ++shardCounter_;
+      const int32_t numPagesToAcquire =
+          acquired.numPages() < numPages ? numPages - acquired.numPages() : 0;
+      evictedBytes += shards_[shardCounter_ & shardMask_]->evict(
+          bytesToFree - evictedBytes,
+          nthAttempt >= numPoliteAttempts,
+          numPagesToAcquire,
+          acquired);
+      if (evictedBytes >= bytesToFree) {
+        break;
+      }
+    }
     if (numPages < kSmallSizePages && sizeMultiplier < 4) {
       sizeMultiplier *= 2;
     }
@@ -842,7 +899,7 @@ uint64_t AsyncDataCache::shrink(uint64_t targetBytes) {
     MicrosecondTimer timer(&shrinkTimeUs);
     for (int shard = 0; shard < shards_.size(); ++shard) {
       memory::Allocation unused;
-      evictedBytes += shards_[shardCounter_++ & (kShardMask)]->evict(
+      evictedBytes += shards_[shardCounter_++ & shardMask_]->evict(
           std::max<uint64_t>(minBytesToEvict, targetBytes - evictedBytes),
           // Cache shrink is triggered when server is under low memory pressure
           // so need to free up memory as soon as possible. So we always avoid
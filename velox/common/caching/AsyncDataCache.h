@@ -20,6 +20,7 @@
 
 #include <fmt/format.h>
 #include <folly/GLog.h>
+#include <folly/SharedMutex.h>
 #include <folly/chrono/Hardware.h>
 #include <folly/container/F14Set.h>
 #include <folly/futures/SharedPromise.h>
@@ -300,7 +301,10 @@ class AsyncDataCacheEntry {
   std::unique_ptr<folly::SharedPromise<bool>> promise_;
   int32_t size_{0};
 
-  // Setting this from 0 to 1 or to kExclusive requires owning shard_->mutex_.
+  // Setting this to kExclusive requires owning shard_->mutex_ exclusively.
+  // Adding a shared pin requires owning shard_->mutex_ in either shared or
+  // exclusive mode, so that the entry cannot be evicted or invalidated
+  // concurrently.
   std::atomic<int32_t> numPins_{0};
 
   AccessStats accessStats_;
@@ -308,7 +312,7 @@ class AsyncDataCacheEntry {
   // True if 'this' is speculatively loaded. This is reset on first hit. Allows
   // catching a situation where prefetched entries get evicted before they are
   // hit.
-  bool isPrefetch_{false};
+  tsan_atomic<bool> isPrefetch_{false};
 
   // Sets after first use of a prefetched entry. Cleared by
   // getAndClearFirstUseFlag(). Does not require synchronization since used for
@@ -575,7 +579,7 @@ class CacheShard {
     return cache_;
   }
 
-  std::mutex& mutex() {
+  folly::SharedMutex& mutex() {
     return mutex_;
   }
 
@@ -642,6 +646,11 @@ class CacheShard {
 
   CachePin initEntry(RawFileCacheKey key, AsyncDataCacheEntry* entry);
 
+  // Looks up 'key' holding 'mutex_' in shared mode and pins the entry if it is
+  // readable, at least 'size' bytes and not prefetched. Returns an empty pin
+  // otherwise, in which case the caller retries holding 'mutex_' exclusively.
+  CachePin tryFindShared(RawFileCacheKey key, uint64_t size);
+
   void freeAllocations(std::vector<memory::Allocation>& allocations);
 
   void tryAddFreeEntry(std::unique_ptr<AsyncDataCacheEntry>&& entry);
@@ -649,7 +658,9 @@ class CacheShard {
   AsyncDataCache* const cache_;
   const double maxWriteRatio_;
 
-  mutable std::mutex mutex_;
+  // Held in shared mode for cache hits and in exclusive mode for anything that
+  // modifies 'entryMap_' or 'entries_'.
+  mutable folly::SharedMutex mutex_;
   folly::F14FastMap<RawFileCacheKey, AsyncDataCacheEntry*> entryMap_;
   // Entries associated to a key.
   std::deque<std::unique_ptr<AsyncDataCacheEntry>> entries_;
@@ -661,14 +672,15 @@ class CacheShard {
 
   // Index in 'entries_' for the next eviction candidate.
   uint32_t clockHand_{0};
-  // Number of gets since last stats sampling.
-  uint32_t eventCounter_{0};
+  // Number of gets since last stats sampling. Incremented by hits that hold
+  // 'mutex_' in shared mode.
+  std::atomic<uint32_t> eventCounter_{0};
   // Maximum retainable entry score(). Anything above this is evictable.
   int32_t evictionThreshold_{kNoThreshold};
   // Cumulative count of cache hits.
-  uint64_t numHit_{0};
+  std::atomic<uint64_t> numHit_{0};
   // Cumulative Sum of bytes in cache hits.
-  uint64_t hitBytes_{0};
+  std::atomic<uint64_t> hitBytes_{0};
   // Cumulative count of hits on entries held in exclusive mode.
   uint64_t numWaitExclusive_{0};
   // Cumulative count of new entry creation.
@@ -700,10 +712,12 @@ class AsyncDataCache : public memory::Cache {
     Options(
         double _maxWriteRatio = 0.7,
         double _ssdSavableRatio = 0.125,
-        int32_t _minSsdSavableBytes = 1 << 24)
+        int32_t _minSsdSavableBytes = 1 << 24,
+        int32_t _numShards = 0)
         : maxWriteRatio(_maxWriteRatio),
           ssdSavableRatio(_ssdSavableRatio),
-          minSsdSavableBytes(_minSsdSavableBytes){};
+          minSsdSavableBytes(_minSsdSavableBytes),
+          numShards(_numShards){};
 
     /// The max ratio of the number of in-memory cache entries being written to
     /// SSD cache over the total number of cache entries. This is to control SSD
@@ -722,6 +736,12 @@ class AsyncDataCache : public memory::Cache {
     /// NOTE: we only write to SSD cache when both above conditions satisfy. The
     /// default is 16MB.
     int32_t minSsdSavableBytes;
+
+    /// The number of shards the cache entries are divided into. Each shard has
+    /// its own mutex so more shards reduce contention between concurrent
+    /// readers. The value is rounded up to a power of 2. If 0,
+    /// 'kDefaultNumShards' is used.
+    int32_t numShards;
   };
 
   AsyncDataCache(
@@ -875,10 +895,15 @@ class AsyncDataCache : public memory::Cache {
   /// NOTE: it is used by testing and Prestissimo server operation.
   void clear();
 
- private:
-  static constexpr int32_t kNumShards = 4; // Must be power of 2.
-  static constexpr int32_t kShardMask = kNumShards - 1;
+  /// Returns the number of shards. This is always a power of 2.
+  int32_t numShards() const {
+    return numShards_;
+  }
+
+  /// The number of shards used when 'Options::numShards' is 0.
+  static constexpr int32_t kDefaultNumShards = 4;
 
+ private:
   // True if 'acquired' has more pages than 'numPages' or allocator has space
   // for numPages - acquired pages of more allocation.
   bool canTryAllocate(
@@ -893,6 +918,8 @@ class AsyncDataCache : public memory::Cache {
   const Options opts_;
   memory::MemoryAllocator* const allocator_;
   std::unique_ptr<SsdCache> ssdCache_;
+  const int32_t numShards_;
+  const int32_t shardMask_;
   std::vector<std::unique_ptr<CacheShard>> shards_;
   std::atomic<int32_t> shardCounter_{0};
   std::atomic<memory::MachinePageCount> cachedPages_{0};
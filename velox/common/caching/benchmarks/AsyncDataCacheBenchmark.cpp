@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include <thread>
+
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/memory/Memory.h"
+
+DEFINE_int32(num_entries, 10'000, "Number of distinct cache entries");
+DEFINE_int32(entry_bytes, 1'000, "Size of each cache entry");
+DEFINE_int32(lookups_per_thread, 100'000, "Cache lookups done by each thread");
+DEFINE_int32(
+    pinned_pct,
+    10,
+    "Percentage of entries kept pinned during the benchmark, emulating "
+    "concurrent readers of the same data");
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+namespace {
+
+/// Measures the contention between threads that look up entries that are
+/// already in an AsyncDataCache. All lookups are hits, so the time is
+/// dominated by the shard lookup and pinning.
+class AsyncDataCacheBenchmark {
+ public:
+  explicit AsyncDataCacheBenchmark(int32_t numShards) {
+    // Each cache needs its own allocator.
+    memory::MemoryManager::Options managerOptions;
+    managerOptions.useMmapAllocator = true;
+    managerOptions.allocatorCapacity = 1L << 30;
+    manager_ = std::make_unique<memory::MemoryManager>(managerOptions);
+    AsyncDataCache::Options options;
+    options.numShards = numShards;
+    cache_ = AsyncDataCache::create(manager_->allocator(), nullptr, options);
+    file_ = StringIdLease(fileIds(), std::string_view("benchmark_file"));
+    for (auto i = 0; i < FLAGS_num_entries; ++i) {
+      auto pin = cache_->findOrCreate(key(i), FLAGS_entry_bytes);
+      VELOX_CHECK(pin.checkedEntry()->isExclusive());
+      pin.checkedEntry()->setExclusiveToShared();
+      if (folly::Random::rand32(100) < FLAGS_pinned_pct) {
+        pinned_.push_back(std::move(pin));
+      }
+    }
+  }
+
+  ~AsyncDataCacheBenchmark() {
+    pinned_.clear();
+    cache_->shutdown();
+  }
+
+  void run(int32_t numThreads) {
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (auto i = 0; i < numThreads; ++i) {
+      threads.emplace_back([&, i]() {
+        folly::Random::DefaultGenerator rng(i);
+        int64_t sum = 0;
+        for (auto n = 0; n < FLAGS_lookups_per_thread; ++n) {
+          auto pin = cache_->findOrCreate(
+              key(folly::Random::rand32(FLAGS_num_entries, rng)),
+              FLAGS_entry_bytes);
+          VELOX_CHECK(!pin.empty());
+          sum += pin.checkedEntry()->size();
+        }
+        folly::doNotOptimizeAway(sum);
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+ private:
+  RawFileCacheKey key(int32_t index) const {
+    return RawFileCacheKey{
+        file_.id(), static_cast<uint64_t>(index) * FLAGS_entry_bytes};
+  }
+
+  std::unique_ptr<memory::MemoryManager> manager_;
+  std::shared_ptr<AsyncDataCache> cache_;
+  StringIdLease file_;
+  std::vector<CachePin> pinned_;
+};
+
+std::unique_ptr<AsyncDataCacheBenchmark> fourShards;
+std::unique_ptr<AsyncDataCacheBenchmark> perCoreShards;
+
+void runFourShards(uint32_t, int32_t numThreads) {
+  fourShards->run(numThreads);
+}
+
+void runPerCoreShards(uint32_t, int32_t numThreads) {
+  perCoreShards->run(numThreads);
+}
+
+#define CACHE_HIT_BENCHMARKS(_numThreads_)                                    \
+  BENCHMARK_NAMED_PARAM(runFourShards, threads_##_numThreads_, _numThreads_); \
+  BENCHMARK_RELATIVE_NAMED_PARAM(                                             \
+      runPerCoreShards, threads_##_numThreads_, _numThreads_);                \
+  BENCHMARK_DRAW_LINE();
+
+CACHE_HIT_BENCHMARKS(8)
+CACHE_HIT_BENCHMARKS(16)
+CACHE_HIT_BENCHMARKS(32)
+CACHE_HIT_BENCHMARKS(64)
+CACHE_HIT_BENCHMARKS(128)
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init(&argc, &argv);
+  memory::MemoryManager::initialize(memory::MemoryManager::Options{});
+
+  fourShards = std::make_unique<AsyncDataCacheBenchmark>(4);
+  perCoreShards = std::make_unique<AsyncDataCacheBenchmark>(
+      std::thread::hardware_concurrency());
+  folly::runBenchmarks();
+  fourShards.reset();
+  perCoreShards.reset();
+  return 0;
+}
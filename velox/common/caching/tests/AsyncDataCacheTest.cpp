@@ -719,6 +719,48 @@ TEST_P(AsyncDataCacheTest, pin) {
   EXPECT_EQ(0, cache_->incrementPrefetchPages(0));
 }
 
+TEST_P(AsyncDataCacheTest, numShards) {
+  constexpr int64_t kSize = 25000;
+  initializeCache(1 << 20);
+  ASSERT_EQ(cache_->numShards(), AsyncDataCache::kDefaultNumShards);
+  ASSERT_EQ(asyncDataCacheHelper_->numShards(), cache_->numShards());
+
+  // A non power of 2 shard count is rounded up.
+  AsyncDataCache::Options options;
+  options.numShards = 5;
+  initializeCache(1 << 20, 0, 0, false, options);
+  ASSERT_EQ(cache_->numShards(), 8);
+  ASSERT_EQ(asyncDataCacheHelper_->numShards(), 8);
+
+  options.numShards = 1;
+  initializeCache(1 << 20, 0, 0, false, options);
+  ASSERT_EQ(cache_->numShards(), 1);
+
+  // Hits on shared and unpinned entries are counted the same way with any
+  // shard count.
+  StringIdLease file(fileIds(), std::string_view("testingfile"));
+  RawFileCacheKey key{file.id(), 1000};
+  auto pin = cache_->findOrCreate(key, kSize);
+  ASSERT_TRUE(pin.entry()->isExclusive());
+  initializeContents(key.fileNum + key.offset, pin.checkedEntry()->data());
+  pin.checkedEntry()->setExclusiveToShared();
+
+  auto otherPin = cache_->findOrCreate(key, kSize);
+  ASSERT_EQ(otherPin.entry(), pin.entry());
+  ASSERT_EQ(pin.entry()->numPins(), 2);
+  checkContents(*otherPin.entry());
+  otherPin.clear();
+  pin.clear();
+  pin = cache_->findOrCreate(key, kSize);
+  ASSERT_TRUE(pin.checkedEntry()->isShared());
+  pin.clear();
+  auto stats = cache_->refreshStats();
+  ASSERT_EQ(stats.numHit, 2);
+  ASSERT_EQ(stats.hitBytes, 2 * kSize);
+  ASSERT_EQ(stats.numShared, 0);
+  ASSERT_EQ(stats.numEntries, 1);
+}
+
 TEST_P(AsyncDataCacheTest, replace) {
   constexpr int64_t kMaxBytes = 64 << 20;
   FLAGS_velox_exception_user_stacktrace_enabled = false;
@@ -760,6 +802,28 @@ TEST_P(AsyncDataCacheTest, evictAccounting) {
   EXPECT_LT(0, stats.numEvict);
 }
 
+TEST_P(AsyncDataCacheTest, evictManyShards) {
+  constexpr int64_t kMaxBytes = 64 << 20;
+  FLAGS_velox_exception_user_stacktrace_enabled = false;
+  AsyncDataCache::Options options;
+  options.numShards = 256;
+  initializeCache(kMaxBytes, 0, 0, false, options);
+  auto pool = manager_->addLeafPool("test");
+  loadLoop(0, kMaxBytes * 1.1);
+  waitForPendingLoads();
+
+  // The cached data is spread over many more shards than there are eviction
+  // attempts. The allocation must still find it.
+  constexpr memory::MachinePageCount kNumPages =
+      kMaxBytes * 3 / 4 / memory::AllocationTraits::kPageSize;
+  memory::Allocation allocation;
+  pool->allocateNonContiguous(kNumPages, allocation);
+  EXPECT_EQ(memory::AllocationTraits::pageBytes(kNumPages), pool->usedBytes());
+  pool->freeNonContiguous(allocation);
+  auto stats = cache_->refreshStats();
+  EXPECT_LT(0, stats.numEvict);
+}
+
 TEST_P(AsyncDataCacheTest, largeEvict) {
   constexpr int64_t kMaxBytes = 256 << 20;
   constexpr int32_t kNumThreads = 24;
@@ -146,7 +146,7 @@ class CacheShardTestHelper {
 
   std::vector<AsyncDataCacheEntry*> cacheEntries() const {
     std::vector<AsyncDataCacheEntry*> entries;
-    std::lock_guard<std::mutex> l(cacheShard_->mutex_);
+    std::lock_guard<folly::SharedMutex> l(cacheShard_->mutex_);
     entries.reserve(cacheShard_->entries_.size());
     for (const auto& entry : cacheShard_->entries_) {
       entries.push_back(entry.get());
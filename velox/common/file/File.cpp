@@ -16,6 +16,7 @@
 
 #include "velox/common/file/File.h"
 #include "velox/common/base/Fs.h"
+#include "velox/common/file/IoUringReader.h"
 
 #include <fmt/format.h>
 #include <glog/logging.h>
@@ -143,8 +144,9 @@ uint64_t InMemoryWriteFile::size() const {
 LocalReadFile::LocalReadFile(
     std::string_view path,
     folly::Executor* executor,
-    bool bufferIo)
-    : executor_(executor), path_(path) {
+    bool bufferIo,
+    IoUringReader* ioUring)
+    : executor_(executor), ioUring_(ioUring), path_(path) {
   int32_t flags = O_RDONLY;
 #ifdef linux
   if (!bufferIo) {
@@ -174,8 +176,11 @@ LocalReadFile::LocalReadFile(
   size_ = ret;
 }
 
-LocalReadFile::LocalReadFile(int32_t fd, folly::Executor* executor)
-    : executor_(executor), fd_(fd) {}
+LocalReadFile::LocalReadFile(
+    int32_t fd,
+    folly::Executor* executor,
+    IoUringReader* ioUring)
+    : executor_(executor), ioUring_(ioUring), fd_(fd) {}
 
 LocalReadFile::~LocalReadFile() {
   const int ret = close(fd_);
@@ -268,6 +273,9 @@ folly::SemiFuture<uint64_t> LocalReadFile::preadvAsync(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers,
     filesystems::File::IoStats* stats) const {
+  if (ioUring_) {
+    return ioUring_->preadv(fd_, offset, buffers, stats);
+  }
   if (!executor_) {
     return ReadFile::preadvAsync(offset, buffers, stats);
   }
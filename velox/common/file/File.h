@@ -45,6 +45,8 @@
 
 namespace facebook::velox {
 
+class IoUringReader;
+
 // A read-only file.  All methods in this object should be thread safe.
 class ReadFile {
  public:
@@ -294,16 +296,23 @@ class InMemoryWriteFile final : public WriteFile {
 /// Current implementation for the local version is quite simple (e.g. no
 /// internal arenaing), as local disk writes are expected to be cheap. Local
 /// files match against any filepath starting with '/'.
+///
+/// preadvAsync() is served by 'ioUring' if set. Otherwise it runs preadv() on
+/// 'executor' if set, or synchronously.
 class LocalReadFile final : public ReadFile {
  public:
   LocalReadFile(
       std::string_view path,
       folly::Executor* executor = nullptr,
-      bool bufferIo = true);
+      bool bufferIo = true,
+      IoUringReader* ioUring = nullptr);
 
   /// TODO: deprecate this after creating local file all through velox fs
   /// interface.
-  LocalReadFile(int32_t fd, folly::Executor* executor = nullptr);
+  LocalReadFile(
+      int32_t fd,
+      folly::Executor* executor = nullptr,
+      IoUringReader* ioUring = nullptr);
 
   ~LocalReadFile();
 
@@ -326,7 +335,7 @@ class LocalReadFile final : public ReadFile {
       filesystems::File::IoStats* stats = nullptr) const override;
 
   bool hasPreadvAsync() const override {
-    return executor_ != nullptr;
+    return executor_ != nullptr || ioUring_ != nullptr;
   }
 
   uint64_t memoryUsage() const final;
@@ -350,6 +359,7 @@ class LocalReadFile final : public ReadFile {
   void preadInternal(uint64_t offset, uint64_t length, char* pos) const;
 
   folly::Executor* const executor_;
+  IoUringReader* const ioUring_;
   std::string path_;
   int32_t fd_;
   long size_;
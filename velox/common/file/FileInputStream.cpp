@@ -21,12 +21,16 @@ namespace facebook::velox::common {
 FileInputStream::FileInputStream(
     std::unique_ptr<ReadFile>&& file,
     uint64_t bufferSize,
-    memory::MemoryPool* pool)
+    memory::MemoryPool* pool,
+    folly::Executor* readAheadExecutor)
     : file_(std::move(file)),
       fileSize_(file_->size()),
       bufferSize_(std::min(fileSize_, bufferSize)),
       pool_(pool),
-      readAheadEnabled_((bufferSize_ < fileSize_) && file_->hasPreadvAsync()) {
+      readAheadExecutor_(readAheadExecutor),
+      readAheadEnabled_(
+          (bufferSize_ < fileSize_) &&
+          (file_->hasPreadvAsync() || readAheadExecutor_ != nullptr)) {
   VELOX_CHECK_NOT_NULL(pool_);
   VELOX_CHECK_GT(fileSize_, 0, "Empty FileInputStream");
 
@@ -59,6 +63,12 @@ void FileInputStream::readNextRange() {
   {
     NanosecondTimer timer{&readTimeNs};
     if (readAheadWait_.valid()) {
+      if (readAheadWait_.isReady()) {
+        ++stats_.numReadAheadHits;
+      } else {
+        ++stats_.numReadAheadMisses;
+      }
+      NanosecondTimer waitTimer{&stats_.readAheadWaitTimeNs};
       readBytes = std::move(readAheadWait_)
                       .via(&folly::QueuedImmediateExecutor::instance())
                       .wait()
@@ -214,12 +224,36 @@ void FileInputStream::maybeIssueReadahead() {
   if (size == 0) {
     return;
   }
-  std::vector<folly::Range<char*>> ranges;
-  ranges.emplace_back(nextBuffer()->asMutable<char>(), size);
-  readAheadWait_ = file_->preadvAsync(fileOffset_, ranges);
+  if (file_->hasPreadvAsync()) {
+    std::vector<folly::Range<char*>> ranges;
+    ranges.emplace_back(nextBuffer()->asMutable<char>(), size);
+    readAheadWait_ = file_->preadvAsync(fileOffset_, ranges);
+  } else {
+    readAheadWait_ = readAheadOnExecutor(size);
+  }
   VELOX_CHECK(readAheadWait_.valid());
 }
 
+folly::SemiFuture<uint64_t> FileInputStream::readAheadOnExecutor(
+    uint64_t size) {
+  VELOX_CHECK_NOT_NULL(readAheadExecutor_);
+  folly::Promise<uint64_t> promise;
+  auto future = promise.getSemiFuture();
+  // The destructor waits for the read-ahead so 'file_' and the buffer outlive
+  // the read.
+  readAheadExecutor_->add([file = file_.get(),
+                           offset = fileOffset_,
+                           size,
+                           buffer = nextBuffer()->asMutable<char>(),
+                           promise = std::move(promise)]() mutable {
+    promise.setWith([&]() -> uint64_t {
+      file->pread(offset, size, buffer);
+      return size;
+    });
+  });
+  return future;
+}
+
 void FileInputStream::updateStats(uint64_t readBytes, uint64_t readTimeNs) {
   stats_.readBytes += readBytes;
   stats_.readTimeNs += readTimeNs;
@@ -241,15 +275,31 @@ FileInputStream::Stats FileInputStream::stats() const {
 
 bool FileInputStream::Stats::operator==(
     const FileInputStream::Stats& other) const {
-  return std::tie(numReads, readBytes, readTimeNs) ==
-      std::tie(other.numReads, other.readBytes, other.readTimeNs);
+  return std::tie(
+             numReads,
+             readBytes,
+             readTimeNs,
+             numReadAheadHits,
+             numReadAheadMisses,
+             readAheadWaitTimeNs) ==
+      std::tie(
+             other.numReads,
+             other.readBytes,
+             other.readTimeNs,
+             other.numReadAheadHits,
+             other.numReadAheadMisses,
+             other.readAheadWaitTimeNs);
 }
 
 std::string FileInputStream::Stats::toString() const {
   return fmt::format(
-      "numReads: {}, readBytes: {}, readTimeNs: {}",
+      "numReads: {}, readBytes: {}, readTimeNs: {}, numReadAheadHits: {}, "
+      "numReadAheadMisses: {}, readAheadWaitTimeNs: {}",
       numReads,
       succinctBytes(readBytes),
-      succinctMicros(readTimeNs));
+      succinctMicros(readTimeNs),
+      numReadAheadHits,
+      numReadAheadMisses,
+      succinctNanos(readAheadWaitTimeNs));
 }
 } // namespace facebook::velox::common
@@ -18,6 +18,8 @@
 
 #include <cstdint>
 
+#include <folly/Executor.h>
+
 #include "velox/buffer/Buffer.h"
 #include "velox/common/file/File.h"
 #include "velox/common/memory/ByteStream.h"
@@ -27,10 +29,13 @@ namespace facebook::velox::common {
 /// Readonly byte input stream backed by file.
 class FileInputStream : public ByteInputStream {
  public:
+  /// If 'readAheadExecutor' is set and 'file' does not support async read,
+  /// the next buffer is read ahead on 'readAheadExecutor'.
   FileInputStream(
       std::unique_ptr<ReadFile>&& file,
       uint64_t bufferSize,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      folly::Executor* readAheadExecutor = nullptr);
 
   ~FileInputStream() override;
 
@@ -64,6 +69,11 @@ class FileInputStream : public ByteInputStream {
     uint32_t numReads{0};
     uint64_t readBytes{0};
     uint64_t readTimeNs{0};
+    // Number of reads served by a completed read-ahead.
+    uint32_t numReadAheadHits{0};
+    // Number of reads which waited for a read-ahead in progress.
+    uint32_t numReadAheadMisses{0};
+    uint64_t readAheadWaitTimeNs{0};
 
     bool operator==(const Stats& other) const;
 
@@ -77,12 +87,14 @@ class FileInputStream : public ByteInputStream {
   // Invoked to read the next byte range from the file in a buffer.
   void readNextRange();
 
-  // Issues readahead if underlying file system supports async mode read.
-  //
-  // TODO: we might consider to use AsyncSource to support read-ahead on
-  // filesystem which doesn't support async mode read.
+  // Issues readahead if underlying file system supports async mode read or
+  // 'readAheadExecutor_' is set.
   void maybeIssueReadahead();
 
+  // Reads 'size' bytes at 'fileOffset_' into the next buffer on
+  // 'readAheadExecutor_'.
+  folly::SemiFuture<uint64_t> readAheadOnExecutor(uint64_t size);
+
   inline uint64_t readSize() const;
 
   inline uint32_t bufferIndex() const {
@@ -112,6 +124,7 @@ class FileInputStream : public ByteInputStream {
   const uint64_t fileSize_;
   const uint64_t bufferSize_;
   memory::MemoryPool* const pool_;
+  folly::Executor* const readAheadExecutor_;
   const bool readAheadEnabled_;
 
   // Offset of the next byte to read from file.
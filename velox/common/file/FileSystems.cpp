@@ -19,6 +19,7 @@
 #include <folly/synchronization/CallOnce.h>
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/file/File.h"
+#include "velox/common/file/IoUringReader.h"
 
 #include <cstdio>
 #include <filesystem>
@@ -93,7 +94,8 @@ class LocalFileSystem : public FileSystem {
                               std::thread::hardware_concurrency() / 2)),
                       std::make_shared<folly::NamedThreadFactory>(
                           "LocalReadahead"))
-                : nullptr) {}
+                : nullptr),
+        ioUring_(options.ioUringEnabled ? IoUringReader::create() : nullptr) {}
 
   ~LocalFileSystem() override {
     if (executor_) {
@@ -117,7 +119,7 @@ class LocalFileSystem : public FileSystem {
       std::string_view path,
       const FileOptions& options) override {
     return std::make_unique<LocalReadFile>(
-        extractPath(path), executor_.get(), options.bufferIo);
+        extractPath(path), executor_.get(), options.bufferIo, ioUring_.get());
   }
 
   std::unique_ptr<WriteFile> openFileForWrite(
@@ -251,6 +253,7 @@ class LocalFileSystem : public FileSystem {
 
  private:
   const std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
+  const std::unique_ptr<IoUringReader> ioUring_;
 };
 } // namespace
 
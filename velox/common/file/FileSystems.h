@@ -104,6 +104,12 @@ struct FileSystemOptions {
   /// async read by using a background cpu executor. Some filesystem might has
   /// native async read-ahead support.
   bool readAheadEnabled{false};
+
+  /// As for now, only local file system respects this option. It implements
+  /// async read by submitting the reads to io_uring and takes precedence over
+  /// 'readAheadEnabled'. Falls back to 'readAheadEnabled' if io_uring is not
+  /// available.
+  bool ioUringEnabled{false};
 };
 
 /// Free form statistics for a file system. The keys are arbitrary strings, and
@@ -0,0 +1,429 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/IoUringReader.h"
+
+#include <folly/String.h>
+#include <folly/Synchronized.h>
+#include <folly/portability/SysUio.h>
+#include <folly/system/ThreadName.h>
+#include <glog/logging.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/time/Timer.h"
+
+#ifdef VELOX_ENABLE_IO_URING
+#include <liburing.h>
+#else
+// Placeholder so that the std::unique_ptr member is destructible.
+struct io_uring {};
+#endif
+
+namespace facebook::velox {
+
+struct IoUringReader::Request {
+  folly::Promise<uint64_t> promise;
+  // Total size of the requested ranges.
+  uint64_t size{0};
+  // Number of reads not completed.
+  std::atomic<int32_t> numPending{0};
+  // Set by the first failed read. Reads fail on the reaper thread and on the
+  // threads calling preadv().
+  folly::Synchronized<folly::exception_wrapper> error;
+
+  filesystems::File::IoStats* stats{nullptr};
+  uint64_t startNanos{0};
+  // Number of READV operations including resubmits.
+  std::atomic<uint64_t> numReads{0};
+  // Bytes read, including the gaps read through.
+  std::atomic<uint64_t> bytesRead{0};
+
+  // Sets 'error' unless a read has failed before.
+  void setError(const folly::exception_wrapper& readError) {
+    auto lockedError = error.wlock();
+    if (!*lockedError) {
+      *lockedError = readError;
+    }
+  }
+
+  // Fulfills 'promise' after the last read has finished.
+  void fulfill() {
+    auto readError = std::move(*error.wlock());
+    if (readError) {
+      promise.setException(std::move(readError));
+    } else {
+      promise.setValue(size);
+    }
+  }
+};
+
+struct IoUringReader::Read {
+  std::shared_ptr<Request> request;
+  int32_t fd;
+  uint64_t offset;
+  std::vector<iovec> iovecs;
+  // First iovec not completely read. Non-0 after a short read.
+  size_t firstIovec{0};
+  // Bytes not yet read.
+  uint64_t remaining{0};
+
+  void add(char* data, uint64_t size) {
+    iovecs.push_back({data, size});
+    remaining += size;
+  }
+
+  // Advances past 'bytes' that were read.
+  void advance(uint64_t bytes) {
+    offset += bytes;
+    remaining -= bytes;
+    while (bytes > 0) {
+      auto& iov = iovecs[firstIovec];
+      if (bytes < iov.iov_len) {
+        iov.iov_base = static_cast<char*>(iov.iov_base) + bytes;
+        iov.iov_len -= bytes;
+        return;
+      }
+      bytes -= iov.iov_len;
+      ++firstIovec;
+    }
+  }
+};
+
+IoUringReader::Stats IoUringReader::stats() const {
+  Stats stats;
+  stats.numReads = numReads_;
+  stats.numSubmits = numSubmits_;
+  stats.numResubmits = numResubmits_;
+  return stats;
+}
+
+#ifdef VELOX_ENABLE_IO_URING
+
+namespace {
+folly::exception_wrapper
+readError(const std::string& reason, uint64_t size, uint64_t offset) {
+  try {
+    VELOX_FAIL(
+        "io_uring read of {} bytes at {} failed: {}", size, offset, reason);
+  } catch (const std::exception&) {
+    return folly::exception_wrapper(std::current_exception());
+  }
+}
+
+folly::exception_wrapper ringError(const std::string& reason) {
+  try {
+    VELOX_FAIL("io_uring failed: {}", reason);
+  } catch (const std::exception&) {
+    return folly::exception_wrapper(std::current_exception());
+  }
+}
+} // namespace
+
+// static
+std::unique_ptr<IoUringReader> IoUringReader::create(const Options& options) {
+  VELOX_CHECK_GT(options.queueDepth, 0);
+  auto ring = std::make_unique<io_uring>();
+  const int rc = io_uring_queue_init(options.queueDepth, ring.get(), 0);
+  if (rc < 0) {
+    LOG(WARNING) << "io_uring is not available: " << folly::errnoStr(-rc);
+    return nullptr;
+  }
+  return std::unique_ptr<IoUringReader>(
+      new IoUringReader(options, std::move(ring)));
+}
+
+IoUringReader::IoUringReader(
+    const Options& options,
+    std::unique_ptr<io_uring> ring)
+    : options_(options),
+      ring_(std::move(ring)),
+      gapBuffer_(options_.maxCoalesceGap) {
+  reaper_ = std::thread([this]() {
+    folly::setThreadName("IoUringReaper");
+    reap();
+  });
+}
+
+IoUringReader::~IoUringReader() {
+  {
+    std::unique_lock<std::mutex> l(mutex_);
+    readDone_.wait(l, [&]() { return inFlight_.empty(); });
+    // The reaper has exited if the ring failed.
+    if (!ringError_) {
+      // A NOP without user data tells the reaper to exit.
+      auto* sqe = io_uring_get_sqe(ring_.get());
+      if (sqe == nullptr) {
+        submitLocked();
+        sqe = io_uring_get_sqe(ring_.get());
+      }
+      VELOX_CHECK_NOT_NULL(sqe);
+      io_uring_prep_nop(sqe);
+      io_uring_sqe_set_data(sqe, nullptr);
+      ++numUnsubmitted_;
+      submitLocked();
+    }
+  }
+  reaper_.join();
+  io_uring_queue_exit(ring_.get());
+}
+
+folly::SemiFuture<uint64_t> IoUringReader::preadv(
+    int32_t fd,
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    filesystems::File::IoStats* stats) {
+  auto request = std::make_shared<Request>();
+  request->stats = stats;
+  request->startNanos = getCurrentTimeNano();
+  std::vector<std::unique_ptr<Read>> reads;
+  // Number of trailing gap bytes in the last read. These are dropped if the
+  // read is not continued by a non-gap range.
+  uint64_t trailingGap = 0;
+  uint64_t position = offset;
+  auto finishRead = [&]() {
+    if (reads.empty() || trailingGap == 0) {
+      return;
+    }
+    auto& read = *reads.back();
+    while (trailingGap > 0) {
+      trailingGap -= read.iovecs.back().iov_len;
+      read.remaining -= read.iovecs.back().iov_len;
+      read.iovecs.pop_back();
+    }
+  };
+  bool newRead = true;
+  for (const auto& range : buffers) {
+    const uint64_t size = range.size();
+    position += size;
+    request->size += size;
+    if (size == 0) {
+      continue;
+    }
+    if (range.data() == nullptr) {
+      if (newRead || size > options_.maxCoalesceGap) {
+        finishRead();
+        newRead = true;
+        continue;
+      }
+      reads.back()->add(gapBuffer_.data(), size);
+      trailingGap += size;
+      continue;
+    }
+    if (newRead || reads.back()->iovecs.size() >= IOV_MAX) {
+      finishRead();
+      reads.push_back(std::make_unique<Read>());
+      reads.back()->request = request;
+      reads.back()->fd = fd;
+      reads.back()->offset = position - size;
+      newRead = false;
+    }
+    reads.back()->add(range.data(), size);
+    trailingGap = 0;
+  }
+  finishRead();
+
+  if (reads.empty()) {
+    return folly::makeSemiFuture<uint64_t>(request->size);
+  }
+  auto future = request->promise.getSemiFuture();
+  request->numPending = reads.size();
+  std::unique_lock<std::mutex> l(mutex_);
+  for (size_t i = 0; i < reads.size(); ++i) {
+    if (inFlight_.size() >= options_.queueDepth) {
+      submitLocked();
+      readDone_.wait(l, [&]() {
+        return inFlight_.size() < options_.queueDepth || ringError_;
+      });
+    }
+    if (ringError_) {
+      // The reads prepared before the ring failed are finished by failAll()
+      // or by their completion. The remaining reads are dropped. Whoever
+      // finishes the last read fulfills the promise.
+      if ((request->numPending -= reads.size() - i) == 0) {
+        request->setError(ringError_);
+        request->fulfill();
+      }
+      return future;
+    }
+    inFlight_.insert(reads[i].get());
+    prepareLocked(reads[i].release());
+  }
+  submitLocked();
+  return future;
+}
+
+void IoUringReader::prepareLocked(Read* read) {
+  auto* sqe = io_uring_get_sqe(ring_.get());
+  if (sqe == nullptr) {
+    submitLocked();
+    sqe = io_uring_get_sqe(ring_.get());
+    VELOX_CHECK_NOT_NULL(sqe, "No io_uring submission queue entry");
+  }
+  io_uring_prep_readv(
+      sqe,
+      read->fd,
+      read->iovecs.data() + read->firstIovec,
+      read->iovecs.size() - read->firstIovec,
+      read->offset);
+  io_uring_sqe_set_data(sqe, read);
+  ++numUnsubmitted_;
+}
+
+void IoUringReader::submitLocked() {
+  if (numUnsubmitted_ == 0) {
+    return;
+  }
+  int rc;
+  do {
+    rc = io_uring_submit(ring_.get());
+  } while (rc == -EINTR || rc == -EAGAIN);
+  VELOX_CHECK_GE(rc, 0, "io_uring_submit failed: {}", folly::errnoStr(-rc));
+  numUnsubmitted_ = 0;
+  ++numSubmits_;
+}
+
+void IoUringReader::reap() {
+  for (;;) {
+    io_uring_cqe* cqe;
+    const int rc = io_uring_wait_cqe(ring_.get(), &cqe);
+    if (rc == -EINTR) {
+      continue;
+    }
+    if (rc != 0) {
+      LOG(ERROR) << "io_uring_wait_cqe failed: " << folly::errnoStr(-rc);
+      failAll(ringError(
+          fmt::format("io_uring_wait_cqe failed: {}", folly::errnoStr(-rc))));
+      return;
+    }
+    auto* read = static_cast<Read*>(io_uring_cqe_get_data(cqe));
+    const int32_t res = cqe->res;
+    io_uring_cqe_seen(ring_.get(), cqe);
+    if (read == nullptr) {
+      return;
+    }
+    if (!complete(read, res)) {
+      return;
+    }
+  }
+}
+
+bool IoUringReader::complete(Read* read, int32_t res) {
+  auto& request = *read->request;
+  ++request.numReads;
+  if (res == -EAGAIN || res == -EINTR) {
+    res = 0;
+  } else if (res <= 0) {
+    request.setError(readError(
+        res == 0 ? "end of file" : folly::errnoStr(-res),
+        read->remaining,
+        read->offset));
+    read->remaining = 0;
+  }
+  if (res > 0) {
+    request.bytesRead += res;
+    read->advance(res);
+  }
+  if (read->remaining > 0) {
+    // Continue a short read. The read stays in 'inFlight_'.
+    ++numResubmits_;
+    try {
+      std::lock_guard<std::mutex> l(mutex_);
+      prepareLocked(read);
+      submitLocked();
+    } catch (const std::exception&) {
+      LOG(ERROR) << "Failed to resubmit io_uring read: "
+                 << folly::exceptionStr(std::current_exception());
+      failAll(folly::exception_wrapper(std::current_exception()));
+      return false;
+    }
+    return true;
+  }
+  ++numReads_;
+  finish(read);
+  return true;
+}
+
+void IoUringReader::finish(Read* read) {
+  auto request = std::move(read->request);
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    inFlight_.erase(read);
+  }
+  delete read;
+  readDone_.notify_all();
+  if (--request->numPending > 0) {
+    return;
+  }
+  if (request->stats != nullptr) {
+    request->stats->addCounter(
+        "ioUringReads", RuntimeCounter(request->numReads));
+    request->stats->addCounter(
+        "ioUringReadBytes",
+        RuntimeCounter(request->bytesRead, RuntimeCounter::Unit::kBytes));
+    request->stats->addCounter(
+        "ioUringReadWallNanos",
+        RuntimeCounter(
+            getCurrentTimeNano() - request->startNanos,
+            RuntimeCounter::Unit::kNanos));
+  }
+  request->fulfill();
+}
+
+void IoUringReader::failAll(folly::exception_wrapper error) {
+  std::unordered_set<Read*> reads;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    ringError_ = error;
+    reads.swap(inFlight_);
+    // Reads prepared and not submitted are never submitted.
+    numUnsubmitted_ = 0;
+  }
+  for (auto* read : reads) {
+    read->request->setError(error);
+    finish(read);
+  }
+  readDone_.notify_all();
+}
+
+#else
+
+// static
+std::unique_ptr<IoUringReader> IoUringReader::create(
+    const Options& /*options*/) {
+  LOG(WARNING) << "io_uring is not available: Velox is built without "
+               << "VELOX_ENABLE_IO_URING";
+  return nullptr;
+}
+
+IoUringReader::IoUringReader(
+    const Options& options,
+    std::unique_ptr<io_uring> ring)
+    : options_(options), ring_(std::move(ring)) {}
+
+IoUringReader::~IoUringReader() = default;
+
+folly::SemiFuture<uint64_t> IoUringReader::preadv(
+    int32_t /*fd*/,
+    uint64_t /*offset*/,
+    const std::vector<folly::Range<char*>>& /*buffers*/,
+    filesystems::File::IoStats* /*stats*/) {
+  VELOX_UNREACHABLE();
+}
+
+#endif // VELOX_ENABLE_IO_URING
+
+} // namespace facebook::velox
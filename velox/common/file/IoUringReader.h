@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <folly/Range.h>
+#include <folly/futures/Future.h>
+
+struct io_uring;
+
+namespace facebook::velox {
+namespace filesystems::File {
+class IoStats;
+}
+
+/// Reads local files asynchronously through io_uring. A preadv() request is
+/// split into coalesced READV operations which are placed on the submission
+/// queue and handed to the kernel with a single submit. A reaper thread waits
+/// for completions and fulfills the futures, so that no thread is blocked per
+/// outstanding read as with executor based offloading.
+///
+/// io_uring is only used when Velox is built with VELOX_ENABLE_IO_URING and
+/// the kernel supports it. Otherwise create() returns nullptr and callers are
+/// expected to fall back to synchronous or executor based reads.
+///
+/// Errors on the reaper thread fail the futures of the affected requests. If
+/// the ring itself fails, all reads in flight and all later reads fail.
+class IoUringReader {
+ public:
+  struct Options {
+    /// Number of submission queue entries. This is also the max number of
+    /// reads in flight. Callers block when this is exceeded.
+    uint32_t queueDepth{256};
+
+    /// Gaps between ranges up to this size are read into a scratch buffer so
+    /// that the surrounding ranges go into one READV. A larger gap starts a
+    /// new read.
+    uint64_t maxCoalesceGap{64 << 10};
+  };
+
+  struct Stats {
+    /// Number of completed READV operations.
+    uint64_t numReads{0};
+    /// Number of io_uring_submit() calls.
+    uint64_t numSubmits{0};
+    /// Number of READV operations resubmitted after a short read.
+    uint64_t numResubmits{0};
+  };
+
+  /// Returns a reader or nullptr if io_uring is not available.
+  static std::unique_ptr<IoUringReader> create(const Options& options);
+
+  static std::unique_ptr<IoUringReader> create() {
+    return create(Options{});
+  }
+
+  /// Waits for the reads in flight to complete.
+  ~IoUringReader();
+
+  /// Reads the bytes starting at 'offset' of 'fd' into 'buffers'. A range
+  /// with a null data pointer is skipped. The result is the total size of
+  /// 'buffers', including the skipped ranges. 'buffers' must stay valid until
+  /// the returned future is fulfilled. If 'stats' is set, the number of READV
+  /// operations, the bytes read and the wall time of the request are added to
+  /// it before the future is fulfilled. 'stats' must stay valid until then.
+  folly::SemiFuture<uint64_t> preadv(
+      int32_t fd,
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      filesystems::File::IoStats* stats = nullptr);
+
+  Stats stats() const;
+
+ private:
+  struct Request;
+  struct Read;
+
+  IoUringReader(const Options& options, std::unique_ptr<io_uring> ring);
+
+  // Adds 'read' to the submission queue. Submits the queued reads first if
+  // the queue is full.
+  void prepareLocked(Read* read);
+
+  // Submits the queued reads to the kernel.
+  void submitLocked();
+
+  // Loop of 'reaper_'. Returns when the shutdown marker is reaped or the ring
+  // fails.
+  void reap();
+
+  // Handles the completion of 'read' with the result 'res' of the READV.
+  // Returns false if resubmitting a short read failed the ring.
+  bool complete(Read* read, int32_t res);
+
+  // Removes 'read' from 'inFlight_', deletes it and fulfills its request if
+  // this was the last read of the request.
+  void finish(Read* read);
+
+  // Fails the requests of all reads in flight with 'error' and makes later
+  // preadv() calls fail. Called on the reaper thread when the ring cannot be
+  // used anymore.
+  void failAll(folly::exception_wrapper error);
+
+  const Options options_;
+  const std::unique_ptr<io_uring> ring_;
+
+  // Target of the iovecs for the gaps between coalesced ranges. The data is
+  // never used, so concurrent reads may overwrite each other.
+  std::vector<char> gapBuffer_;
+
+  std::mutex mutex_;
+  // Signaled when a read completes.
+  std::condition_variable readDone_;
+  // Reads prepared or submitted and not completed.
+  std::unordered_set<Read*> inFlight_;
+  // Number of reads prepared and not submitted.
+  uint32_t numUnsubmitted_{0};
+  // Set when the ring fails. Later reads fail with this error.
+  folly::exception_wrapper ringError_;
+
+  std::atomic<uint64_t> numReads_{0};
+  std::atomic<uint64_t> numSubmits_{0};
+  std::atomic<uint64_t> numResubmits_{0};
+
+  std::thread reaper_;
+};
+
+} // namespace facebook::velox
@@ -21,6 +21,7 @@
 #include "velox/common/memory/MmapAllocator.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 
 using namespace facebook::velox;
@@ -50,7 +51,8 @@ class FileInputStreamTest : public testing::Test {
 
   std::unique_ptr<common::FileInputStream> createStream(
       uint64_t streamSize,
-      uint32_t bufferSize = 1024) {
+      uint32_t bufferSize = 1024,
+      folly::Executor* readAheadExecutor = nullptr) {
     const auto filePath =
         fmt::format("{}/{}", tempDirPath_->getPath(), fileId_++);
     auto writeFile = fs_->openFileForWrite(filePath);
@@ -62,7 +64,10 @@ class FileInputStreamTest : public testing::Test {
         std::string_view(reinterpret_cast<char*>(buffer.data()), streamSize));
     writeFile->close();
     return std::make_unique<common::FileInputStream>(
-        fs_->openFileForRead(filePath), bufferSize, pool_.get());
+        fs_->openFileForRead(filePath),
+        bufferSize,
+        pool_.get(),
+        readAheadExecutor);
   }
 
   folly::Random::DefaultGenerator rng_;
@@ -111,3 +116,35 @@ TEST_F(FileInputStreamTest, stats) {
     ASSERT_GT(byteStream->stats().readTimeNs, 0);
   }
 }
+
+TEST_F(FileInputStreamTest, readAheadOnExecutor) {
+  folly::CPUThreadPoolExecutor executor(2);
+  const size_t streamSize = 4096;
+  const size_t bufferSize = 512;
+  auto byteStream = createStream(streamSize, bufferSize, &executor);
+  // The second buffer is allocated for read-ahead.
+  ASSERT_GE(pool_->usedBytes(), 2 * bufferSize);
+  std::vector<uint8_t> buffer(100);
+  for (int offset = 0; offset < streamSize;) {
+    const auto size = std::min<int>(buffer.size(), streamSize - offset);
+    byteStream->readBytes(buffer.data(), size);
+    for (int i = 0; i < size; ++i, ++offset) {
+      ASSERT_EQ(buffer[i], offset % 256);
+    }
+  }
+  ASSERT_TRUE(byteStream->atEnd());
+  const auto stats = byteStream->stats();
+  ASSERT_EQ(stats.numReads, streamSize / bufferSize);
+  ASSERT_EQ(stats.readBytes, streamSize);
+  // All the reads but the first one are read ahead.
+  ASSERT_EQ(
+      stats.numReadAheadHits + stats.numReadAheadMisses,
+      streamSize / bufferSize - 1);
+
+  // No read-ahead if the whole file fits in one buffer.
+  byteStream = createStream(streamSize, streamSize, &executor);
+  byteStream->skip(streamSize);
+  ASSERT_TRUE(byteStream->atEnd());
+  ASSERT_EQ(byteStream->stats().numReadAheadHits, 0);
+  ASSERT_EQ(byteStream->stats().numReadAheadMisses, 0);
+}
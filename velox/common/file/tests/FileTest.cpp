@@ -20,10 +20,12 @@
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/file/IoUringReader.h"
 #include "velox/common/file/tests/FaultyFileSystem.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/exec/tests/utils/TempFilePath.h"
 
+#include <gmock/gmock.h>
 #include "gtest/gtest.h"
 
 using namespace facebook::velox;
@@ -227,6 +229,14 @@ TEST_P(LocalFileTest, writeAndRead) {
       readData(readFile.get(), true, true);
       auto readFileWithoutExecutor = std::make_shared<LocalReadFile>(filename);
       readData(readFileWithoutExecutor.get(), true, true);
+      // io_uring is not available in all builds and kernels.
+      if (auto ioUring = IoUringReader::create()) {
+        auto readFileWithIoUring = std::make_shared<LocalReadFile>(
+            filename, nullptr, true, ioUring.get());
+        ASSERT_TRUE(readFileWithIoUring->hasPreadvAsync());
+        readData(readFileWithIoUring.get(), true, true);
+        ASSERT_GT(ioUring->stats().numReads, 0);
+      }
     }
     auto readFile = fs->openFileForRead(filename);
     readData(readFile.get());
@@ -471,6 +481,78 @@ TEST_P(LocalFileTest, attributes) {
   writeFile->close();
 }
 
+TEST(IoUringReaderTest, coalesce) {
+  auto ioUring = IoUringReader::create();
+  if (ioUring == nullptr) {
+    GTEST_SKIP() << "io_uring is not available";
+  }
+  auto tempFile = exec::test::TempFilePath::create();
+  const auto& filename = tempFile->getPath();
+  std::string data(kOneMB, 0);
+  for (auto i = 0; i < data.size(); ++i) {
+    data[i] = 'a' + i % 26;
+  }
+  {
+    LocalWriteFile writeFile(filename, false, false);
+    writeFile.append(data);
+    writeFile.close();
+  }
+
+  LocalReadFile readFile(filename, nullptr, true, ioUring.get());
+  // The small gap is read through, the large gap splits the reads.
+  std::string first(100, 0);
+  std::string second(200, 0);
+  std::string third(300, 0);
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(first.data(), first.size()),
+      folly::Range<char*>(nullptr, (char*)(uint64_t)1000),
+      folly::Range<char*>(second.data(), second.size()),
+      folly::Range<char*>(nullptr, (char*)(uint64_t)500000),
+      folly::Range<char*>(third.data(), third.size())};
+  const uint64_t offset = 10;
+  filesystems::File::IoStats ioStats;
+  ASSERT_EQ(
+      100 + 1000 + 200 + 500000 + 300,
+      readFile.preadvAsync(offset, buffers, &ioStats).wait().value());
+  EXPECT_EQ(first, data.substr(offset, 100));
+  EXPECT_EQ(second, data.substr(offset + 1100, 200));
+  EXPECT_EQ(third, data.substr(offset + 501300, 300));
+  const auto stats = ioUring->stats();
+  EXPECT_EQ(stats.numReads, 2);
+  EXPECT_EQ(stats.numSubmits, 1);
+
+  const auto ioStatsMap = ioStats.stats();
+  EXPECT_EQ(ioStatsMap.at("ioUringReads").sum, 2);
+  // The small gap is read, the large one is not.
+  EXPECT_EQ(ioStatsMap.at("ioUringReadBytes").sum, 100 + 1000 + 200 + 300);
+  EXPECT_EQ(ioStatsMap.count("ioUringReadWallNanos"), 1);
+}
+
+TEST(IoUringReaderTest, readError) {
+  auto ioUring = IoUringReader::create();
+  if (ioUring == nullptr) {
+    GTEST_SKIP() << "io_uring is not available";
+  }
+  auto tempFile = exec::test::TempFilePath::create();
+  const auto& filename = tempFile->getPath();
+  {
+    LocalWriteFile writeFile(filename, false, false);
+    writeFile.append(std::string(100, 'a'));
+    writeFile.close();
+  }
+
+  // Reading past the end of the file fails the future, not the process.
+  LocalReadFile readFile(filename, nullptr, true, ioUring.get());
+  std::string buffer(200, 0);
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(buffer.data(), buffer.size())};
+  auto result = readFile.preadvAsync(0, buffers).wait().result();
+  ASSERT_TRUE(result.hasException());
+  EXPECT_THAT(
+      result.exception().what().toStdString(),
+      testing::HasSubstr("end of file"));
+}
+
 INSTANTIATE_TEST_SUITE_P(
     LocalFileTestSuite,
     LocalFileTest,
@@ -584,6 +584,12 @@ class IOBufOutputStream : public OutputStream {
   std::unique_ptr<folly::IOBuf> getIOBuf(
       const std::function<void()>& releaseFn = nullptr);
 
+  /// Returns the bytes allocated for the stream. The IOBufs returned by
+  /// getIOBuf() keep all of these allocated, not only the bytes written.
+  size_t retainedSize() const {
+    return arena_->size();
+  }
+
  private:
   std::shared_ptr<StreamArena> arena_;
   std::unique_ptr<ByteOutputStream> out_;
@@ -52,6 +52,7 @@ std::shared_ptr<MemoryAllocator> createAllocator(
     mmapOptions.largestSizeClass = options.largestSizeClassPages;
     mmapOptions.useMmapArena = options.useMmapArena;
     mmapOptions.mmapArenaCapacityRatio = options.mmapArenaCapacityRatio;
+    mmapOptions.numaAware = options.numaAware;
     return std::make_shared<MmapAllocator>(mmapOptions);
   } else {
     return std::make_shared<MallocAllocator>(
@@ -82,6 +83,7 @@ std::shared_ptr<MemoryAllocator> createAllocator(
     mmapOptions.largestSizeClass = options.largestSizeClassPages;
     mmapOptions.useMmapArena = options.useMmapArena;
     mmapOptions.mmapArenaCapacityRatio = options.mmapArenaCapacityRatio;
+    mmapOptions.numaAware = options.numaAware;
     return std::make_shared<MmapAllocator>(mmapOptions);
   } else {
     return std::make_shared<MallocAllocator>(
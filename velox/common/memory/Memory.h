@@ -108,6 +108,12 @@ struct MemoryManagerOptions {
   /// NOTE: this only applies for MmapAllocator.
   int32_t mmapArenaCapacityRatio{10};
 
+  /// If true, MmapAllocator keeps separate size classes for each NUMA node and
+  /// serves allocations from the node preferred by the allocating thread.
+  ///
+  /// NOTE: this only applies for MmapAllocator.
+  bool numaAware{false};
+
   /// If not zero, reserve 'smallAllocationReservePct'% of space from
   /// 'allocatorCapacity' for ad hoc small allocations. And those allocations
   /// are delegated to std::malloc. If 'maxMallocBytes' is 0, this value will be
@@ -225,6 +231,13 @@ class MemoryManager {
     /// NOTE: this only applies for MmapAllocator.
     int32_t mmapArenaCapacityRatio{10};
 
+    /// If true, MmapAllocator keeps separate size classes for each NUMA node
+    /// and serves allocations from the node preferred by the allocating
+    /// thread.
+    ///
+    /// NOTE: this only applies for MmapAllocator.
+    bool numaAware{false};
+
     /// If not zero, reserve 'smallAllocationReservePct'% of space from
     /// 'allocatorCapacity' for ad hoc small allocations. And those allocations
     /// are delegated to std::malloc. If 'maxMallocBytes' is 0, this value will
@@ -22,6 +22,7 @@
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/memory/Memory.h"
+#include "velox/common/process/Numa.h"
 
 namespace facebook::velox::memory {
 MmapAllocator::MmapAllocator(const Options& options)
@@ -35,9 +36,13 @@ MmapAllocator::MmapAllocator(const Options& options)
               : options.capacity * options.smallAllocationReservePct / 100),
       capacity_(bits::roundUp(
           AllocationTraits::numPages(options.capacity - mallocReservedBytes_),
-          64 * sizeClassSizes_.back())) {
-  for (const auto& size : sizeClassSizes_) {
-    sizeClasses_.push_back(std::make_unique<SizeClass>(capacity_ / size, size));
+          64 * sizeClassSizes_.back())),
+      numNumaNodes_(options.numaAware ? process::numaNodeCount() : 1) {
+  for (auto node = 0; node < numNumaNodes_; ++node) {
+    for (const auto& size : sizeClassSizes_) {
+      sizeClasses_.push_back(std::make_unique<SizeClass>(
+          capacity_ / size, size, numNumaNodes_ > 1 ? node : -1));
+    }
   }
 
   if (useMmapArena_) {
@@ -92,14 +97,15 @@ bool MmapAllocator::allocateNonContiguousWithoutRetry(
   ++numAllocations_;
   numAllocatedPages_ += sizeMix.totalPages;
   MachinePageCount newMapsNeeded = 0;
+  const auto node = numaNode();
   for (int i = 0; i < sizeMix.numSizes; ++i) {
     bool success;
     stats_.recordAllocate(
         AllocationTraits::pageBytes(sizeClassSizes_[sizeMix.sizeIndices[i]]),
         sizeMix.sizeCounts[i],
         [&]() {
-          success = sizeClasses_[sizeMix.sizeIndices[i]]->allocate(
-              sizeMix.sizeCounts[i], newMapsNeeded, out);
+          success = sizeClass(node, sizeMix.sizeIndices[i])
+                        .allocate(sizeMix.sizeCounts[i], newMapsNeeded, out);
         });
     if (success && ((i > 0) || (sizeMix.numSizes == 1)) &&
         testingHasInjectedFailure(InjectedFailure::kAllocate)) {
@@ -195,8 +201,8 @@ MachinePageCount MmapAllocator::freeNonContiguousInternal(
       // Increment the free time only if the allocation contained
       // pages in the class. Note that size class indices in the
       // allocator are not necessarily the same as in the stats.
-      const auto sizeIndex =
-          Stats::sizeIndex(AllocationTraits::pageBytes(sizeClassSizes_[i]));
+      const auto sizeIndex = Stats::sizeIndex(AllocationTraits::pageBytes(
+          sizeClassSizes_[i % sizeClassSizes_.size()]));
       stats_.sizes[sizeIndex].freeClocks += clocks;
     }
     numFreed += pages;
@@ -353,6 +359,10 @@ bool MmapAllocator::allocateContiguousImpl(
     rollbackAllocation(numToMap);
     return false;
   }
+  if (numNumaNodes_ > 1) {
+    process::setNumaNodePreference(
+        data, AllocationTraits::pageBytes(maxPages), numaNode());
+  }
   allocation.set(
       data,
       AllocationTraits::pageBytes(numPages),
@@ -509,7 +519,10 @@ MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   return numAway;
 }
 
-MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
+MmapAllocator::SizeClass::SizeClass(
+    size_t capacity,
+    MachinePageCount unitSize,
+    int32_t numaNode)
     : capacity_(capacity),
       unitSize_(unitSize),
       byteSize_(AllocationTraits::pageBytes(capacity_ * unitSize_)),
@@ -538,6 +551,12 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
         unitSize_);
   }
   address_ = reinterpret_cast<uint8_t*>(ptr);
+  if (numaNode >= 0 &&
+      !process::setNumaNodePreference(address_, byteSize_, numaNode)) {
+    VELOX_MEM_LOG(WARNING) << "Failed to set NUMA node " << numaNode
+                           << " for sizeClass " << unitSize_ << ": "
+                           << folly::errnoStr(errno);
+  }
 }
 
 MmapAllocator::SizeClass::~SizeClass() {
@@ -951,6 +970,13 @@ bool MmapAllocator::checkConsistency() const {
   return numErrors == 0;
 }
 
+int32_t MmapAllocator::numaNode() const {
+  if (numNumaNodes_ == 1) {
+    return 0;
+  }
+  return process::currentNumaNode() % numNumaNodes_;
+}
+
 bool MmapAllocator::useMalloc(uint64_t bytes) {
   return (maxMallocBytes_ != 0) && (bytes <= maxMallocBytes_);
 }
@@ -965,7 +991,11 @@ std::string MmapAllocator::toString() const {
               : succinctBytes(
                     capacity() - AllocationTraits::pageBytes(numAllocated())))
       << " allocated pages " << numAllocated_ << " mapped pages " << numMapped_
-      << " external mapped pages " << numExternalMapped_ << std::endl;
+      << " external mapped pages " << numExternalMapped_;
+  if (numNumaNodes_ > 1) {
+    out << " numa nodes " << numNumaNodes_;
+  }
+  out << std::endl;
   for (auto& sizeClass : sizeClasses_) {
     out << sizeClass->toString() << std::endl;
   }
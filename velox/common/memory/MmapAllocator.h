@@ -80,6 +80,13 @@ class MmapAllocator : public MemoryAllocator {
     /// and 'smallAllocationReservePct' will be automatically set to 0
     /// disregarding any passed in value.
     int32_t maxMallocBytes = 3072;
+
+    /// If true, the size classes are replicated for each NUMA node of the
+    /// machine with their memory preferring that node. Non-contiguous
+    /// allocations are served from the size classes of the node preferred by
+    /// the allocating thread (see process::ScopedNumaNode) and contiguous
+    /// allocations prefer that node.
+    bool numaAware = false;
   };
 
   explicit MmapAllocator(const Options& options);
@@ -105,6 +112,12 @@ class MmapAllocator : public MemoryAllocator {
     return AllocationTraits::pageBytes(capacity_);
   }
 
+  /// Returns the number of NUMA nodes with their own size classes. 1 if not
+  /// NUMA aware.
+  int32_t numNumaNodes() const {
+    return numNumaNodes_;
+  }
+
   bool growContiguousWithoutRetry(
       MachinePageCount increment,
       ContiguousAllocation& allocation) override;
@@ -168,7 +181,11 @@ class MmapAllocator : public MemoryAllocator {
   // 'unitSize_' machine pages.
   class SizeClass {
    public:
-    SizeClass(size_t capacity, MachinePageCount unitSize);
+    // If 'numaNode' is not negative, the memory of 'this' prefers that node.
+    SizeClass(
+        size_t capacity,
+        MachinePageCount unitSize,
+        int32_t numaNode = -1);
 
     ~SizeClass();
 
@@ -372,6 +389,14 @@ class MmapAllocator : public MemoryAllocator {
 
   bool useMalloc(uint64_t bytes);
 
+  // Returns the NUMA node to allocate from for the calling thread.
+  int32_t numaNode() const;
+
+  // Returns the size class 'index' of 'numaNode'.
+  SizeClass& sizeClass(int32_t numaNode, int32_t index) {
+    return *sizeClasses_[numaNode * sizeClassSizes_.size() + index];
+  }
+
   const Kind kind_;
 
   // If set true, allocations larger than the largest size class size will be
@@ -408,6 +433,10 @@ class MmapAllocator : public MemoryAllocator {
   // to std::malloc().
   const MachinePageCount capacity_ = 0;
 
+  const int32_t numNumaNodes_;
+
+  // The size classes of all NUMA nodes, one 'sizeClassSizes_' worth of size
+  // classes per node in node order. Each size class can hold 'capacity_'.
   std::vector<std::unique_ptr<SizeClass>> sizeClasses_;
 
   // Statistics.
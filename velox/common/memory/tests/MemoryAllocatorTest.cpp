@@ -21,6 +21,7 @@
 #include "velox/common/memory/MmapAllocator.h"
 #include "velox/common/memory/MmapArena.h"
 #include "velox/common/memory/SharedArbitrator.h"
+#include "velox/common/process/Numa.h"
 #include "velox/common/testutil/TestValue.h"
 
 #include <fmt/format.h>
@@ -1991,4 +1992,33 @@ TEST_F(MmapConfigTest, sizeClasses) {
   }
 }
 
+TEST_F(MmapConfigTest, numaAware) {
+  MmapAllocator::Options options;
+  options.capacity = 256 << 20;
+  options.numaAware = true;
+  auto allocator = std::make_shared<MmapAllocator>(options);
+  ASSERT_EQ(allocator->numNumaNodes(), process::numaNodeCount());
+  for (auto node = 0; node < allocator->numNumaNodes(); ++node) {
+    process::ScopedNumaNode numaNode(node);
+    ASSERT_EQ(process::currentNumaNode(), node);
+    Allocation allocation;
+    ASSERT_TRUE(allocator->allocateNonContiguous(1'000, allocation));
+    for (auto i = 0; i < allocation.numRuns(); ++i) {
+      const auto run = allocation.runAt(i);
+      std::memset(run.data(), node, run.numBytes());
+    }
+    ContiguousAllocation contiguous;
+    ASSERT_TRUE(allocator->allocateContiguous(1'000, nullptr, contiguous));
+    std::memset(contiguous.data(), node, contiguous.size());
+    ASSERT_EQ(
+        allocator->numAllocated(),
+        allocation.numPages() + contiguous.numPages());
+    ASSERT_TRUE(allocator->checkConsistency());
+    allocator->freeNonContiguous(allocation);
+    allocator->freeContiguous(contiguous);
+    ASSERT_EQ(allocator->numAllocated(), 0);
+  }
+  ASSERT_LT(process::currentNumaNode(), process::numaNodeCount());
+}
+
 } // namespace facebook::velox::memory
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/Numa.h"
+
+#include <fmt/format.h>
+#include <folly/Conv.h>
+#include <folly/FileUtil.h>
+#include <folly/String.h>
+
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace facebook::velox::process {
+namespace {
+// Parses a sysfs CPU list like "0-23,48-71".
+std::vector<int32_t> parseCpuList(const std::string& text) {
+  std::vector<int32_t> cpus;
+  std::vector<folly::StringPiece> ranges;
+  folly::split(',', folly::trimWhitespace(text), ranges);
+  for (const auto& range : ranges) {
+    if (range.empty()) {
+      continue;
+    }
+    const auto dash = range.find('-');
+    if (dash == folly::StringPiece::npos) {
+      cpus.push_back(folly::to<int32_t>(range));
+      continue;
+    }
+    const auto first = folly::to<int32_t>(range.subpiece(0, dash));
+    const auto last = folly::to<int32_t>(range.subpiece(dash + 1));
+    for (auto cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+struct NumaTopology {
+  NumaTopology() {
+#ifdef __linux__
+    for (int32_t node = 0;; ++node) {
+      std::string cpuList;
+      if (!folly::readFile(
+              fmt::format("/sys/devices/system/node/node{}/cpulist", node)
+                  .c_str(),
+              cpuList)) {
+        break;
+      }
+      try {
+        nodeCpus.push_back(parseCpuList(cpuList));
+      } catch (const std::exception&) {
+        nodeCpus.clear();
+        break;
+      }
+    }
+#endif
+    if (nodeCpus.empty()) {
+      std::vector<int32_t> cpus(std::thread::hardware_concurrency());
+      for (auto i = 0; i < cpus.size(); ++i) {
+        cpus[i] = i;
+      }
+      nodeCpus.push_back(std::move(cpus));
+    }
+    for (auto node = 0; node < nodeCpus.size(); ++node) {
+      for (const auto cpu : nodeCpus[node]) {
+        if (cpu >= cpuNode.size()) {
+          cpuNode.resize(cpu + 1, 0);
+        }
+        cpuNode[cpu] = node;
+      }
+    }
+  }
+
+  std::vector<std::vector<int32_t>> nodeCpus;
+  std::vector<int32_t> cpuNode;
+};
+
+const NumaTopology& topology() {
+  static const NumaTopology kTopology;
+  return kTopology;
+}
+
+// The node set by ScopedNumaNode for the calling thread, -1 if none.
+thread_local int32_t threadNumaNode{-1};
+
+#ifdef __linux__
+std::vector<int32_t> getThreadCpus() {
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) != 0) {
+    return {};
+  }
+  std::vector<int32_t> cpus;
+  for (int32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &cpuSet)) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+bool setThreadCpus(const std::vector<int32_t>& cpus) {
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  for (const auto cpu : cpus) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &cpuSet);
+    }
+  }
+  return sched_setaffinity(0, sizeof(cpuSet), &cpuSet) == 0;
+}
+#endif
+} // namespace
+
+int32_t numaNodeCount() {
+  return topology().nodeCpus.size();
+}
+
+const std::vector<int32_t>& numaNodeCpus(int32_t node) {
+  const auto& nodeCpus = topology().nodeCpus;
+  return nodeCpus[node % nodeCpus.size()];
+}
+
+int32_t numaNodeOfCpu(int32_t cpu) {
+  const auto& cpuNode = topology().cpuNode;
+  if (cpu < 0 || cpu >= cpuNode.size()) {
+    return 0;
+  }
+  return cpuNode[cpu];
+}
+
+int32_t currentNumaNode() {
+  if (threadNumaNode >= 0) {
+    return threadNumaNode;
+  }
+  if (numaNodeCount() == 1) {
+    return 0;
+  }
+#ifdef __linux__
+  return numaNodeOfCpu(sched_getcpu());
+#else
+  return 0;
+#endif
+}
+
+bool setNumaNodePreference(void* addr, size_t bytes, int32_t node) {
+#if defined(__linux__) && defined(SYS_mbind)
+  // Same as MPOL_PREFERRED in <linux/mempolicy.h>.
+  constexpr int kMpolPreferred = 1;
+  constexpr int32_t kMaskBits = 8 * sizeof(unsigned long);
+  if (numaNodeCount() == 1 || node < 0 || node >= kMaskBits) {
+    return false;
+  }
+  unsigned long nodeMask = 1UL << node;
+  // The kernel ignores the last bit of 'maxnode'.
+  return syscall(
+             SYS_mbind,
+             addr,
+             bytes,
+             kMpolPreferred,
+             &nodeMask,
+             kMaskBits + 1,
+             0) == 0;
+#else
+  return false;
+#endif
+}
+
+ScopedNumaNode::ScopedNumaNode(int32_t node) : prevNode_(threadNumaNode) {
+  threadNumaNode = node;
+#ifdef __linux__
+  if (numaNodeCount() > 1) {
+    prevCpus_ = getThreadCpus();
+    if (!prevCpus_.empty() && !setThreadCpus(numaNodeCpus(node))) {
+      prevCpus_.clear();
+    }
+  }
+#endif
+}
+
+ScopedNumaNode::~ScopedNumaNode() {
+#ifdef __linux__
+  if (!prevCpus_.empty()) {
+    setThreadCpus(prevCpus_);
+  }
+#endif
+  threadNumaNode = prevNode_;
+}
+
+} // namespace facebook::velox::process
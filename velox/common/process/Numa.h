@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace facebook::velox::process {
+
+/// Returns the number of NUMA nodes of this machine. Returns 1 if the NUMA
+/// topology is not available, e.g. on non-Linux platforms.
+int32_t numaNodeCount();
+
+/// Returns the CPUs of NUMA 'node'. Returns all the CPUs of the machine if the
+/// NUMA topology is not available.
+const std::vector<int32_t>& numaNodeCpus(int32_t node);
+
+/// Returns the NUMA node of 'cpu'. Returns 0 if not known.
+int32_t numaNodeOfCpu(int32_t cpu);
+
+/// Returns the NUMA node the calling thread prefers for memory allocations.
+/// This is the node set by ScopedNumaNode if any, otherwise the node of the
+/// CPU the thread is running on.
+int32_t currentNumaNode();
+
+/// Sets the NUMA policy of the memory range [addr, addr + bytes) to prefer
+/// 'node'. Pages of the range are placed on 'node' when first touched if the
+/// node has free memory and on other nodes otherwise. 'addr' must be page
+/// aligned. Returns false if not supported.
+bool setNumaNodePreference(void* addr, size_t bytes, int32_t node);
+
+/// Pins the calling thread to the CPUs of NUMA 'node' and makes 'node' the
+/// preferred node of currentNumaNode() for the lifetime of this object. The
+/// previous CPU affinity and preferred node of the thread are restored on
+/// destruction. Instances nest.
+class ScopedNumaNode {
+ public:
+  explicit ScopedNumaNode(int32_t node);
+
+  ~ScopedNumaNode();
+
+  ScopedNumaNode(const ScopedNumaNode&) = delete;
+  ScopedNumaNode& operator=(const ScopedNumaNode&) = delete;
+
+ private:
+  const int32_t prevNode_;
+  // CPU affinity of the thread before pinning. Empty if the thread was not
+  // pinned.
+  std::vector<int32_t> prevCpus_;
+};
+
+} // namespace facebook::velox::process
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/Numa.h"
+
+#include <gtest/gtest.h>
+
+#include <unordered_set>
+
+namespace facebook::velox::process {
+namespace {
+
+TEST(NumaTest, topology) {
+  const auto numNodes = numaNodeCount();
+  ASSERT_GE(numNodes, 1);
+  std::unordered_set<int32_t> allCpus;
+  for (auto node = 0; node < numNodes; ++node) {
+    for (const auto cpu : numaNodeCpus(node)) {
+      ASSERT_EQ(numaNodeOfCpu(cpu), node);
+      ASSERT_TRUE(allCpus.insert(cpu).second);
+    }
+  }
+  ASSERT_FALSE(allCpus.empty());
+  ASSERT_EQ(numaNodeOfCpu(-1), 0);
+  ASSERT_GE(currentNumaNode(), 0);
+  ASSERT_LT(currentNumaNode(), numNodes);
+}
+
+TEST(NumaTest, scopedNumaNode) {
+  const auto numNodes = numaNodeCount();
+  const auto lastNode = numNodes - 1;
+  {
+    ScopedNumaNode outer(lastNode);
+    ASSERT_EQ(currentNumaNode(), lastNode);
+    {
+      ScopedNumaNode inner(0);
+      ASSERT_EQ(currentNumaNode(), 0);
+    }
+    ASSERT_EQ(currentNumaNode(), lastNode);
+  }
+  ASSERT_GE(currentNumaNode(), 0);
+  ASSERT_LT(currentNumaNode(), numNodes);
+}
+
+} // namespace
+} // namespace facebook::velox::process
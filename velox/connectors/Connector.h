@@ -255,6 +255,24 @@ class DataSource {
       column_index_t outputChannel,
       const std::shared_ptr<common::Filter>& filter) = 0;
 
+  /// Requests SYSTEM sampling: each block of storage, e.g. a stripe or row
+  /// group, is read with probability 'sampleRate' and skipped without IO
+  /// otherwise. Must be called before the first addSplit(). Returns false if
+  /// the connector does not support block sampling, in which case the caller
+  /// is responsible for sampling.
+  virtual bool setBlockSampleRate(double /*sampleRate*/) {
+    return false;
+  }
+
+  /// Returns true if the blocks of the last added split are sampled at the
+  /// rate passed to setBlockSampleRate(). Only called after
+  /// setBlockSampleRate() returned true. Returns false if the format of the
+  /// split cannot skip blocks, in which case the caller samples the output
+  /// of the split.
+  virtual bool isBlockSampled() const {
+    return true;
+  }
+
   /// Returns the number of input bytes processed so far.
   virtual uint64_t getCompletedBytes() = 0;
 
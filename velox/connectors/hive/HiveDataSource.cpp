@@ -322,7 +322,8 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
   splitReader_ = createSplitReader();
   // Split reader subclasses may need to use the reader options in prepareSplit
   // so we initialize it beforehand.
-  splitReader_->configureReaderOptions(randomSkip_);
+  splitReader_->configureReaderOptions(
+      randomSkip_, isBlockSampled() ? blockRandomSkip_ : nullptr);
   splitReader_->prepareSplit(metadataFilter_, runtimeStats_);
   readerOutputType_ = splitReader_->readerOutputType();
 }
@@ -472,6 +473,33 @@ void HiveDataSource::addDynamicFilter(
   }
 }
 
+bool HiveDataSource::setBlockSampleRate(double sampleRate) {
+  VELOX_CHECK_NULL(split_, "Block sampling must be set before any split");
+  VELOX_CHECK(sampleRate >= 0 && sampleRate <= 1);
+  if (sampleRate < 1) {
+    blockRandomSkip_ = std::make_shared<random::RandomSkipTracker>(sampleRate);
+  } else {
+    blockRandomSkip_.reset();
+  }
+  return true;
+}
+
+bool HiveDataSource::isBlockSampled() const {
+  if (blockRandomSkip_ == nullptr || split_ == nullptr) {
+    return false;
+  }
+  // Only these readers skip whole stripes or row groups with
+  // ReaderOptions::blockRandomSkip.
+  switch (split_->fileFormat) {
+    case dwio::common::FileFormat::DWRF:
+    case dwio::common::FileFormat::ORC:
+    case dwio::common::FileFormat::PARQUET:
+      return true;
+    default:
+      return false;
+  }
+}
+
 std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
   auto res = runtimeStats_.toMap();
   res.insert(
@@ -55,6 +55,10 @@ class HiveDataSource : public DataSource {
       column_index_t outputChannel,
       const std::shared_ptr<common::Filter>& filter) override;
 
+  bool setBlockSampleRate(double sampleRate) override;
+
+  bool isBlockSampled() const override;
+
   uint64_t getCompletedBytes() override {
     return ioStats_->rawBytesRead();
   }
@@ -176,6 +180,10 @@ class HiveDataSource : public DataSource {
 
   std::shared_ptr<random::RandomSkipTracker> randomSkip_;
 
+  // Decides which stripes or row groups are read under SYSTEM sampling. Null
+  // if all are read.
+  std::shared_ptr<random::RandomSkipTracker> blockRandomSkip_;
+
   int64_t numBucketConversion_ = 0;
   std::unique_ptr<HivePartitionFunction> partitionFunction_;
   std::vector<uint32_t> partitions_;
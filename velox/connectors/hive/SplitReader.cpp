@@ -148,7 +148,8 @@ SplitReader::SplitReader(
       emptySplit_(false) {}
 
 void SplitReader::configureReaderOptions(
-    std::shared_ptr<velox::random::RandomSkipTracker> randomSkip) {
+    std::shared_ptr<velox::random::RandomSkipTracker> randomSkip,
+    std::shared_ptr<velox::random::RandomSkipTracker> blockRandomSkip) {
   hive::configureReaderOptions(
       hiveConfig_,
       connectorQueryCtx_,
@@ -156,6 +157,7 @@ void SplitReader::configureReaderOptions(
       hiveSplit_,
       baseReaderOpts_);
   baseReaderOpts_.setRandomSkip(std::move(randomSkip));
+  baseReaderOpts_.setBlockRandomSkip(std::move(blockRandomSkip));
   baseReaderOpts_.setScanSpec(scanSpec_);
   baseReaderOpts_.setFileFormat(hiveSplit_->fileFormat);
 }
@@ -70,8 +70,11 @@ class SplitReader {
 
   virtual ~SplitReader() = default;
 
+  /// 'randomSkip' samples rows and 'blockRandomSkip' samples whole stripes or
+  /// row groups. Either may be null.
   void configureReaderOptions(
-      std::shared_ptr<random::RandomSkipTracker> randomSkip);
+      std::shared_ptr<random::RandomSkipTracker> randomSkip,
+      std::shared_ptr<random::RandomSkipTracker> blockRandomSkip = nullptr);
 
   /// This function is used by different table formats like Iceberg and Hudi to
   /// do additional preparations before reading the split, e.g. Open delete
@@ -1403,11 +1403,17 @@ void HashJoinNode::addDetails(std::stringstream& stream) const {
   if (nullAware_) {
     stream << ", null aware";
   }
+  if (useHashTableCache_) {
+    stream << ", hash table cache";
+  }
 }
 
 folly::dynamic HashJoinNode::serialize() const {
   auto obj = serializeBase();
   obj["nullAware"] = nullAware_;
+  if (useHashTableCache_) {
+    obj["useHashTableCache"] = useHashTableCache_;
+  }
   return obj;
 }
 
@@ -1433,6 +1439,10 @@ PlanNodePtr HashJoinNode::create(const folly::dynamic& obj, void* context) {
 
   auto outputType = deserializeRowType(obj["outputType"]);
 
+  const bool useHashTableCache = obj.count("useHashTableCache")
+      ? obj["useHashTableCache"].asBool()
+      : false;
+
   return std::make_shared<HashJoinNode>(
       deserializePlanNodeId(obj),
       joinTypeFromName(obj["joinType"].asString()),
@@ -1442,7 +1452,8 @@ PlanNodePtr HashJoinNode::create(const folly::dynamic& obj, void* context) {
       filter,
       sources[0],
       sources[1],
-      outputType);
+      outputType,
+      useHashTableCache);
 }
 
 MergeJoinNode::MergeJoinNode(
@@ -2863,6 +2874,62 @@ PlanNodePtr LimitNode::create(const folly::dynamic& obj, void* context) {
       std::move(source));
 }
 
+namespace {
+std::unordered_map<SampleNode::Method, std::string> sampleMethodNames() {
+  return {
+      {SampleNode::Method::kBernoulli, "BERNOULLI"},
+      {SampleNode::Method::kSystem, "SYSTEM"},
+  };
+}
+} // namespace
+
+// static
+const char* SampleNode::methodName(Method method) {
+  static const auto kMethods = sampleMethodNames();
+  auto it = kMethods.find(method);
+  VELOX_CHECK(
+      it != kMethods.end(),
+      "Invalid SampleNode method {}",
+      static_cast<int>(method));
+  return it->second.c_str();
+}
+
+// static
+SampleNode::Method SampleNode::methodFromName(const std::string& name) {
+  static const auto kMethods = invertMap(sampleMethodNames());
+  auto it = kMethods.find(name);
+  VELOX_CHECK(it != kMethods.end(), "Invalid SampleNode method " + name);
+  return it->second;
+}
+
+void SampleNode::addDetails(std::stringstream& stream) const {
+  stream << methodName(method_) << " " << sampleRate_;
+}
+
+folly::dynamic SampleNode::serialize() const {
+  auto obj = PlanNode::serialize();
+  obj["method"] = methodName(method_);
+  obj["sampleRate"] = sampleRate_;
+  return obj;
+}
+
+void SampleNode::accept(
+    const PlanNodeVisitor& visitor,
+    PlanNodeVisitorContext& context) const {
+  visitor.visit(*this, context);
+}
+
+// static
+PlanNodePtr SampleNode::create(const folly::dynamic& obj, void* context) {
+  auto source = deserializeSingleSource(obj, context);
+
+  return std::make_shared<SampleNode>(
+      deserializePlanNodeId(obj),
+      methodFromName(obj["method"].asString()),
+      obj["sampleRate"].asDouble(),
+      std::move(source));
+}
+
 void OrderByNode::addDetails(std::stringstream& stream) const {
   if (isPartial_) {
     stream << "PARTIAL ";
@@ -3049,6 +3116,7 @@ void PlanNode::registerSerDe() {
   registry.Register("PartitionedOutputNode", PartitionedOutputNode::create);
   registry.Register("ProjectNode", ProjectNode::create);
   registry.Register("RowNumberNode", RowNumberNode::create);
+  registry.Register("SampleNode", SampleNode::create);
   registry.Register("TableScanNode", TableScanNode::create);
   registry.Register("TableWriteNode", TableWriteNode::create);
   registry.Register("TableWriteMergeNode", TableWriteMergeNode::create);
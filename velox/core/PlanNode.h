@@ -2949,7 +2949,8 @@ class HashJoinNode : public AbstractJoinNode {
       TypedExprPtr filter,
       PlanNodePtr left,
       PlanNodePtr right,
-      RowTypePtr outputType)
+      RowTypePtr outputType,
+      bool useHashTableCache = false)
       : AbstractJoinNode(
             id,
             joinType,
@@ -2959,7 +2960,15 @@ class HashJoinNode : public AbstractJoinNode {
             std::move(left),
             std::move(right),
             std::move(outputType)),
-        nullAware_{nullAware} {
+        nullAware_{nullAware},
+        useHashTableCache_{useHashTableCache} {
+    if (useHashTableCache) {
+      VELOX_USER_CHECK(
+          !isRightJoin() && !isFullJoin() && !isRightSemiFilterJoin() &&
+              !isRightSemiProjectJoin(),
+          "Hash table cache is not supported for joins that track probed "
+          "build side rows");
+    }
     if (nullAware) {
       VELOX_USER_CHECK(
           isNullAwareSupported(joinType),
@@ -2982,6 +2991,7 @@ class HashJoinNode : public AbstractJoinNode {
     explicit Builder(const HashJoinNode& other)
         : AbstractJoinNode::Builder<HashJoinNode, Builder>(other) {
       nullAware_ = other.isNullAware();
+      useHashTableCache_ = other.useHashTableCache();
     }
 
     Builder& nullAware(bool value) {
@@ -2989,6 +2999,11 @@ class HashJoinNode : public AbstractJoinNode {
       return *this;
     }
 
+    Builder& useHashTableCache(bool value) {
+      useHashTableCache_ = value;
+      return *this;
+    }
+
     std::shared_ptr<HashJoinNode> build() const {
       VELOX_USER_CHECK(id_.has_value(), "HashJoinNode id is not set");
       VELOX_USER_CHECK(
@@ -3015,11 +3030,13 @@ class HashJoinNode : public AbstractJoinNode {
           filter_.value_or(nullptr),
           left_.value(),
           right_.value(),
-          outputType_.value());
+          outputType_.value(),
+          useHashTableCache_);
     }
 
    private:
     std::optional<bool> nullAware_;
+    bool useHashTableCache_{false};
   };
 
   std::string_view name() const override {
@@ -3034,14 +3051,24 @@ class HashJoinNode : public AbstractJoinNode {
     // filter set. It requires to cross join the null-key probe rows with all
     // the build-side rows for filter evaluation which is not supported under
     // spilling.
+    // NOTE: a table from the hash table cache is shared by several tasks and
+    // can't be spilled.
     return !(isAntiJoin() && nullAware_ && filter() != nullptr) &&
-        queryConfig.joinSpillEnabled();
+        !useHashTableCache_ && queryConfig.joinSpillEnabled();
   }
 
   bool isNullAware() const {
     return nullAware_;
   }
 
+  /// True if the hash table is shared through the node level hash table cache
+  /// by all the tasks of the query that run this node on the same worker. This
+  /// is set for broadcast joins where all the tasks build identical tables.
+  /// One task builds the table and the other tasks probe it read-only.
+  bool useHashTableCache() const {
+    return useHashTableCache_;
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
@@ -3050,6 +3077,7 @@ class HashJoinNode : public AbstractJoinNode {
   void addDetails(std::stringstream& stream) const override;
 
   const bool nullAware_;
+  const bool useHashTableCache_;
 };
 
 /// Represents inner/outer/semi/anti merge joins. Translates to an
@@ -3902,6 +3930,129 @@ class LimitNode : public PlanNode {
   const std::vector<PlanNodePtr> sources_;
 };
 
+/// Returns a random sample of the input rows, as in SQL TABLESAMPLE. Each row
+/// is kept with probability 'sampleRate'. The output has the same schema as
+/// the input.
+class SampleNode : public PlanNode {
+ public:
+  enum class Method {
+    /// Each row is kept or dropped independently of all other rows.
+    kBernoulli,
+    /// Blocks of rows are kept or dropped as a whole. When the source is a
+    /// table scan, the blocks are storage units like stripes or row groups
+    /// and the dropped ones are not read.
+    kSystem,
+  };
+
+  static const char* methodName(Method method);
+
+  static Method methodFromName(const std::string& name);
+
+  /// @param sampleRate Fraction of rows to keep, in [0, 1].
+  SampleNode(
+      const PlanNodeId& id,
+      Method method,
+      double sampleRate,
+      const PlanNodePtr& source)
+      : PlanNode(id),
+        method_(method),
+        sampleRate_(sampleRate),
+        sources_{source} {
+    VELOX_USER_CHECK(
+        sampleRate >= 0 && sampleRate <= 1,
+        "Sample rate must be between 0 and 1: {}",
+        sampleRate);
+  }
+
+  class Builder {
+   public:
+    Builder() = default;
+
+    explicit Builder(const SampleNode& other) {
+      id_ = other.id();
+      method_ = other.method();
+      sampleRate_ = other.sampleRate();
+      VELOX_CHECK_EQ(other.sources().size(), 1);
+      source_ = other.sources()[0];
+    }
+
+    Builder& id(PlanNodeId id) {
+      id_ = std::move(id);
+      return *this;
+    }
+
+    Builder& method(Method method) {
+      method_ = method;
+      return *this;
+    }
+
+    Builder& sampleRate(double sampleRate) {
+      sampleRate_ = sampleRate;
+      return *this;
+    }
+
+    Builder& source(PlanNodePtr source) {
+      source_ = std::move(source);
+      return *this;
+    }
+
+    std::shared_ptr<SampleNode> build() const {
+      VELOX_USER_CHECK(id_.has_value(), "SampleNode id is not set");
+      VELOX_USER_CHECK(method_.has_value(), "SampleNode method is not set");
+      VELOX_USER_CHECK(
+          sampleRate_.has_value(), "SampleNode sampleRate is not set");
+      VELOX_USER_CHECK(source_.has_value(), "SampleNode source is not set");
+
+      return std::make_shared<SampleNode>(
+          id_.value(), method_.value(), sampleRate_.value(), source_.value());
+    }
+
+   private:
+    std::optional<PlanNodeId> id_;
+    std::optional<Method> method_;
+    std::optional<double> sampleRate_;
+    std::optional<PlanNodePtr> source_;
+  };
+
+  bool supportsBarrier() const override {
+    return true;
+  }
+
+  const RowTypePtr& outputType() const override {
+    return sources_[0]->outputType();
+  }
+
+  const std::vector<PlanNodePtr>& sources() const override {
+    return sources_;
+  }
+
+  void accept(const PlanNodeVisitor& visitor, PlanNodeVisitorContext& context)
+      const override;
+
+  Method method() const {
+    return method_;
+  }
+
+  double sampleRate() const {
+    return sampleRate_;
+  }
+
+  std::string_view name() const override {
+    return "Sample";
+  }
+
+  folly::dynamic serialize() const override;
+
+  static PlanNodePtr create(const folly::dynamic& obj, void* context);
+
+ private:
+  void addDetails(std::stringstream& stream) const override;
+
+  const Method method_;
+  const double sampleRate_;
+  const std::vector<PlanNodePtr> sources_;
+};
+
 /// Expands arrays and maps into separate columns. Arrays are expanded into a
 /// single column, and maps are expanded into two columns (key, value). Can be
 /// used to expand multiple columns. In this case will produce as many rows as
@@ -4969,6 +5120,9 @@ class PlanNodeVisitor {
   virtual void visit(const RowNumberNode& node, PlanNodeVisitorContext& ctx)
       const = 0;
 
+  virtual void visit(const SampleNode& node, PlanNodeVisitorContext& ctx)
+      const = 0;
+
   virtual void visit(const TableScanNode& node, PlanNodeVisitorContext& ctx)
       const = 0;
 
@@ -64,6 +64,11 @@ class QueryConfig {
   static constexpr const char* kExprTrackCpuUsage =
       "expression.track_cpu_usage";
 
+  /// Whether to evaluate trees of plus, minus, multiply and comparison calls
+  /// over INTEGER, BIGINT, REAL and DOUBLE values in a single fused loop
+  /// instead of one call at a time. False by default.
+  static constexpr const char* kExprFusionEnabled = "expression.fusion_enabled";
+
   /// Whether to track CPU usage for stages of individual operators. True by
   /// default. Can be expensive when processing small batches, e.g. < 10K rows.
   static constexpr const char* kOperatorTrackCpuUsage =
@@ -114,7 +119,9 @@ class QueryConfig {
   /// partitions splitting a single 100KB input vector results in 100 1KB
   /// vectors. Exchanging and processing tiny vectors may negatively impact
   /// performance. To avoid this, buffered partitioning is used to accumulate
-  /// larger vectors.
+  /// larger vectors. Without buffering no row data is copied. Each partition
+  /// is a dictionary slice over the input vector, which is shared by all the
+  /// partitions.
   static constexpr const char*
       kMinLocalExchangePartitionCountToUsePartitionBuffer =
           "min_local_exchange_partition_count_to_use_partition_buffer";
@@ -158,6 +165,15 @@ class QueryConfig {
   static constexpr const char* kMinExchangeOutputBatchBytes =
       "min_exchange_output_batch_bytes";
 
+  /// If true, the exchange client adapts to the consumers. A consumer is
+  /// unblocked when the bytes expected to arrive shortly at the observed
+  /// arrival rate are accumulated, up to min_exchange_output_batch_bytes. The
+  /// outstanding requests are limited to twice the bytes the consumers drain
+  /// during a request round trip, between 1/8 of and the full
+  /// exchange.max_buffer_size.
+  static constexpr const char* kExchangeAdaptiveBatching =
+      "exchange.adaptive_batching";
+
   static constexpr const char* kMaxPartialAggregationMemory =
       "max_partial_aggregation_memory";
 
@@ -170,6 +186,23 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// If greater than 0, partial aggregations keep their hash table within this
+  /// many bytes, e.g. the size of the L2 cache, instead of growing it up to
+  /// 'max_partial_aggregation_memory'. When the table is full, only the groups
+  /// that have not been hit since the previous flush are flushed, so that
+  /// frequent keys keep being aggregated locally. 0 disables.
+  static constexpr const char* kPartialAggregationCacheTableBytes =
+      "partial_aggregation_cache_table_bytes";
+
+  /// Number of partitions of the hash table of a final aggregation. If greater
+  /// than 1, the input is split on a hash of the grouping keys into this many
+  /// disjoint partitions, each with its own hash table, which are filled in
+  /// parallel on the query executor. Must be a power of 2. Does not apply to
+  /// aggregations that can spill, have pre-grouped keys or global grouping
+  /// sets.
+  static constexpr const char* kAggregationParallelInsertPartitions =
+      "aggregation_parallel_insert_partitions";
+
   static constexpr const char* kAbandonPartialTopNRowNumberMinRows =
       "abandon_partial_topn_row_number_min_rows";
 
@@ -226,7 +259,8 @@ class QueryConfig {
       "hash_adaptivity_enabled";
 
   /// If true, the conjunction expression can reorder inputs based on the time
-  /// taken to calculate them.
+  /// taken to calculate them. The drivers of a task share the statistics of
+  /// their filters.
   static constexpr const char* kAdaptiveFilterReorderingEnabled =
       "adaptive_filter_reordering_enabled";
 
@@ -297,6 +331,15 @@ class QueryConfig {
   static constexpr const char* kSpillPrefixSortEnabled =
       "spill_prefixsort_enabled";
 
+  /// If true, the window and order by operators spill the input rows of their
+  /// RowContainer in row format instead of converting them to columnar
+  /// vectors. Each spilled row is prefixed by its normalized sorting keys so
+  /// that the spill merge compares raw bytes. Only applies if all the
+  /// partition and sorting keys are fixed width types supported by prefix
+  /// sort. Order by output spilling and aggregation spilling stay columnar.
+  static constexpr const char* kSpillRowFormatEnabled =
+      "spill_row_format_enabled";
+
   /// Specifies spill write buffer size in bytes. The spiller tries to buffer
   /// serialized spill data up to the specified size before write to storage
   /// underneath for io efficiency. If it is set to zero, then spill write
@@ -309,6 +352,15 @@ class QueryConfig {
   /// buffering, which doubles the buffer used to read from each spill file.
   static constexpr const char* kSpillReadBufferSize = "spill_read_buffer_size";
 
+  /// The max bytes of the read-ahead buffers of the spill files merged by one
+  /// operator. If the spill file system does not support async read, up to
+  /// this many bytes divided by 'kSpillReadBufferSize' spill files read their
+  /// next buffer ahead on the spill executor. The buffers are allocated from
+  /// the operator memory pool. If it is zero, read-ahead is only done by file
+  /// systems which support async read.
+  static constexpr const char* kSpillReadAheadBufferSize =
+      "spill_read_ahead_buffer_size";
+
   /// Config used to create spill files. This config is provided to underlying
   /// file system and the config is free form. The form should be defined by the
   /// underlying file system.
@@ -396,6 +448,22 @@ class QueryConfig {
   static constexpr const char* kHashProbeFinishEarlyOnEmptyBuild =
       "hash_probe_finish_early_on_empty_build";
 
+  /// The max size in bytes of a bloom filter that the hash probe pushes down
+  /// to the probe side table scan for a join key that has no exact dynamic
+  /// filter, e.g. a high cardinality, string or multi-column key. 0 disables
+  /// bloom filter pushdown.
+  static constexpr const char* kHashProbeBloomFilterPushdownMaxSize =
+      "hash_probe_bloom_filter_pushdown_max_size";
+
+  /// The number of rows an inner hash join without a filter buffers from each
+  /// input before building the hash table. If the probe input ends within
+  /// this bound and has fewer rows than the buffered build input, the probe
+  /// operator builds the hash table on the probe input and streams the build
+  /// input through it. Only applies to joins with a single build and a single
+  /// probe driver and no spilling. 0 disables the adaptive join side swap.
+  static constexpr const char* kHashJoinAdaptiveSwapRows =
+      "hash_join_adaptive_swap_rows";
+
   /// The minimum number of table rows that can trigger the parallel hash join
   /// table build.
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
@@ -434,6 +502,21 @@ class QueryConfig {
   static constexpr const char* kDriverCpuTimeSliceLimitMs =
       "driver_cpu_time_slice_limit_ms";
 
+  /// If true, the drivers of a task are pinned to the CPUs of one NUMA node
+  /// while running and their memory allocations prefer that node. The nodes
+  /// are assigned to tasks round-robin. Has no effect on machines with a
+  /// single NUMA node or in serial execution mode.
+  static constexpr const char* kNumaNodePinningEnabled =
+      "numa_node_pinning_enabled";
+
+  /// If true, a partial OrderBy running with multiple drivers range partitions
+  /// its sorted rows across the drivers using sampled splitters and each
+  /// driver merges one key range. A LocalMerge on top of it concatenates the
+  /// drivers' outputs instead of merging them. The mode is not used if spilling
+  /// is enabled for OrderBy.
+  static constexpr const char* kOrderByParallelMergeEnabled =
+      "order_by_parallel_merge_enabled";
+
   /// Maximum number of bytes to use for the normalized key in prefix-sort. Use
   /// 0 to disable prefix-sort.
   static constexpr const char* kPrefixSortNormalizedKeyMaxBytes =
@@ -448,6 +531,17 @@ class QueryConfig {
   static constexpr const char* kPrefixSortMaxStringPrefixLength =
       "prefixsort_max_string_prefix_length";
 
+  /// If true, prefix-sort uses radix sort instead of quick sort when all the
+  /// sort keys are fully stored in the normalized key.
+  static constexpr const char* kPrefixSortRadixSortEnabled =
+      "prefixsort_radix_sort_enabled";
+
+  /// If not zero, prefix-sort detects the already sorted runs of the input and
+  /// merges them instead of sorting if there are at most this many runs. Use 0
+  /// to disable.
+  static constexpr const char* kPrefixSortMaxMergeRuns =
+      "prefixsort_max_merge_runs";
+
   /// Enable query tracing flag.
   static constexpr const char* kQueryTraceEnabled = "query_trace_enabled";
 
@@ -569,6 +663,13 @@ class QueryConfig {
   static constexpr const char* kShuffleCompressionKind =
       "shuffle_compression_codec";
 
+  /// If true, PartitionedOutput with the Presto serde writes the dictionary
+  /// encoded columns of the first vector of each page as dictionaries. Rows of
+  /// a shared dictionary are written once per page instead of once per
+  /// reference.
+  static constexpr const char* kShufflePreserveDictionaries =
+      "shuffle_preserve_dictionaries";
+
   /// If a key is found in multiple given maps, by default that key's value in
   /// the resulting map comes from the last one of those maps. When true, throw
   /// exception on duplicate map key.
@@ -590,6 +691,14 @@ class QueryConfig {
   static constexpr const char* kStreamingAggregationMinOutputBatchRows =
       "streaming_aggregation_min_output_batch_rows";
 
+  /// If true, aggregate window functions compute frames whose start moves
+  /// between rows (e.g. 'ROWS BETWEEN 1000 PRECEDING AND CURRENT ROW') with a
+  /// segment tree of partial aggregates built once per partition. This makes
+  /// the cost per row logarithmic in the frame size instead of linear. Only
+  /// applies to aggregates that are not sensitive to the order of inputs.
+  static constexpr const char* kWindowAggregateSegmentTreeEnabled =
+      "window_aggregate_segment_tree_enabled";
+
   /// TODO: Remove after dependencies are cleaned up.
   static constexpr const char* kStreamingAggregationEagerFlush =
       "streaming_aggregation_eager_flush";
@@ -656,6 +765,14 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  uint64_t partialAggregationCacheTableBytes() const {
+    return get<uint64_t>(kPartialAggregationCacheTableBytes, 0);
+  }
+
+  uint32_t aggregationParallelInsertPartitions() const {
+    return get<uint32_t>(kAggregationParallelInsertPartitions, 0);
+  }
+
   int32_t abandonPartialTopNRowNumberMinRows() const {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinRows, 100'000);
   }
@@ -735,6 +852,10 @@ class QueryConfig {
     return get<uint64_t>(kMinExchangeOutputBatchBytes, kDefault);
   }
 
+  bool exchangeAdaptiveBatching() const {
+    return get<bool>(kExchangeAdaptiveBatching, false);
+  }
+
   uint64_t preferredOutputBatchBytes() const {
     static constexpr uint64_t kDefault = 10UL << 20;
     return get<uint64_t>(kPreferredOutputBatchBytes, kDefault);
@@ -872,6 +993,10 @@ class QueryConfig {
     return get<bool>(kSpillPrefixSortEnabled, false);
   }
 
+  bool spillRowFormatEnabled() const {
+    return get<bool>(kSpillRowFormatEnabled, false);
+  }
+
   uint64_t spillWriteBufferSize() const {
     // The default write buffer size set to 1MB.
     return get<uint64_t>(kSpillWriteBufferSize, 1L << 20);
@@ -882,6 +1007,10 @@ class QueryConfig {
     return get<uint64_t>(kSpillReadBufferSize, 1L << 20);
   }
 
+  uint64_t spillReadAheadBufferSize() const {
+    return get<uint64_t>(kSpillReadAheadBufferSize, 0);
+  }
+
   std::string spillFileCreateConfig() const {
     return get<std::string>(kSpillFileCreateConfig, "");
   }
@@ -970,6 +1099,10 @@ class QueryConfig {
     return get<bool>(kExprTrackCpuUsage, false);
   }
 
+  bool exprFusionEnabled() const {
+    return get<bool>(kExprFusionEnabled, false);
+  }
+
   bool operatorTrackCpuUsage() const {
     return get<bool>(kOperatorTrackCpuUsage, true);
   }
@@ -987,6 +1120,14 @@ class QueryConfig {
     return get<bool>(kHashProbeFinishEarlyOnEmptyBuild, false);
   }
 
+  uint64_t hashProbeBloomFilterPushdownMaxSize() const {
+    return get<uint64_t>(kHashProbeBloomFilterPushdownMaxSize, 0);
+  }
+
+  uint32_t hashJoinAdaptiveSwapRows() const {
+    return get<uint32_t>(kHashJoinAdaptiveSwapRows, 0);
+  }
+
   uint32_t minTableRowsForParallelJoinBuild() const {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
@@ -1023,6 +1164,14 @@ class QueryConfig {
     return get<uint32_t>(kDriverCpuTimeSliceLimitMs, 0);
   }
 
+  bool numaNodePinningEnabled() const {
+    return get<bool>(kNumaNodePinningEnabled, false);
+  }
+
+  bool orderByParallelMergeEnabled() const {
+    return get<bool>(kOrderByParallelMergeEnabled, false);
+  }
+
   uint32_t prefixSortNormalizedKeyMaxBytes() const {
     return get<uint32_t>(kPrefixSortNormalizedKeyMaxBytes, 128);
   }
@@ -1035,6 +1184,14 @@ class QueryConfig {
     return get<uint32_t>(kPrefixSortMaxStringPrefixLength, 16);
   }
 
+  bool prefixSortRadixSortEnabled() const {
+    return get<bool>(kPrefixSortRadixSortEnabled, false);
+  }
+
+  uint32_t prefixSortMaxMergeRuns() const {
+    return get<uint32_t>(kPrefixSortMaxMergeRuns, 0);
+  }
+
   double scaleWriterRebalanceMaxMemoryUsageRatio() const {
     return get<double>(kScaleWriterRebalanceMaxMemoryUsageRatio, 0.7);
   }
@@ -1069,6 +1226,10 @@ class QueryConfig {
     return get<std::string>(kShuffleCompressionKind, "none");
   }
 
+  bool shufflePreserveDictionaries() const {
+    return get<bool>(kShufflePreserveDictionaries, false);
+  }
+
   int32_t requestDataSizesMaxWaitSec() const {
     return get<int32_t>(kRequestDataSizesMaxWaitSec, 10);
   }
@@ -1086,6 +1247,10 @@ class QueryConfig {
     return get<int32_t>(kStreamingAggregationMinOutputBatchRows, 0);
   }
 
+  bool windowAggregateSegmentTreeEnabled() const {
+    return get<bool>(kWindowAggregateSegmentTreeEnabled, false);
+  }
+
   bool isFieldNamesInJsonCastEnabled() const {
     return get<bool>(kFieldNamesInJsonCastEnabled, false);
   }
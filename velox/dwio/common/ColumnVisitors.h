@@ -1604,6 +1604,10 @@ class StringColumnReadWithVisitorHelper {
         readHelper<velox::common::NegatedBytesValues, kIsDense>(
             filter, extractValues, std::forward<F>(readWithVisitor));
         break;
+      case velox::common::FilterKind::kBloomFilter:
+        readHelper<velox::common::BloomFilterValues, kIsDense>(
+            filter, extractValues, std::forward<F>(readWithVisitor));
+        break;
       default:
         readHelper<velox::common::Filter, kIsDense>(
             filter, extractValues, std::forward<F>(readWithVisitor));
@@ -599,6 +599,17 @@ class ReaderOptions : public io::ReaderOptions {
     randomSkip_ = std::move(randomSkip);
   }
 
+  /// Bernoulli trials on whole stripes or row groups, used for SYSTEM
+  /// sampling. A block that fails its trial is skipped without being read.
+  const std::shared_ptr<random::RandomSkipTracker>& blockRandomSkip() const {
+    return blockRandomSkip_;
+  }
+
+  void setBlockRandomSkip(
+      std::shared_ptr<random::RandomSkipTracker> blockRandomSkip) {
+    blockRandomSkip_ = std::move(blockRandomSkip);
+  }
+
   bool noCacheRetention() const {
     return noCacheRetention_;
   }
@@ -643,6 +654,7 @@ class ReaderOptions : public io::ReaderOptions {
   bool useColumnNamesForColumnMapping_{false};
   std::shared_ptr<folly::Executor> ioExecutor_;
   std::shared_ptr<random::RandomSkipTracker> randomSkip_;
+  std::shared_ptr<random::RandomSkipTracker> blockRandomSkip_;
   std::shared_ptr<velox::common::ScanSpec> scanSpec_;
   const tz::TimeZone* sessionTimezone_{nullptr};
   bool adjustTimestampToTimezone_{false};
@@ -554,6 +554,12 @@ struct RuntimeStatistics {
   // Number of strides (row groups) processed based on statistics.
   int64_t processedStrides{0};
 
+  // Number of data pages skipped based on page level statistics.
+  int64_t skippedPages{0};
+
+  // Number of rows in the data pages skipped based on page level statistics.
+  int64_t skippedPageRows{0};
+
   int64_t footerBufferOverread{0};
 
   int64_t numStripes{0};
@@ -579,6 +585,12 @@ struct RuntimeStatistics {
     if (processedStrides > 0) {
       result.emplace("processedStrides", RuntimeCounter(processedStrides));
     }
+    if (skippedPages > 0) {
+      result.emplace("skippedPages", RuntimeCounter(skippedPages));
+    }
+    if (skippedPageRows > 0) {
+      result.emplace("skippedPageRows", RuntimeCounter(skippedPageRows));
+    }
     if (footerBufferOverread > 0) {
       result.emplace(
           "footerBufferOverread",
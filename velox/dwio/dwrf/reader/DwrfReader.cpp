@@ -553,6 +553,13 @@ int64_t DwrfRowReader::nextRowNumber() {
   const auto strideSize = getReader().footer().rowIndexStride();
   while (currentStripe_ < stripeCeiling_) {
     if (currentRowInStripe_ == 0) {
+      if (getReader().blockRandomSkip() &&
+          !getReader().blockRandomSkip()->testOne()) {
+        const auto numStripeRows =
+            getReader().footer().stripes(currentStripe_).numberOfRows();
+        skippedStrides_ += bits::divRoundUp(numStripeRows, strideSize);
+        goto advanceToNextStripe;
+      }
       if (getReader().randomSkip()) {
         const auto numStripeRows =
             getReader().footer().stripes(currentStripe_).numberOfRows();
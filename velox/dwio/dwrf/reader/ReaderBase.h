@@ -248,6 +248,10 @@ class ReaderBase {
     return options_.randomSkip();
   }
 
+  const std::shared_ptr<random::RandomSkipTracker>& blockRandomSkip() const {
+    return options_.blockRandomSkip();
+  }
+
   int footerBufferOverread() const {
     return footerBufferOverread_;
   }
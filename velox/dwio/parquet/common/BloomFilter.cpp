@@ -162,7 +162,11 @@ BlockSplitBloomFilter BlockSplitBloomFilter::deserialize(
 void BlockSplitBloomFilter::writeTo(
     velox::dwio::common::AppendOnlyBufferedStream* sink) const {
   VELOX_CHECK(sink != nullptr);
+  serialize([&](const char* data, size_t size) { sink->write(data, size); });
+}
 
+void BlockSplitBloomFilter::serialize(
+    const std::function<void(const char* data, size_t size)>& write) const {
   thrift::BloomFilterHeader header;
   if (algorithm_ != BloomFilter::Algorithm::BLOCK) {
     VELOX_FAIL("BloomFilter does not support Algorithm other than BLOCK");
@@ -198,9 +202,9 @@ void BlockSplitBloomFilter::writeTo(
   uint32_t outLength;
   memBuffer->getBuffer(&outBuffer, &outLength);
   // write header
-  sink->write(reinterpret_cast<const char*>(outBuffer), outLength);
+  write(reinterpret_cast<const char*>(outBuffer), outLength);
   // write bitset
-  sink->write(data_->as<char>(), numBytes_);
+  write(data_->as<char>(), numBytes_);
 }
 
 bool BlockSplitBloomFilter::findHash(uint64_t hash) const {
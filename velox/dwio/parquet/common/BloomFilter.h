@@ -25,6 +25,7 @@
 
 #include <cmath>
 #include <cstdint>
+#include <functional>
 #include <memory>
 
 namespace facebook::velox::parquet {
@@ -244,6 +245,13 @@ class BlockSplitBloomFilter : public BloomFilter {
   void insertHashes(const uint64_t* hashes, int numValues) override;
   void writeTo(
       velox::dwio::common::AppendOnlyBufferedStream* sink) const override;
+
+  /// Serializes the Bloom filter header and bitset like writeTo() and passes
+  /// the bytes to 'write'. Used by writers that do not write to a
+  /// velox::dwio::common output stream.
+  void serialize(
+      const std::function<void(const char* data, size_t size)>& write) const;
+
   uint32_t getBitsetSize() const override {
     return numBytes_;
   }
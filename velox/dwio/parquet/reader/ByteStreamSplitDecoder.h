@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <xsimd/xsimd.hpp>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+#include "velox/dwio/common/DecoderUtil.h"
+
+namespace facebook::velox::parquet {
+
+// Decoder for the BYTE_STREAM_SPLIT encoding. A page of 'numValues_' values
+// of 'width_' bytes is laid out as 'width_' streams of 'numValues_' bytes,
+// where stream k holds byte k of every value. Values are transposed back
+// straight into the value buffer of the visitor, so no decoded copy of the
+// page is made.
+class ByteStreamSplitDecoder {
+ public:
+  ByteStreamSplitDecoder(const char* start, const char* end, int32_t width)
+      : data_(reinterpret_cast<const uint8_t*>(start)),
+        width_(width),
+        numValues_((end - start) / width) {
+    VELOX_CHECK(
+        width_ == sizeof(int32_t) || width_ == sizeof(int64_t),
+        "BYTE_STREAM_SPLIT only supports 4 and 8 byte values, got {}",
+        width_);
+    VELOX_CHECK_EQ(
+        (end - start) % width_,
+        0,
+        "BYTE_STREAM_SPLIT page size is not a multiple of the value width");
+  }
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(int32_t numValues, int32_t current, const uint64_t* nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    VELOX_DCHECK_LE(position_ + numValues, numValues_);
+    position_ += numValues;
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(
+      const uint64_t* nulls,
+      Visitor visitor,
+      bool useFastPath = true) {
+    if (useFastPath && canUseFastPath<typename Visitor::DataType>() &&
+        dwio::common::useFastPath<Visitor, hasNulls>(visitor)) {
+      fastPath<hasNulls>(nulls, visitor);
+      return;
+    }
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      bool atEnd = false;
+      int32_t toSkip;
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+        toSkip =
+            visitor.process(readValue<typename Visitor::DataType>(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+  // True if values can be transposed directly into a buffer of T.
+  template <typename T>
+  bool canUseFastPath() const {
+    return (std::is_same_v<T, float> || std::is_same_v<T, double> ||
+            std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t>) &&
+        sizeof(T) == width_;
+  }
+
+ private:
+  // Returns the value at 'index' in the page.
+  template <typename T>
+  T valueAt(int64_t index) const {
+    T value;
+    auto* bytes = reinterpret_cast<uint8_t*>(&value);
+    for (size_t i = 0; i < sizeof(T); ++i) {
+      bytes[i] = data_[i * numValues_ + index];
+    }
+    return value;
+  }
+
+  // Returns the next value converted to the data type of the visitor.
+  // Integers are passed as int64_t like in DirectDecoder.
+  template <typename T>
+  auto readValue() {
+    VELOX_DCHECK_LT(position_, numValues_);
+    const auto index = position_++;
+    if constexpr (std::is_floating_point_v<T>) {
+      return width_ == sizeof(float) ? static_cast<T>(valueAt<float>(index))
+                                     : static_cast<T>(valueAt<double>(index));
+    } else {
+      return width_ == sizeof(int32_t)
+          ? static_cast<int64_t>(valueAt<int32_t>(index))
+          : valueAt<int64_t>(index);
+    }
+  }
+
+  // Transposes 'numValues' consecutive values starting at 'position_' into
+  // 'result' and advances 'position_'. sizeof(T) must be 'width_'.
+  template <typename T>
+  void readDense(int32_t numValues, T* result) {
+    VELOX_DCHECK_LE(position_ + numValues, numValues_);
+    using Batch = xsimd::batch<uint8_t>;
+    constexpr int32_t kBatchSize = Batch::size;
+    auto* output = reinterpret_cast<uint8_t*>(result);
+    int32_t i = 0;
+    for (; i + kBatchSize <= numValues; i += kBatchSize) {
+      const auto* streams = data_ + position_ + i;
+      if constexpr (sizeof(T) == 4) {
+        transpose4(streams, output + i * sizeof(T));
+      } else {
+        transpose8(streams, output + i * sizeof(T));
+      }
+    }
+    for (; i < numValues; ++i) {
+      result[i] = valueAt<T>(position_ + i);
+    }
+    position_ += numValues;
+  }
+
+  // Reads the values at 'rows' relative to 'position_' into consecutive
+  // elements of 'result' and advances 'position_' past the last row.
+  template <typename T>
+  void readRows(folly::Range<const int32_t*> rows, T* result) {
+    for (auto i = 0; i < rows.size(); ++i) {
+      result[i] = valueAt<T>(position_ + rows[i]);
+    }
+    position_ += rows.back() + 1;
+  }
+
+  // Interleaves one batch of bytes from each of the 4 streams starting at
+  // 'streams' into 4-byte values at 'output'.
+  void transpose4(const uint8_t* streams, uint8_t* output) const {
+    using Batch = xsimd::batch<uint8_t>;
+    using Batch16 = xsimd::batch<uint16_t>;
+    const auto s0 = Batch::load_unaligned(streams);
+    const auto s1 = Batch::load_unaligned(streams + numValues_);
+    const auto s2 = Batch::load_unaligned(streams + 2 * numValues_);
+    const auto s3 = Batch::load_unaligned(streams + 3 * numValues_);
+    // Bytes 0-1 and 2-3 of the first and second half of the values.
+    const auto lo01 = xsimd::bitwise_cast<uint16_t>(xsimd::zip_lo(s0, s1));
+    const auto hi01 = xsimd::bitwise_cast<uint16_t>(xsimd::zip_hi(s0, s1));
+    const auto lo23 = xsimd::bitwise_cast<uint16_t>(xsimd::zip_lo(s2, s3));
+    const auto hi23 = xsimd::bitwise_cast<uint16_t>(xsimd::zip_hi(s2, s3));
+    constexpr auto kBytes = Batch16::size * sizeof(uint16_t);
+    xsimd::zip_lo(lo01, lo23).store_unaligned(
+        reinterpret_cast<uint16_t*>(output));
+    xsimd::zip_hi(lo01, lo23).store_unaligned(
+        reinterpret_cast<uint16_t*>(output + kBytes));
+    xsimd::zip_lo(hi01, hi23).store_unaligned(
+        reinterpret_cast<uint16_t*>(output + 2 * kBytes));
+    xsimd::zip_hi(hi01, hi23).store_unaligned(
+        reinterpret_cast<uint16_t*>(output + 3 * kBytes));
+  }
+
+  // Interleaves one batch of bytes from each of the 8 streams starting at
+  // 'streams' into 8-byte values at 'output'.
+  void transpose8(const uint8_t* streams, uint8_t* output) const {
+    using Batch = xsimd::batch<uint8_t>;
+    using Batch32 = xsimd::batch<uint32_t>;
+    xsimd::batch<uint16_t> pairs[4][2];
+    for (auto k = 0; k < 4; ++k) {
+      const auto* even = streams + 2 * k * numValues_;
+      const auto* odd = even + numValues_;
+      const auto evenBytes = Batch::load_unaligned(even);
+      const auto oddBytes = Batch::load_unaligned(odd);
+      pairs[k][0] =
+          xsimd::bitwise_cast<uint16_t>(xsimd::zip_lo(evenBytes, oddBytes));
+      pairs[k][1] =
+          xsimd::bitwise_cast<uint16_t>(xsimd::zip_hi(evenBytes, oddBytes));
+    }
+    // quads[g][q] has bytes 4g to 4g + 3 of quarter q of the values.
+    Batch32 quads[2][4];
+    for (auto g = 0; g < 2; ++g) {
+      for (auto half = 0; half < 2; ++half) {
+        const auto& low = pairs[2 * g][half];
+        const auto& high = pairs[2 * g + 1][half];
+        quads[g][2 * half] =
+            xsimd::bitwise_cast<uint32_t>(xsimd::zip_lo(low, high));
+        quads[g][2 * half + 1] =
+            xsimd::bitwise_cast<uint32_t>(xsimd::zip_hi(low, high));
+      }
+    }
+    constexpr auto kBytes = Batch32::size * sizeof(uint32_t);
+    for (auto q = 0; q < 4; ++q) {
+      xsimd::zip_lo(quads[0][q], quads[1][q])
+          .store_unaligned(
+              reinterpret_cast<uint32_t*>(output + 2 * q * kBytes));
+      xsimd::zip_hi(quads[0][q], quads[1][q])
+          .store_unaligned(
+              reinterpret_cast<uint32_t*>(output + (2 * q + 1) * kBytes));
+    }
+  }
+
+  // Decodes the non-null values of the visited rows directly into the value
+  // buffer of 'visitor' and then filters them in place like the fixed width
+  // bulk path of DirectDecoder.
+  template <bool hasNulls, typename Visitor>
+  void fastPath(const uint64_t* nulls, Visitor& visitor) {
+    using T = typename Visitor::DataType;
+    constexpr bool hasFilter =
+        !std::
+            is_same_v<typename Visitor::FilterType, velox::common::AlwaysTrue>;
+    constexpr bool filterOnly =
+        std::is_same_v<typename Visitor::Extract, dwio::common::DropValues>;
+    constexpr bool hasHook =
+        !std::is_same_v<typename Visitor::HookType, dwio::common::NoHook>;
+
+    int32_t numValues = 0;
+    auto rows = visitor.rows();
+    auto numRows = visitor.numRows();
+    auto rowsAsRange = folly::Range<const int32_t*>(rows, numRows);
+    auto data = visitor.rawValues(numRows);
+    if (hasNulls) {
+      int32_t tailSkip = 0;
+      raw_vector<int32_t>* innerVector = nullptr;
+      auto outerVector = &visitor.outerNonNullRows();
+      if (Visitor::dense || rowsAsRange.back() == rowsAsRange.size() - 1) {
+        dwio::common::nonNullRowsFromDense(nulls, numRows, *outerVector);
+        if (outerVector->empty()) {
+          visitor.setAllNull(hasFilter ? 0 : numRows);
+          return;
+        }
+        readDense(outerVector->size(), data);
+      } else {
+        innerVector = &visitor.innerNonNullRows();
+        auto anyNulls = dwio::common::
+            nonNullRowsFromSparse<hasFilter, !hasFilter && !hasHook>(
+                nulls,
+                rowsAsRange,
+                *innerVector,
+                *outerVector,
+                (hasFilter || hasHook) ? nullptr : visitor.rawNulls(numRows),
+                tailSkip);
+        if (anyNulls) {
+          visitor.setHasNulls();
+        }
+        if (innerVector->empty()) {
+          skip<false>(tailSkip, 0, nullptr);
+          visitor.setAllNull(hasFilter ? 0 : numRows);
+          return;
+        }
+        readRows(*innerVector, data);
+      }
+      skip<false>(tailSkip, 0, nullptr);
+      if (hasHook && visitor.numValuesBias() > 0) {
+        for (auto& row : *outerVector) {
+          row += visitor.numValuesBias();
+        }
+      }
+      auto dataRows = innerVector
+          ? folly::Range<const int32_t*>(*innerVector)
+          : folly::Range<const int32_t*>(rows, outerVector->size());
+      dwio::common::processFixedWidthRun<T, filterOnly, true, Visitor::dense>(
+          dataRows,
+          0,
+          dataRows.size(),
+          outerVector->data(),
+          data,
+          hasFilter ? visitor.outputRows(numRows) : nullptr,
+          numValues,
+          visitor.filter(),
+          visitor.hook());
+    } else {
+      if (Visitor::dense) {
+        readDense(numRows, data);
+      } else {
+        readRows(rowsAsRange, data);
+      }
+      dwio::common::processFixedWidthRun<T, filterOnly, false, Visitor::dense>(
+          rowsAsRange,
+          0,
+          rowsAsRange.size(),
+          hasHook ? velox::iota(
+                        numRows,
+                        visitor.innerNonNullRows(),
+                        visitor.numValuesBias())
+                  : nullptr,
+          data,
+          hasFilter ? visitor.outputRows(numRows) : nullptr,
+          numValues,
+          visitor.filter(),
+          visitor.hook());
+    }
+    visitor.setNumValues(hasFilter ? numValues : numRows);
+  }
+
+  const uint8_t* const data_;
+  const size_t width_;
+  const int64_t numValues_;
+  // Index of the next value to read.
+  int64_t position_{0};
+};
+
+} // namespace facebook::velox::parquet
@@ -31,6 +31,72 @@ class DeltaLengthByteArrayDecoder {
     bufferStart_ = lengthDecoder_->bufferStart();
   }
 
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(int32_t numValues, int32_t current, const uint64_t* nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    VELOX_CHECK_LE(
+        lengthIdx_ + numValues,
+        bufferedLength_.size(),
+        "skipping past the end of DELTA_LENGTH_BYTE_ARRAY page");
+    // The lengths are all decoded up front, so skipping only advances past
+    // the bytes of the skipped strings.
+    for (int32_t i = 0; i < numValues; ++i) {
+      bufferStart_ += bufferedLength_[lengthIdx_++];
+    }
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    int32_t current = visitor.start();
+    int32_t numValues = 0;
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            if constexpr (Visitor::kHasHook) {
+              visitor.setNumValues(
+                  Visitor::kHasFilter ? numValues : visitor.numRows());
+            }
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit. The string points
+        // into the page, so it is not copied before the filter is applied.
+        toSkip = visitor.process(readString(), atEnd);
+      }
+      ++current;
+      ++numValues;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        if constexpr (Visitor::kHasHook) {
+          visitor.setNumValues(
+              Visitor::kHasFilter ? numValues : visitor.numRows());
+        }
+        return;
+      }
+    }
+  }
+
   std::string_view readString() {
     const int64_t length = bufferedLength_[lengthIdx_++];
     VELOX_CHECK_GE(length, 0, "negative string delta length");
@@ -21,6 +21,17 @@
 
 namespace facebook::velox::parquet {
 
+namespace thrift {
+class Statistics;
+} // namespace thrift
+
+/// Builds the column statistics of 'type' from the thrift statistics of a
+/// column chunk or of a single data page holding 'numRows' rows.
+std::unique_ptr<dwio::common::ColumnStatistics> buildColumnStatisticsFromThrift(
+    const thrift::Statistics& stats,
+    const velox::Type& type,
+    uint64_t numRows);
+
 /// ColumnChunkMetaDataPtr is a proxy around pointer to thrift::ColumnChunk.
 class ColumnChunkMetaDataPtr {
  public:
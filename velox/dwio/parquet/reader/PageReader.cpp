@@ -745,7 +745,32 @@ void PageReader::makeDecoder() {
             std::make_unique<DeltaByteArrayDecoder>(pageData_);
         break;
       }
-      FMT_FALLTHROUGH;
+      VELOX_UNSUPPORTED("DELTA_BYTE_ARRAY decoder only supports BYTE_ARRAY");
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+      if (parquetType == thrift::Type::BYTE_ARRAY) {
+        deltaLengthByteArrDecoder_ =
+            std::make_unique<DeltaLengthByteArrayDecoder>(pageData_);
+        break;
+      }
+      VELOX_UNSUPPORTED(
+          "DELTA_LENGTH_BYTE_ARRAY decoder only supports BYTE_ARRAY");
+    case Encoding::BYTE_STREAM_SPLIT:
+      switch (parquetType) {
+        case thrift::Type::INT32:
+        case thrift::Type::INT64:
+        case thrift::Type::FLOAT:
+        case thrift::Type::DOUBLE:
+          byteStreamSplitDecoder_ = std::make_unique<ByteStreamSplitDecoder>(
+              pageData_,
+              pageData_ + encodedDataSize_,
+              parquetTypeBytes(parquetType));
+          break;
+        default:
+          VELOX_UNSUPPORTED(
+              "BYTE_STREAM_SPLIT decoder only supports INT32, INT64, FLOAT "
+              "and DOUBLE");
+      }
+      break;
     default:
       VELOX_UNSUPPORTED("Encoding not supported yet: {}", encoding_);
   }
@@ -778,6 +803,10 @@ void PageReader::skip(int64_t numRows) {
   // Skip the decoder
   if (isDictionary()) {
     dictionaryIdDecoder_->skip(toSkip);
+  } else if (encoding_ == Encoding::BYTE_STREAM_SPLIT) {
+    byteStreamSplitDecoder_->skip(toSkip);
+  } else if (encoding_ == Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+    deltaLengthByteArrDecoder_->skip(toSkip);
   } else if (directDecoder_) {
     directDecoder_->skip(toSkip);
   } else if (stringDecoder_) {
@@ -18,6 +18,7 @@
 
 #include <thrift/protocol/TCompactProtocol.h> //@manual
 
+#include "velox/dwio/parquet/common/BloomFilter.h"
 #include "velox/dwio/parquet/reader/ParquetColumnReader.h"
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
@@ -83,6 +84,14 @@ class ReaderBase {
     return options_.sessionTimezone();
   }
 
+  const std::shared_ptr<random::RandomSkipTracker>& blockRandomSkip() const {
+    return options_.blockRandomSkip();
+  }
+
+  int64_t prefetchRowGroups() const {
+    return options_.prefetchRowGroups();
+  }
+
   std::optional<SemanticVersion> version() const {
     return version_;
   }
@@ -1104,8 +1113,9 @@ class ParquetRowReader::Impl {
       auto isEmpty = rowGroups_[i].num_rows == 0;
 
       // Add a row group to read if it is within range and not empty and not in
-      // the excluded list.
-      if (rowGroupInRange && !isExcluded && !isEmpty) {
+      // the excluded list and is kept by block sampling. The bloom filters are
+      // checked later by filterRowGroupsByBloomFilters().
+      if (rowGroupInRange && !isExcluded && !isEmpty && sampleRowGroup()) {
         rowGroupIds_.push_back(i);
         firstRowOfRowGroup_.push_back(rowNumber);
       } else {
@@ -1124,10 +1134,179 @@ class ParquetRowReader::Impl {
     }
   }
 
+  // Returns false if block sampling drops the next row group.
+  bool sampleRowGroup() const {
+    const auto& blockRandomSkip = readerBase_->blockRandomSkip();
+    return blockRandomSkip == nullptr || blockRandomSkip->testOne();
+  }
+
+  // Drops the row groups whose bloom filters prove that they do not contain
+  // the filter values. Only checks the row groups up to the last one that the
+  // next scheduleRowGroups() loads. This reads the bloom filters lazily, only
+  // for the row groups that survive the statistics and are reached, and
+  // before any of their data is loaded.
+  void filterRowGroupsByBloomFilters() {
+    const auto scheduleEnd =
+        nextRowGroupIdsIdx_ + readerBase_->prefetchRowGroups() + 1;
+    while (numBloomFilterCheckedRowGroups_ < rowGroupIds_.size() &&
+           numBloomFilterCheckedRowGroups_ < scheduleEnd) {
+      const auto index = numBloomFilterCheckedRowGroups_;
+      const auto rowGroupId = rowGroupIds_[index];
+      if (bloomFiltersMatch(rowGroups_[rowGroupId])) {
+        ++numBloomFilterCheckedRowGroups_;
+        continue;
+      }
+      if (rowGroupId != 0) {
+        rowGroups_[rowGroupId].columns.clear();
+      }
+      rowGroupIds_.erase(rowGroupIds_.begin() + index);
+      firstRowOfRowGroup_.erase(firstRowOfRowGroup_.begin() + index);
+      ++skippedStrides_;
+    }
+  }
+
+  // Returns false if the bloom filter of a top level column in 'rowGroup'
+  // proves that none of the values accepted by the equality or IN filter on
+  // the column is in the column chunk.
+  bool bloomFiltersMatch(const thrift::RowGroup& rowGroup) const {
+    for (auto* child : columnReader_->children()) {
+      auto* filter = child->scanSpec()->filter();
+      if (!filter || filter->testNull()) {
+        continue;
+      }
+      const auto& fileType =
+          static_cast<const ParquetTypeWithId&>(child->fileType());
+      if (!canUseBloomFilter(fileType)) {
+        continue;
+      }
+      const auto& metaData = rowGroup.columns[fileType.column()].meta_data;
+      if (!metaData.__isset.bloom_filter_offset) {
+        continue;
+      }
+      std::vector<int64_t> bigintValues;
+      std::vector<std::string_view> bytesValues;
+      if (!bloomFilterValues(*filter, bigintValues, bytesValues)) {
+        continue;
+      }
+      const auto bloomFilter = readBloomFilter(metaData.bloom_filter_offset);
+      const bool isInt32 = fileType.parquetType_ == thrift::Type::INT32;
+      bool mayContain = false;
+      for (auto value : bigintValues) {
+        if (!isInt32) {
+          mayContain = bloomFilter.findHash(bloomFilter.hash(value));
+        } else if (
+            value >= std::numeric_limits<int32_t>::min() &&
+            value <= std::numeric_limits<int32_t>::max()) {
+          mayContain = bloomFilter.findHash(
+              bloomFilter.hash(static_cast<int32_t>(value)));
+        }
+        if (mayContain) {
+          break;
+        }
+      }
+      for (auto value : bytesValues) {
+        if (mayContain) {
+          break;
+        }
+        const ByteArray byteArray(value);
+        mayContain = bloomFilter.findHash(bloomFilter.hash(&byteArray));
+      }
+      if (!mayContain) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Returns true if a bloom filter written by the Parquet writer for 'type'
+  // hashes values the same way as the Velox filter on 'type' compares them.
+  // Struct, list and map columns have no column chunk and no bloom filter.
+  static bool canUseBloomFilter(const ParquetTypeWithId& type) {
+    if (!type.isLeaf() || type.maxRepeat_ > 0 ||
+        !type.parquetType_.has_value() || type.type()->isDecimal()) {
+      return false;
+    }
+    switch (type.type()->kind()) {
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+        return type.parquetType_ == thrift::Type::INT32;
+      case TypeKind::BIGINT:
+        return type.parquetType_ == thrift::Type::INT64;
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        return type.parquetType_ == thrift::Type::BYTE_ARRAY;
+      default:
+        return false;
+    }
+  }
+
+  // Collects the values accepted by 'filter' if it only accepts a small set
+  // of values. Returns false for range and other filters.
+  static bool bloomFilterValues(
+      const common::Filter& filter,
+      std::vector<int64_t>& bigintValues,
+      std::vector<std::string_view>& bytesValues) {
+    switch (filter.kind()) {
+      case common::FilterKind::kBigintRange: {
+        const auto& range = static_cast<const common::BigintRange&>(filter);
+        if (!range.isSingleValue()) {
+          return false;
+        }
+        bigintValues.push_back(range.lower());
+        return true;
+      }
+      case common::FilterKind::kBigintValuesUsingHashTable:
+        bigintValues =
+            static_cast<const common::BigintValuesUsingHashTable&>(filter)
+                .values();
+        return true;
+      case common::FilterKind::kBigintValuesUsingBitmask:
+        bigintValues =
+            static_cast<const common::BigintValuesUsingBitmask&>(filter)
+                .values();
+        return true;
+      case common::FilterKind::kBytesRange: {
+        const auto& range = static_cast<const common::BytesRange&>(filter);
+        if (!range.isSingleValue()) {
+          return false;
+        }
+        bytesValues.push_back(range.lower());
+        return true;
+      }
+      case common::FilterKind::kBytesValues:
+        for (const auto& value :
+             static_cast<const common::BytesValues&>(filter).values()) {
+          bytesValues.push_back(value);
+        }
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  BlockSplitBloomFilter readBloomFilter(int64_t offset) const {
+    // The thrift metadata has no bloom filter length, so the stream extends to
+    // the end of the file and only the bytes given in the header are read.
+    dwio::common::SeekableFileInputStream input(
+        readerBase_->bufferedInput().getInputStream(),
+        offset,
+        readerBase_->fileLength() - offset,
+        pool_,
+        dwio::common::LogType::FOOTER);
+    return BlockSplitBloomFilter::deserialize(&input, pool_);
+  }
+
   int64_t nextRowNumber() {
-    if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
-        !advanceToNextRowGroup()) {
-      return kAtEnd;
+    for (;;) {
+      if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
+          !advanceToNextRowGroup()) {
+        return kAtEnd;
+      }
+      skipFilteredPages();
+      if (currentRowInGroup_ < rowsInCurrentRowGroup_) {
+        break;
+      }
     }
     return firstRowOfRowGroup_[nextRowGroupIdsIdx_ - 1] + currentRowInGroup_;
   }
@@ -1137,7 +1316,11 @@ class ParquetRowReader::Impl {
     if (nextRowNumber() == kAtEnd) {
       return kAtEnd;
     }
-    return std::min(size, rowsInCurrentRowGroup_ - currentRowInGroup_);
+    // Do not read into the next range of rows skipped by the page index.
+    const uint64_t endRow = nextSkippedRowRange_ < skippedRowRanges_.size()
+        ? skippedRowRanges_[nextSkippedRowRange_].first
+        : rowsInCurrentRowGroup_;
+    return std::min(size, endRow - currentRowInGroup_);
   }
 
   uint64_t next(
@@ -1177,6 +1360,8 @@ class ParquetRowReader::Impl {
   void updateRuntimeStats(dwio::common::RuntimeStatistics& stats) const {
     stats.skippedStrides += skippedStrides_;
     stats.processedStrides += rowGroupIds_.size();
+    stats.skippedPages += skippedPages_;
+    stats.skippedPageRows += skippedPageRows_;
   }
 
   void resetFilterCaches() {
@@ -1189,6 +1374,7 @@ class ParquetRowReader::Impl {
 
  private:
   bool advanceToNextRowGroup() {
+    filterRowGroupsByBloomFilters();
     if (nextRowGroupIdsIdx_ == rowGroupIds_.size()) {
       return false;
     }
@@ -1203,9 +1389,152 @@ class ParquetRowReader::Impl {
     currentRowInGroup_ = 0;
     nextRowGroupIdsIdx_++;
     columnReader_->seekToRowGroup(nextRowGroupIndex);
+    filterDataPages();
     return true;
   }
 
+  // Computes the ranges of rows in the current row group that are in data
+  // pages whose page index statistics do not match the filter of a top level
+  // primitive column. Filters on different columns are conjunctive, so a row
+  // in any of these ranges is dropped.
+  void filterDataPages() {
+    skippedRowRanges_.clear();
+    nextSkippedRowRange_ = 0;
+    for (auto* child : columnReader_->children()) {
+      auto* filter = child->scanSpec()->filter();
+      if (!filter) {
+        continue;
+      }
+      const auto& fileType =
+          static_cast<const ParquetTypeWithId&>(child->fileType());
+      // Struct, list and map columns have no column chunk of their own.
+      if (!fileType.isLeaf()) {
+        continue;
+      }
+      const auto& chunk = currentRowGroupPtr_->columns[fileType.column()];
+      if (!canFilterDataPages(fileType, chunk)) {
+        continue;
+      }
+      const auto columnIndex = readPageIndex<thrift::ColumnIndex>(
+          chunk.column_index_offset, chunk.column_index_length);
+      const auto offsetIndex = readPageIndex<thrift::OffsetIndex>(
+          chunk.offset_index_offset, chunk.offset_index_length);
+      const auto& pages = offsetIndex.page_locations;
+      VELOX_CHECK_EQ(pages.size(), columnIndex.null_pages.size());
+      for (auto i = 0; i < pages.size(); ++i) {
+        const uint64_t firstRow = pages[i].first_row_index;
+        const uint64_t endRow = i + 1 < pages.size()
+            ? pages[i + 1].first_row_index
+            : rowsInCurrentRowGroup_;
+        const auto numRows = endRow - firstRow;
+        thrift::Statistics pageStats;
+        if (!columnIndex.null_pages[i]) {
+          pageStats.__set_min_value(columnIndex.min_values[i]);
+          pageStats.__set_max_value(columnIndex.max_values[i]);
+        }
+        if (columnIndex.__isset.null_counts) {
+          pageStats.__set_null_count(columnIndex.null_counts[i]);
+        } else if (columnIndex.null_pages[i]) {
+          pageStats.__set_null_count(numRows);
+        }
+        auto columnStats = buildColumnStatisticsFromThrift(
+            pageStats, *fileType.type(), numRows);
+        if (!testFilter(filter, columnStats.get(), numRows, fileType.type())) {
+          skippedRowRanges_.emplace_back(firstRow, endRow);
+          ++skippedPages_;
+        }
+      }
+    }
+    if (skippedRowRanges_.empty()) {
+      return;
+    }
+
+    // Merge the ranges of all columns into sorted disjoint ranges.
+    std::sort(skippedRowRanges_.begin(), skippedRowRanges_.end());
+    size_t numRanges = 0;
+    for (const auto& range : skippedRowRanges_) {
+      auto* last = numRanges > 0 ? &skippedRowRanges_[numRanges - 1] : nullptr;
+      if (last && range.first <= last->second) {
+        last->second = std::max(last->second, range.second);
+      } else {
+        skippedRowRanges_[numRanges++] = range;
+      }
+    }
+    skippedRowRanges_.resize(numRanges);
+  }
+
+  // Returns true if the page index of 'chunk' can be used to evaluate a
+  // filter on 'type'. Only top level columns with physical types whose
+  // min/max bytes are loaded by buildColumnStatisticsFromThrift() qualify.
+  bool canFilterDataPages(
+      const ParquetTypeWithId& type,
+      const thrift::ColumnChunk& chunk) const {
+    if (!chunk.__isset.column_index_offset ||
+        !chunk.__isset.offset_index_offset || type.maxRepeat_ > 0 ||
+        !type.parquetType_.has_value() ||
+        parquetStatsContext_.shouldIgnoreStatistics(
+            type.parquetType_.value())) {
+      return false;
+    }
+    if (type.type()->isDecimal()) {
+      return false;
+    }
+    switch (type.type()->kind()) {
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+        return type.parquetType_ == thrift::Type::INT32;
+      case TypeKind::BIGINT:
+        return type.parquetType_ == thrift::Type::INT64;
+      case TypeKind::REAL:
+        return type.parquetType_ == thrift::Type::FLOAT;
+      case TypeKind::DOUBLE:
+        return type.parquetType_ == thrift::Type::DOUBLE;
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        return type.parquetType_ == thrift::Type::BYTE_ARRAY;
+      default:
+        return false;
+    }
+  }
+
+  template <typename T>
+  T readPageIndex(int64_t offset, int32_t length) const {
+    auto stream = readerBase_->bufferedInput().read(
+        offset, length, dwio::common::LogType::FOOTER);
+    std::vector<char> buffer(length);
+    const char* bufferStart = nullptr;
+    const char* bufferEnd = nullptr;
+    dwio::common::readBytes(
+        length, stream.get(), buffer.data(), bufferStart, bufferEnd);
+    auto thriftTransport = std::make_shared<thrift::ThriftBufferedTransport>(
+        buffer.data(), length);
+    auto thriftProtocol = std::make_unique<
+        apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
+        thriftTransport);
+    T index;
+    index.read(thriftProtocol.get());
+    return index;
+  }
+
+  // Moves 'currentRowInGroup_' past the rows skipped by the page index. The
+  // child readers skip the pages lazily when they are next positioned at the
+  // new read offset of 'columnReader_'.
+  void skipFilteredPages() {
+    while (nextSkippedRowRange_ < skippedRowRanges_.size()) {
+      const auto& range = skippedRowRanges_[nextSkippedRowRange_];
+      if (currentRowInGroup_ < range.first) {
+        return;
+      }
+      if (currentRowInGroup_ < range.second) {
+        skippedPageRows_ += range.second - currentRowInGroup_;
+        currentRowInGroup_ = range.second;
+        columnReader_->setReadOffset(currentRowInGroup_);
+      }
+      ++nextSkippedRowRange_;
+    }
+  }
+
   memory::MemoryPool& pool_;
   const std::shared_ptr<ReaderBase> readerBase_;
   const dwio::common::RowReaderOptions options_;
@@ -1220,6 +1549,15 @@ class ParquetRowReader::Impl {
   uint64_t rowsInCurrentRowGroup_;
   uint64_t currentRowInGroup_;
   uint32_t skippedStrides_{0};
+  // Number of leading entries of 'rowGroupIds_' whose bloom filters have been
+  // checked by filterRowGroupsByBloomFilters().
+  uint32_t numBloomFilterCheckedRowGroups_{0};
+  // Sorted and disjoint [begin, end) ranges of rows in the current row group
+  // that are skipped based on the page index.
+  std::vector<std::pair<uint64_t, uint64_t>> skippedRowRanges_;
+  size_t nextSkippedRowRange_{0};
+  uint64_t skippedPages_{0};
+  uint64_t skippedPageRows_{0};
 
   std::unique_ptr<dwio::common::SelectiveColumnReader> columnReader_;
 
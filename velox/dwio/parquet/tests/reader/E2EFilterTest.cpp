@@ -149,6 +149,23 @@ TEST_F(E2EFilterTest, integerDeltaBinaryPack) {
       20);
 }
 
+TEST_F(E2EFilterTest, integerByteStreamSplit) {
+  options_.enableDictionary = false;
+  options_.dataPageSize = 4 * 1024;
+  options_.encoding =
+      facebook::velox::parquet::arrow::Encoding::BYTE_STREAM_SPLIT;
+
+  testWithTypes(
+      "short_val:smallint,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "long_null:bigint",
+      [&]() { makeAllNulls("long_null"); },
+      true,
+      {"short_val", "int_val", "long_val"},
+      20);
+}
+
 TEST_F(E2EFilterTest, compression) {
   for (const auto compression :
        {common::CompressionKind_SNAPPY,
@@ -331,6 +348,28 @@ TEST_F(E2EFilterTest, floatAndDoubleDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, floatAndDoubleByteStreamSplit) {
+  options_.enableDictionary = false;
+  options_.dataPageSize = 4 * 1024;
+  options_.encoding =
+      facebook::velox::parquet::arrow::Encoding::BYTE_STREAM_SPLIT;
+
+  testWithTypes(
+      "float_val:float,"
+      "double_val:double,"
+      "float_val2:float,"
+      "double_val2:double,"
+      "float_null:float",
+      [&]() {
+        makeAllNulls("float_null");
+        makeQuantizedFloat<float>("float_val2", 200, true);
+        makeQuantizedFloat<double>("double_val2", 522, true);
+      },
+      true,
+      {"float_val", "double_val", "float_val2", "double_val2", "float_null"},
+      20);
+}
+
 TEST_F(E2EFilterTest, floatAndDouble) {
   // float_val and double_val may be direct since the
   // values are random.float_val2 and double_val2 are expected to be
@@ -539,6 +578,23 @@ TEST_F(E2EFilterTest, stringDeltaByteArray) {
       20);
 }
 
+TEST_F(E2EFilterTest, stringDeltaLengthByteArray) {
+  options_.enableDictionary = false;
+  options_.encoding =
+      facebook::velox::parquet::arrow::Encoding::DELTA_LENGTH_BYTE_ARRAY;
+
+  testWithTypes(
+      "string_val:string,"
+      "string_val_2:string",
+      [&]() {
+        makeStringUnique("string_val");
+        makeStringUnique("string_val_2");
+      },
+      true,
+      {"string_val", "string_val_2"},
+      20);
+}
+
 TEST_F(E2EFilterTest, dedictionarize) {
   rowsInRowGroup_ = 10'000;
   options_.dictionaryPageSizeLimit = 20'000;
@@ -690,6 +690,228 @@ TEST_F(ParquetWriterTest, toggleDataPageVersion) {
       thrift::PageType::type::DATA_PAGE_V2);
 }
 
+TEST_F(ParquetWriterTest, pageIndex) {
+  const auto schema = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  constexpr int64_t kRows = 10'000;
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(kRows, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          kRows, [](auto row) { return fmt::format("str_{}", row % 100); }),
+  });
+
+  // Write 'data' with small pages, then read it back with the filter
+  // 'c0 BETWEEN 5'000 AND 5'099' and return the runtime stats of the reader.
+  const auto writeAndFilter = [&](bool enablePageIndex) {
+    auto sink = std::make_unique<MemorySink>(
+        200 * 1024 * 1024,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto sinkPtr = sink.get();
+    parquet::WriterOptions writerOptions;
+    writerOptions.memoryPool = leafPool_.get();
+    writerOptions.dataPageSize = 1'024;
+    writerOptions.batchSize = 100;
+    writerOptions.enablePageIndex = enablePageIndex;
+    auto writer = std::make_unique<parquet::Writer>(
+        std::move(sink), writerOptions, rootPool_, schema);
+    writer->write(data);
+    writer->close();
+
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+    auto scanSpec = makeScanSpec(schema);
+    scanSpec->childByName("c0")->setFilter(
+        std::make_unique<common::BigintRange>(5'000, 5'099, false));
+    auto rowReaderOpts = getReaderOpts(schema);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+
+    const auto expected = makeRowVector({
+        makeFlatVector<int64_t>(100, [](auto row) { return row + 5'000; }),
+        makeFlatVector<std::string>(
+            100, [](auto row) { return fmt::format("str_{}", row); }),
+    });
+    assertReadWithReaderAndExpected(schema, *rowReader, expected, *leafPool_);
+
+    dwio::common::RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    return stats;
+  };
+
+  auto stats = writeAndFilter(false);
+  EXPECT_EQ(stats.skippedPages, 0);
+  EXPECT_EQ(stats.skippedPageRows, 0);
+
+  stats = writeAndFilter(true);
+  EXPECT_GT(stats.skippedPages, 0);
+  // Only the pages overlapping the filter range are read.
+  EXPECT_GT(stats.skippedPageRows, kRows / 2);
+  EXPECT_LT(stats.skippedPageRows, kRows - 100);
+}
+
+TEST_F(ParquetWriterTest, pageIndexWithNestedColumnFilter) {
+  const auto schema = ROW({"c0", "c1"}, {BIGINT(), ROW({"a"}, {BIGINT()})});
+  constexpr int64_t kRows = 10'000;
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(kRows, [](auto row) { return row; }),
+      makeRowVector(
+          {"a"},
+          {makeFlatVector<int64_t>(kRows, [](auto row) { return row * 2; })}),
+  });
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto sinkPtr = sink.get();
+  parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  writerOptions.dataPageSize = 1'024;
+  writerOptions.batchSize = 100;
+  writerOptions.enablePageIndex = true;
+  auto writer = std::make_unique<parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, schema);
+  writer->write(data);
+  writer->close();
+
+  // The filter on the struct column 'c1' has no page index and must not
+  // prevent the pages of 'c0' from being skipped.
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+  auto scanSpec = makeScanSpec(schema);
+  scanSpec->childByName("c0")->setFilter(
+      std::make_unique<common::BigintRange>(5'000, 5'099, false));
+  scanSpec->childByName("c1")->setFilter(std::make_unique<common::IsNotNull>());
+  auto rowReaderOpts = getReaderOpts(schema);
+  rowReaderOpts.setScanSpec(scanSpec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+
+  const auto expected = makeRowVector({
+      makeFlatVector<int64_t>(100, [](auto row) { return row + 5'000; }),
+      makeRowVector(
+          {"a"},
+          {makeFlatVector<int64_t>(
+              100, [](auto row) { return (row + 5'000) * 2; })}),
+  });
+  assertReadWithReaderAndExpected(schema, *rowReader, expected, *leafPool_);
+
+  dwio::common::RuntimeStatistics stats;
+  rowReader->updateRuntimeStats(stats);
+  EXPECT_GT(stats.skippedPages, 0);
+}
+
+TEST_F(ParquetWriterTest, bloomFilter) {
+  const auto schema = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  constexpr int64_t kRows = 4'000;
+  constexpr int64_t kRowsInRowGroup = 1'000;
+  // Even values only, so odd values are within the min/max of a row group but
+  // not in it.
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(kRows, [](auto row) { return row * 2; }),
+      makeFlatVector<std::string>(
+          kRows, [](auto row) { return fmt::format("str_{}", row); }),
+  });
+
+  // Write 'data' in row groups of 'kRowsInRowGroup' rows, then read it back
+  // with the filter 'c0 IN (1'001, 2'000, 5'001)' and return the runtime stats
+  // of the reader.
+  const auto writeAndFilter = [&](bool enableBloomFilter) {
+    auto sink = std::make_unique<MemorySink>(
+        200 * 1024 * 1024,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto sinkPtr = sink.get();
+    parquet::WriterOptions writerOptions;
+    writerOptions.memoryPool = leafPool_.get();
+    writerOptions.flushPolicyFactory = []() {
+      return std::make_unique<DefaultFlushPolicy>(
+          kRowsInRowGroup, 1024 * 1024 * 1024);
+    };
+    if (enableBloomFilter) {
+      writerOptions.bloomFilterColumns["c0"] = {.ndv = 1'000, .fpp = 0.01};
+    }
+    auto writer = std::make_unique<parquet::Writer>(
+        std::move(sink), writerOptions, rootPool_, schema);
+    writer->write(data);
+    writer->close();
+
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+    EXPECT_EQ(reader->fileMetaData().numRowGroups(), kRows / kRowsInRowGroup);
+    auto scanSpec = makeScanSpec(schema);
+    scanSpec->childByName("c0")->setFilter(
+        common::createBigintValues({1'001, 2'000, 5'001}, false));
+    auto rowReaderOpts = getReaderOpts(schema);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+
+    const auto expected = makeRowVector({
+        makeFlatVector<int64_t>({2'000}),
+        makeFlatVector<std::string>({"str_1000"}),
+    });
+    assertReadWithReaderAndExpected(schema, *rowReader, expected, *leafPool_);
+
+    dwio::common::RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    return stats;
+  };
+
+  // Only the last row group is outside the min/max of the filter.
+  auto stats = writeAndFilter(false);
+  EXPECT_EQ(stats.skippedStrides, 1);
+
+  // The bloom filters also skip the first and third row groups.
+  stats = writeAndFilter(true);
+  EXPECT_EQ(stats.skippedStrides, 3);
+}
+
+TEST_F(ParquetWriterTest, bloomFilterWithNestedColumnFilter) {
+  const auto schema = ROW({"c0", "c1"}, {BIGINT(), ROW({"a"}, {BIGINT()})});
+  constexpr int64_t kRows = 4'000;
+  constexpr int64_t kRowsInRowGroup = 1'000;
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(kRows, [](auto row) { return row * 2; }),
+      makeRowVector(
+          {"a"},
+          {makeFlatVector<int64_t>(kRows, [](auto row) { return row; })}),
+  });
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto sinkPtr = sink.get();
+  parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  writerOptions.flushPolicyFactory = []() {
+    return std::make_unique<DefaultFlushPolicy>(
+        kRowsInRowGroup, 1024 * 1024 * 1024);
+  };
+  writerOptions.bloomFilterColumns["c0"] = {.ndv = 1'000, .fpp = 0.01};
+  auto writer = std::make_unique<parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, schema);
+  writer->write(data);
+  writer->close();
+
+  // The filter on the struct column 'c1' is not evaluated with bloom filters
+  // and does not prevent the bloom filters of 'c0' from skipping row groups.
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+  auto scanSpec = makeScanSpec(schema);
+  scanSpec->childByName("c0")->setFilter(
+      common::createBigintValues({1'001, 2'000, 5'001}, false));
+  scanSpec->childByName("c1")->setFilter(std::make_unique<common::IsNotNull>());
+  auto rowReaderOpts = getReaderOpts(schema);
+  rowReaderOpts.setScanSpec(scanSpec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+
+  const auto expected = makeRowVector({
+      makeFlatVector<int64_t>({2'000}),
+      makeRowVector({"a"}, {makeFlatVector<int64_t>({1'000})}),
+  });
+  assertReadWithReaderAndExpected(schema, *rowReader, expected, *leafPool_);
+
+  dwio::common::RuntimeStatistics stats;
+  rowReader->updateRuntimeStats(stats);
+  EXPECT_EQ(stats.skippedStrides, 3);
+}
+
 DEBUG_ONLY_TEST_F(ParquetWriterTest, unitFromWriterOptions) {
   SCOPED_TESTVALUE_SET(
       "facebook::velox::parquet::Writer::write",
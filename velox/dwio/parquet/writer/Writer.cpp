@@ -128,7 +128,8 @@ namespace {
 
 std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
     const parquet::WriterOptions& options,
-    const std::unique_ptr<DefaultFlushPolicy>& flushPolicy) {
+    const std::unique_ptr<DefaultFlushPolicy>& flushPolicy,
+    memory::MemoryPool* pool) {
   auto builder = WriterProperties::Builder();
   WriterProperties::Builder* properties = &builder;
   if (options.enableDictionary.value_or(
@@ -164,6 +165,13 @@ std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
     properties =
         properties->data_page_version(arrow::ParquetDataPageVersion::V1);
   }
+  if (options.enablePageIndex.value_or(false)) {
+    properties = properties->enable_write_page_index();
+  }
+  for (const auto& [path, bloomFilterOptions] : options.bloomFilterColumns) {
+    properties = properties->enable_bloom_filter(path, bloomFilterOptions);
+  }
+  properties = properties->bloom_filter_pool(pool);
   return properties->build();
 }
 
@@ -335,7 +343,7 @@ Writer::Writer(
   common::testutil::TestValue::adjust(
       "facebook::velox::parquet::Writer::Writer", &options_);
   arrowContext_->properties =
-      getArrowParquetWriterOptions(options, flushPolicy_);
+      getArrowParquetWriterOptions(options, flushPolicy_, generalPool_.get());
   setMemoryReclaimers();
   writeInt96AsTimestamp_ = options.writeInt96AsTimestamp;
 }
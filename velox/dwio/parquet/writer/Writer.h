@@ -24,6 +24,7 @@
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/Writer.h"
 #include "velox/dwio/common/WriterFactory.h"
+#include "velox/dwio/parquet/writer/arrow/Properties.h"
 #include "velox/dwio/parquet/writer/arrow/Types.h"
 #include "velox/dwio/parquet/writer/arrow/util/Compression.h"
 #include "velox/vector/ComplexVector.h"
@@ -98,6 +99,11 @@ struct WriterOptions : public dwio::common::WriterOptions {
   std::shared_ptr<CodecOptions> codecOptions;
   std::unordered_map<std::string, common::CompressionKind>
       columnCompressionsMap;
+  /// Columns, by dot separated path, for which a split block bloom filter is
+  /// written per column chunk. Readers use them to skip row groups that cannot
+  /// contain the values of an equality or IN filter.
+  std::unordered_map<std::string, arrow::BloomFilterOptions>
+      bloomFilterColumns;
 
   /// Timestamp unit for Parquet write through Arrow bridge.
   /// Default if not specified: TimestampPrecision::kNanoseconds (9).
@@ -111,6 +117,9 @@ struct WriterOptions : public dwio::common::WriterOptions {
   std::optional<int64_t> dictionaryPageSizeLimit;
   std::optional<bool> enableDictionary;
   std::optional<bool> useParquetDataPageV2;
+  /// Writes the ColumnIndex and OffsetIndex of each column chunk so that
+  /// readers can skip data pages whose statistics do not match a filter.
+  std::optional<bool> enablePageIndex;
 
   // Parsing session and hive configs.
 
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Adapted from Apache Arrow.
+
+#include "velox/dwio/parquet/writer/arrow/BloomFilterBuilder.h"
+
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "velox/dwio/parquet/common/BloomFilter.h"
+#include "velox/dwio/parquet/writer/arrow/Exception.h"
+#include "velox/dwio/parquet/writer/arrow/Metadata.h"
+#include "velox/dwio/parquet/writer/arrow/Properties.h"
+#include "velox/dwio/parquet/writer/arrow/Schema.h"
+
+namespace facebook::velox::parquet::arrow {
+
+namespace {
+
+using facebook::velox::parquet::BlockSplitBloomFilter;
+
+/// Physical types whose values are hashed into the bloom filter. These are
+/// the types whose bloom filters the Velox Parquet reader uses.
+bool supportsBloomFilter(Type::type type) {
+  switch (type) {
+    case Type::INT32:
+    case Type::INT64:
+    case Type::BYTE_ARRAY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+class BloomFilterBuilderImpl final : public BloomFilterBuilder {
+ public:
+  BloomFilterBuilderImpl(
+      const SchemaDescriptor* schema,
+      const WriterProperties* properties)
+      : schema_(schema), properties_(properties) {}
+
+  void AppendRowGroup() override {
+    if (finished_) {
+      throw ParquetException(
+          "Cannot call AppendRowGroup() to finished BloomFilterBuilder.");
+    }
+    bloom_filters_.emplace_back();
+    bloom_filters_.back().resize(schema_->num_columns());
+  }
+
+  facebook::velox::parquet::BloomFilter* GetOrCreateBloomFilter(
+      int32_t i) override {
+    if (finished_) {
+      throw ParquetException("BloomFilterBuilder is already finished.");
+    }
+    if (i < 0 || i >= schema_->num_columns()) {
+      throw ParquetException("Invalid column ordinal: ", i);
+    }
+    if (bloom_filters_.empty()) {
+      throw ParquetException("No row group appended to BloomFilterBuilder.");
+    }
+    const auto* descr = schema_->Column(i);
+    const auto& options = properties_->bloom_filter_options(descr->path());
+    if (!options.has_value() || !supportsBloomFilter(descr->physical_type())) {
+      return nullptr;
+    }
+    auto& bloom_filter = bloom_filters_.back()[i];
+    if (bloom_filter == nullptr) {
+      if (properties_->bloom_filter_pool() == nullptr) {
+        throw ParquetException("No memory pool set for bloom filters.");
+      }
+      bloom_filter = std::make_unique<BlockSplitBloomFilter>(
+          properties_->bloom_filter_pool());
+      bloom_filter->init(BlockSplitBloomFilter::optimalNumOfBytes(
+          options->ndv, options->fpp));
+    }
+    return bloom_filter.get();
+  }
+
+  void WriteTo(::arrow::io::OutputStream* sink, BloomFilterLocation* location)
+      override {
+    const auto num_columns = static_cast<size_t>(schema_->num_columns());
+    for (size_t row_group = num_written_row_groups_;
+         row_group < bloom_filters_.size();
+         ++row_group) {
+      auto& row_group_bloom_filters = bloom_filters_[row_group];
+      bool has_bloom_filter = false;
+      std::vector<std::optional<IndexLocation>> locations(
+          num_columns, std::nullopt);
+      for (size_t column = 0; column < num_columns; ++column) {
+        const auto& bloom_filter = row_group_bloom_filters[column];
+        if (bloom_filter == nullptr) {
+          continue;
+        }
+        PARQUET_ASSIGN_OR_THROW(int64_t pos_before_write, sink->Tell());
+        bloom_filter->serialize([&](const char* data, size_t size) {
+          PARQUET_THROW_NOT_OK(sink->Write(data, size));
+        });
+        PARQUET_ASSIGN_OR_THROW(int64_t pos_after_write, sink->Tell());
+        const int64_t len = pos_after_write - pos_before_write;
+        if (len > std::numeric_limits<int32_t>::max()) {
+          throw ParquetException("Bloom filter size overflows to INT32_MAX");
+        }
+        locations[column] = {pos_before_write, static_cast<int32_t>(len)};
+        has_bloom_filter = true;
+      }
+      if (has_bloom_filter) {
+        location->bloom_filter_location.emplace(
+            row_group, std::move(locations));
+      }
+      // The bitsets are no longer needed once they are written.
+      row_group_bloom_filters.clear();
+    }
+    num_written_row_groups_ = bloom_filters_.size();
+  }
+
+  void Finish() override {
+    finished_ = true;
+  }
+
+ private:
+  const SchemaDescriptor* schema_;
+  const WriterProperties* properties_;
+  // Bloom filters indexed by row group ordinal and then column ordinal.
+  std::vector<std::vector<std::unique_ptr<BlockSplitBloomFilter>>>
+      bloom_filters_;
+  // Number of leading row groups in 'bloom_filters_' already written.
+  size_t num_written_row_groups_ = 0;
+  bool finished_ = false;
+};
+
+} // namespace
+
+std::unique_ptr<BloomFilterBuilder> BloomFilterBuilder::Make(
+    const SchemaDescriptor* schema,
+    const WriterProperties* properties) {
+  return std::make_unique<BloomFilterBuilderImpl>(schema, properties);
+}
+
+} // namespace facebook::velox::parquet::arrow
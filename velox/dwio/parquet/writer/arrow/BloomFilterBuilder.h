@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Adapted from Apache Arrow.
+
+#pragma once
+
+#include "arrow/io/interfaces.h"
+#include "velox/dwio/parquet/writer/arrow/Platform.h"
+
+#include <memory>
+
+namespace facebook::velox::parquet {
+class BloomFilter;
+} // namespace facebook::velox::parquet
+
+namespace facebook::velox::parquet::arrow {
+
+struct BloomFilterLocation;
+class SchemaDescriptor;
+class WriterProperties;
+
+/// \brief Interface for collecting the bloom filters of a parquet file.
+///
+/// A bloom filter is created for each column chunk whose column has
+/// BloomFilterOptions in the WriterProperties. The bloom filters of a row
+/// group are written right after the row group is closed, so that only the
+/// bitsets of the row group being written are kept in memory. The bitsets are
+/// allocated from WriterProperties::bloom_filter_pool().
+class PARQUET_EXPORT BloomFilterBuilder {
+ public:
+  /// \brief API convenience to create a BloomFilterBuilder.
+  static std::unique_ptr<BloomFilterBuilder> Make(
+      const SchemaDescriptor* schema,
+      const WriterProperties* properties);
+
+  virtual ~BloomFilterBuilder() = default;
+
+  /// \brief Start a new row group.
+  virtual void AppendRowGroup() = 0;
+
+  /// \brief Get the bloom filter of the column chunk in the current row group.
+  ///
+  /// \param i Column ordinal.
+  /// \return BloomFilter for the column chunk, or nullptr if the column does
+  /// not have a bloom filter. Its memory ownership belongs to the
+  /// BloomFilterBuilder.
+  virtual facebook::velox::parquet::BloomFilter* GetOrCreateBloomFilter(
+      int32_t i) = 0;
+
+  /// \brief Serialize the bloom filters of the row groups appended since the
+  /// last call and add their locations to 'location'. The serialized bloom
+  /// filters are released.
+  ///
+  /// \param[out] sink The output stream to write the bloom filters.
+  /// \param[out] location The location of the bloom filters to the start of
+  /// sink.
+  virtual void WriteTo(
+      ::arrow::io::OutputStream* sink,
+      BloomFilterLocation* location) = 0;
+
+  /// \brief Complete the bloom filter builder and no more write is allowed.
+  virtual void Finish() = 0;
+};
+
+} // namespace facebook::velox::parquet::arrow
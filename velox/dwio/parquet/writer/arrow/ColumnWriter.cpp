@@ -20,10 +20,12 @@
 
 #include <glog/logging.h>
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <cstring>
 #include <map>
 #include <memory>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -34,6 +36,7 @@
 #include "arrow/status.h"
 #include "arrow/type.h"
 #include "arrow/type_traits.h"
+#include "arrow/util/bit_run_reader.h"
 #include "arrow/util/bit_util.h"
 #include "arrow/util/bitmap_ops.h"
 #include "arrow/util/checked_cast.h"
@@ -41,6 +44,7 @@
 #include "arrow/util/type_traits.h"
 
 #include "velox/common/base/Exceptions.h"
+#include "velox/dwio/parquet/common/BloomFilter.h"
 #include "velox/dwio/parquet/common/LevelConversion.h"
 #include "velox/dwio/parquet/writer/arrow/ColumnPage.h"
 #include "velox/dwio/parquet/writer/arrow/Encoding.h"
@@ -1465,13 +1469,15 @@ class TypedColumnWriterImpl : public ColumnWriterImpl,
       std::unique_ptr<PageWriter> pager,
       const bool use_dictionary,
       Encoding::type encoding,
-      const WriterProperties* properties)
+      const WriterProperties* properties,
+      facebook::velox::parquet::BloomFilter* bloom_filter = nullptr)
       : ColumnWriterImpl(
             metadata,
             std::move(pager),
             use_dictionary,
             encoding,
-            properties) {
+            properties),
+        bloom_filter_(bloom_filter) {
     current_encoder_ = MakeEncoder(
         DType::type_num,
         encoding,
@@ -1756,6 +1762,9 @@ class TypedColumnWriterImpl : public ColumnWriterImpl,
   std::shared_ptr<TypedStats> page_statistics_;
   std::shared_ptr<TypedStats> chunk_statistics_;
   bool pages_change_on_record_boundaries_;
+  // Bloom filter of the column chunk or nullptr if not enabled for the column.
+  // Owned by the BloomFilterBuilder of the file writer.
+  facebook::velox::parquet::BloomFilter* bloom_filter_;
 
   // If writing a sequence of ::arrow::DictionaryArray to the writer, we keep
   // the dictionary passed to DictEncoder<T>::PutDictionary so we can check
@@ -1957,6 +1966,9 @@ class TypedColumnWriterImpl : public ColumnWriterImpl,
     if (page_statistics_ != nullptr) {
       page_statistics_->Update(values, num_values, num_nulls);
     }
+    if (bloom_filter_ != nullptr) {
+      UpdateBloomFilter(values, num_values);
+    }
   }
 
   /// \brief Write values with spaces and update page statistics accordingly.
@@ -2002,6 +2014,57 @@ class TypedColumnWriterImpl : public ColumnWriterImpl,
           num_values,
           num_nulls);
     }
+    if (bloom_filter_ != nullptr) {
+      if (num_values != num_spaced_values) {
+        ::arrow::internal::VisitSetBitRunsVoid(
+            valid_bits,
+            valid_bits_offset,
+            num_spaced_values,
+            [&](int64_t position, int64_t length) {
+              UpdateBloomFilter(values + position, length);
+            });
+      } else {
+        UpdateBloomFilter(values, num_values);
+      }
+    }
+  }
+
+  /// Inserts the hashes of 'num_values' non-null values into the bloom filter.
+  /// Types without bloom filter support never have 'bloom_filter_' set.
+  void UpdateBloomFilter(const T* values, int64_t num_values) {
+    if constexpr (std::is_same_v<DType, ByteArrayType>) {
+      for (int64_t i = 0; i < num_values; ++i) {
+        const facebook::velox::parquet::ByteArray value(
+            values[i].len, values[i].ptr);
+        bloom_filter_->insertHash(bloom_filter_->hash(&value));
+      }
+    } else if constexpr (
+        std::is_same_v<DType, Int32Type> || std::is_same_v<DType, Int64Type> ||
+        std::is_same_v<DType, FloatType> ||
+        std::is_same_v<DType, DoubleType>) {
+      constexpr int64_t kHashBatchSize = 256;
+      std::array<uint64_t, kHashBatchSize> hashes;
+      for (int64_t i = 0; i < num_values; i += kHashBatchSize) {
+        const auto batch_size =
+            static_cast<int>(std::min(kHashBatchSize, num_values - i));
+        bloom_filter_->hashes(values + i, batch_size, hashes.data());
+        bloom_filter_->insertHashes(hashes.data(), batch_size);
+      }
+    }
+  }
+
+  /// Inserts the non-null values of a binary or string 'array' into the bloom
+  /// filter.
+  template <typename ArrayType>
+  void UpdateBloomFilterBinary(const ::arrow::Array& array) {
+    const auto& binary_array = checked_cast<const ArrayType&>(array);
+    for (int64_t i = 0; i < binary_array.length(); ++i) {
+      if (binary_array.IsValid(i)) {
+        const facebook::velox::parquet::ByteArray value(
+            binary_array.GetView(i));
+        bloom_filter_->insertHash(bloom_filter_->hash(&value));
+      }
+    }
   }
 };
 
@@ -2041,8 +2104,9 @@ Status TypedColumnWriterImpl<DType>::WriteArrowDictionary(
         maybe_parent_nulls);
   };
 
+  // The bloom filter is only populated on the dense write path.
   if (!IsDictionaryEncoding(current_encoder_->encoding()) ||
-      !DictionaryDirectWriteSupported(array)) {
+      !DictionaryDirectWriteSupported(array) || bloom_filter_ != nullptr) {
     // No longer dictionary-encoding for whatever reason, maybe we never were
     // or we decided to stop. Note that WriteArrow can be invoked multiple
     // times with both dense and dictionary-encoded versions of the same data
@@ -2729,6 +2793,13 @@ Status TypedColumnWriterImpl<ByteArrayType>::WriteArrowDense(
         MaybeReplaceValidity(data_slice, null_count, ctx->memory_pool));
 
     current_encoder_->Put(*data_slice);
+    if (bloom_filter_ != nullptr) {
+      if (::arrow::is_large_binary_like(data_slice->type_id())) {
+        UpdateBloomFilterBinary<::arrow::LargeBinaryArray>(*data_slice);
+      } else {
+        UpdateBloomFilterBinary<::arrow::BinaryArray>(*data_slice);
+      }
+    }
     // Null values in ancestors count as nulls.
     const int64_t non_null = data_slice->length() - data_slice->null_count();
     if (page_statistics_ != nullptr) {
@@ -2886,7 +2957,8 @@ Status TypedColumnWriterImpl<FLBAType>::WriteArrowDense(
 std::shared_ptr<ColumnWriter> ColumnWriter::Make(
     ColumnChunkMetaDataBuilder* metadata,
     std::unique_ptr<PageWriter> pager,
-    const WriterProperties* properties) {
+    const WriterProperties* properties,
+    facebook::velox::parquet::BloomFilter* bloom_filter) {
   const ColumnDescriptor* descr = metadata->descr();
   const bool use_dictionary = properties->dictionary_enabled(descr->path()) &&
       descr->physical_type() != Type::BOOLEAN;
@@ -2911,22 +2983,47 @@ std::shared_ptr<ColumnWriter> ColumnWriter::Make(
           metadata, std::move(pager), use_dictionary, encoding, properties);
     case Type::INT32:
       return std::make_shared<TypedColumnWriterImpl<Int32Type>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::INT64:
       return std::make_shared<TypedColumnWriterImpl<Int64Type>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::INT96:
       return std::make_shared<TypedColumnWriterImpl<Int96Type>>(
           metadata, std::move(pager), use_dictionary, encoding, properties);
     case Type::FLOAT:
       return std::make_shared<TypedColumnWriterImpl<FloatType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::DOUBLE:
       return std::make_shared<TypedColumnWriterImpl<DoubleType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::BYTE_ARRAY:
       return std::make_shared<TypedColumnWriterImpl<ByteArrayType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::FIXED_LEN_BYTE_ARRAY:
       return std::make_shared<TypedColumnWriterImpl<FLBAType>>(
           metadata, std::move(pager), use_dictionary, encoding, properties);
@@ -34,6 +34,7 @@ class Array;
 
 namespace facebook::velox::parquet {
 class BitWriter;
+class BloomFilter;
 class RleEncoder;
 } // namespace facebook::velox::parquet
 
@@ -159,10 +160,13 @@ class PARQUET_EXPORT ColumnWriter {
  public:
   virtual ~ColumnWriter() = default;
 
+  /// \param bloom_filter The bloom filter of the column chunk to populate with
+  /// the written values, or nullptr. Not owned.
   static std::shared_ptr<ColumnWriter> Make(
       ColumnChunkMetaDataBuilder*,
       std::unique_ptr<PageWriter>,
-      const WriterProperties* properties);
+      const WriterProperties* properties,
+      facebook::velox::parquet::BloomFilter* bloom_filter = nullptr);
 
   /// \brief Closes the ColumnWriter, commits any buffered values to pages.
   /// \return Total size of the column in bytes
@@ -986,6 +986,16 @@ void ByteStreamSplitEncoder<DoubleType>::Put(const ::arrow::Array& values) {
   PutImpl<::arrow::DoubleType>(values);
 }
 
+template <>
+void ByteStreamSplitEncoder<Int32Type>::Put(const ::arrow::Array& values) {
+  PutImpl<::arrow::Int32Type>(values);
+}
+
+template <>
+void ByteStreamSplitEncoder<Int64Type>::Put(const ::arrow::Array& values) {
+  PutImpl<::arrow::Int64Type>(values);
+}
+
 template <typename DType>
 void ByteStreamSplitEncoder<DType>::PutSpaced(
     const T* src,
@@ -4177,6 +4187,10 @@ std::unique_ptr<Encoder> MakeEncoder(
     }
   } else if (encoding == Encoding::BYTE_STREAM_SPLIT) {
     switch (type_num) {
+      case Type::INT32:
+        return std::make_unique<ByteStreamSplitEncoder<Int32Type>>(descr, pool);
+      case Type::INT64:
+        return std::make_unique<ByteStreamSplitEncoder<Int64Type>>(descr, pool);
       case Type::FLOAT:
         return std::make_unique<ByteStreamSplitEncoder<FloatType>>(descr, pool);
       case Type::DOUBLE:
@@ -4184,7 +4198,7 @@ std::unique_ptr<Encoder> MakeEncoder(
             descr, pool);
       default:
         throw ParquetException(
-            "BYTE_STREAM_SPLIT only supports FLOAT and DOUBLE");
+            "BYTE_STREAM_SPLIT only supports INT32, INT64, FLOAT and DOUBLE");
     }
   } else if (encoding == Encoding::DELTA_BINARY_PACKED) {
     switch (type_num) {
@@ -27,6 +27,7 @@
 #include "arrow/util/key_value_metadata.h"
 
 #include "velox/common/base/Exceptions.h"
+#include "velox/dwio/parquet/writer/arrow/BloomFilterBuilder.h"
 #include "velox/dwio/parquet/writer/arrow/ColumnWriter.h"
 #include "velox/dwio/parquet/writer/arrow/EncryptionInternal.h"
 #include "velox/dwio/parquet/writer/arrow/Exception.h"
@@ -109,7 +110,8 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
       const WriterProperties* properties,
       bool buffered_row_group = false,
       InternalFileEncryptor* file_encryptor = nullptr,
-      PageIndexBuilder* page_index_builder = nullptr)
+      PageIndexBuilder* page_index_builder = nullptr,
+      BloomFilterBuilder* bloom_filter_builder = nullptr)
       : sink_(std::move(sink)),
         metadata_(metadata),
         properties_(properties),
@@ -121,7 +123,8 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
         num_rows_(0),
         buffered_row_group_(buffered_row_group),
         file_encryptor_(file_encryptor),
-        page_index_builder_(page_index_builder) {
+        page_index_builder_(page_index_builder),
+        bloom_filter_builder_(bloom_filter_builder) {
     if (buffered_row_group) {
       InitColumns();
     } else {
@@ -211,8 +214,11 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
           oi_builder,
           *codec_options);
     }
-    column_writers_[0] =
-        ColumnWriter::Make(col_meta, std::move(pager), properties_);
+    auto bloom_filter = bloom_filter_builder_
+        ? bloom_filter_builder_->GetOrCreateBloomFilter(column_ordinal)
+        : nullptr;
+    column_writers_[0] = ColumnWriter::Make(
+        col_meta, std::move(pager), properties_, bloom_filter);
     return column_writers_[0].get();
   }
 
@@ -307,6 +313,7 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
   bool buffered_row_group_;
   InternalFileEncryptor* file_encryptor_;
   PageIndexBuilder* page_index_builder_;
+  BloomFilterBuilder* bloom_filter_builder_;
 
   void CheckRowsWritten() const {
     // verify when only one column is written at a time
@@ -391,8 +398,11 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
             oi_builder,
             *codec_options);
       }
-      column_writers_.push_back(
-          ColumnWriter::Make(col_meta, std::move(pager), properties_));
+      auto bloom_filter = bloom_filter_builder_
+          ? bloom_filter_builder_->GetOrCreateBloomFilter(column_ordinal)
+          : nullptr;
+      column_writers_.push_back(ColumnWriter::Make(
+          col_meta, std::move(pager), properties_, bloom_filter));
     }
   }
 
@@ -432,6 +442,7 @@ class FileSerializer : public ParquetFileWriter::Contents {
       }
       row_group_writer_.reset();
 
+      WriteBloomFilter();
       WritePageIndex();
 
       // Write magic bytes and metadata
@@ -466,12 +477,16 @@ class FileSerializer : public ParquetFileWriter::Contents {
   RowGroupWriter* AppendRowGroup(bool buffered_row_group) {
     if (row_group_writer_) {
       row_group_writer_->Close();
+      WriteRowGroupBloomFilters();
     }
     num_row_groups_++;
     auto rg_metadata = metadata_->AppendRowGroup();
     if (page_index_builder_) {
       page_index_builder_->AppendRowGroup();
     }
+    if (bloom_filter_builder_) {
+      bloom_filter_builder_->AppendRowGroup();
+    }
     std::unique_ptr<RowGroupWriter::Contents> contents(new RowGroupSerializer(
         sink_,
         rg_metadata,
@@ -479,7 +494,8 @@ class FileSerializer : public ParquetFileWriter::Contents {
         properties_.get(),
         buffered_row_group,
         file_encryptor_.get(),
-        page_index_builder_.get()));
+        page_index_builder_.get(),
+        bloom_filter_builder_.get()));
     row_group_writer_ = std::make_unique<RowGroupWriter>(std::move(contents));
     return row_group_writer_.get();
   }
@@ -564,6 +580,23 @@ class FileSerializer : public ParquetFileWriter::Contents {
     }
   }
 
+  // Writes the bloom filters of the row groups closed so far right after their
+  // column chunks, so that their bitsets need not be kept until the file is
+  // closed.
+  void WriteRowGroupBloomFilters() {
+    if (bloom_filter_builder_ != nullptr) {
+      bloom_filter_builder_->WriteTo(sink_.get(), &bloom_filter_location_);
+    }
+  }
+
+  void WriteBloomFilter() {
+    if (bloom_filter_builder_ != nullptr) {
+      WriteRowGroupBloomFilters();
+      bloom_filter_builder_->Finish();
+      metadata_->SetBloomFilterLocation(bloom_filter_location_);
+    }
+  }
+
   void WritePageIndex() {
     if (page_index_builder_ != nullptr) {
       if (properties_->file_encryption_properties()) {
@@ -588,6 +621,9 @@ class FileSerializer : public ParquetFileWriter::Contents {
   // Only one of the row group writers is active at a time
   std::unique_ptr<RowGroupWriter> row_group_writer_;
   std::unique_ptr<PageIndexBuilder> page_index_builder_;
+  std::unique_ptr<BloomFilterBuilder> bloom_filter_builder_;
+  // Locations of the bloom filters written so far.
+  BloomFilterLocation bloom_filter_location_;
   std::unique_ptr<InternalFileEncryptor> file_encryptor_;
 
   void StartFile() {
@@ -632,6 +668,13 @@ class FileSerializer : public ParquetFileWriter::Contents {
     if (properties_->page_index_enabled()) {
       page_index_builder_ = PageIndexBuilder::Make(&schema_);
     }
+    if (properties_->bloom_filter_enabled()) {
+      if (properties_->file_encryption_properties()) {
+        throw ParquetException("Encryption is not supported with bloom filter");
+      }
+      bloom_filter_builder_ =
+          BloomFilterBuilder::Make(&schema_, properties_.get());
+    }
   }
 };
 
@@ -2171,6 +2171,25 @@ class FileMetaDataBuilder::FileMetaDataBuilderImpl {
     }
   }
 
+  void SetBloomFilterLocation(const BloomFilterLocation& location) {
+    for (const auto& [row_group_ordinal, row_group_location] :
+         location.bloom_filter_location) {
+      auto& row_group_metadata = row_groups_.at(row_group_ordinal);
+      for (size_t i = 0; i < row_group_location.size(); ++i) {
+        if (i >= row_group_metadata.columns.size()) {
+          throw ParquetException("Cannot find metadata for column ordinal ", i);
+        }
+        const auto& bloom_filter_location = row_group_location.at(i);
+        if (bloom_filter_location.has_value()) {
+          // The thrift definition in this tree has no bloom_filter_length, so
+          // readers deserialize the filter header to find its size.
+          row_group_metadata.columns.at(i).meta_data.__set_bloom_filter_offset(
+              bloom_filter_location->offset);
+        }
+      }
+    }
+  }
+
   std::unique_ptr<FileMetaData> Finish(
       const std::shared_ptr<const KeyValueMetadata>& key_value_metadata) {
     int64_t total_rows = 0;
@@ -2325,6 +2344,11 @@ void FileMetaDataBuilder::SetPageIndexLocation(
   impl_->SetPageIndexLocation(location);
 }
 
+void FileMetaDataBuilder::SetBloomFilterLocation(
+    const BloomFilterLocation& location) {
+  impl_->SetBloomFilterLocation(location);
+}
+
 std::unique_ptr<FileMetaData> FileMetaDataBuilder::Finish(
     const std::shared_ptr<const KeyValueMetadata>& key_value_metadata) {
   return impl_->Finish(key_value_metadata);
@@ -564,6 +564,19 @@ struct PageIndexLocation {
   FileIndexLocation offset_index_location;
 };
 
+/// \brief Public struct for location to all bloom filters in a parquet file.
+struct BloomFilterLocation {
+  /// Alias type of bloom filter location of a row group. The filter location
+  /// is located by column ordinal. If the column does not have the bloom
+  /// filter, its value is set to std::nullopt.
+  using RowGroupBloomFilterLocation = std::vector<std::optional<IndexLocation>>;
+  /// Alias type of bloom filter location of a parquet file. The filter
+  /// location is located by the row group ordinal.
+  using FileBloomFilterLocation = std::map<size_t, RowGroupBloomFilterLocation>;
+  /// Row group bloom filter locations which uses row group ordinal as the key.
+  FileBloomFilterLocation bloom_filter_location;
+};
+
 class PARQUET_EXPORT FileMetaDataBuilder {
  public:
   ARROW_DEPRECATED(
@@ -586,6 +599,9 @@ class PARQUET_EXPORT FileMetaDataBuilder {
   // Update location to all page indexes in the parquet file
   void SetPageIndexLocation(const PageIndexLocation& location);
 
+  // Update location to all bloom filters in the parquet file
+  void SetBloomFilterLocation(const BloomFilterLocation& location);
+
   // Complete the Thrift structure
   std::unique_ptr<FileMetaData> Finish(
       const std::shared_ptr<const KeyValueMetadata>& key_value_metadata =
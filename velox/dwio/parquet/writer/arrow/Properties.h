@@ -19,6 +19,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -27,6 +28,7 @@
 #include "arrow/io/caching.h"
 #include "arrow/type.h"
 #include "arrow/util/type_fwd.h"
+#include "velox/common/memory/Memory.h"
 #include "velox/dwio/parquet/writer/arrow/Encryption.h"
 #include "velox/dwio/parquet/writer/arrow/Exception.h"
 #include "velox/dwio/parquet/writer/arrow/Platform.h"
@@ -220,6 +222,16 @@ static constexpr Compression::type DEFAULT_COMPRESSION_TYPE =
     Compression::UNCOMPRESSED;
 static constexpr bool DEFAULT_IS_PAGE_INDEX_ENABLED = false;
 
+/// Options to build the split block bloom filter of a column chunk.
+struct PARQUET_EXPORT BloomFilterOptions {
+  /// Expected number of distinct values in a column chunk. Together with
+  /// 'fpp' it determines the size of the bloom filter bitset.
+  int32_t ndv = 1 << 20;
+
+  /// Target false positive probability of the bloom filter.
+  double fpp = 0.05;
+};
+
 class PARQUET_EXPORT ColumnProperties {
  public:
   ColumnProperties(
@@ -271,6 +283,25 @@ class PARQUET_EXPORT ColumnProperties {
     page_index_enabled_ = page_index_enabled;
   }
 
+  void set_bloom_filter_options(
+      std::optional<BloomFilterOptions> bloom_filter_options) {
+    if (bloom_filter_options.has_value()) {
+      if (bloom_filter_options->fpp >= 1.0 ||
+          bloom_filter_options->fpp <= 0.0) {
+        throw ParquetException(
+            "Bloom filter false positive probability must be in (0.0, 1.0), "
+            "got ",
+            bloom_filter_options->fpp);
+      }
+      if (bloom_filter_options->ndv <= 0) {
+        throw ParquetException(
+            "Bloom filter number of distinct values must be positive, got ",
+            bloom_filter_options->ndv);
+      }
+    }
+    bloom_filter_options_ = bloom_filter_options;
+  }
+
   Encoding::type encoding() const {
     return encoding_;
   }
@@ -303,6 +334,14 @@ class PARQUET_EXPORT ColumnProperties {
     return page_index_enabled_;
   }
 
+  const std::optional<BloomFilterOptions>& bloom_filter_options() const {
+    return bloom_filter_options_;
+  }
+
+  bool bloom_filter_enabled() const {
+    return bloom_filter_options_.has_value();
+  }
+
  private:
   Encoding::type encoding_;
   Compression::type codec_;
@@ -311,6 +350,7 @@ class PARQUET_EXPORT ColumnProperties {
   size_t max_stats_size_;
   std::shared_ptr<CodecOptions> codec_options_;
   bool page_index_enabled_;
+  std::optional<BloomFilterOptions> bloom_filter_options_;
 };
 
 class PARQUET_EXPORT WriterProperties {
@@ -735,6 +775,46 @@ class PARQUET_EXPORT WriterProperties {
       return this->disable_write_page_index(path->ToDotString());
     }
 
+    /// Enable writing a split block bloom filter for the column specified by
+    /// `path`. Bloom filters are only written for INT32, INT64 and BYTE_ARRAY
+    /// columns. Default disabled.
+    Builder* enable_bloom_filter(
+        const std::string& path,
+        const BloomFilterOptions& bloom_filter_options = {}) {
+      bloom_filter_options_[path] = bloom_filter_options;
+      return this;
+    }
+
+    /// Enable writing a split block bloom filter for the column specified by
+    /// `path`. Default disabled.
+    Builder* enable_bloom_filter(
+        const std::shared_ptr<schema::ColumnPath>& path,
+        const BloomFilterOptions& bloom_filter_options = {}) {
+      return this->enable_bloom_filter(
+          path->ToDotString(), bloom_filter_options);
+    }
+
+    /// Disable writing a bloom filter for the column specified by `path`.
+    /// Default disabled.
+    Builder* disable_bloom_filter(const std::string& path) {
+      bloom_filter_options_[path] = std::nullopt;
+      return this;
+    }
+
+    /// Disable writing a bloom filter for the column specified by `path`.
+    /// Default disabled.
+    Builder* disable_bloom_filter(
+        const std::shared_ptr<schema::ColumnPath>& path) {
+      return this->disable_bloom_filter(path->ToDotString());
+    }
+
+    /// Specify the memory pool for the bitsets of the bloom filters. Required
+    /// if a bloom filter is enabled for any column.
+    Builder* bloom_filter_pool(velox::memory::MemoryPool* pool) {
+      bloom_filter_pool_ = pool;
+      return this;
+    }
+
     /// \brief Build the WriterProperties with the builder parameters.
     /// \return The WriterProperties defined by the builder.
     std::shared_ptr<WriterProperties> build() {
@@ -759,6 +839,8 @@ class PARQUET_EXPORT WriterProperties {
         get(item.first).set_statistics_enabled(item.second);
       for (const auto& item : page_index_enabled_)
         get(item.first).set_page_index_enabled(item.second);
+      for (const auto& item : bloom_filter_options_)
+        get(item.first).set_bloom_filter_options(item.second);
 
       return std::shared_ptr<WriterProperties>(new WriterProperties(
           pool_,
@@ -774,7 +856,8 @@ class PARQUET_EXPORT WriterProperties {
           column_properties,
           data_page_version_,
           store_decimal_as_integer_,
-          std::move(sorting_columns_)));
+          std::move(sorting_columns_),
+          bloom_filter_pool_));
     }
 
    private:
@@ -803,6 +886,9 @@ class PARQUET_EXPORT WriterProperties {
     std::unordered_map<std::string, bool> dictionary_enabled_;
     std::unordered_map<std::string, bool> statistics_enabled_;
     std::unordered_map<std::string, bool> page_index_enabled_;
+    std::unordered_map<std::string, std::optional<BloomFilterOptions>>
+        bloom_filter_options_;
+    velox::memory::MemoryPool* bloom_filter_pool_{nullptr};
   };
 
   inline MemoryPool* memory_pool() const {
@@ -912,6 +998,24 @@ class PARQUET_EXPORT WriterProperties {
     return column_properties(path).page_index_enabled();
   }
 
+  const std::optional<BloomFilterOptions>& bloom_filter_options(
+      const std::shared_ptr<schema::ColumnPath>& path) const {
+    return column_properties(path).bloom_filter_options();
+  }
+
+  bool bloom_filter_enabled() const {
+    for (const auto& item : column_properties_) {
+      if (item.second.bloom_filter_enabled()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  velox::memory::MemoryPool* bloom_filter_pool() const {
+    return bloom_filter_pool_;
+  }
+
   bool page_index_enabled() const {
     if (default_column_properties_.page_index_enabled()) {
       return true;
@@ -953,7 +1057,8 @@ class PARQUET_EXPORT WriterProperties {
           column_properties,
       ParquetDataPageVersion data_page_version,
       bool store_short_decimal_as_integer,
-      std::vector<SortingColumn> sorting_columns)
+      std::vector<SortingColumn> sorting_columns,
+      velox::memory::MemoryPool* bloom_filter_pool)
       : pool_(pool),
         dictionary_pagesize_limit_(dictionary_pagesize_limit),
         write_batch_size_(write_batch_size),
@@ -967,7 +1072,8 @@ class PARQUET_EXPORT WriterProperties {
         file_encryption_properties_(file_encryption_properties),
         sorting_columns_(std::move(sorting_columns)),
         default_column_properties_(default_column_properties),
-        column_properties_(column_properties) {}
+        column_properties_(column_properties),
+        bloom_filter_pool_(bloom_filter_pool) {}
 
   MemoryPool* pool_;
   int64_t dictionary_pagesize_limit_;
@@ -986,6 +1092,7 @@ class PARQUET_EXPORT WriterProperties {
 
   ColumnProperties default_column_properties_;
   std::unordered_map<std::string, ColumnProperties> column_properties_;
+  velox::memory::MemoryPool* bloom_filter_pool_;
 };
 
 PARQUET_EXPORT const std::shared_ptr<WriterProperties>&
@@ -15,6 +15,9 @@
  */
 
 #include "velox/exec/AggregateWindow.h"
+
+#include <numeric>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/WindowFunction.h"
@@ -29,6 +32,12 @@ namespace {
 // Creates an Aggregate function object for the window function invocation.
 // At each row, computes the aggregation across all rows from the frameStart
 // to frameEnd boundaries at that row using singleGroup.
+//
+// Frames with a moving start (e.g. ROWS BETWEEN k PRECEDING AND CURRENT ROW)
+// can optionally be computed with a segment tree of intermediate accumulators
+// built once per partition. Each frame is then assembled from at most
+// 2 * (kSegmentTreeFanout - 1) entries per tree level instead of from every
+// row in the frame.
 class AggregateWindowFunction : public exec::WindowFunction {
  public:
   AggregateWindowFunction(
@@ -67,6 +76,15 @@ class AggregateWindowFunction : public exec::WindowFunction {
         config);
     aggregate_->setAllocator(stringAllocator_);
 
+    // The segment tree combines partial aggregates out of order, so it can
+    // only be used for aggregates that are not sensitive to input order.
+    useSegmentTree_ = config.windowAggregateSegmentTreeEnabled() &&
+        !exec::getAggregateFunctionMetadata(name).orderSensitive;
+    if (useSegmentTree_) {
+      intermediateType_ = exec::Aggregate::intermediateType(name, argTypes_);
+      intermediateVector_ = BaseVector::create(intermediateType_, 0, pool_);
+    }
+
     // Aggregate initialization.
     // Row layout is:
     //  - null flags - one bit per aggregate.
@@ -116,6 +134,7 @@ class AggregateWindowFunction : public exec::WindowFunction {
     partition_ = partition;
 
     previousFrameMetadata_.reset();
+    segmentTreeLevels_.clear();
   }
 
   void apply(
@@ -163,6 +182,15 @@ class AggregateWindowFunction : public exec::WindowFunction {
           rawFrameEnds,
           resultOffset,
           result);
+    } else if (useSegmentTree_ && !partition_->partial()) {
+      // The segment tree is built over all the rows of the partition, so it
+      // requires a complete partition and is not used with
+      // RowsStreamingWindowBuild.
+      if (segmentTreeLevels_.empty()) {
+        buildSegmentTree();
+      }
+      segmentTreeAggregation(
+          validRows, rawFrameStarts, rawFrameEnds, resultOffset, result);
     } else {
       fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
       simpleAggregation(
@@ -345,6 +373,165 @@ class AggregateWindowFunction : public exec::WindowFunction {
     setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
   }
 
+  // Copies the argument values of the partition rows in 'rowNumbers' into
+  // argVectors_.
+  void fillArgVectors(folly::Range<const vector_size_t*> rowNumbers) {
+    for (int i = 0; i < argIndices_.size(); i++) {
+      argVectors_[i]->resize(rowNumbers.size());
+      if (argIndices_[i] != kConstantChannel) {
+        partition_->extractColumn(
+            argIndices_[i], rowNumbers, 0, argVectors_[i]);
+      }
+    }
+  }
+
+  // Allocates 'numGroups' zero-initialized group rows for the segment tree
+  // nodes of one level and returns pointers to them in 'groups'.
+  void allocateTreeGroups(vector_size_t numGroups, std::vector<char*>& groups) {
+    const auto groupSize = bits::roundUp(
+        singleGroupRowSize_, aggregate_->accumulatorAlignmentSize());
+    if (!treeGroupsBuffer_ ||
+        treeGroupsBuffer_->capacity() < numGroups * groupSize) {
+      treeGroupsBuffer_ =
+          AlignedBuffer::allocate<char>(numGroups * groupSize, pool_);
+    }
+    auto* rawGroups = treeGroupsBuffer_->asMutable<char>();
+    ::memset(rawGroups, 0, numGroups * groupSize);
+    groups.resize(numGroups);
+    for (auto i = 0; i < numGroups; ++i) {
+      groups[i] = rawGroups + i * groupSize;
+    }
+  }
+
+  // Builds the segment tree for the current partition. Level 0 has one
+  // accumulator for every kSegmentTreeFanout consecutive partition rows. Each
+  // following level has one accumulator for every kSegmentTreeFanout
+  // consecutive entries of the level below. The levels are kept as vectors of
+  // the intermediate type of the aggregate.
+  void buildSegmentTree() {
+    VELOX_CHECK(segmentTreeLevels_.empty());
+    const auto numRows = partition_->numRows();
+    VELOX_CHECK_GT(numRows, 0);
+
+    std::vector<char*> groups;
+    std::vector<char*> rowGroups;
+    std::vector<vector_size_t> allGroups;
+
+    // Initializes 'numGroups' tree nodes, lets 'addInput' accumulate into
+    // them and extracts the nodes into a new level.
+    auto makeLevel = [&](vector_size_t numGroups, auto addInput) {
+      allocateTreeGroups(numGroups, groups);
+      allGroups.resize(numGroups);
+      std::iota(allGroups.begin(), allGroups.end(), 0);
+      aggregate_->clear();
+      aggregate_->initializeNewGroups(groups.data(), allGroups);
+      addInput();
+      auto level = BaseVector::create(intermediateType_, numGroups, pool_);
+      aggregate_->extractAccumulators(groups.data(), numGroups, &level);
+      aggregate_->destroy(folly::Range(groups.data(), numGroups));
+      segmentTreeLevels_.push_back(std::move(level));
+    };
+
+    // Accumulates the raw input in batches of partition rows to bound the
+    // size of the argument vectors.
+    static constexpr vector_size_t kLeafBatchRows = kSegmentTreeFanout * 1'024;
+    makeLevel(bits::divRoundUp(numRows, kSegmentTreeFanout), [&]() {
+      SelectivityVector rows;
+      for (vector_size_t start = 0; start < numRows; start += kLeafBatchRows) {
+        const auto numBatchRows = std::min(kLeafBatchRows, numRows - start);
+        fillArgVectors(start, start + numBatchRows - 1);
+        rowGroups.resize(numBatchRows);
+        for (auto i = 0; i < numBatchRows; ++i) {
+          rowGroups[i] = groups[(start + i) / kSegmentTreeFanout];
+        }
+        rows.resizeFill(numBatchRows, true);
+        aggregate_->addRawInput(rowGroups.data(), rows, argVectors_, false);
+      }
+    });
+
+    while (segmentTreeLevels_.back()->size() > 1) {
+      const auto childLevel = segmentTreeLevels_.back();
+      const auto numChildren = childLevel->size();
+      makeLevel(bits::divRoundUp(numChildren, kSegmentTreeFanout), [&]() {
+        rowGroups.resize(numChildren);
+        for (auto i = 0; i < numChildren; ++i) {
+          rowGroups[i] = groups[i / kSegmentTreeFanout];
+        }
+        SelectivityVector rows(numChildren);
+        aggregate_->addIntermediateResults(
+            rowGroups.data(), rows, {childLevel}, false);
+      });
+    }
+    aggregate_->clear();
+  }
+
+  // Adds the entries [begin, end) of segment tree 'level' to the single group
+  // accumulator. Level -1 denotes the partition rows.
+  void addTreeRange(int32_t level, vector_size_t begin, vector_size_t end) {
+    if (begin >= end) {
+      return;
+    }
+    const auto numEntries = end - begin;
+    if (level < 0) {
+      treeRowNumbers_.resize(numEntries);
+      std::iota(treeRowNumbers_.begin(), treeRowNumbers_.end(), begin);
+      fillArgVectors(treeRowNumbers_);
+      treeRows_.resizeFill(numEntries, true);
+      aggregate_->addSingleGroupRawInput(
+          rawSingleGroupRow_, treeRows_, argVectors_, false);
+    } else {
+      intermediateVector_->resize(numEntries);
+      intermediateVector_->copy(
+          segmentTreeLevels_[level].get(), 0, begin, numEntries);
+      treeRows_.resizeFill(numEntries, true);
+      aggregate_->addSingleGroupIntermediateResults(
+          rawSingleGroupRow_, treeRows_, {intermediateVector_}, false);
+    }
+  }
+
+  // Computes the aggregate for each valid row by combining the partition rows
+  // and segment tree entries that exactly cover the frame of the row.
+  void segmentTreeAggregation(
+      const SelectivityVector& validRows,
+      const vector_size_t* frameStartsVector,
+      const vector_size_t* frameEndsVector,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    static auto kSingleGroup = std::vector<vector_size_t>{0};
+    const int32_t numLevels = segmentTreeLevels_.size();
+
+    validRows.applyToSelected([&](auto i) {
+      aggregate_->clear();
+      aggregate_->initializeNewGroups(&rawSingleGroupRow_, kSingleGroup);
+      aggregateInitialized_ = true;
+
+      // Half-open range of entries at 'level' still to be aggregated.
+      vector_size_t begin = frameStartsVector[i];
+      vector_size_t end = frameEndsVector[i] + 1;
+      for (int32_t level = -1; begin < end; ++level) {
+        const auto parentBegin = bits::divRoundUp(begin, kSegmentTreeFanout);
+        const auto parentEnd = end / kSegmentTreeFanout;
+        if (level + 1 == numLevels || parentBegin >= parentEnd) {
+          addTreeRange(level, begin, end);
+          break;
+        }
+        // Adds the partial parent nodes at both ends and continues with the
+        // fully covered parent nodes one level up.
+        addTreeRange(level, begin, parentBegin * kSegmentTreeFanout);
+        addTreeRange(level, parentEnd * kSegmentTreeFanout, end);
+        begin = parentBegin;
+        end = parentEnd;
+      }
+
+      BaseVector::prepareForReuse(aggregateResultVector_, 1);
+      aggregate_->extractValues(&rawSingleGroupRow_, 1, &aggregateResultVector_);
+      result->copy(aggregateResultVector_.get(), resultOffset + i, 0, 1);
+    });
+
+    // Set null values for empty (non valid) frames in the output block.
+    setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
+  }
+
   // Precompute and save the aggregate output for empty input in emptyResult_.
   // This value is returned for rows with empty frames.
   void computeDefaultAggregateValue(const TypePtr& resultType) {
@@ -389,6 +576,26 @@ class AggregateWindowFunction : public exec::WindowFunction {
   // to optimize aggregate computation and reading argument vectors.
   std::optional<FrameMetadata> previousFrameMetadata_;
 
+  // Number of entries of a segment tree level combined into one entry of the
+  // next level.
+  static constexpr vector_size_t kSegmentTreeFanout = 16;
+
+  // True if frames with a moving start are computed with a segment tree.
+  bool useSegmentTree_{false};
+
+  // Intermediate type of the aggregate. Used for the segment tree levels.
+  TypePtr intermediateType_;
+
+  // Segment tree of the current partition, from the leaf level up to the
+  // root level with a single entry. Built on the first use in a partition.
+  std::vector<VectorPtr> segmentTreeLevels_;
+
+  // Scratch data used to aggregate a range of segment tree entries.
+  VectorPtr intermediateVector_;
+  SelectivityVector treeRows_;
+  std::vector<vector_size_t> treeRowNumbers_;
+  BufferPtr treeGroupsBuffer_;
+
   // Stores default result value for empty frame aggregation. Window functions
   // return the default value of an aggregate (aggregation with no rows) for
   // empty frames. e.g. count for empty frames should return 0 and not null.
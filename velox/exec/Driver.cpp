@@ -16,6 +16,7 @@
 
 #include "velox/exec/Driver.h"
 
+#include "velox/common/process/Numa.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/exec/Task.h"
 
@@ -144,7 +145,9 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       queryConfig.spillPrefixSortEnabled()
           ? std::optional<common::PrefixSortConfig>(prefixSortConfig())
           : std::nullopt,
-      queryConfig.spillFileCreateConfig());
+      queryConfig.spillFileCreateConfig(),
+      queryConfig.spillRowFormatEnabled(),
+      queryConfig.spillReadAheadBufferSize());
 }
 
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
@@ -248,6 +251,7 @@ void Driver::init(
   VELOX_CHECK_NULL(ctx_);
   ctx_ = std::move(ctx);
   cpuSliceMs_ = task()->driverCpuTimeSliceLimitMs();
+  numaNode_ = task()->numaNode();
   VELOX_CHECK(operators_.empty());
   operators_ = std::move(operators);
   curOperatorId_ = operators_.size() - 1;
@@ -529,6 +533,11 @@ StopReason Driver::runInternal(
     close();
   });
 
+  std::optional<process::ScopedNumaNode> numaNodeGuard;
+  if (numaNode_ >= 0) {
+    numaNodeGuard.emplace(numaNode_);
+  }
+
   try {
     // Invoked to initialize the operators once before driver starts execution.
     initializeOperators();
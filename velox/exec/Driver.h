@@ -189,6 +189,8 @@ enum class BlockingReason {
   /// Some operators can get blocked due to the producer(s) (they are
   /// currently waiting data from) not having anything produced. Used by
   /// LocalExchange, LocalMergeExchange, Exchange and MergeExchange operators.
+  /// Also used by OrderBy in parallel merge mode to wait for its peers to
+  /// finish input.
   kWaitForProducer,
   kWaitForJoinBuild,
   /// For a build operator, it is blocked waiting for the probe operators to
@@ -308,7 +310,9 @@ struct DriverCtx {
     return common::PrefixSortConfig{
         queryConfig().prefixSortNormalizedKeyMaxBytes(),
         queryConfig().prefixSortMinRows(),
-        queryConfig().prefixSortMaxStringPrefixLength()};
+        queryConfig().prefixSortMaxStringPrefixLength(),
+        queryConfig().prefixSortRadixSortEnabled(),
+        queryConfig().prefixSortMaxMergeRuns()};
   }
 };
 
@@ -634,6 +638,9 @@ class Driver : public std::enable_shared_from_this<Driver> {
   // If not zero, specifies the driver cpu time slice.
   size_t cpuSliceMs_{0};
 
+  // If not negative, the NUMA node this driver is pinned to while running.
+  int32_t numaNode_{-1};
+
   bool operatorsInitialized_{false};
 
   std::atomic_bool closed_{false};
@@ -115,6 +115,12 @@ folly::F14FastMap<std::string, RuntimeMetric> ExchangeClient::stats() const {
   stats["numReceivedPages"] = RuntimeMetric(queue_->receivedPages());
   stats["averageReceivedPageBytes"] = RuntimeMetric(
       queue_->averageReceivedPageBytes(), RuntimeCounter::Unit::kBytes);
+  if (queue_->adaptiveBatching()) {
+    stats["maxQueuedBytes"] =
+        RuntimeMetric(maxQueuedBytesLocked(), RuntimeCounter::Unit::kBytes);
+    stats["drainBytesPerSecond"] = RuntimeMetric(
+        queue_->drainBytesPerSecond(), RuntimeCounter::Unit::kBytes);
+  }
 
   return stats;
 }
@@ -141,7 +147,7 @@ std::vector<std::unique_ptr<SerializedPage>> ExchangeClient::next(
       return pages;
     }
 
-    if (!pages.empty() && queue_->totalBytes() > maxQueuedBytes_) {
+    if (!pages.empty() && queue_->totalBytes() > maxQueuedBytesLocked()) {
       return pages;
     }
 
@@ -169,9 +175,10 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
     std::move(future)
         .via(executor_)
         .thenValue(
-            [self, spec = std::move(spec), sendTimeMs = getCurrentTimeMs()](
+            [self, spec = std::move(spec), sendTimeUs = getCurrentTimeMicro()](
                 ExchangeSource::Response&& response) {
-              const auto requestTimeMs = getCurrentTimeMs() - sendTimeMs;
+              const auto requestTimeUs = getCurrentTimeMicro() - sendTimeUs;
+              const auto requestTimeMs = requestTimeUs / 1'000;
               if (spec.maxBytes == 0) {
                 RECORD_HISTOGRAM_METRIC_VALUE(
                     kMetricExchangeDataSizeTimeMs, requestTimeMs);
@@ -193,6 +200,10 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
                 if (self->closed_) {
                   return;
                 }
+                if (spec.maxBytes > 0) {
+                  self->queue_->recordResponseLocked(
+                      response.bytes, requestTimeUs);
+                }
                 if (!response.atEnd) {
                   if (!response.remainingBytes.empty()) {
                     for (auto bytes : response.remainingBytes) {
@@ -240,7 +251,7 @@ ExchangeClient::pickSourcesToRequestLocked() {
     emptySources_.pop();
   }
   int64_t availableSpace =
-      maxQueuedBytes_ - queue_->totalBytes() - totalPendingBytes_;
+      maxQueuedBytesLocked() - queue_->totalBytes() - totalPendingBytes_;
   while (availableSpace > 0 && !producingSources_.empty()) {
     auto& source = producingSources_.front().source;
     int64_t requestBytes = 0;
@@ -283,6 +294,24 @@ ExchangeClient::pickSourcesToRequestLocked() {
   return requestSpecs;
 }
 
+int64_t ExchangeClient::maxQueuedBytesLocked() const {
+  if (!queue_->adaptiveBatching()) {
+    return maxQueuedBytes_;
+  }
+  const auto drainBytesPerSecond = queue_->drainBytesPerSecond();
+  const auto latencyUs = queue_->averageResponseLatencyUs();
+  if (drainBytesPerSecond == 0 || latencyUs == 0) {
+    return maxQueuedBytes_;
+  }
+  // Requests for twice the bytes drained during a round trip keep the
+  // consumers busy while the responses are in flight and let the rate grow.
+  const int64_t targetBytes = 2 * drainBytesPerSecond * latencyUs / 1'000'000;
+  const int64_t minBytes = std::min<int64_t>(
+      maxQueuedBytes_,
+      std::max<int64_t>(minOutputBatchBytes_, maxQueuedBytes_ / 8));
+  return std::clamp(targetBytes, minBytes, maxQueuedBytes_);
+}
+
 ExchangeClient::~ExchangeClient() {
   close();
 }
@@ -36,7 +36,8 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
       uint64_t minOutputBatchBytes,
       memory::MemoryPool* pool,
       folly::Executor* executor,
-      int32_t requestDataSizesMaxWaitSec = 10)
+      int32_t requestDataSizesMaxWaitSec = 10,
+      bool adaptiveBatching = false)
       : taskId_{std::move(taskId)},
         destination_(destination),
         maxQueuedBytes_{maxQueuedBytes},
@@ -45,7 +46,8 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
         executor_(executor),
         queue_(std::make_shared<ExchangeQueue>(
             numberOfConsumers,
-            minOutputBatchBytes)),
+            minOutputBatchBytes,
+            adaptiveBatching)),
         // See comment in 'pickSourcesToRequestLocked' for why this is needed
         // for 'minOutputBatchBytes_'. Note: ExchangeQueue does not need max(1,
         // minOutputBatchBytes) because for 'MergeExchangeSource', we want
@@ -133,6 +135,12 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
 
   std::vector<RequestSpec> pickSourcesToRequestLocked();
 
+  // Returns the limit on the queued plus requested bytes. This is
+  // 'maxQueuedBytes_' unless the queue is in adaptive batching mode. In
+  // adaptive mode, the limit is twice the bytes the consumers drain during an
+  // average request, between 1/8 of 'maxQueuedBytes_' and 'maxQueuedBytes_'.
+  int64_t maxQueuedBytesLocked() const;
+
   void request(std::vector<RequestSpec>&& requestSpecs);
 
   // Handy for ad-hoc logging.
@@ -70,8 +70,42 @@ int64_t ExchangeQueue::minOutputBatchBytesLocked() const {
   if (atEnd_) {
     return 0;
   }
-  // At most 1% of received bytes so far to minimize latency for small exchanges
-  return std::min<int64_t>(minOutputBatchBytes_, receivedBytes_ / 100);
+  if (!adaptiveBatching_) {
+    // At most 1% of received bytes so far to minimize latency for small
+    // exchanges
+    return std::min<int64_t>(minOutputBatchBytes_, receivedBytes_ / 100);
+  }
+  // The bytes expected to arrive within kMaxBatchDelayUs at the average
+  // arrival rate so far. Fast exchanges fill full batches while slow ones do
+  // not hold data back. Never more than received so far, which caps the wait
+  // early in the exchange.
+  const auto elapsedUs = std::max<uint64_t>(
+      kMaxBatchDelayUs, getCurrentTimeMicro() - createTimeUs_);
+  return std::min<int64_t>(
+      minOutputBatchBytes_, receivedBytes_ * kMaxBatchDelayUs / elapsedUs);
+}
+
+void ExchangeQueue::recordDrainLocked(int64_t bytes) {
+  const auto nowUs = getCurrentTimeMicro();
+  if (drainIntervalStartUs_ == 0) {
+    drainIntervalStartUs_ = nowUs;
+  }
+  drainIntervalBytes_ += bytes;
+  const auto elapsedUs = nowUs - drainIntervalStartUs_;
+  if (elapsedUs >= kDrainIntervalUs) {
+    drainBytesPerSecond_ = drainIntervalBytes_ * 1'000'000 / elapsedUs;
+    drainIntervalStartUs_ = nowUs;
+    drainIntervalBytes_ = 0;
+  }
+}
+
+void ExchangeQueue::recordResponseLocked(int64_t bytes, uint64_t latencyUs) {
+  if (!adaptiveBatching_ || bytes == 0) {
+    return;
+  }
+  responseLatencyUs_ = responseLatencyUs_ == 0
+      ? latencyUs
+      : (responseLatencyUs_ * 7 + latencyUs) / 8;
 }
 
 void ExchangeQueue::enqueueLocked(
@@ -159,10 +193,16 @@ std::vector<std::unique_ptr<SerializedPage>> ExchangeQueue::dequeueLocked(
       } else if (pages.empty()) {
         addPromiseLocked(consumerId, future, stalePromise);
       }
+      if (adaptiveBatching_ && pageBytes > 0) {
+        recordDrainLocked(pageBytes);
+      }
       return pages;
     }
 
     if (pageBytes > 0 && pageBytes + queue_.front()->size() > maxBytes) {
+      if (adaptiveBatching_) {
+        recordDrainLocked(pageBytes);
+      }
       return pages;
     }
 
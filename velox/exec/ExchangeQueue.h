@@ -16,6 +16,7 @@
 #pragma once
 
 #include "velox/common/memory/ByteStream.h"
+#include "velox/common/time/Timer.h"
 
 namespace facebook::velox::exec {
 
@@ -81,11 +82,19 @@ class SerializedPage {
 /// for input.
 class ExchangeQueue {
  public:
+  /// If 'adaptiveBatching' is true, the minimum number of bytes to accumulate
+  /// before unblocking a consumer follows the arrival rate of the data, see
+  /// minOutputBatchBytesLocked(), and the queue measures the rate at which the
+  /// consumers drain it and the latency of the requests to the sources. The
+  /// ExchangeClient sizes its outstanding requests from these.
   explicit ExchangeQueue(
       int32_t numberOfConsumers,
-      uint64_t minOutputBatchBytes)
+      uint64_t minOutputBatchBytes,
+      bool adaptiveBatching = false)
       : numberOfConsumers_{numberOfConsumers},
-        minOutputBatchBytes_{minOutputBatchBytes} {
+        minOutputBatchBytes_{minOutputBatchBytes},
+        adaptiveBatching_{adaptiveBatching},
+        createTimeUs_{getCurrentTimeMicro()} {
     VELOX_CHECK_GE(numberOfConsumers, 1);
   }
 
@@ -155,6 +164,27 @@ class ExchangeQueue {
     return receivedPages_ > 0 ? receivedBytes_ / receivedPages_ : 0;
   }
 
+  bool adaptiveBatching() const {
+    return adaptiveBatching_;
+  }
+
+  /// Records a response of 'bytes' to a data request that took 'latencyUs'.
+  /// Only tracked in adaptive batching mode. Responses without data are
+  /// ignored.
+  void recordResponseLocked(int64_t bytes, uint64_t latencyUs);
+
+  /// Returns the average latency of the data requests with a non-empty
+  /// response. 0 if there has been no such response.
+  uint64_t averageResponseLatencyUs() const {
+    return responseLatencyUs_;
+  }
+
+  /// Returns the rate at which the consumers dequeued data in the last
+  /// measured interval. 0 if not measured yet.
+  int64_t drainBytesPerSecond() const {
+    return drainBytesPerSecond_;
+  }
+
   void addSourceLocked() {
     VELOX_CHECK(!noMoreSources_, "addSource called after noMoreSources");
     numSources_++;
@@ -211,8 +241,20 @@ class ExchangeQueue {
 
   int64_t minOutputBatchBytesLocked() const;
 
+  // Adds 'bytes' dequeued by a consumer to the drain rate measurement.
+  void recordDrainLocked(int64_t bytes);
+
+  // Minimum interval over which the drain rate is measured.
+  static constexpr uint64_t kDrainIntervalUs = 100'000;
+
+  // In adaptive batching mode, a consumer waits for the bytes expected to
+  // arrive within this time.
+  static constexpr uint64_t kMaxBatchDelayUs = 50'000;
+
   const int32_t numberOfConsumers_;
   const uint64_t minOutputBatchBytes_;
+  const bool adaptiveBatching_;
+  const uint64_t createTimeUs_;
 
   int numCompleted_{0};
   int numSources_{0};
@@ -236,5 +278,14 @@ class ExchangeQueue {
   int64_t receivedBytes_{0};
   // Maximum value of totalBytes_.
   int64_t peakBytes_{0};
+
+  // Adaptive batching state. Start time and dequeued bytes of the current
+  // drain rate measurement interval and the rate measured over the previous
+  // interval.
+  uint64_t drainIntervalStartUs_{0};
+  int64_t drainIntervalBytes_{0};
+  int64_t drainBytesPerSecond_{0};
+  // Moving average of the latency of data requests.
+  uint64_t responseLatencyUs_{0};
 };
 } // namespace facebook::velox::exec
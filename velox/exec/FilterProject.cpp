@@ -15,6 +15,8 @@
  */
 #include "velox/exec/FilterProject.h"
 #include "velox/core/Expressions.h"
+#include "velox/exec/Task.h"
+#include "velox/expression/ConjunctExpr.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
 
@@ -124,6 +126,15 @@ void FilterProject::initialize() {
   }
   numExprs_ = allExprs.size();
   exprs_ = makeExprSetFromFlag(std::move(allExprs), operatorCtx_->execCtx());
+  if (operatorCtx_->driverCtx()
+          ->queryConfig()
+          .adaptiveFilterReorderingEnabled()) {
+    // All drivers compile the same expressions, so they can learn the order
+    // of the conjuncts together.
+    shareConjunctSelectivity(
+        *exprs_,
+        operatorCtx_->task()->getSharedConjunctSelectivity(planNodeId()));
+  }
 
   if (numExprs_ > 0 && !identityProjections_.empty()) {
     const auto inputType = project_ ? project_->sources()[0]->outputType()
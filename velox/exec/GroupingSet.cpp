@@ -256,6 +256,9 @@ void GroupingSet::addInputForActiveRows(
   }
 
   table_->groupProbe(*lookup_, BaseHashTable::kNoSpillInputStartPartitionBit);
+  if (evictGroups_) {
+    markHitGroups();
+  }
   masks_.addInput(input, activeRows_);
 
   auto* groups = lookup_->hits.data();
@@ -374,10 +377,10 @@ std::vector<Accumulator> GroupingSet::accumulators(bool excludeToIntermediate) {
 void GroupingSet::createHashTable() {
   if (ignoreNullKeys_) {
     table_ = HashTable<true>::createForAggregation(
-        std::move(hashers_), accumulators(false), &pool_);
+        std::move(hashers_), accumulators(false), &pool_, evictGroups_);
   } else {
     table_ = HashTable<false>::createForAggregation(
-        std::move(hashers_), accumulators(false), &pool_);
+        std::move(hashers_), accumulators(false), &pool_, evictGroups_);
   }
 
   RowContainer& rows = *table_->rows();
@@ -821,7 +824,7 @@ void GroupingSet::resetTable(bool freeTable) {
 
 bool GroupingSet::isPartialFull(int64_t maxBytes) {
   VELOX_CHECK(isPartial_);
-  if (!table_ || allocatedBytes() <= maxBytes) {
+  if (!table_ || usedBytes() <= maxBytes) {
     return false;
   }
   if (table_->hashMode() != BaseHashTable::HashMode::kArray) {
@@ -838,7 +841,104 @@ bool GroupingSet::isPartialFull(int64_t maxBytes) {
     table_->decideHashMode(
         0, BaseHashTable::kNoSpillInputStartPartitionBit, true);
   }
-  return allocatedBytes() > maxBytes;
+  return usedBytes() > maxBytes;
+}
+
+uint64_t GroupingSet::usedBytes() const {
+  if (!evictGroups_ || table_ == nullptr) {
+    return allocatedBytes();
+  }
+  const auto* rows = table_->rows();
+  const auto [freeRows, freeBytes] = rows->freeSpace();
+  const auto unusedBytes = freeRows * rows->fixedRowSize() + freeBytes;
+  const auto bytes = allocatedBytes();
+  return bytes > unusedBytes ? bytes - unusedBytes : 0;
+}
+
+bool GroupingSet::canEvictGroups() const {
+  if (!isPartial_ || isGlobal_ || isDistinct() ||
+      !preGroupedKeyChannels_.empty() || sortedAggregations_ != nullptr) {
+    return false;
+  }
+  for (const auto& aggregation : distinctAggregations_) {
+    if (aggregation != nullptr) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void GroupingSet::enableGroupEviction() {
+  VELOX_CHECK(canEvictGroups());
+  VELOX_CHECK_NULL(table_);
+  evictGroups_ = true;
+}
+
+void GroupingSet::markHitGroups() {
+  const auto probedFlagOffset = table_->rows()->probedFlagOffset();
+  auto* groups = lookup_->hits.data();
+  // A group is not hit by the row that creates it.
+  newGroupRows_.resizeFill(lookup_->hits.size(), false);
+  for (const auto row : lookup_->newGroups) {
+    newGroupRows_.setValid(row, true);
+  }
+  for (const auto row : lookup_->rows) {
+    if (!newGroupRows_.isValid(row)) {
+      bits::setBit(groups[row], probedFlagOffset);
+    }
+  }
+}
+
+bool GroupingSet::getEvictedOutput(
+    int32_t maxOutputRows,
+    int32_t maxOutputBytes,
+    RowContainerIterator& iterator,
+    RowVectorPtr& result) {
+  VELOX_CHECK(evictGroups_);
+  if (table_ == nullptr) {
+    return false;
+  }
+  auto* rows = table_->rows();
+  const auto probedFlagOffset = rows->probedFlagOffset();
+  evictedGroups_.resize(maxOutputRows);
+  int32_t numEvicted{0};
+  // Skips the batches of groups that have all been hit.
+  while (numEvicted == 0) {
+    const auto numGroups = rows->listRows(
+        &iterator, maxOutputRows, maxOutputBytes, evictedGroups_.data());
+    if (numGroups == 0) {
+      return false;
+    }
+    for (auto i = 0; i < numGroups; ++i) {
+      auto* group = evictedGroups_[i];
+      if (bits::isBitSet(group, probedFlagOffset)) {
+        // Gives the group a second chance.
+        bits::clearBit(group, probedFlagOffset);
+      } else {
+        evictedGroups_[numEvicted++] = group;
+      }
+    }
+  }
+  const folly::Range<char**> groups(evictedGroups_.data(), numEvicted);
+  extractGroups(rows, groups, result);
+  // The iterator skips the erased groups. These are reused for new groups.
+  table_->erase(groups);
+  return true;
+}
+
+void GroupingSet::maybeRecreateEmptyTable() {
+  if (table_ == nullptr || table_->numDistinct() > 0 ||
+      table_->hashMode() == BaseHashTable::HashMode::kArray) {
+    return;
+  }
+  VELOX_CHECK(evictGroups_);
+  hashers_.clear();
+  for (const auto& hasher : table_->hashers()) {
+    hashers_.push_back(VectorHasher::create(hasher->type(), hasher->channel()));
+  }
+  lookup_.reset();
+  table_.reset();
+  createHashTable();
 }
 
 uint64_t GroupingSet::allocatedBytes() const {
@@ -1134,8 +1234,7 @@ bool GroupingSet::prepareNextSpillPartitionOutput() {
   auto it = spillPartitionSet_.begin();
   VELOX_CHECK_NE(outputSpillPartition_, it->first.partitionNumber());
   outputSpillPartition_ = it->first.partitionNumber();
-  merge_ = it->second->createOrderedReader(
-      spillConfig_->readBufferSize, &pool_, spillStats_);
+  merge_ = it->second->createOrderedReader(*spillConfig_, &pool_, spillStats_);
   spillPartitionSet_.erase(it);
   return true;
 }
@@ -93,6 +93,33 @@ class GroupingSet {
   /// based on value ranges to one based on value ids can save a lot.
   bool isPartialFull(int64_t maxBytes);
 
+  /// Returns true if the groups can be flushed a few at a time with
+  /// getEvictedOutput(). This requires a partial aggregation with grouping keys
+  /// and without sorted or distinct aggregates or pre-grouped keys.
+  bool canEvictGroups() const;
+
+  /// Makes 'this' track the groups hit by the input so that getEvictedOutput()
+  /// can flush the other groups. Must be called before adding input.
+  void enableGroupEviction();
+
+  /// Produces the next batch of groups that have not been hit by the input
+  /// since the previous pass of getEvictedOutput() over the table and erases
+  /// them from the table. The other groups are kept and become candidates for
+  /// eviction in the next pass unless hit again. Returns false when the pass
+  /// is at end. 'maxOutputRows' and 'maxOutputBytes' specify the max number of
+  /// rows/bytes to return in 'result' respectively.
+  bool getEvictedOutput(
+      int32_t maxOutputRows,
+      int32_t maxOutputBytes,
+      RowContainerIterator& iterator,
+      RowVectorPtr& result);
+
+  /// Replaces the hash table with a new one if the table is empty and not in
+  /// kArray hash mode. The new table picks the hash mode again from the keys
+  /// added next. A table in kHash or kNormalizedKey mode never goes back to
+  /// kArray mode otherwise.
+  void maybeRecreateEmptyTable();
+
   /// Returns the count of the hash table, if any.
   int64_t numDistinct() const {
     return table_ ? table_->numDistinct() : 0;
@@ -182,6 +209,15 @@ class GroupingSet {
 
   void createHashTable();
 
+  // Sets the probed flag of the groups hit by rows of the last input other
+  // than the rows that created them. The flag marks the groups to keep in the
+  // next pass of getEvictedOutput().
+  void markHitGroups();
+
+  // Returns the bytes used by the groups. Excludes the memory of evicted groups
+  // which is kept for reuse.
+  uint64_t usedBytes() const;
+
   void populateTempVectors(int32_t aggregateIndex, const RowVectorPtr& input);
 
   // If the given aggregation has mask, the method returns reference to the
@@ -342,6 +378,16 @@ class GroupingSet {
   memory::AllocationPool rows_;
   const bool isAdaptive_;
 
+  // True if the groups hit by the input are tracked for getEvictedOutput().
+  bool evictGroups_{false};
+
+  // Reusable memory for the groups listed in getEvictedOutput().
+  std::vector<char*> evictedGroups_;
+
+  // The rows of the last input that have created a group. Used in
+  // markHitGroups().
+  SelectivityVector newGroupRows_;
+
   bool noMoreInput_{false};
 
   // In case of partial streaming aggregation, the input vector passed to
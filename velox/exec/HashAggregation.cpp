@@ -15,7 +15,11 @@
  */
 #include "velox/exec/HashAggregation.h"
 
+#include <folly/ScopeGuard.h>
+#include <folly/hash/Hash.h>
 #include <optional>
+#include "velox/common/base/AsyncSource.h"
+#include "velox/exec/OperatorUtils.h"
 #include "velox/exec/PrefixSort.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/Expr.h"
@@ -99,21 +103,67 @@ void HashAggregation::initialize() {
     VELOX_CHECK(groupIdChannel.has_value());
   }
 
-  groupingSet_ = std::make_unique<GroupingSet>(
-      inputType,
-      std::move(hashers),
-      std::move(preGroupedChannels),
-      std::move(groupingKeyOutputChannels),
-      std::move(aggregateInfos),
-      aggregationNode_->ignoreNullKeys(),
-      isPartialOutput_,
-      isRawInput(aggregationNode_->step()),
-      aggregationNode_->globalGroupingSets(),
-      groupIdChannel,
-      spillConfig_.has_value() ? &spillConfig_.value() : nullptr,
-      &nonReclaimableSection_,
-      operatorCtx_.get(),
-      &spillStats_);
+  auto makeGroupingSet =
+      [&](std::vector<std::unique_ptr<VectorHasher>> hashers,
+          std::vector<AggregateInfo> aggregateInfos) {
+        return std::make_unique<GroupingSet>(
+            inputType,
+            std::move(hashers),
+            std::vector<column_index_t>(preGroupedChannels),
+            std::vector<column_index_t>(groupingKeyOutputChannels),
+            std::move(aggregateInfos),
+            aggregationNode_->ignoreNullKeys(),
+            isPartialOutput_,
+            isRawInput(aggregationNode_->step()),
+            aggregationNode_->globalGroupingSets(),
+            groupIdChannel,
+            spillConfig_.has_value() ? &spillConfig_.value() : nullptr,
+            &nonReclaimableSection_,
+            operatorCtx_.get(),
+            &spillStats_);
+      };
+
+  const auto numPartitions = operatorCtx_->driverCtx()
+                                 ->queryConfig()
+                                 .aggregationParallelInsertPartitions();
+  if (numPartitions > 1 && !isPartialOutput_ && !isGlobal_ && !isDistinct_ &&
+      preGroupedChannels.empty() &&
+      aggregationNode_->globalGroupingSets().empty() && !canSpill()) {
+    VELOX_USER_CHECK(
+        bits::isPowerOfTwo(numPartitions),
+        "{} must be a power of 2: {}",
+        core::QueryConfig::kAggregationParallelInsertPartitions,
+        numPartitions);
+    // Each partition has its own hashers and aggregate functions since these
+    // keep state and are used from different threads.
+    partitionGroupingSets_.push_back(
+        makeGroupingSet(std::move(hashers), std::move(aggregateInfos)));
+    for (auto i = 1; i < numPartitions; ++i) {
+      std::shared_ptr<core::ExpressionEvaluator> partitionEvaluator;
+      partitionGroupingSets_.push_back(makeGroupingSet(
+          createVectorHashers(inputType, groupingKeyInputChannels),
+          toAggregateInfo(
+              *aggregationNode_,
+              *operatorCtx_,
+              numHashers,
+              partitionEvaluator)));
+    }
+    partitionHashers_ =
+        createVectorHashers(inputType, groupingKeyInputChannels);
+    executor_ = operatorCtx_->task()->queryCtx()->executor();
+    pendingPartitionInput_.resize(numPartitions);
+  } else {
+    groupingSet_ =
+        makeGroupingSet(std::move(hashers), std::move(aggregateInfos));
+    const auto cacheTableBytes = operatorCtx_->driverCtx()
+                                     ->queryConfig()
+                                     .partialAggregationCacheTableBytes();
+    if (cacheTableBytes > 0 && groupingSet_->canEvictGroups()) {
+      groupingSet_->enableGroupEviction();
+      partialAggregationCacheTableBytes_ = cacheTableBytes;
+      maxPartialAggregationMemoryUsage_ = cacheTableBytes;
+    }
+  }
 
   aggregationNode_.reset();
 }
@@ -182,6 +232,11 @@ void HashAggregation::addInput(RowVectorPtr input) {
     numInputRows_ += input->size();
     return;
   }
+  if (parallelInsert()) {
+    addPartitionInput(input);
+    numInputRows_ += input->size();
+    return;
+  }
   groupingSet_->addInput(input, mayPushdown_);
   numInputRows_ += input->size();
 
@@ -215,22 +270,27 @@ void HashAggregation::addInput(RowVectorPtr input) {
 }
 
 void HashAggregation::updateRuntimeStats() {
-  // Report range sizes and number of distinct values for the group-by keys.
-  const auto& hashers = groupingSet_->hashLookup().hashers;
-  uint64_t asRange{0};
-  uint64_t asDistinct{0};
-  const auto hashTableStats = groupingSet_->hashTableStats();
+  const auto hashTableStats = this->hashTableStats();
 
   auto lockedStats = stats_.wlock();
   auto& runtimeStats = lockedStats->runtimeStats;
 
-  for (auto i = 0; i < hashers.size(); i++) {
-    hashers[i]->cardinality(0, asRange, asDistinct);
-    if (asRange != VectorHasher::kRangeTooLarge) {
-      runtimeStats[fmt::format("rangeKey{}", i)] = RuntimeMetric(asRange);
-    }
-    if (asDistinct != VectorHasher::kRangeTooLarge) {
-      runtimeStats[fmt::format("distinctKey{}", i)] = RuntimeMetric(asDistinct);
+  // Report range sizes and number of distinct values for the group-by keys.
+  // The hashers of the partitions in parallel insert mode each see a part of
+  // the keys, so these are not reported then.
+  if (!parallelInsert()) {
+    const auto& hashers = groupingSet_->hashLookup().hashers;
+    uint64_t asRange{0};
+    uint64_t asDistinct{0};
+    for (auto i = 0; i < hashers.size(); i++) {
+      hashers[i]->cardinality(0, asRange, asDistinct);
+      if (asRange != VectorHasher::kRangeTooLarge) {
+        runtimeStats[fmt::format("rangeKey{}", i)] = RuntimeMetric(asRange);
+      }
+      if (asDistinct != VectorHasher::kRangeTooLarge) {
+        runtimeStats[fmt::format("distinctKey{}", i)] =
+            RuntimeMetric(asDistinct);
+      }
     }
   }
 
@@ -244,6 +304,170 @@ void HashAggregation::updateRuntimeStats() {
       RuntimeMetric(hashTableStats.numTombstones);
 }
 
+HashTableStats HashAggregation::hashTableStats() const {
+  if (!parallelInsert()) {
+    return groupingSet_->hashTableStats();
+  }
+  HashTableStats stats;
+  for (const auto& groupingSet : partitionGroupingSets_) {
+    const auto partitionStats = groupingSet->hashTableStats();
+    stats.capacity += partitionStats.capacity;
+    stats.numRehashes += partitionStats.numRehashes;
+    stats.numDistinct += partitionStats.numDistinct;
+    stats.numTombstones += partitionStats.numTombstones;
+  }
+  return stats;
+}
+
+void HashAggregation::addPartitionInput(const RowVectorPtr& input) {
+  // Lazy vectors must be loaded before the slices are used from different
+  // threads.
+  input->loadedVector();
+  const auto numRows = input->size();
+  partitionRows_.resize(numRows);
+  partitionRows_.setAll();
+  partitionHashes_.resize(numRows);
+  for (auto i = 0; i < partitionHashers_.size(); ++i) {
+    auto& hasher = partitionHashers_[i];
+    hasher->decode(*input->childAt(hasher->channel()), partitionRows_);
+    hasher->hash(partitionRows_, i > 0, partitionHashes_);
+  }
+
+  // The partition is taken from the high bits of the mixed hash. The input is
+  // typically partitioned on the low bits of the hash by a local or remote
+  // exchange, and the hash tables of the partitions use the low bits too.
+  const auto numPartitions = partitionGroupingSets_.size();
+  const auto shift = 64 - __builtin_ctzll(numPartitions);
+  partitionSizes_.assign(numPartitions, 0);
+  for (auto row = 0; row < numRows; ++row) {
+    partitionHashes_[row] =
+        folly::hash::twang_mix64(partitionHashes_[row]) >> shift;
+    ++partitionSizes_[partitionHashes_[row]];
+  }
+
+  partitionIndices_.resize(numPartitions);
+  std::vector<vector_size_t*> rawIndices(numPartitions);
+  for (auto i = 0; i < numPartitions; ++i) {
+    if (partitionSizes_[i] > 0) {
+      partitionIndices_[i] = allocateIndices(partitionSizes_[i], pool());
+      rawIndices[i] = partitionIndices_[i]->asMutable<vector_size_t>();
+    }
+  }
+  for (auto row = 0; row < numRows; ++row) {
+    *rawIndices[partitionHashes_[row]]++ = row;
+  }
+  for (auto i = 0; i < numPartitions; ++i) {
+    if (partitionSizes_[i] == 0) {
+      continue;
+    }
+    if (partitionSizes_[i] == numRows) {
+      pendingPartitionInput_[i].push_back(input);
+    } else {
+      pendingPartitionInput_[i].push_back(
+          wrap(partitionSizes_[i], std::move(partitionIndices_[i]), input));
+    }
+  }
+
+  numPendingRows_ += numRows;
+  if (numPendingRows_ >= kMinParallelInsertRows) {
+    flushPartitionInput();
+  }
+}
+
+void HashAggregation::flushPartitionInput() {
+  if (numPendingRows_ == 0) {
+    return;
+  }
+  std::vector<std::shared_ptr<AsyncSource<bool>>> steps;
+  // All steps must be synced also in case of error because they reference
+  // 'this'.
+  auto sync = folly::makeGuard([&]() {
+    for (auto& step : steps) {
+      try {
+        step->move();
+      } catch (const std::exception&) {
+      }
+    }
+  });
+
+  // Passing driver context directly to avoid cross thread access to thread
+  // local driver thread context.
+  const DriverCtx* driverCtx = operatorCtx_->driverCtx();
+  for (auto i = 0; i < partitionGroupingSets_.size(); ++i) {
+    if (pendingPartitionInput_[i].empty()) {
+      continue;
+    }
+    steps.push_back(std::make_shared<AsyncSource<bool>>([this, i]() {
+      for (const auto& input : pendingPartitionInput_[i]) {
+        partitionGroupingSets_[i]->addInput(input, /*mayPushdown=*/false);
+      }
+      return std::make_unique<bool>(true);
+    }));
+    if (executor_ != nullptr) {
+      executor_->add([driverCtx, step = steps.back()]() {
+        ScopedDriverThreadContext scopedDriverThreadContext(driverCtx);
+        step->prepare();
+      });
+    }
+  }
+
+  std::exception_ptr error;
+  for (auto& step : steps) {
+    try {
+      step->move();
+    } catch (const std::exception&) {
+      error = std::current_exception();
+    }
+  }
+  steps.clear();
+  for (auto& input : pendingPartitionInput_) {
+    input.clear();
+  }
+  numPendingRows_ = 0;
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+  updateRuntimeStats();
+}
+
+bool HashAggregation::getEvictedOutput(
+    int32_t maxOutputRows,
+    int32_t maxOutputBytes) {
+  for (;;) {
+    if (groupingSet_->getEvictedOutput(
+            maxOutputRows, maxOutputBytes, resultIterator_, output_)) {
+      return true;
+    }
+    resultIterator_.reset();
+    const auto numGroups = groupingSet_->numDistinct();
+    if (numGroups == 0) {
+      return false;
+    }
+    // Flushes the remaining groups if all input has been received, if partial
+    // aggregation is not reducing enough to be kept or if the pass has evicted
+    // less than a quarter of the groups, i.e. the frequently hit groups do not
+    // fit in the table. The pass has cleared the hit flags, so the next pass
+    // evicts all the groups.
+    if (!noMoreInput_ && !abandonPartialAggregationEarly(numOutputRows_) &&
+        numOutputRows_ * 4 >= numOutputRows_ + numGroups) {
+      return false;
+    }
+  }
+}
+
+bool HashAggregation::getPartitionOutput(
+    int32_t maxOutputRows,
+    int32_t maxOutputBytes) {
+  for (; outputPartition_ < partitionGroupingSets_.size(); ++outputPartition_) {
+    if (partitionGroupingSets_[outputPartition_]->getOutput(
+            maxOutputRows, maxOutputBytes, resultIterator_, output_)) {
+      return true;
+    }
+    resultIterator_.reset();
+  }
+  return false;
+}
+
 void HashAggregation::prepareOutput(vector_size_t size) {
   if (output_) {
     VectorPtr output = std::move(output_);
@@ -270,7 +494,11 @@ void HashAggregation::resetPartialOutputIfNeed() {
     lockedStats->addRuntimeStat(
         "partialAggregationPct", RuntimeCounter(aggregationPct));
   }
-  groupingSet_->resetTable(/*freeTable=*/false);
+  if (evictGroups()) {
+    groupingSet_->maybeRecreateEmptyTable();
+  } else {
+    groupingSet_->resetTable(/*freeTable=*/false);
+  }
   partialFull_ = false;
   if (!finished_) {
     maybeIncreasePartialAggregationMemoryUsage(aggregationPct);
@@ -285,17 +513,26 @@ void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
   constexpr int32_t kPartialMinFinalPct = 40;
   VELOX_DCHECK(isPartialOutput_);
   // If size is at max and there still is not enough reduction, abandon partial
-  // aggregation.
-  if (abandonPartialAggregationEarly(numOutputRows_) ||
-      (aggregationPct > kPartialMinFinalPct &&
-       maxPartialAggregationMemoryUsage_ >=
-           maxExtendedPartialAggregationMemoryUsage_)) {
+  // aggregation. In group eviction mode, the table keeps its size and the
+  // flush has emptied the table if there is not enough reduction, see
+  // getEvictedOutput().
+  const bool abandon = evictGroups()
+      ? groupingSet_->numDistinct() == 0 &&
+          abandonPartialAggregationEarly(numOutputRows_)
+      : abandonPartialAggregationEarly(numOutputRows_) ||
+          (aggregationPct > kPartialMinFinalPct &&
+           maxPartialAggregationMemoryUsage_ >=
+               maxExtendedPartialAggregationMemoryUsage_);
+  if (abandon) {
     groupingSet_->abandonPartialAggregation();
     pool()->release();
     addRuntimeStat("abandonedPartialAggregation", RuntimeCounter(1));
     abandonedPartialAggregation_ = true;
     return;
   }
+  if (evictGroups()) {
+    return;
+  }
   const int64_t extendedPartialAggregationMemoryUsage = std::min(
       maxPartialAggregationMemoryUsage_ * 2,
       maxExtendedPartialAggregationMemoryUsage_);
@@ -342,7 +579,7 @@ RowVectorPtr HashAggregation::getOutput() {
   // - distinct aggregation has new keys;
   // - running in partial streaming mode and have some output ready.
   if (!noMoreInput_ && !partialFull_ && !newDistincts_ &&
-      !groupingSet_->hasOutput()) {
+      (parallelInsert() || !groupingSet_->hasOutput())) {
     input_ = nullptr;
     return nullptr;
   }
@@ -357,11 +594,17 @@ RowVectorPtr HashAggregation::getOutput() {
   // Reuse output vectors if possible.
   prepareOutput(maxOutputRows);
 
-  const bool hasData = groupingSet_->getOutput(
-      maxOutputRows,
-      queryConfig.preferredOutputBatchBytes(),
-      resultIterator_,
-      output_);
+  const bool hasData = parallelInsert()
+      ? getPartitionOutput(
+            maxOutputRows, queryConfig.preferredOutputBatchBytes())
+      : evictGroups()
+      ? getEvictedOutput(
+            maxOutputRows, queryConfig.preferredOutputBatchBytes())
+      : groupingSet_->getOutput(
+            maxOutputRows,
+            queryConfig.preferredOutputBatchBytes(),
+            resultIterator_,
+            output_);
   if (!hasData) {
     resultIterator_.reset();
     if (noMoreInput_) {
@@ -434,8 +677,16 @@ RowVectorPtr HashAggregation::getDistinctOutput() {
 }
 
 void HashAggregation::noMoreInput() {
-  updateEstimatedOutputRowSize();
-  groupingSet_->noMoreInput();
+  if (parallelInsert()) {
+    flushPartitionInput();
+    updateEstimatedOutputRowSize();
+    for (auto& groupingSet : partitionGroupingSets_) {
+      groupingSet->noMoreInput();
+    }
+  } else {
+    updateEstimatedOutputRowSize();
+    groupingSet_->noMoreInput();
+  }
   Operator::noMoreInput();
   // Release the extra reserved memory right after processing all the inputs.
   pool()->release();
@@ -493,10 +744,22 @@ void HashAggregation::close() {
 
   output_ = nullptr;
   groupingSet_.reset();
+  pendingPartitionInput_.clear();
+  partitionGroupingSets_.clear();
 }
 
 void HashAggregation::updateEstimatedOutputRowSize() {
-  const auto optionalRowSize = groupingSet_->estimateOutputRowSize();
+  if (parallelInsert()) {
+    for (const auto& groupingSet : partitionGroupingSets_) {
+      updateEstimatedOutputRowSize(groupingSet->estimateOutputRowSize());
+    }
+    return;
+  }
+  updateEstimatedOutputRowSize(groupingSet_->estimateOutputRowSize());
+}
+
+void HashAggregation::updateEstimatedOutputRowSize(
+    std::optional<int64_t> optionalRowSize) {
   if (!optionalRowSize.has_value()) {
     return;
   }
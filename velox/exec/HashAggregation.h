@@ -53,6 +53,39 @@ class HashAggregation : public Operator {
  private:
   void updateRuntimeStats();
 
+  // Returns true if the input is split over 'partitionGroupingSets_'.
+  bool parallelInsert() const {
+    return !partitionGroupingSets_.empty();
+  }
+
+  // Splits 'input' on the hash of the grouping keys and queues the slices for
+  // their partitions. Adds the queued input to the partitions when enough rows
+  // have been queued.
+  void addPartitionInput(const RowVectorPtr& input);
+
+  // Adds the queued input to 'partitionGroupingSets_'. The partitions are
+  // disjoint, so they are filled in parallel on 'executor_' while the driver
+  // thread works on the partitions not yet started.
+  void flushPartitionInput();
+
+  // Produces output from 'partitionGroupingSets_' one partition after the
+  // other. Returns false when all partitions are at end.
+  bool getPartitionOutput(int32_t maxOutputRows, int32_t maxOutputBytes);
+
+  // Returns true if partial aggregation keeps a cache sized hash table and
+  // flushes the groups not recently hit when the table is full.
+  bool evictGroups() const {
+    return partialAggregationCacheTableBytes_ > 0;
+  }
+
+  // Produces the output of a flush in group eviction mode. Makes further
+  // passes over the table if a pass has evicted too few groups or if all
+  // input has been received. Returns false when the flush is at end.
+  bool getEvictedOutput(int32_t maxOutputRows, int32_t maxOutputBytes);
+
+  // Returns the sum of the hash table stats over the grouping sets.
+  HashTableStats hashTableStats() const;
+
   void prepareOutput(vector_size_t size);
 
   // Invoked to reset partial aggregation state if it was full and has been
@@ -84,6 +117,8 @@ class HashAggregation : public Operator {
 
   void updateEstimatedOutputRowSize();
 
+  void updateEstimatedOutputRowSize(std::optional<int64_t> optionalRowSize);
+
   std::shared_ptr<const core::AggregationNode> aggregationNode_;
 
   const bool isPartialOutput_;
@@ -96,6 +131,9 @@ class HashAggregation : public Operator {
   // Min unique rows pct for partial aggregation. If more than this many rows
   // are unique, the partial aggregation is not worthwhile.
   const int32_t abandonPartialAggregationMinPct_;
+  // Size of the hash table of a partial aggregation in group eviction mode. 0
+  // if not in group eviction mode.
+  uint64_t partialAggregationCacheTableBytes_{0};
 
   int64_t maxPartialAggregationMemoryUsage_;
   std::unique_ptr<GroupingSet> groupingSet_;
@@ -124,6 +162,34 @@ class HashAggregation : public Operator {
 
   // Possibly reusable output vector.
   RowVectorPtr output_;
+
+  // Min number of queued rows to add to the partitions in parallel.
+  static constexpr vector_size_t kMinParallelInsertRows = 64 << 10;
+
+  // Grouping sets of the disjoint hash partitions of a final aggregation in
+  // parallel insert mode. 'groupingSet_' is not used then. Empty if not in
+  // parallel insert mode.
+  std::vector<std::unique_ptr<GroupingSet>> partitionGroupingSets_;
+
+  // Hashers for the grouping keys for assigning the rows to partitions.
+  std::vector<std::unique_ptr<VectorHasher>> partitionHashers_;
+
+  // Executor for filling the partitions. Partitions are filled on the driver
+  // thread if nullptr.
+  folly::Executor* executor_{nullptr};
+
+  // Input slices queued for each of 'partitionGroupingSets_'.
+  std::vector<std::vector<RowVectorPtr>> pendingPartitionInput_;
+  vector_size_t numPendingRows_{0};
+
+  // The partition producing output.
+  size_t outputPartition_{0};
+
+  // Reusable memory for partitioning the input.
+  SelectivityVector partitionRows_;
+  raw_vector<uint64_t> partitionHashes_;
+  std::vector<vector_size_t> partitionSizes_;
+  std::vector<BufferPtr> partitionIndices_;
 };
 
 } // namespace facebook::velox::exec
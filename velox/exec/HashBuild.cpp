@@ -71,6 +71,18 @@ HashBuild::HashBuild(
 
   joinBridge_->addBuilder();
 
+  if (joinNode_->useHashTableCache()) {
+    cacheEntry_ = HashTableCache::instance()->get(
+        operatorCtx_->task(),
+        operatorCtx_->driverCtx()->splitGroupId,
+        planNodeId());
+    cacheBuilder_ = cacheEntry_->isBuilder(operatorCtx_->taskId());
+    if (cacheBuilder_) {
+      cacheEntry_->addPool(pool()->shared_from_this());
+      joinBridge_->setHashTableCacheEntry(cacheEntry_);
+    }
+  }
+
   const auto& inputType = joinNode_->sources()[1]->outputType();
 
   const auto numKeys = joinNode_->rightKeys().size();
@@ -113,6 +125,14 @@ void HashBuild::initialize() {
   if (isAntiJoin(joinType_) && joinNode_->filter()) {
     setupFilterForAntiJoins(keyChannelMap_);
   }
+
+  swapRows_ = adaptiveJoinSwapRows(
+      joinNode_, operatorCtx_->driverCtx()->queryConfig());
+  if (swapRows_ > 0 &&
+      !operatorCtx_->task()->hasMixedExecutionGroupJoin(joinNode_.get()) &&
+      joinBridge_->canSwapJoinSides()) {
+    swapState_ = SwapState::kCollecting;
+  }
 }
 
 void HashBuild::setupTable() {
@@ -308,6 +328,14 @@ void HashBuild::removeInputRowsForAntiJoinFilter() {
 
 void HashBuild::addInput(RowVectorPtr input) {
   checkRunning();
+  if (useCachedTable() && cacheEntry_->built()) {
+    // The input is not needed once another task has built the table.
+    return;
+  }
+  if (swapState_ != SwapState::kDisabled) {
+    addSwapInput(std::move(input));
+    return;
+  }
   ensureInputFits(input);
 
   TestValue::adjust("facebook::velox::exec::HashBuild::addInput", this);
@@ -424,6 +452,83 @@ void HashBuild::addInput(RowVectorPtr input) {
   });
 }
 
+void HashBuild::addSwapInput(RowVectorPtr input) {
+  if (swapState_ == SwapState::kSwapped) {
+    if (!joinBridge_->addSwappedBuildInput(std::move(input), &future_)) {
+      setState(State::kWaitForProbe);
+    }
+    return;
+  }
+  VELOX_CHECK(swapState_ == SwapState::kCollecting);
+  // Load lazy vectors as 'input' is kept past the next input.
+  input->loadedVector();
+  numSwapInputRows_ += input->size();
+  swapInputs_.push_back(std::move(input));
+  if (numSwapInputRows_ > swapRows_) {
+    swapState_ = SwapState::kDeciding;
+    joinBridge_->setSwapBuildRows(numSwapInputRows_);
+    decideJoinSideSwap();
+  }
+}
+
+void HashBuild::noMoreSwapInput() {
+  switch (swapState_) {
+    case SwapState::kCollecting:
+      swapState_ = SwapState::kDeciding;
+      joinBridge_->setSwapBuildRows(numSwapInputRows_);
+      decideJoinSideSwap();
+      break;
+    case SwapState::kSwapped:
+      joinBridge_->noMoreSwappedBuildInput();
+      setState(State::kFinish);
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+void HashBuild::decideJoinSideSwap() {
+  checkRunning();
+  VELOX_CHECK(swapState_ == SwapState::kDeciding);
+
+  const auto swapped = joinBridge_->joinSidesSwappedOrFuture(&future_);
+  if (!swapped.has_value()) {
+    VELOX_CHECK(future_.valid());
+    setState(State::kWaitForProbe);
+    return;
+  }
+  addRuntimeStat(
+      HashJoinBridge::kSwapBuildRows, RuntimeCounter(numSwapInputRows_));
+  auto inputs = std::move(swapInputs_);
+
+  if (!swapped.value()) {
+    swapState_ = SwapState::kDisabled;
+    for (auto& input : inputs) {
+      addInput(std::move(input));
+    }
+    if (noMoreInput_) {
+      noMoreInputInternal();
+    }
+    return;
+  }
+
+  swapState_ = SwapState::kSwapped;
+  addRuntimeStat(HashJoinBridge::kJoinSidesSwapped, RuntimeCounter(1));
+  ContinueFuture future{ContinueFuture::makeEmpty()};
+  bool queueFull{false};
+  for (auto& input : inputs) {
+    queueFull = !joinBridge_->addSwappedBuildInput(std::move(input), &future);
+  }
+  if (noMoreInput_) {
+    // The queued inputs are consumed by the probe side after this finishes.
+    joinBridge_->noMoreSwappedBuildInput();
+    setState(State::kFinish);
+  } else if (queueFull) {
+    future_ = std::move(future);
+    setState(State::kWaitForProbe);
+  }
+}
+
 void HashBuild::ensureInputFits(RowVectorPtr& input) {
   // NOTE: we don't need memory reservation if all the partitions are spilling
   // as we spill all the input rows to disk directly.
@@ -621,6 +726,11 @@ void HashBuild::spillPartition(
 }
 
 void HashBuild::noMoreInput() {
+  if (useCachedTable()) {
+    // The table may come from another task. See finishCachedHashBuild().
+    Operator::noMoreInput();
+    return;
+  }
   checkRunning();
 
   if (noMoreInput_) {
@@ -628,6 +738,10 @@ void HashBuild::noMoreInput() {
   }
   Operator::noMoreInput();
 
+  if (swapState_ != SwapState::kDisabled) {
+    noMoreSwapInput();
+    return;
+  }
   noMoreInputInternal();
 }
 
@@ -794,6 +908,40 @@ bool HashBuild::finishHashBuild() {
   return true;
 }
 
+void HashBuild::finishCachedHashBuild() {
+  TestValue::adjust(
+      "facebook::velox::exec::HashBuild::finishCachedHashBuild", this);
+
+  checkRunning();
+  VELOX_CHECK(useCachedTable());
+
+  auto buildResult = cacheEntry_->buildResultOrFuture(&future_);
+  if (!buildResult.has_value()) {
+    if (future_.valid()) {
+      setState(State::kWaitForBuild);
+      return;
+    }
+    // The building task has closed without building the table. Builds the
+    // table from the input of this task instead.
+    VELOX_CHECK(noMoreInput_);
+    cacheEntry_.reset();
+    stats_.wlock()->addRuntimeStat(kHashTableCacheFallback, RuntimeCounter(1));
+    noMoreInputInternal();
+    return;
+  }
+
+  {
+    // Frees the input added before the table was built.
+    std::lock_guard<std::mutex> l(mutex_);
+    table_->clear(true);
+  }
+  pool()->release();
+  joinBridge_->setCachedHashBuildResult(
+      std::move(buildResult.value()), cacheEntry_);
+  stats_.wlock()->addRuntimeStat(kUsedCachedHashTable, RuntimeCounter(1));
+  setState(State::kFinish);
+}
+
 void HashBuild::ensureTableFits(uint64_t numRows) {
   // NOTE: we don't need memory reservation if all the partitions have been
   // spilled as nothing need to be built.
@@ -965,6 +1113,8 @@ BlockingReason HashBuild::isBlocked(ContinueFuture* future) {
     case State::kRunning:
       if (isInputFromSpill()) {
         processSpillInput();
+      } else if (useCachedTable() && (noMoreInput_ || cacheEntry_->built())) {
+        finishCachedHashBuild();
       }
       break;
     case State::kYield:
@@ -979,7 +1129,13 @@ BlockingReason HashBuild::isBlocked(ContinueFuture* future) {
     case State::kWaitForProbe:
       if (!future_.valid()) {
         setRunning();
-        postHashBuildProcess();
+        if (swapState_ == SwapState::kDeciding) {
+          decideJoinSideSwap();
+        } else if (useCachedTable()) {
+          finishCachedHashBuild();
+        } else if (swapState_ != SwapState::kSwapped) {
+          postHashBuildProcess();
+        }
       }
       break;
     default:
@@ -1018,7 +1174,7 @@ void HashBuild::checkStateTransition(State state) {
   VELOX_CHECK_NE(state_, state);
   switch (state) {
     case State::kRunning:
-      if (!canSpill()) {
+      if (!canSpill() && swapState_ == SwapState::kDisabled) {
         VELOX_CHECK_EQ(state_, State::kWaitForBuild);
       } else {
         VELOX_CHECK_NE(state_, State::kFinish);
@@ -1175,6 +1331,15 @@ void HashBuild::close() {
     spiller_.reset();
     table_.reset();
   }
+  swapInputs_.clear();
+  if (cacheEntry_ != nullptr) {
+    if (cacheBuilder_) {
+      // Makes the tasks waiting for the table build their own if this task has
+      // not built it.
+      cacheEntry_->abandon();
+    }
+    cacheEntry_.reset();
+  }
 }
 
 HashBuildSpiller::HashBuildSpiller(
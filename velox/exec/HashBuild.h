@@ -17,6 +17,7 @@
 
 #include "velox/exec/HashJoinBridge.h"
 #include "velox/exec/HashTable.h"
+#include "velox/exec/HashTableCache.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/Spill.h"
 #include "velox/exec/Spiller.h"
@@ -38,6 +39,16 @@ class HashBuildSpiller;
 /// their state.
 class HashBuild final : public Operator {
  public:
+  /// Runtime stat reported with value 1 by the HashBuild operators that use
+  /// a table built by another task through HashTableCache.
+  static inline const std::string kUsedCachedHashTable{"usedCachedHashTable"};
+
+  /// Runtime stat reported with value 1 by the HashBuild operators that build
+  /// their own table because the task building the table for HashTableCache
+  /// has closed without building it.
+  static inline const std::string kHashTableCacheFallback{
+      "hashTableCacheFallback"};
+
   /// Define the internal execution state for hash build.
   enum class State {
     /// The running state.
@@ -206,6 +217,44 @@ class HashBuild final : public Operator {
   // not.
   bool nonReclaimableState() const;
 
+  // Progress of the adaptive join side swap. See
+  // QueryConfig::hashJoinAdaptiveSwapRows().
+  enum class SwapState {
+    // The swap does not apply or the join sides are not swapped.
+    kDisabled,
+    // Buffers the input in 'swapInputs_' until there are more than
+    // 'swapRows_' rows or no more input.
+    kCollecting,
+    // Waits for the probe side to decide on the swap.
+    kDeciding,
+    // The join sides are swapped. The input is passed to the probe side.
+    kSwapped,
+  };
+
+  // Invoked to add 'input' while the adaptive join side swap is in progress.
+  void addSwapInput(RowVectorPtr input);
+
+  // Invoked when there is no more input while the adaptive join side swap is
+  // in progress.
+  void noMoreSwapInput();
+
+  // Gets the swap decision from 'joinBridge_' or waits for it. Then either
+  // passes 'swapInputs_' to the probe side or adds them to 'table_'.
+  void decideJoinSideSwap();
+
+  // True if this operator uses the table built by another task through
+  // 'cacheEntry_'. The input is added to 'table_' until the table is built,
+  // and ignored after.
+  bool useCachedTable() const {
+    return cacheEntry_ != nullptr && !cacheBuilder_;
+  }
+
+  // Gets the table built by another task from 'cacheEntry_' or waits for it.
+  // Then frees 'table_', passes the cached table to the probe side and
+  // finishes. If the building task has abandoned 'cacheEntry_', builds the
+  // table from the input in 'table_' as if the cache was not used.
+  void finishCachedHashBuild();
+
   const std::shared_ptr<const core::HashJoinNode> joinNode_;
 
   const core::JoinType joinType_;
@@ -221,6 +270,13 @@ class HashBuild final : public Operator {
 
   std::shared_ptr<HashJoinBridge> joinBridge_;
 
+  // Set if the join uses the hash table cache. See
+  // core::HashJoinNode::useHashTableCache().
+  std::shared_ptr<HashTableCacheEntry> cacheEntry_;
+
+  // True if this operator's task builds the table of 'cacheEntry_'.
+  bool cacheBuilder_{false};
+
   tsan_atomic<bool> exceededMaxSpillLevelLimit_{false};
 
   State state_{State::kRunning};
@@ -312,6 +368,16 @@ class HashBuild final : public Operator {
 
   // Maps key channel in 'input_' to channel in key.
   folly::F14FastMap<column_index_t, column_index_t> keyChannelMap_;
+
+  // The number of rows to buffer for the adaptive join side swap. 0 if the
+  // swap does not apply.
+  uint32_t swapRows_{0};
+
+  SwapState swapState_{SwapState::kDisabled};
+
+  // The input buffered for the adaptive join side swap.
+  std::vector<RowVectorPtr> swapInputs_;
+  uint64_t numSwapInputRows_{0};
 };
 
 inline std::ostream& operator<<(std::ostream& os, HashBuild::State state) {
@@ -17,6 +17,7 @@
 #include "velox/exec/HashJoinBridge.h"
 #include "velox/common/memory/MemoryArbitrator.h"
 #include "velox/exec/HashBuild.h"
+#include "velox/exec/HashTableCache.h"
 
 namespace facebook::velox::exec {
 namespace {
@@ -65,6 +66,17 @@ void HashJoinBridge::addBuilder() {
   ++numBuilders_;
 }
 
+void HashJoinBridge::addProber() {
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numProbers_;
+}
+
+bool HashJoinBridge::canSwapJoinSides() {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(started_);
+  return numBuilders_ == 1 && numProbers_ == 1;
+}
+
 void HashJoinBridge::reclaim() {
   std::lock_guard<std::mutex> l(mutex_);
   VELOX_CHECK(tableSpillFunc_ == nullptr || !probeStarted_);
@@ -219,6 +231,8 @@ void HashJoinBridge::setHashTable(
   VELOX_CHECK_NOT_NULL(table, "setHashTable called with null table");
   VELOX_CHECK(table->numDistinct() == 0 || spillPartitionSet.empty());
   std::vector<ContinuePromise> promises;
+  std::shared_ptr<HashTableCacheEntry> cacheEntry;
+  std::optional<HashBuildResult> cachedResult;
   {
     std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK(started_);
@@ -236,8 +250,15 @@ void HashJoinBridge::setHashTable(
         hasNullKeys);
     restoringSpillPartitionId_.reset();
     promises = std::move(promises_);
+    if (cacheBuilder_) {
+      cacheEntry = cacheEntry_;
+      cachedResult = buildResult_;
+    }
   }
   notify(std::move(promises));
+  if (cacheEntry != nullptr) {
+    cacheEntry->setBuildResult(std::move(cachedResult.value()));
+  }
 }
 
 void HashJoinBridge::setHashTable(
@@ -280,6 +301,7 @@ void HashJoinBridge::appendSpilledHashTablePartitionsLocked(
 
 void HashJoinBridge::setAntiJoinHasNullKeys() {
   std::vector<ContinuePromise> promises;
+  std::shared_ptr<HashTableCacheEntry> cacheEntry;
   {
     std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK(started_);
@@ -290,6 +312,41 @@ void HashJoinBridge::setAntiJoinHasNullKeys() {
     restoringSpillPartitionId_.reset();
     spillPartitionSet_.clear();
     promises = std::move(promises_);
+    if (cacheBuilder_) {
+      cacheEntry = cacheEntry_;
+    }
+  }
+  notify(std::move(promises));
+  if (cacheEntry != nullptr) {
+    cacheEntry->setBuildResult(HashBuildResult{});
+  }
+}
+
+void HashJoinBridge::setHashTableCacheEntry(
+    std::shared_ptr<HashTableCacheEntry> cacheEntry) {
+  VELOX_CHECK_NOT_NULL(cacheEntry);
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!buildResult_.has_value());
+  VELOX_CHECK(cacheEntry_ == nullptr || cacheEntry_ == cacheEntry);
+  cacheEntry_ = std::move(cacheEntry);
+  cacheBuilder_ = true;
+}
+
+void HashJoinBridge::setCachedHashBuildResult(
+    HashBuildResult result,
+    std::shared_ptr<HashTableCacheEntry> cacheEntry) {
+  VELOX_CHECK_NOT_NULL(cacheEntry);
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(started_);
+    VELOX_CHECK(!cacheBuilder_);
+    if (buildResult_.has_value()) {
+      return;
+    }
+    cacheEntry_ = std::move(cacheEntry);
+    buildResult_ = std::move(result);
+    promises = std::move(promises_);
   }
   notify(std::move(promises));
 }
@@ -313,12 +370,44 @@ std::optional<HashJoinBridge::HashBuildResult> HashJoinBridge::tableOrFuture(
   return std::nullopt;
 }
 
+std::optional<HashJoinBridge::BloomFilters>
+HashJoinBridge::bloomFiltersOrFuture(ContinueFuture* future) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!cancelled_, "Getting bloom filters after join is aborted");
+  VELOX_CHECK(buildResult_.has_value());
+  if (bloomFilters_.has_value()) {
+    return bloomFilters_.value();
+  }
+  if (!buildingBloomFilters_) {
+    buildingBloomFilters_ = true;
+    return std::nullopt;
+  }
+  bloomFilterPromises_.emplace_back("HashJoinBridge::bloomFiltersOrFuture");
+  *future = bloomFilterPromises_.back().getSemiFuture();
+  return std::nullopt;
+}
+
+void HashJoinBridge::setBloomFilters(BloomFilters filters) {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(buildingBloomFilters_);
+    VELOX_CHECK(!bloomFilters_.has_value());
+    bloomFilters_ = std::move(filters);
+    promises = std::move(bloomFilterPromises_);
+  }
+  notify(std::move(promises));
+}
+
 void HashJoinBridge::probeFinished(bool restart) {
   std::vector<ContinuePromise> promises;
   {
     std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK(started_);
     VELOX_CHECK(buildResult_.has_value());
+    VELOX_CHECK(bloomFilterPromises_.empty());
+    buildingBloomFilters_ = false;
+    bloomFilters_.reset();
     VELOX_CHECK(
         !restoringSpillPartitionId_.has_value() &&
         restoringSpillShards_.empty());
@@ -392,6 +481,102 @@ std::optional<HashJoinBridge::SpillInput> HashJoinBridge::spillInputOrFuture(
   return SpillInput(std::move(spillShard));
 }
 
+void HashJoinBridge::setSwapBuildRows(uint64_t numRows) {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(started_);
+    VELOX_CHECK(!swapBuildRows_.has_value());
+    swapBuildRows_ = numRows;
+    promises = std::move(promises_);
+  }
+  notify(std::move(promises));
+}
+
+void HashJoinBridge::setSwapProbeRows(uint64_t numRows, bool finished) {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(started_);
+    VELOX_CHECK(!swapProbeRows_.has_value());
+    swapProbeRows_ = numRows;
+    swapProbeFinished_ = finished;
+    promises = std::move(promises_);
+  }
+  notify(std::move(promises));
+}
+
+std::optional<bool> HashJoinBridge::joinSidesSwappedOrFuture(
+    ContinueFuture* future) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(started_);
+  VELOX_CHECK(!cancelled_, "Getting join side swap after join is aborted");
+  if (swapBuildRows_.has_value() && swapProbeRows_.has_value()) {
+    // An empty probe side makes the join return nothing without building the
+    // table, so there is nothing to gain from a swap.
+    return swapProbeFinished_ && swapProbeRows_.value() > 0 &&
+        swapProbeRows_.value() < swapBuildRows_.value();
+  }
+  promises_.emplace_back("HashJoinBridge::joinSidesSwappedOrFuture");
+  *future = promises_.back().getSemiFuture();
+  return std::nullopt;
+}
+
+bool HashJoinBridge::addSwappedBuildInput(
+    RowVectorPtr input,
+    ContinueFuture* future) {
+  std::vector<ContinuePromise> promises;
+  bool full{false};
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(started_);
+    VELOX_CHECK(!cancelled_, "Adding build input after join is aborted");
+    VELOX_CHECK(!noMoreSwappedBuildInput_);
+    swappedBuildInputs_.push_back(std::move(input));
+    promises = std::move(promises_);
+    if (swappedBuildInputs_.size() >= kMaxSwappedBuildInputs) {
+      promises_.emplace_back("HashJoinBridge::addSwappedBuildInput");
+      *future = promises_.back().getSemiFuture();
+      full = true;
+    }
+  }
+  notify(std::move(promises));
+  return !full;
+}
+
+void HashJoinBridge::noMoreSwappedBuildInput() {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(started_);
+    noMoreSwappedBuildInput_ = true;
+    promises = std::move(promises_);
+  }
+  notify(std::move(promises));
+}
+
+RowVectorPtr HashJoinBridge::swappedBuildInputOrFuture(ContinueFuture* future) {
+  std::vector<ContinuePromise> promises;
+  RowVectorPtr input;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(started_);
+    VELOX_CHECK(!cancelled_, "Getting build input after join is aborted");
+    if (swappedBuildInputs_.empty()) {
+      if (!noMoreSwappedBuildInput_) {
+        promises_.emplace_back("HashJoinBridge::swappedBuildInputOrFuture");
+        *future = promises_.back().getSemiFuture();
+      }
+      return nullptr;
+    }
+    input = std::move(swappedBuildInputs_.front());
+    swappedBuildInputs_.pop_front();
+    promises = std::move(promises_);
+  }
+  notify(std::move(promises));
+  return input;
+}
+
 bool HashJoinBridge::testingHasMoreSpilledPartitions() {
   std::lock_guard<std::mutex> l(mutex_);
   return spillPartitionSet_.hasNext();
@@ -404,6 +589,17 @@ bool isLeftNullAwareJoinWithFilter(
       joinNode->isNullAware() && (joinNode->filter() != nullptr);
 }
 
+uint32_t adaptiveJoinSwapRows(
+    const std::shared_ptr<const core::HashJoinNode>& joinNode,
+    const core::QueryConfig& config) {
+  if (!joinNode->isInnerJoin() || joinNode->filter() != nullptr ||
+      joinNode->isNullAware() || joinNode->useHashTableCache() ||
+      joinNode->canSpill(config)) {
+    return 0;
+  }
+  return config.hashJoinAdaptiveSwapRows();
+}
+
 uint64_t HashJoinMemoryReclaimer::reclaim(
     memory::MemoryPool* pool,
     uint64_t targetBytes,
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <deque>
+
 #include "velox/exec/HashBitRange.h"
 #include "velox/exec/HashTable.h"
 #include "velox/exec/JoinBridge.h"
@@ -27,6 +29,7 @@ struct HashTableHolder;
 
 namespace facebook::velox::exec {
 class HashBuildSpiller;
+class HashTableCacheEntry;
 
 namespace test {
 class HashJoinBridgeTestHelper;
@@ -41,6 +44,14 @@ using HashJoinTableSpillFunc =
 /// the same name.
 class HashJoinBridge : public JoinBridge {
  public:
+  /// Runtime stats of HashBuild and HashProbe operators for the adaptive join
+  /// side swap. The row counts are the rows each operator buffered before the
+  /// swap decision. 'kJoinSidesSwapped' is only reported if the join sides are
+  /// swapped.
+  static inline const std::string kJoinSidesSwapped{"joinSidesSwapped"};
+  static inline const std::string kSwapBuildRows{"joinSideSwapBuildRows"};
+  static inline const std::string kSwapProbeRows{"joinSideSwapProbeRows"};
+
   void start() override;
 
   /// Invoked by HashBuild operator ctor to add to this bridge by incrementing
@@ -48,6 +59,14 @@ class HashJoinBridge : public JoinBridge {
   /// HashBuild operators to parallelize the restoring operation.
   void addBuilder();
 
+  /// Invoked by HashProbe operator ctor to increment 'numProbers_'.
+  void addProber();
+
+  /// Returns true if the build and probe sides of the join can be swapped at
+  /// runtime, which requires a single build and a single probe operator. See
+  /// QueryConfig::hashJoinAdaptiveSwapRows().
+  bool canSwapJoinSides();
+
   void reclaim();
 
   /// Invoked by the build operator to set the built hash table.
@@ -71,6 +90,18 @@ class HashJoinBridge : public JoinBridge {
 
   void setAntiJoinHasNullKeys();
 
+  /// Invoked by the HashBuild operators of the task that builds the table of
+  /// 'cacheEntry'. The build result is passed to 'cacheEntry' when set.
+  void setHashTableCacheEntry(std::shared_ptr<HashTableCacheEntry> cacheEntry);
+
+  /// Invoked by the HashBuild operators of a task that uses the table built by
+  /// another task for 'cacheEntry'. The first call sets 'result' as the build
+  /// result and the others are ignored. 'this' keeps 'cacheEntry' alive while
+  /// the table is in use.
+  void setCachedHashBuildResult(
+      HashBuildResult result,
+      std::shared_ptr<HashTableCacheEntry> cacheEntry);
+
   /// Represents the result of HashBuild operators. In case of an anti join, a
   /// build side entry with a null in a join key makes the join return nothing.
   /// In this case, HashBuild operators finishes early without processing all
@@ -114,6 +145,25 @@ class HashJoinBridge : public JoinBridge {
   /// optional spilling related information will be returned in HashBuildResult.
   std::optional<HashBuildResult> tableOrFuture(ContinueFuture* future);
 
+  /// Bloom filters on the join keys of the built table. The first of each pair
+  /// is the index of the key in the join keys.
+  using BloomFilters = std::vector<
+      std::pair<column_index_t, std::shared_ptr<common::Filter>>>;
+
+  /// Invoked by HashProbe operator to get the bloom filters on the join keys
+  /// of the built table. Returns the filters if they are set. Otherwise
+  /// returns std::nullopt and, if another HashProbe operator is building the
+  /// filters, sets 'future' to wait asynchronously. If 'future' is not set,
+  /// the caller is the first one and must build the filters and pass them to
+  /// setBloomFilters(), so that the table is scanned once rather than by every
+  /// HashProbe operator. The filters are reset when the probe side finishes
+  /// the table.
+  std::optional<BloomFilters> bloomFiltersOrFuture(ContinueFuture* future);
+
+  /// Invoked by the HashProbe operator that builds the bloom filters to set
+  /// them and unblock the other HashProbe operators waiting for them.
+  void setBloomFilters(BloomFilters filters);
+
   /// Invoked by HashProbe operator after finishes probing the built table to
   /// set one of the previously spilled partition to restore. The HashBuild
   /// operators will then build the next hash table from the selected spilled
@@ -141,18 +191,72 @@ class HashJoinBridge : public JoinBridge {
   /// 'spillPartition' will be set to null in the returned SpillInput.
   std::optional<SpillInput> spillInputOrFuture(ContinueFuture* future);
 
+  /// Invoked by HashBuild operator with the number of build side rows buffered
+  /// for the adaptive join side swap.
+  void setSwapBuildRows(uint64_t numRows);
+
+  /// Invoked by HashProbe operator with the number of probe side rows buffered
+  /// for the adaptive join side swap. 'finished' is true if these are all the
+  /// probe side rows.
+  void setSwapProbeRows(uint64_t numRows, bool finished);
+
+  /// Returns true if the join sides are swapped, that is, HashProbe operator
+  /// builds the hash table on the probe side rows and HashBuild operator
+  /// streams the build side input through it. The sides are swapped if the
+  /// probe side has finished with fewer rows than the build side. If either
+  /// side has not reported its rows yet, 'future' is set to wait
+  /// asynchronously and std::nullopt is returned.
+  std::optional<bool> joinSidesSwappedOrFuture(ContinueFuture* future);
+
+  /// Invoked by HashBuild operator to pass 'input' to HashProbe operator after
+  /// the join sides are swapped. Returns false and sets 'future' if the queued
+  /// inputs have reached the limit. 'input' is queued in either case.
+  bool addSwappedBuildInput(RowVectorPtr input, ContinueFuture* future);
+
+  /// Invoked by HashBuild operator when there is no more build side input
+  /// after the join sides are swapped.
+  void noMoreSwappedBuildInput();
+
+  /// Invoked by HashProbe operator to get the next build side input after the
+  /// join sides are swapped. If no input is queued, returns nullptr and sets
+  /// 'future' to wait asynchronously unless there is no more build side input.
+  RowVectorPtr swappedBuildInputOrFuture(ContinueFuture* future);
+
   bool testingHasMoreSpilledPartitions();
 
  private:
+  // Max number of build side inputs queued for HashProbe operator after the
+  // join sides are swapped.
+  static constexpr uint32_t kMaxSwappedBuildInputs = 4;
+
   void appendSpilledHashTablePartitionsLocked(
       SpillPartitionSet&& spillPartitionSet);
 
   uint32_t numBuilders_{0};
 
+  uint32_t numProbers_{0};
+
+  // Set if the table is shared through HashTableCache. Keeps the entry in use
+  // for the lifetime of 'this'. Declared before 'buildResult_' so that a
+  // cached table is freed before the entry.
+  std::shared_ptr<HashTableCacheEntry> cacheEntry_;
+  // True if the task of 'this' builds the table of 'cacheEntry_'. The build
+  // result is then passed to 'cacheEntry_' when set.
+  bool cacheBuilder_{false};
+
   // The result of the build side. It is set by the last build operator when
   // build is done.
   std::optional<HashBuildResult> buildResult_;
 
+  // True if a HashProbe operator is building the bloom filters of the
+  // current table.
+  bool buildingBloomFilters_{false};
+  // Set by the HashProbe operator that builds the bloom filters of the
+  // current table.
+  std::optional<BloomFilters> bloomFilters_;
+  // The HashProbe operators waiting for 'bloomFilters_' to be set.
+  std::vector<ContinuePromise> bloomFilterPromises_;
+
   // Spill function that lets hash join bridge spill the hash table on behalf of
   // the hash build operator after the table ownership transfer, and before
   // probing.
@@ -183,6 +287,20 @@ class HashJoinBridge : public JoinBridge {
   // processing.
   bool probeStarted_;
 
+  // Rows buffered by HashBuild and HashProbe operators for the adaptive join
+  // side swap. Set when the operator reports them.
+  std::optional<uint64_t> swapBuildRows_;
+  std::optional<uint64_t> swapProbeRows_;
+
+  // True if 'swapProbeRows_' are all the probe side rows.
+  bool swapProbeFinished_{false};
+
+  // The build side inputs passed from HashBuild to HashProbe operator after
+  // the join sides are swapped.
+  std::deque<RowVectorPtr> swappedBuildInputs_;
+
+  bool noMoreSwappedBuildInput_{false};
+
   friend test::HashJoinBridgeTestHelper;
 };
 
@@ -191,6 +309,13 @@ class HashJoinBridge : public JoinBridge {
 bool isLeftNullAwareJoinWithFilter(
     const std::shared_ptr<const core::HashJoinNode>& joinNode);
 
+/// Returns the number of rows HashBuild and HashProbe operators of 'joinNode'
+/// buffer for the adaptive join side swap, or 0 if the swap does not apply to
+/// 'joinNode'. See QueryConfig::hashJoinAdaptiveSwapRows().
+uint32_t adaptiveJoinSwapRows(
+    const std::shared_ptr<const core::HashJoinNode>& joinNode,
+    const core::QueryConfig& config);
+
 class HashJoinMemoryReclaimer final : public MemoryReclaimer {
  public:
   static std::unique_ptr<memory::MemoryReclaimer> create(
@@ -132,6 +132,7 @@ HashProbe::HashProbe(
       filterResult_(1),
       outputTableRowsCapacity_(outputBatchSize_) {
   VELOX_CHECK_NOT_NULL(joinBridge_);
+  joinBridge_->addProber();
 }
 
 void HashProbe::initialize() {
@@ -185,6 +186,14 @@ void HashProbe::initialize() {
   if (nullAware_) {
     filterTableResult_.resize(1);
   }
+
+  swapRows_ = adaptiveJoinSwapRows(
+      joinNode_, operatorCtx_->driverCtx()->queryConfig());
+  if (swapRows_ > 0 &&
+      !operatorCtx_->task()->hasMixedExecutionGroupJoin(joinNode_.get()) &&
+      joinBridge_->canSwapJoinSides()) {
+    swapState_ = SwapState::kCollecting;
+  }
 }
 
 void HashProbe::initializeFilter(
@@ -413,10 +422,14 @@ void HashProbe::asyncWaitForHashTable() {
   if (table_->numDistinct() == 0) {
     if (skipProbeOnEmptyBuild()) {
       if (!needToSpillInput()) {
+        // The inputs buffered for the adaptive join side swap have no match.
+        // These may have been all the input.
+        swapInputs_.clear();
         if (isSpillInput() ||
-            operatorCtx_->driverCtx()
-                ->queryConfig()
-                .hashProbeFinishEarlyOnEmptyBuild()) {
+            (!noMoreInput_ &&
+             operatorCtx_->driverCtx()
+                 ->queryConfig()
+                 .hashProbeFinishEarlyOnEmptyBuild())) {
           noMoreInput();
         } else {
           skipInput_ = true;
@@ -428,8 +441,7 @@ void HashProbe::asyncWaitForHashTable() {
        isRightSemiFilterJoin(joinType_) ||
        (isRightSemiProjectJoin(joinType_) && !nullAware_) ||
        isRightJoin(joinType_)) &&
-      table_->hashMode() != BaseHashTable::HashMode::kHash && !isSpillInput() &&
-      !hasMoreSpillData()) {
+      !isSpillInput() && !hasMoreSpillData()) {
     // Find out whether there are any upstream operators that can accept dynamic
     // filters on all or a subset of the join keys. Create dynamic filters to
     // push down.
@@ -438,21 +450,343 @@ void HashProbe::asyncWaitForHashTable() {
     // probe input is read from spilled data and there is no upstream operators
     // involved; (2) if there is spill data to restore, then we can't filter
     // probe inputs solely based on the current table's join keys.
+    //
+    // Keys without an exact filter get a bloom filter. The hashers do not
+    // track the key values in kHash mode, so all keys get a bloom filter then.
     const auto& buildHashers = table_->hashers();
     const auto channels = operatorCtx_->driverCtx()->driver->canPushdownFilters(
         this, keyChannels_);
 
+    VELOX_CHECK(bloomFilterKeys_.empty());
     for (auto i = 0; i < keyChannels_.size(); ++i) {
       if (channels.find(keyChannels_[i]) != channels.end()) {
-        if (auto filter = buildHashers[i]->getFilter(/*nullAllowed=*/false)) {
+        std::unique_ptr<common::Filter> filter;
+        if (table_->hashMode() != BaseHashTable::HashMode::kHash) {
+          filter = buildHashers[i]->getFilter(/*nullAllowed=*/false);
+        }
+        if (filter != nullptr) {
           dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
+        } else {
+          bloomFilterKeys_.push_back(i);
         }
       }
     }
     hasGeneratedDynamicFilters_ = !dynamicFilters_.empty();
+    addBloomFilters();
+  }
+}
+
+void HashProbe::addSwapInput(RowVectorPtr input) {
+  VELOX_CHECK(swapState_ == SwapState::kCollecting);
+  // Load lazy vectors as 'input' is kept past the next input.
+  input->loadedVector();
+  numSwapInputRows_ += input->size();
+  swapInputs_.push_back(std::move(input));
+  if (numSwapInputRows_ > swapRows_) {
+    swapState_ = SwapState::kDeciding;
+    joinBridge_->setSwapProbeRows(numSwapInputRows_, /*finished=*/false);
+    decideJoinSideSwap();
   }
 }
 
+void HashProbe::decideJoinSideSwap() {
+  checkRunning();
+  VELOX_CHECK(swapState_ == SwapState::kDeciding);
+
+  const auto swapped = joinBridge_->joinSidesSwappedOrFuture(&future_);
+  if (!swapped.has_value()) {
+    VELOX_CHECK(future_.valid());
+    setState(ProbeOperatorState::kWaitForBuild);
+    return;
+  }
+  addRuntimeStat(
+      HashJoinBridge::kSwapProbeRows, RuntimeCounter(numSwapInputRows_));
+  if (swapped.value()) {
+    swapJoinSides();
+    return;
+  }
+  swapState_ = SwapState::kNotSwapped;
+  asyncWaitForHashTable();
+}
+
+void HashProbe::swapJoinSides() {
+  VELOX_CHECK_NULL(table_);
+  VELOX_CHECK(noMoreInput_);
+  swapState_ = SwapState::kSwapped;
+  addRuntimeStat(HashJoinBridge::kJoinSidesSwapped, RuntimeCounter(1));
+
+  const auto tableType =
+      makeTableType(probeType_.get(), joinNode_->leftKeys());
+  table_ = buildSwappedTable(tableType);
+  swapInputs_.clear();
+
+  // From here on, the build side input is probed against the probe side rows
+  // in 'table_'.
+  const auto& buildType = joinNode_->sources()[1]->outputType();
+  hashers_ = createVectorHashers(buildType, joinNode_->rightKeys());
+  keyChannels_.clear();
+  for (auto& hasher : hashers_) {
+    keyChannels_.push_back(hasher->channel());
+  }
+  lookup_ = std::make_unique<HashLookup>(hashers_, pool());
+
+  projectedInputColumns_.clear();
+  identityProjections_.clear();
+  isIdentityProjection_ = false;
+  for (auto i = 0; i < buildType->size(); ++i) {
+    auto outIndex = outputType_->getChildIdxIfExists(buildType->nameOf(i));
+    if (outIndex.has_value()) {
+      projectedInputColumns_[i] = *outIndex;
+      identityProjections_.emplace_back(i, *outIndex);
+    }
+  }
+  tableOutputProjections_.clear();
+  for (column_index_t i = 0; i < outputType_->size(); ++i) {
+    auto tableChannel = tableType->getChildIdxIfExists(outputType_->nameOf(i));
+    if (tableChannel.has_value()) {
+      tableOutputProjections_.emplace_back(tableChannel.value(), i);
+    }
+  }
+  initializeResultIter();
+
+  if (table_->numDistinct() == 0) {
+    // All the probe side keys are null. The build side input is consumed
+    // without producing output.
+    skipInput_ = true;
+  }
+}
+
+std::unique_ptr<BaseHashTable> HashProbe::buildSwappedTable(
+    const RowTypePtr& tableType) {
+  const auto numKeys = keyChannels_.size();
+  std::vector<std::unique_ptr<VectorHasher>> keyHashers;
+  keyHashers.reserve(numKeys);
+  for (auto i = 0; i < numKeys; ++i) {
+    keyHashers.emplace_back(
+        VectorHasher::create(tableType->childAt(i), keyChannels_[i]));
+  }
+  std::vector<TypePtr> dependentTypes(
+      tableType->children().begin() + numKeys, tableType->children().end());
+  std::vector<column_index_t> dependentChannels;
+  for (column_index_t i = 0; i < probeType_->size(); ++i) {
+    if (std::find(keyChannels_.begin(), keyChannels_.end(), i) ==
+        keyChannels_.end()) {
+      dependentChannels.push_back(i);
+    }
+  }
+  VELOX_CHECK_EQ(dependentChannels.size(), dependentTypes.size());
+
+  auto table = HashTable<true>::createForJoin(
+      std::move(keyHashers),
+      dependentTypes,
+      true, // allowDuplicates
+      false, // hasProbedFlag
+      operatorCtx_->driverCtx()
+          ->queryConfig()
+          .minTableRowsForParallelJoinBuild(),
+      pool());
+  auto& hashers = table->hashers();
+  auto* rows = table->rows();
+  const auto nextOffset = rows->nextOffset();
+  bool analyzeKeys = table->hashMode() != BaseHashTable::HashMode::kHash;
+  raw_vector<uint64_t> hashes;
+  std::vector<DecodedVector> decoders(dependentChannels.size());
+  SelectivityVector activeRows;
+  for (const auto& input : swapInputs_) {
+    activeRows.resize(input->size());
+    activeRows.setAll();
+    for (auto& hasher : hashers) {
+      hasher->decode(*input->childAt(hasher->channel()), activeRows);
+    }
+    // Inner join rows with null keys have no match.
+    deselectRowsWithNulls(hashers, activeRows);
+    if (!activeRows.hasSelections()) {
+      continue;
+    }
+    for (auto i = 0; i < dependentChannels.size(); ++i) {
+      decoders[i].decode(*input->childAt(dependentChannels[i]), activeRows);
+    }
+    if (analyzeKeys) {
+      hashes.resize(activeRows.end());
+      for (auto& hasher : hashers) {
+        hasher->computeValueIds(activeRows, hashes);
+        analyzeKeys = hasher->mayUseValueIds();
+        if (!analyzeKeys) {
+          break;
+        }
+      }
+    }
+    activeRows.applyToSelected([&](auto row) {
+      char* newRow = rows->newRow();
+      if (nextOffset) {
+        *reinterpret_cast<char**>(newRow + nextOffset) = nullptr;
+      }
+      for (auto i = 0; i < numKeys; ++i) {
+        rows->store(hashers[i]->decodedVector(), row, newRow, i);
+      }
+      for (auto i = 0; i < dependentChannels.size(); ++i) {
+        rows->store(decoders[i], row, newRow, i + numKeys);
+      }
+    });
+  }
+  table->prepareJoinTable({}, BaseHashTable::kNoSpillInputStartPartitionBit);
+  return table;
+}
+
+void HashProbe::addNextSwapInput() {
+  while (input_ == nullptr) {
+    RowVectorPtr input;
+    if (swapState_ == SwapState::kSwapped) {
+      input = joinBridge_->swappedBuildInputOrFuture(&future_);
+      if (future_.valid()) {
+        setState(ProbeOperatorState::kWaitForBuild);
+        return;
+      }
+    } else if (!swapInputs_.empty()) {
+      input = std::move(swapInputs_.front());
+      swapInputs_.pop_front();
+    }
+    if (input == nullptr) {
+      return;
+    }
+    addInput(std::move(input));
+  }
+}
+
+namespace {
+template <typename T>
+void addToBloomFilter(
+    const BaseVector& keys,
+    vector_size_t numRows,
+    common::BloomFilterValues::Bloom& bloom) {
+  const auto* flatKeys = keys.asUnchecked<FlatVector<T>>();
+  for (vector_size_t i = 0; i < numRows; ++i) {
+    if (flatKeys->isNullAt(i)) {
+      continue;
+    }
+    if constexpr (std::is_same_v<T, StringView>) {
+      const auto value = flatKeys->valueAt(i);
+      bloom.insert(
+          common::BloomFilterValues::hashBytes(value.data(), value.size()));
+    } else {
+      bloom.insert(common::BloomFilterValues::hashInt64(flatKeys->valueAt(i)));
+    }
+  }
+}
+} // namespace
+
+void HashProbe::addBloomFilters() {
+  if (bloomFilterKeys_.empty()) {
+    return;
+  }
+  if (operatorCtx_->driverCtx()
+          ->queryConfig()
+          .hashProbeBloomFilterPushdownMaxSize() == 0) {
+    bloomFilterKeys_.clear();
+    return;
+  }
+  auto filters = joinBridge_->bloomFiltersOrFuture(&future_);
+  if (!filters.has_value()) {
+    if (future_.valid()) {
+      setState(ProbeOperatorState::kWaitForBuild);
+      return;
+    }
+    filters = makeBloomFilters();
+    joinBridge_->setBloomFilters(filters.value());
+  }
+  bloomFilterKeys_.clear();
+  if (filters->empty()) {
+    return;
+  }
+  for (const auto& [key, filter] : filters.value()) {
+    dynamicFilters_.emplace(keyChannels_[key], filter);
+  }
+  hasGeneratedDynamicFilters_ = true;
+  addRuntimeStat("bloomFiltersProduced", RuntimeCounter(filters->size()));
+}
+
+HashJoinBridge::BloomFilters HashProbe::makeBloomFilters() {
+  const auto maxSize = operatorCtx_->driverCtx()
+                           ->queryConfig()
+                           .hashProbeBloomFilterPushdownMaxSize();
+  const auto numDistinct = table_->numDistinct();
+  // A bloom filter takes 2 bytes per entry.
+  if (numDistinct > std::numeric_limits<int32_t>::max() ||
+      bits::nextPowerOfTwo(numDistinct) * 2 > maxSize) {
+    return {};
+  }
+
+  auto* rows = table_->rows();
+  std::vector<column_index_t> filterKeys;
+  std::vector<VectorPtr> keyValues;
+  std::vector<std::shared_ptr<common::BloomFilterValues::Bloom>> blooms;
+  for (auto key : bloomFilterKeys_) {
+    const auto& type = rows->keyTypes()[key];
+    switch (type->kind()) {
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        break;
+      default:
+        continue;
+    }
+    filterKeys.push_back(key);
+    keyValues.push_back(BaseVector::create(type, 0, pool()));
+    blooms.push_back(std::make_shared<common::BloomFilterValues::Bloom>());
+    blooms.back()->reset(numDistinct);
+  }
+  if (filterKeys.empty()) {
+    return {};
+  }
+
+  BaseHashTable::RowsIterator iter;
+  std::vector<char*> tableRows(kBatchSize);
+  while (auto numRows = table_->listAllRows(
+             &iter,
+             tableRows.size(),
+             RowContainer::kUnlimited,
+             tableRows.data())) {
+    for (auto i = 0; i < filterKeys.size(); ++i) {
+      RowContainer::extractColumn(
+          tableRows.data(),
+          numRows,
+          rows->columnAt(filterKeys[i]),
+          /*columnHasNulls=*/true,
+          keyValues[i]);
+      switch (keyValues[i]->typeKind()) {
+        case TypeKind::TINYINT:
+          addToBloomFilter<int8_t>(*keyValues[i], numRows, *blooms[i]);
+          break;
+        case TypeKind::SMALLINT:
+          addToBloomFilter<int16_t>(*keyValues[i], numRows, *blooms[i]);
+          break;
+        case TypeKind::INTEGER:
+          addToBloomFilter<int32_t>(*keyValues[i], numRows, *blooms[i]);
+          break;
+        case TypeKind::BIGINT:
+          addToBloomFilter<int64_t>(*keyValues[i], numRows, *blooms[i]);
+          break;
+        default:
+          addToBloomFilter<StringView>(*keyValues[i], numRows, *blooms[i]);
+          break;
+      }
+    }
+  }
+
+  HashJoinBridge::BloomFilters filters;
+  for (auto i = 0; i < filterKeys.size(); ++i) {
+    filters.emplace_back(
+        filterKeys[i],
+        std::make_shared<common::BloomFilterValues>(
+            std::move(blooms[i]), /*nullAllowed=*/false));
+  }
+  addRuntimeStat("bloomFiltersBuilt", RuntimeCounter(filters.size()));
+  return filters;
+}
+
 bool HashProbe::isSpillInput() const {
   return spillInputReader_ != nullptr;
 }
@@ -601,14 +935,26 @@ void HashProbe::prepareInputIndicesBuffers(
 BlockingReason HashProbe::isBlocked(ContinueFuture* future) {
   switch (state_) {
     case ProbeOperatorState::kWaitForBuild:
-      VELOX_CHECK_NULL(table_);
+      VELOX_CHECK(
+          table_ == nullptr || swapState_ == SwapState::kSwapped ||
+          !bloomFilterKeys_.empty());
       if (!future_.valid()) {
         setRunning();
-        asyncWaitForHashTable();
+        if (!bloomFilterKeys_.empty()) {
+          addBloomFilters();
+        } else if (swapState_ == SwapState::kDeciding) {
+          decideJoinSideSwap();
+        } else if (
+            swapState_ != SwapState::kCollecting &&
+            swapState_ != SwapState::kSwapped) {
+          asyncWaitForHashTable();
+        }
       }
       break;
     case ProbeOperatorState::kRunning:
-      VELOX_CHECK_NOT_NULL(table_);
+      VELOX_CHECK(
+          table_ != nullptr || swapState_ == SwapState::kCollecting ||
+          swapState_ == SwapState::kDeciding);
       if (spillInputReader_ != nullptr) {
         addSpillInput();
       }
@@ -638,8 +984,14 @@ void HashProbe::clearDynamicFilters() {
   // following conditions are met:
   //  * hash table has a single key with unique values,
   //  * build side has no dependent columns.
-  if (keyChannels_.size() == 1 && !table_->hasDuplicateKeys() &&
+  // A bloom filter may pass keys that are not in the table.
+  // Inputs buffered for the adaptive join side swap were read before the
+  // filter was pushed down, so the join can not be replaced.
+  if (keyChannels_.size() == 1 && swapState_ == SwapState::kDisabled &&
+      !table_->hasDuplicateKeys() &&
       tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty() &&
+      dynamicFilters_.begin()->second->kind() !=
+          common::FilterKind::kBloomFilter &&
       !isRightJoin(joinType_)) {
     canReplaceWithDynamicFilter_ = true;
   }
@@ -664,6 +1016,10 @@ void HashProbe::decodeAndDetectNonNullKeys() {
 }
 
 void HashProbe::addInput(RowVectorPtr input) {
+  if (swapState_ == SwapState::kCollecting) {
+    addSwapInput(std::move(input));
+    return;
+  }
   if (skipInput_) {
     VELOX_CHECK_NULL(input_);
     return;
@@ -1022,6 +1378,15 @@ RowVectorPtr HashProbe::getOutputInternal(bool toSpillOutput) {
 
   clearProjectedOutput();
 
+  if (!input_ &&
+      (swapState_ == SwapState::kNotSwapped ||
+       swapState_ == SwapState::kSwapped)) {
+    addNextSwapInput();
+    if (!isRunning()) {
+      return nullptr;
+    }
+  }
+
   if (!input_) {
     if (hasMoreInput()) {
       return nullptr;
@@ -1678,6 +2043,11 @@ void HashProbe::ensureLoaded(column_index_t channel) {
 void HashProbe::noMoreInput() {
   Operator::noMoreInput();
   noMoreInputInternal();
+  if (swapState_ == SwapState::kCollecting) {
+    swapState_ = SwapState::kDeciding;
+    joinBridge_->setSwapProbeRows(numSwapInputRows_, /*finished=*/true);
+    decideJoinSideSwap();
+  }
 }
 
 bool HashProbe::hasMoreInput() const {
@@ -2050,14 +2420,16 @@ void HashProbe::checkMaxSpillLevel(
 void HashProbe::close() {
   Operator::close();
 
-  // Free up major memory usage.
+  // Free up major memory usage. 'table_' is freed before 'joinBridge_' which
+  // may keep the memory pools of a table from the hash table cache alive.
+  table_.reset();
   joinBridge_.reset();
   inputSpiller_.reset();
-  table_.reset();
   spillInputReader_.reset();
   restoringPartitionId_.reset();
   spillOutputPartitionSet_.clear();
   spillOutputReader_.reset();
+  swapInputs_.clear();
   clearBuffers();
 
   // Fullfill any pending promises
@@ -39,6 +39,12 @@ class HashProbe : public Operator {
         noMoreSpillInput_ || input_ != nullptr) {
       return false;
     }
+    if (swapState_ == SwapState::kCollecting) {
+      return true;
+    }
+    if (!swapInputs_.empty()) {
+      return false;
+    }
     if (table_) {
       return true;
     }
@@ -109,6 +115,22 @@ class HashProbe : public Operator {
   }
 
  private:
+  // Progress of the adaptive join side swap. See
+  // QueryConfig::hashJoinAdaptiveSwapRows().
+  enum class SwapState {
+    // The swap does not apply.
+    kDisabled,
+    // Buffers the input in 'swapInputs_' until there are more than
+    // 'swapRows_' rows or no more input.
+    kCollecting,
+    // Waits for the build side to report its buffered rows.
+    kDeciding,
+    // Probes the table built by HashBuild, starting with 'swapInputs_'.
+    kNotSwapped,
+    // Probes the table built on 'swapInputs_' with the build side input.
+    kSwapped,
+  };
+
   // Indicates if the join type includes misses from the left side in the
   // output.
   static bool joinIncludesMissesFromLeft(core::JoinType joinType) {
@@ -136,6 +158,38 @@ class HashProbe : public Operator {
   // the hash table.
   void asyncWaitForHashTable();
 
+  // Adds a bloom filter on each of 'bloomFilterKeys_' to 'dynamicFilters_'.
+  // The filters are built once per table by the first HashProbe operator and
+  // shared through 'joinBridge_'. If another HashProbe operator is building
+  // them, sets 'future_' to wait for it and keeps 'bloomFilterKeys_'.
+  void addBloomFilters();
+
+  // Builds the bloom filters for addBloomFilters() from the keys in 'table_'.
+  // Keys of types other than integers and strings are skipped. Returns no
+  // filters if they would be larger than
+  // QueryConfig::hashProbeBloomFilterPushdownMaxSize().
+  HashJoinBridge::BloomFilters makeBloomFilters();
+
+  // Invoked to buffer 'input' for the adaptive join side swap.
+  void addSwapInput(RowVectorPtr input);
+
+  // Gets the swap decision from 'joinBridge_' or waits for it. Then either
+  // swaps the join sides or waits for the hash table built by HashBuild.
+  void decideJoinSideSwap();
+
+  // Builds 'table_' on 'swapInputs_' and sets up the hashers and projections
+  // to probe it with the build side input.
+  void swapJoinSides();
+
+  // Returns a hash table of 'tableType' with the rows of 'swapInputs_'.
+  std::unique_ptr<BaseHashTable> buildSwappedTable(
+      const RowTypePtr& tableType);
+
+  // Adds the next input of 'swapInputs_' if the join sides are not swapped,
+  // or the next build side input if they are swapped, until there is pending
+  // 'input_'. Sets 'future_' to wait if no build side input is queued yet.
+  void addNextSwapInput();
+
   // Sets up 'filter_' and related members.
   void initializeFilter(
       const core::TypedExprPtr& filter,
@@ -419,6 +473,10 @@ class HashProbe : public Operator {
   // down to the upstream operators.
   tsan_atomic<bool> hasGeneratedDynamicFilters_{false};
 
+  // The join keys to push down bloom filters on, as indices into
+  // 'keyChannels_'. Cleared once the filters are added to 'dynamicFilters_'.
+  std::vector<column_index_t> bloomFilterKeys_;
+
   // True if the join can become a no-op starting with the next batch of input.
   bool canReplaceWithDynamicFilter_{false};
 
@@ -733,6 +791,16 @@ class HashProbe : public Operator {
 
   // Input vector used for listing rows with null keys.
   VectorPtr nullKeyProbeInput_;
+
+  // The number of rows to buffer for the adaptive join side swap. 0 if the
+  // swap does not apply.
+  uint32_t swapRows_{0};
+
+  SwapState swapState_{SwapState::kDisabled};
+
+  // The input buffered for the adaptive join side swap.
+  std::deque<RowVectorPtr> swapInputs_;
+  uint64_t numSwapInputRows_{0};
 };
 
 inline std::ostream& operator<<(std::ostream& os, ProbeOperatorState state) {
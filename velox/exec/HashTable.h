@@ -486,17 +486,20 @@ class HashTable : public BaseHashTable {
 
   ~HashTable() override = default;
 
+  /// 'hasProbedFlag' adds an extra bit in every group for tracking the groups
+  /// hit by the input, see GroupingSet::enableGroupEviction().
   static std::unique_ptr<HashTable> createForAggregation(
       std::vector<std::unique_ptr<VectorHasher>>&& hashers,
       const std::vector<Accumulator>& accumulators,
-      memory::MemoryPool* pool) {
+      memory::MemoryPool* pool,
+      bool hasProbedFlag = false) {
     return std::make_unique<HashTable>(
         std::move(hashers),
         accumulators,
         std::vector<TypePtr>{},
         false, // allowDuplicates
         false, // isJoinBuild
-        false, // hasProbedFlag
+        hasProbedFlag,
         0, // minTableSizeForParallelJoinBuild
         pool);
   }
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/HashTableCache.h"
+
+#include "velox/exec/Task.h"
+
+namespace facebook::velox::exec {
+
+HashTableCacheEntry::HashTableCacheEntry(
+    std::string key,
+    std::string builderTaskId)
+    : key_(std::move(key)), builderTaskId_(std::move(builderTaskId)) {}
+
+void HashTableCacheEntry::addPool(std::shared_ptr<memory::MemoryPool> pool) {
+  std::lock_guard<std::mutex> l(mutex_);
+  pools_.push_back(std::move(pool));
+}
+
+void HashTableCacheEntry::setBuildResult(
+    HashJoinBridge::HashBuildResult result) {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(!buildResult_.has_value());
+    VELOX_CHECK(!abandoned_);
+    buildResult_ = std::move(result);
+    promises = std::move(promises_);
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
+void HashTableCacheEntry::abandon() {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (buildResult_.has_value() || abandoned_) {
+      return;
+    }
+    abandoned_ = true;
+    promises = std::move(promises_);
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
+bool HashTableCacheEntry::built() {
+  std::lock_guard<std::mutex> l(mutex_);
+  return buildResult_.has_value();
+}
+
+bool HashTableCacheEntry::abandoned() {
+  std::lock_guard<std::mutex> l(mutex_);
+  return abandoned_;
+}
+
+std::optional<HashJoinBridge::HashBuildResult>
+HashTableCacheEntry::buildResultOrFuture(ContinueFuture* future) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (buildResult_.has_value()) {
+    return buildResult_;
+  }
+  if (abandoned_) {
+    return std::nullopt;
+  }
+  promises_.emplace_back("HashTableCacheEntry::buildResultOrFuture");
+  *future = promises_.back().getSemiFuture();
+  return std::nullopt;
+}
+
+// static
+HashTableCache* HashTableCache::instance() {
+  static HashTableCache kInstance;
+  return &kInstance;
+}
+
+std::shared_ptr<HashTableCacheEntry> HashTableCache::get(
+    const std::shared_ptr<Task>& task,
+    uint32_t splitGroupId,
+    const core::PlanNodeId& planNodeId) {
+  auto key = fmt::format(
+      "{}:{}:{}", task->queryCtx()->queryId(), splitGroupId, planNodeId);
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& entry = entries_[key];
+  if (auto cached = entry.lock()) {
+    if (!cached->abandoned()) {
+      return cached;
+    }
+  }
+  // Drops the entries that are no longer in use.
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->first != key && it->second.expired()) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  auto newEntry = std::make_shared<HashTableCacheEntry>(key, task->taskId());
+  entries_[key] = newEntry;
+  return newEntry;
+}
+
+size_t HashTableCache::numEntries() {
+  std::lock_guard<std::mutex> l(mutex_);
+  size_t numEntries{0};
+  for (const auto& [_, entry] : entries_) {
+    if (!entry.expired()) {
+      ++numEntries;
+    }
+  }
+  return numEntries;
+}
+
+} // namespace facebook::velox::exec
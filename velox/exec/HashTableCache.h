@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include "velox/exec/HashJoinBridge.h"
+
+namespace facebook::velox::exec {
+
+class Task;
+
+/// A hash join table shared by the tasks of a query on the same worker. The
+/// first task that asks for the entry builds the table and the other tasks
+/// probe it read-only once it is built. Until then, the other tasks keep their
+/// build side input, so that they can build their own table if the building
+/// task fails or is cancelled. The entry keeps the memory pools of the
+/// building HashBuild operators alive so that the table can outlive the
+/// building task. The entry is owned by shared_ptr by the HashBuild operators
+/// and the HashJoinBridges of the tasks using it.
+class HashTableCacheEntry {
+ public:
+  HashTableCacheEntry(std::string key, std::string builderTaskId);
+
+  const std::string& key() const {
+    return key_;
+  }
+
+  /// Returns true if the task with 'taskId' builds the table.
+  bool isBuilder(const std::string& taskId) const {
+    return taskId == builderTaskId_;
+  }
+
+  /// Invoked by the building HashBuild operators to keep 'pool' alive while
+  /// the table is in use.
+  void addPool(std::shared_ptr<memory::MemoryPool> pool);
+
+  /// Invoked by the building task's HashJoinBridge when the table is built.
+  void setBuildResult(HashJoinBridge::HashBuildResult result);
+
+  /// Invoked by the building task's HashBuild operators on close. Wakes up the
+  /// waiting tasks if the table has not been built, e.g. because the building
+  /// task has failed, so that they build their own tables.
+  void abandon();
+
+  /// Returns true if the table is built.
+  bool built();
+
+  /// Returns true if the building task has closed without building the table.
+  bool abandoned();
+
+  /// Returns the build result if the table is built. Otherwise returns
+  /// std::nullopt and sets 'future' to wait for the table, unless the building
+  /// task has abandoned the entry.
+  std::optional<HashJoinBridge::HashBuildResult> buildResultOrFuture(
+      ContinueFuture* future);
+
+ private:
+  const std::string key_;
+  const std::string builderTaskId_;
+
+  std::mutex mutex_;
+  // Declared before 'buildResult_' so that the table is freed before the
+  // pools it is allocated from.
+  std::vector<std::shared_ptr<memory::MemoryPool>> pools_;
+  std::optional<HashJoinBridge::HashBuildResult> buildResult_;
+  bool abandoned_{false};
+  std::vector<ContinuePromise> promises_;
+};
+
+/// Node level cache of hash join tables for joins that build identical tables
+/// in all the tasks of a query, e.g. broadcast joins. See
+/// core::HashJoinNode::useHashTableCache(). The entries are keyed by query id,
+/// split group id and plan node id. Plan node ids are unique within a query,
+/// so the key also identifies the stage. An entry lives as long as a task
+/// uses it.
+class HashTableCache {
+ public:
+  static HashTableCache* instance();
+
+  /// Returns the entry for 'planNodeId' of the query of 'task'. Creates the
+  /// entry with 'task' as the building task if there is no entry in use or the
+  /// entry in use is abandoned. The abandoned entry is then dropped from the
+  /// cache. Its users build their own tables.
+  std::shared_ptr<HashTableCacheEntry> get(
+      const std::shared_ptr<Task>& task,
+      uint32_t splitGroupId,
+      const core::PlanNodeId& planNodeId);
+
+  /// Returns the number of entries in use.
+  size_t numEntries();
+
+ private:
+  std::mutex mutex_;
+  folly::F14FastMap<std::string, std::weak_ptr<HashTableCacheEntry>> entries_;
+};
+
+} // namespace facebook::velox::exec
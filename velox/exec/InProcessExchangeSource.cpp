@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/InProcessExchangeSource.h"
+#include "velox/common/testutil/TestValue.h"
+
+using facebook::velox::common::testutil::TestValue;
+
+namespace facebook::velox::exec {
+
+InProcessExchangeSource::InProcessExchangeSource(
+    const std::string& remoteTaskId,
+    int destination,
+    std::shared_ptr<ExchangeQueue> queue,
+    memory::MemoryPool* pool,
+    std::shared_ptr<OutputBufferManager> bufferManager)
+    : ExchangeSource(remoteTaskId, destination, std::move(queue), pool),
+      bufferManager_(std::move(bufferManager)) {
+  VELOX_CHECK_NOT_NULL(bufferManager_);
+}
+
+// static
+std::shared_ptr<ExchangeSource> InProcessExchangeSource::create(
+    const std::string& remoteTaskId,
+    int destination,
+    std::shared_ptr<ExchangeQueue> queue,
+    memory::MemoryPool* pool) {
+  const auto& bufferManager = OutputBufferManager::getInstanceRef();
+  if (bufferManager == nullptr ||
+      bufferManager->getBufferIfExists(remoteTaskId) == nullptr) {
+    return nullptr;
+  }
+  return std::make_shared<InProcessExchangeSource>(
+      remoteTaskId, destination, std::move(queue), pool, bufferManager);
+}
+
+// static
+void InProcessExchangeSource::registerFactory() {
+  ExchangeSource::registerFactory(InProcessExchangeSource::create);
+}
+
+bool InProcessExchangeSource::shouldRequestLocked() {
+  if (atEnd_) {
+    return false;
+  }
+  return !requestPending_.exchange(true);
+}
+
+folly::SemiFuture<ExchangeSource::Response> InProcessExchangeSource::request(
+    uint32_t maxBytes,
+    std::chrono::microseconds maxWait) {
+  auto promise = VeloxPromise<Response>("InProcessExchangeSource::request");
+  auto future = promise.getSemiFuture();
+  uint64_t requestId;
+  int64_t requestedSequence;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    VELOX_CHECK(requestPending_);
+    promise_ = std::move(promise);
+    requestId = ++requestId_;
+    requestedSequence = sequence_;
+  }
+
+  // The callback may outlive 'this' if the consumer goes away while the
+  // request is pending, so it holds a reference.
+  auto self =
+      std::static_pointer_cast<InProcessExchangeSource>(shared_from_this());
+  const bool found = bufferManager_->getData(
+      remoteTaskId_,
+      destination_,
+      maxBytes,
+      requestedSequence,
+      [self, requestId, requestedSequence](
+          std::vector<std::unique_ptr<folly::IOBuf>> data,
+          int64_t sequence,
+          std::vector<int64_t> remainingBytes) {
+        self->processData(
+            std::move(data),
+            requestId,
+            requestedSequence,
+            sequence,
+            std::move(remainingBytes));
+      });
+  if (!found) {
+    queue_->setError(
+        fmt::format("Output buffers of task {} not found", remoteTaskId_));
+    completePendingRequest();
+    return future;
+  }
+
+  // The timer must not keep 'this' alive after the consumer goes away.
+  std::weak_ptr<InProcessExchangeSource> weakSelf = self;
+  return std::move(future).within(maxWait).deferError(
+      folly::tag_t<folly::FutureTimeout>{},
+      [weakSelf, requestId](const folly::FutureTimeout&) {
+        if (auto source = weakSelf.lock()) {
+          source->timeout(requestId);
+        }
+        return Response{0, false, {}};
+      });
+}
+
+folly::SemiFuture<ExchangeSource::Response>
+InProcessExchangeSource::requestDataSizes(std::chrono::microseconds maxWait) {
+  return request(0, maxWait);
+}
+
+void InProcessExchangeSource::processData(
+    std::vector<std::unique_ptr<folly::IOBuf>> data,
+    uint64_t requestId,
+    int64_t requestedSequence,
+    int64_t sequence,
+    std::vector<int64_t> remainingBytes) {
+  if (requestedSequence > sequence && !data.empty()) {
+    const int64_t numExtra = requestedSequence - sequence;
+    VELOX_CHECK_LT(numExtra, data.size());
+    data.erase(data.begin(), data.begin() + numExtra);
+    sequence = requestedSequence;
+  }
+  if (data.empty()) {
+    sequence = requestedSequence;
+  }
+
+  std::vector<std::unique_ptr<SerializedPage>> pages;
+  bool atEnd = false;
+  int64_t totalBytes = 0;
+  for (auto& inputPage : data) {
+    if (inputPage == nullptr) {
+      atEnd = true;
+      // Keep looping, there could be extra end markers.
+      continue;
+    }
+    totalBytes += inputPage->computeChainDataLength();
+    pages.push_back(makePage(std::move(inputPage)));
+  }
+
+  try {
+    TestValue::adjust(
+        "facebook::velox::exec::InProcessExchangeSource::processData", this);
+  } catch (const std::exception& e) {
+    queue_->setError(e.what());
+    completePendingRequest();
+    return;
+  }
+
+  VeloxPromise<Response> requestPromise;
+  std::vector<ContinuePromise> queuePromises;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    if (requestId != requestId_ || !promise_.valid()) {
+      // The request has timed out or 'this' is closed.
+      return;
+    }
+    requestPending_ = false;
+    requestPromise = std::move(promise_);
+    const auto numPages = pages.size();
+    for (auto& page : pages) {
+      queue_->enqueueLocked(std::move(page), queuePromises);
+    }
+    if (atEnd) {
+      queue_->enqueueLocked(nullptr, queuePromises);
+      atEnd_ = true;
+    }
+    if (!data.empty()) {
+      sequence_ = sequence + numPages;
+    }
+    numPages_ += numPages;
+    totalBytes_ += totalBytes;
+  }
+  for (auto& promise : queuePromises) {
+    promise.setValue();
+  }
+
+  // Outside of queue mutex.
+  if (atEnd) {
+    bufferManager_->deleteResults(remoteTaskId_, destination_);
+  }
+  requestPromise.setValue(
+      Response{totalBytes, atEnd, std::move(remainingBytes)});
+}
+
+void InProcessExchangeSource::timeout(uint64_t requestId) {
+  VeloxPromise<Response> promise;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    if (requestId != requestId_ || !promise_.valid()) {
+      return;
+    }
+    requestPending_ = false;
+    promise = std::move(promise_);
+  }
+  TestValue::adjust(
+      "facebook::velox::exec::InProcessExchangeSource::timeout", this);
+  // The response of the request is set by the timeout. This only releases
+  // the promise.
+  promise.setValue(Response{0, false, {}});
+}
+
+void InProcessExchangeSource::pause() {
+  TestValue::adjust(
+      "facebook::velox::exec::InProcessExchangeSource::pause", this);
+  int64_t ackSequence;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    ackSequence = sequence_;
+  }
+  bufferManager_->acknowledge(remoteTaskId_, destination_, ackSequence);
+}
+
+void InProcessExchangeSource::close() {
+  completePendingRequest();
+  bufferManager_->deleteResults(remoteTaskId_, destination_);
+}
+
+void InProcessExchangeSource::completePendingRequest() {
+  VeloxPromise<Response> promise;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    promise = std::move(promise_);
+  }
+  if (promise.valid() && !promise.isFulfilled()) {
+    promise.setValue(Response{0, false, {}});
+  }
+}
+
+folly::F14FastMap<std::string, RuntimeMetric>
+InProcessExchangeSource::metrics() const {
+  return {
+      {"inProcessExchangeSource.numPages", RuntimeMetric(numPages_)},
+      {"inProcessExchangeSource.totalBytes",
+       RuntimeMetric(totalBytes_, RuntimeCounter::Unit::kBytes)},
+  };
+}
+
+} // namespace facebook::velox::exec
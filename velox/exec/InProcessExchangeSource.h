@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/ExchangeSource.h"
+#include "velox/exec/OutputBufferManager.h"
+
+namespace facebook::velox::exec {
+
+/// ExchangeSource that fetches the pages of a task running in the same
+/// process directly from the OutputBufferManager. The pages are handed over as
+/// shared IOBufs without copying. The IOBufs keep the producing task alive,
+/// see PartitionedOutput, so the pages stay valid after the producer
+/// acknowledges them.
+///
+/// A request completes when the producer notifies it of new data, end of data
+/// or deletion of the results, or with an empty response after 'maxWait'.
+/// Applications register it with registerFactory() to read the output of
+/// tasks in the same process without a network round trip.
+class InProcessExchangeSource : public ExchangeSource {
+ public:
+  InProcessExchangeSource(
+      const std::string& remoteTaskId,
+      int destination,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool,
+      std::shared_ptr<OutputBufferManager> bufferManager);
+
+  /// ExchangeSource::Factory that returns an InProcessExchangeSource if
+  /// 'remoteTaskId' has output buffers in this process and nullptr
+  /// otherwise.
+  static std::shared_ptr<ExchangeSource> create(
+      const std::string& remoteTaskId,
+      int destination,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool);
+
+  /// Registers create() with ExchangeSource::registerFactory(). To be called
+  /// before the factories of remote sources are registered, so that tasks in
+  /// the same process are read in process.
+  static void registerFactory();
+
+  bool supportsMetrics() const override {
+    return true;
+  }
+
+  bool shouldRequestLocked() override;
+
+  folly::SemiFuture<Response> request(
+      uint32_t maxBytes,
+      std::chrono::microseconds maxWait) override;
+
+  folly::SemiFuture<Response> requestDataSizes(
+      std::chrono::microseconds maxWait) override;
+
+  void pause() override;
+
+  void close() override;
+
+  folly::F14FastMap<std::string, RuntimeMetric> metrics() const override;
+
+ protected:
+  // Returns the page to add to 'queue_' for 'data' fetched from the producer.
+  // The default shares 'data' with the producer.
+  virtual std::unique_ptr<SerializedPage> makePage(
+      std::unique_ptr<folly::IOBuf> data) {
+    return std::make_unique<SerializedPage>(std::move(data));
+  }
+
+  std::atomic<int64_t> numPages_{0};
+  std::atomic<int64_t> totalBytes_{0};
+
+ private:
+  // Invoked by the producer's OutputBuffer with the result of request number
+  // 'requestId' for 'requestedSequence'. Ignored if that request has timed
+  // out. The producer keeps the pages until they are acknowledged, so the
+  // next request fetches them again.
+  void processData(
+      std::vector<std::unique_ptr<folly::IOBuf>> data,
+      uint64_t requestId,
+      int64_t requestedSequence,
+      int64_t sequence,
+      std::vector<int64_t> remainingBytes);
+
+  // Invoked when request number 'requestId' has not completed within its
+  // 'maxWait'. Ends the request if it is still pending.
+  void timeout(uint64_t requestId);
+
+  // Completes the pending request, if any, with an empty response.
+  void completePendingRequest();
+
+  const std::shared_ptr<OutputBufferManager> bufferManager_;
+
+  // Guarded by 'queue_->mutex()'.
+  uint64_t requestId_{0};
+  // Set by request() and fulfilled by processData() or close(). Guarded by
+  // 'queue_->mutex()'.
+  VeloxPromise<Response> promise_{VeloxPromise<Response>::makeEmpty()};
+};
+
+} // namespace facebook::velox::exec
@@ -402,7 +402,11 @@ RowVectorPtr LocalPartition::wrapChildren(
 
   for (auto i = 0; i < input->childrenSize(); ++i) {
     auto& child = result->childAt(i);
-    if (child && child->encoding() == VectorEncoding::Simple::DICTIONARY &&
+    if (input->childAt(i)->isConstantEncoding()) {
+      // Constant columns stay constant. They share the value of the input.
+      child = BaseVector::wrapInConstant(size, 0, input->childAt(i));
+    } else if (
+        child && child->encoding() == VectorEncoding::Simple::DICTIONARY &&
         child.use_count() == 1) {
       child->BaseVector::resize(size);
       child->setWrapInfo(indices);
@@ -474,6 +478,9 @@ RowVectorPtr LocalPartition::processPartition(
       VELOX_CHECK(partitionData);
       partitionBuffers_[partition] = nullptr;
     }
+  } else if (size == input->size()) {
+    // All rows go to one partition. The input is passed as is.
+    partitionData = input;
   } else {
     partitionData =
         wrapChildren(input, size, indices, queues_[partition]->getVector());
@@ -38,6 +38,7 @@
 #include "velox/exec/PartitionedOutput.h"
 #include "velox/exec/RoundRobinPartitionFunction.h"
 #include "velox/exec/RowNumber.h"
+#include "velox/exec/Sample.h"
 #include "velox/exec/ScaleWriterLocalPartition.h"
 #include "velox/exec/StreamingAggregation.h"
 #include "velox/exec/TableScan.h"
@@ -121,7 +122,10 @@ OperatorSupplier makeOperatorSupplier(
           std::dynamic_pointer_cast<const core::LocalMergeNode>(planNode)) {
     return [localMerge](int32_t operatorId, DriverCtx* ctx) {
       auto mergeSource = ctx->task->addLocalMergeSource(
-          ctx->splitGroupId, localMerge->id(), localMerge->outputType());
+          ctx->splitGroupId,
+          localMerge->id(),
+          localMerge->outputType(),
+          ctx->partitionId);
       auto consumerCb =
           [mergeSource](
               RowVectorPtr input, bool drained, ContinueFuture* future) {
@@ -506,6 +510,19 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
     } else if (
         auto tableScanNode =
             std::dynamic_pointer_cast<const core::TableScanNode>(planNode)) {
+      // SYSTEM sampling of a table scan is pushed into the scan so that the
+      // dropped blocks are not read.
+      if (i < planNodes.size() - 1) {
+        auto sampleNode =
+            std::dynamic_pointer_cast<const core::SampleNode>(planNodes[i + 1]);
+        if (sampleNode != nullptr &&
+            sampleNode->method() == core::SampleNode::Method::kSystem) {
+          operators.push_back(std::make_unique<TableScan>(
+              id, ctx.get(), tableScanNode, sampleNode));
+          i++;
+          continue;
+        }
+      }
       operators.push_back(
           std::make_unique<TableScan>(id, ctx.get(), tableScanNode));
     } else if (
@@ -581,6 +598,10 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
         auto limitNode =
             std::dynamic_pointer_cast<const core::LimitNode>(planNode)) {
       operators.push_back(std::make_unique<Limit>(id, ctx.get(), limitNode));
+    } else if (
+        auto sampleNode =
+            std::dynamic_pointer_cast<const core::SampleNode>(planNode)) {
+      operators.push_back(std::make_unique<Sample>(id, ctx.get(), sampleNode));
     } else if (
         auto orderByNode =
             std::dynamic_pointer_cast<const core::OrderByNode>(planNode)) {
@@ -33,6 +33,35 @@ std::unique_ptr<VectorSerde::Options> getVectorSerdeOptions(
       common::stringToCompressionKind(queryConfig.shuffleCompressionKind());
   return options;
 }
+
+// Returns true if the only source of 'localMergeNode' is a partial OrderBy in
+// parallel merge mode, see OrderBy::isParallelMerge(). The OrderBy driver with
+// partition id i then produces the i-th key range, and the merge sources are
+// ordered by the partition ids of their producer drivers, see
+// Task::addLocalMergeSource().
+bool isRangePartitioned(
+    const core::LocalMergeNode& localMergeNode,
+    const core::QueryConfig& queryConfig) {
+  if (!queryConfig.orderByParallelMergeEnabled() ||
+      localMergeNode.sources().size() != 1) {
+    return false;
+  }
+  const auto* orderBy = dynamic_cast<const core::OrderByNode*>(
+      localMergeNode.sources()[0].get());
+  if (orderBy == nullptr || !orderBy->isPartial() ||
+      (queryConfig.spillEnabled() && orderBy->canSpill(queryConfig)) ||
+      orderBy->sortingOrders() != localMergeNode.sortingOrders() ||
+      orderBy->sortingKeys().size() != localMergeNode.sortingKeys().size()) {
+    return false;
+  }
+  for (auto i = 0; i < orderBy->sortingKeys().size(); ++i) {
+    if (orderBy->sortingKeys()[i]->name() !=
+        localMergeNode.sortingKeys()[i]->name()) {
+      return false;
+    }
+  }
+  return true;
+}
 } // namespace
 
 Merge::Merge(
@@ -43,14 +72,16 @@ Merge::Merge(
         sortingKeys,
     const std::vector<core::SortOrder>& sortingOrders,
     const std::string& planNodeId,
-    const std::string& operatorType)
+    const std::string& operatorType,
+    bool concatenateSources)
     : SourceOperator(
           driverCtx,
           std::move(outputType),
           operatorId,
           planNodeId,
           operatorType),
-      outputBatchSize_{outputBatchRows()} {
+      outputBatchSize_{outputBatchRows()},
+      concatenateSources_{concatenateSources} {
   auto numKeys = sortingKeys.size();
   sortingKeys_.reserve(numKeys);
   for (int i = 0; i < numKeys; ++i) {
@@ -103,8 +134,9 @@ BlockingReason Merge::isBlocked(ContinueFuture* future) {
 
   startSources();
 
-  // No merging is needed if there is only one source.
-  if (streams_.empty() && sources_.size() > 1) {
+  // No merging is needed if there is only one source or the sources are
+  // concatenated.
+  if (streams_.empty() && sources_.size() > 1 && !concatenateSources_) {
     initializeTreeOfLosers();
   }
 
@@ -151,18 +183,24 @@ RowVectorPtr Merge::getOutput() {
 
   VELOX_CHECK_EQ(numStartedSources_, sources_.size());
 
-  // No merging is needed if there is only one source.
-  if (sources_.size() == 1) {
-    ContinueFuture future;
-    RowVectorPtr data;
-    auto reason = sources_[0]->next(data, &future);
-    if (reason != BlockingReason::kNotBlocked) {
-      sourceBlockingFutures_.emplace_back(std::move(future));
-      return nullptr;
+  // No merging is needed if there is only one source or the sources are
+  // concatenated.
+  if (sources_.size() == 1 || concatenateSources_) {
+    while (currentSource_ < sources_.size()) {
+      ContinueFuture future;
+      RowVectorPtr data;
+      auto reason = sources_[currentSource_]->next(data, &future);
+      if (reason != BlockingReason::kNotBlocked) {
+        sourceBlockingFutures_.emplace_back(std::move(future));
+        return nullptr;
+      }
+      if (data != nullptr) {
+        return data;
+      }
+      ++currentSource_;
     }
-
-    finished_ = data == nullptr;
-    return data;
+    finished_ = true;
+    return nullptr;
   }
 
   if (!output_) {
@@ -174,7 +212,10 @@ RowVectorPtr Merge::getOutput() {
   }
 
   for (;;) {
-    auto stream = treeOfLosers_->next();
+    // Takes the consecutive rows of the stream that come before the current
+    // row of any other stream in one step.
+    auto [stream, numRows] =
+        treeOfLosers_->nextRun(outputBatchSize_ - outputSize_);
 
     if (!stream) {
       finished_ = true;
@@ -188,16 +229,16 @@ RowVectorPtr Merge::getOutput() {
       return std::move(output_);
     }
 
-    if (stream->setOutputRow(outputSize_)) {
+    if (stream->setOutputRows(outputSize_, numRows)) {
       // The stream is at end of input batch. Need to copy out the rows before
       // fetching next batch in 'pop'.
       stream->copyToOutput(output_);
     }
 
-    ++outputSize_;
+    outputSize_ += numRows;
 
     // Advance the stream.
-    stream->pop(sourceBlockingFutures_);
+    stream->pop(numRows, sourceBlockingFutures_);
 
     if (outputSize_ == outputBatchSize_) {
       // Copy out data from all sources.
@@ -222,26 +263,51 @@ void Merge::close() {
 }
 
 bool SourceStream::operator<(const MergeStream& other) const {
-  const auto& otherCursor = static_cast<const SourceStream&>(other);
+  return compareRow(
+             currentSourceRow_, static_cast<const SourceStream&>(other)) < 0;
+}
+
+uint32_t SourceStream::upperBound(
+    const MergeStream* other,
+    uint32_t maxElements) const {
+  const uint32_t numRows =
+      std::min<uint32_t>(maxElements, data_->size() - currentSourceRow_);
+  if (other == nullptr) {
+    return numRows;
+  }
+  const auto& otherCursor = static_cast<const SourceStream&>(*other);
+  return runLength(numRows, [&](uint32_t offset) {
+    return compareRow(currentSourceRow_ + offset, otherCursor) <= 0;
+  });
+}
+
+int32_t SourceStream::compareRow(
+    vector_size_t row,
+    const SourceStream& other) const {
   for (auto i = 0; i < sortingKeys_.size(); ++i) {
     const auto& [_, compareFlags] = sortingKeys_[i];
     VELOX_DCHECK(
         compareFlags.nullAsValue(), "not supported null handling mode");
     if (auto result = keyColumns_[i]
                           ->compare(
-                              otherCursor.keyColumns_[i],
-                              currentSourceRow_,
-                              otherCursor.currentSourceRow_,
+                              other.keyColumns_[i],
+                              row,
+                              other.currentSourceRow_,
                               compareFlags)
                           .value()) {
-      return result < 0;
+      return result;
     }
   }
-  return false;
+  return 0;
 }
 
 bool SourceStream::pop(std::vector<ContinueFuture>& futures) {
-  ++currentSourceRow_;
+  return pop(1, futures);
+}
+
+bool SourceStream::pop(uint32_t count, std::vector<ContinueFuture>& futures) {
+  currentSourceRow_ += count;
+  VELOX_DCHECK_LE(currentSourceRow_, data_->size());
   if (currentSourceRow_ == data_->size()) {
     // Make sure all current data has been copied out.
     VELOX_CHECK(!outputRows_.hasSelections());
@@ -312,7 +378,8 @@ LocalMerge::LocalMerge(
           localMergeNode->sortingKeys(),
           localMergeNode->sortingOrders(),
           localMergeNode->id(),
-          "LocalMerge") {
+          "LocalMerge",
+          isRangePartitioned(*localMergeNode, driverCtx->queryConfig())) {
   VELOX_CHECK_EQ(
       operatorCtx_->driverCtx()->driverId,
       0,
@@ -323,6 +390,9 @@ BlockingReason LocalMerge::addMergeSources(ContinueFuture* /* future */) {
   if (sources_.empty()) {
     sources_ = operatorCtx_->task()->getLocalMergeSources(
         operatorCtx_->driverCtx()->splitGroupId, planNodeId());
+    for (const auto& source : sources_) {
+      VELOX_CHECK_NOT_NULL(source);
+    }
   }
   return BlockingReason::kNotBlocked;
 }
@@ -37,7 +37,8 @@ class Merge : public SourceOperator {
           sortingKeys,
       const std::vector<core::SortOrder>& sortingOrders,
       const std::string& planNodeId,
-      const std::string& operatorType);
+      const std::string& operatorType,
+      bool concatenateSources = false);
 
   BlockingReason isBlocked(ContinueFuture* future) override;
 
@@ -65,6 +66,14 @@ class Merge : public SourceOperator {
   /// Maximum number of rows in the output batch.
   const vector_size_t outputBatchSize_;
 
+  /// If true, the sources hold consecutive key ranges in source order and are
+  /// output one after another without merging.
+  const bool concatenateSources_;
+
+  /// The source being output if there is a single source or
+  /// 'concatenateSources_' is true.
+  size_t currentSource_{0};
+
   std::vector<SpillSortKey> sortingKeys_;
 
   /// A list of cursors over batches of ordered source data. One per source.
@@ -116,12 +125,22 @@ class SourceStream final : public MergeStream {
   /// 'other'.
   bool operator<(const MergeStream& other) const override;
 
+  /// Returns the number of consecutive rows from the current source row that
+  /// are not greater than the current source row in 'other'. The rows are
+  /// limited to the current batch.
+  uint32_t upperBound(const MergeStream* other, uint32_t maxElements)
+      const override;
+
   /// Advances to the next row. Returns true and appends a future to 'futures'
   /// if runs out of rows in the current batch and needs to wait for the
   /// source to produce the next batch. The return flag has the meaning of
   /// 'is-blocked'.
   bool pop(std::vector<ContinueFuture>& futures);
 
+  /// Same as above but advances by 'count' rows. The rows must be in the
+  /// current batch.
+  bool pop(uint32_t count, std::vector<ContinueFuture>& futures);
+
   /// Records the output row number for the current row. Returns true if
   /// current row is the last row in the current batch, in which case the
   /// caller must call 'copyToOutput' before calling pop(). The caller must
@@ -132,6 +151,14 @@ class SourceStream final : public MergeStream {
     return currentSourceRow_ == data_->size() - 1;
   }
 
+  /// Same as setOutputRow() for 'count' consecutive rows starting at the
+  /// current row. Returns true if the last of these is the last row in the
+  /// current batch.
+  bool setOutputRows(vector_size_t row, vector_size_t count) {
+    outputRows_.setValidRange(row, row + count, true);
+    return currentSourceRow_ + count == data_->size();
+  }
+
   /// Called if either current row is the last row in the current batch or the
   /// caller accumulated enough output rows across all sources to produce an
   /// output batch.
@@ -140,6 +167,9 @@ class SourceStream final : public MergeStream {
  private:
   bool fetchMoreData(std::vector<ContinueFuture>& futures);
 
+  // Compares 'row' with the current source row in 'other'.
+  int32_t compareRow(vector_size_t row, const SourceStream& other) const;
+
   MergeSource* source_;
 
   const std::vector<SpillSortKey>& sortingKeys_;
@@ -173,7 +203,8 @@ class SourceStream final : public MergeStream {
 
 // LocalMerge merges its source's output into a single stream of
 // sorted rows. It runs single threaded. The sources may run multi-threaded and
-// in the same task.
+// in the same task. If the source is a partial OrderBy in parallel merge mode,
+// the sources are range partitioned and LocalMerge concatenates them.
 class LocalMerge : public Merge {
  public:
   LocalMerge(
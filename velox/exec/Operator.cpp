@@ -487,6 +487,35 @@ void Operator::recordSpillStats() {
                 lockedSpillStats->spillDeserializationTimeNanos),
             RuntimeCounter::Unit::kNanos});
   }
+
+  if (lockedSpillStats->spillReadAheadHits != 0) {
+    lockedStats->addRuntimeStat(
+        kSpillReadAheadHits,
+        RuntimeCounter{
+            static_cast<int64_t>(lockedSpillStats->spillReadAheadHits)});
+  }
+
+  if (lockedSpillStats->spillReadAheadMisses != 0) {
+    lockedStats->addRuntimeStat(
+        kSpillReadAheadMisses,
+        RuntimeCounter{
+            static_cast<int64_t>(lockedSpillStats->spillReadAheadMisses)});
+  }
+
+  if (lockedSpillStats->spillReadAheadWaitTimeNanos != 0) {
+    lockedStats->addRuntimeStat(
+        kSpillReadAheadWaitTime,
+        RuntimeCounter{
+            static_cast<int64_t>(lockedSpillStats->spillReadAheadWaitTimeNanos),
+            RuntimeCounter::Unit::kNanos});
+  }
+
+  if (lockedSpillStats->spilledRowFormatRows != 0) {
+    lockedStats->addRuntimeStat(
+        kSpilledRowFormatRows,
+        RuntimeCounter{
+            static_cast<int64_t>(lockedSpillStats->spilledRowFormatRows)});
+  }
   lockedSpillStats->reset();
 }
 
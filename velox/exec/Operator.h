@@ -178,6 +178,14 @@ class Operator : public BaseRuntimeStatWriter {
   static inline const std::string kSpillReadTime{"spillReadWallNanos"};
   static inline const std::string kSpillDeserializationTime{
       "spillDeserializationWallNanos"};
+  static inline const std::string kSpillReadAheadHits{"spillReadAheadHits"};
+  static inline const std::string kSpillReadAheadMisses{
+      "spillReadAheadMisses"};
+  static inline const std::string kSpillReadAheadWaitTime{
+      "spillReadAheadWaitWallNanos"};
+  /// The number of rows spilled in row format. See SortRowSpiller.
+  static inline const std::string kSpilledRowFormatRows{
+      "spilledRowFormatRows"};
 
   /// The vector serde kind used by an operator for shuffle. The recorded
   /// runtime stats value is the corresponding enum value.
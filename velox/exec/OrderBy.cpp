@@ -42,7 +42,12 @@ OrderBy::OrderBy(
           "OrderBy",
           orderByNode->canSpill(driverCtx->queryConfig())
               ? driverCtx->makeSpillConfig(operatorId)
-              : std::nullopt) {
+              : std::nullopt),
+      parallelMerge_(isParallelMerge(
+          *orderByNode,
+          driverCtx->queryConfig(),
+          driverCtx->task->numDrivers(driverCtx->pipelineId))),
+      mergedRows_(0, memory::StlAllocator<char*>(*pool())) {
   maxOutputRows_ = outputBatchRows(std::nullopt);
   VELOX_CHECK(pool()->trackUsage());
   std::vector<column_index_t> sortColumnIndices;
@@ -59,7 +64,7 @@ OrderBy::OrderBy(
     sortCompareFlags.push_back(
         fromSortOrderToCompareFlags(orderByNode->sortingOrders()[i]));
   }
-  sortBuffer_ = std::make_unique<SortBuffer>(
+  sortBuffer_ = std::make_shared<SortBuffer>(
       outputType_,
       sortColumnIndices,
       sortCompareFlags,
@@ -70,6 +75,18 @@ OrderBy::OrderBy(
       &spillStats_);
 }
 
+// static
+bool OrderBy::isParallelMerge(
+    const core::OrderByNode& orderByNode,
+    const core::QueryConfig& queryConfig,
+    uint32_t numDrivers) {
+  // The range merge needs random access to the sorted rows of all the drivers,
+  // so the mode is not used if OrderBy may spill.
+  return orderByNode.isPartial() && numDrivers > 1 &&
+      queryConfig.orderByParallelMergeEnabled() &&
+      !(queryConfig.spillEnabled() && orderByNode.canSpill(queryConfig));
+}
+
 void OrderBy::addInput(RowVectorPtr input) {
   loadLazyReclaimable(input);
   sortBuffer_->addInput(input);
@@ -93,20 +110,196 @@ void OrderBy::noMoreInput() {
   Operator::noMoreInput();
   sortBuffer_->noMoreInput();
   maxOutputRows_ = outputBatchRows(sortBuffer_->estimateOutputRowSize());
+  if (!parallelMerge_) {
+    return;
+  }
+
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  // The last driver to finish input sets up the range merge for all the
+  // drivers. The other drivers wait for it in isBlocked().
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), operatorCtx_->driver(), &future_, promises, peers)) {
+    return;
+  }
+
+  auto promisesGuard = folly::makeGuard([&]() {
+    // Realize the promises so that the other drivers (which were not the last
+    // to finish) can continue from the barrier.
+    peers.clear();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  });
+  setupParallelMerge(peers);
+}
+
+void OrderBy::setupParallelMerge(
+    const std::vector<std::shared_ptr<Driver>>& peers) {
+  std::vector<OrderBy*> orderBys(peers.size() + 1, nullptr);
+  orderBys[operatorCtx_->driverCtx()->partitionId] = this;
+  for (const auto& peer : peers) {
+    auto* orderBy = dynamic_cast<OrderBy*>(peer->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(orderBy);
+    const auto partitionId = orderBy->operatorCtx_->driverCtx()->partitionId;
+    VELOX_CHECK_LT(partitionId, orderBys.size());
+    VELOX_CHECK_NULL(orderBys[partitionId]);
+    orderBys[partitionId] = orderBy;
+  }
+
+  std::vector<std::shared_ptr<SortBuffer>> sortBuffers;
+  sortBuffers.reserve(orderBys.size());
+  for (auto* orderBy : orderBys) {
+    VELOX_CHECK_NOT_NULL(orderBy);
+    sortBuffers.push_back(orderBy->sortBuffer_);
+  }
+
+  // Samples evenly spaced rows from the sorted rows of each peer. A sample
+  // stands for the rows up to the next sample of the same peer.
+  std::vector<std::pair<char*, double>> samples;
+  uint64_t numRows{0};
+  for (const auto& sortBuffer : sortBuffers) {
+    const auto& rows = sortBuffer->sortedRows();
+    numRows += rows.size();
+    const auto numSamples =
+        std::min<uint64_t>(rows.size(), kNumSamplesPerDriver);
+    for (uint64_t i = 0; i < numSamples; ++i) {
+      samples.emplace_back(
+          rows[i * rows.size() / numSamples],
+          static_cast<double>(rows.size()) / numSamples);
+    }
+  }
+  std::sort(
+      samples.begin(),
+      samples.end(),
+      [&](const auto& left, const auto& right) {
+        return sortBuffer_->compare(left.first, right.first) < 0;
+      });
+
+  // Picks the splitters so that each range has about the same number of rows.
+  std::vector<char*> splitters;
+  splitters.reserve(orderBys.size() - 1);
+  double cumulativeRows{0};
+  for (const auto& [row, weight] : samples) {
+    if (splitters.size() == orderBys.size() - 1) {
+      break;
+    }
+    const double rangeEnd =
+        static_cast<double>(numRows) * (splitters.size() + 1) / orderBys.size();
+    if (cumulativeRows >= rangeEnd) {
+      splitters.push_back(row);
+    }
+    cumulativeRows += weight;
+  }
+  // Fewer rows than ranges. The last ranges are empty.
+  while (splitters.size() < orderBys.size() - 1) {
+    splitters.push_back(nullptr);
+  }
+
+  for (auto* orderBy : orderBys) {
+    orderBy->peerSortBuffers_ = sortBuffers;
+    orderBy->splitters_ = splitters;
+  }
+}
+
+BlockingReason OrderBy::isBlocked(ContinueFuture* future) {
+  if (future_.valid()) {
+    *future = std::move(future_);
+    return BlockingReason::kWaitForProducer;
+  }
+  return BlockingReason::kNotBlocked;
+}
+
+void OrderBy::mergeRange() {
+  VELOX_CHECK_EQ(peerSortBuffers_.size(), splitters_.size() + 1);
+  const auto partitionId = operatorCtx_->driverCtx()->partitionId;
+  // Returns the first row in 'rows' that is not less than 'splitter'. A null
+  // splitter is past the end of all the rows.
+  const auto lowerBound = [&](const auto& rows, const char* splitter) {
+    if (splitter == nullptr) {
+      return rows.data() + rows.size();
+    }
+    return std::lower_bound(
+        rows.data(),
+        rows.data() + rows.size(),
+        splitter,
+        [&](const char* row, const char* key) {
+          return sortBuffer_->compare(row, key) < 0;
+        });
+  };
+
+  std::vector<std::unique_ptr<SortedRowsStream>> streams;
+  streams.reserve(peerSortBuffers_.size());
+  size_t numRows{0};
+  for (const auto& sortBuffer : peerSortBuffers_) {
+    const auto& rows = sortBuffer->sortedRows();
+    const auto* rangeStart = partitionId == 0
+        ? rows.data()
+        : lowerBound(rows, splitters_[partitionId - 1]);
+    const auto* rangeEnd = partitionId == splitters_.size()
+        ? rows.data() + rows.size()
+        : lowerBound(rows, splitters_[partitionId]);
+    if (rangeStart < rangeEnd) {
+      numRows += rangeEnd - rangeStart;
+      streams.push_back(std::make_unique<SortedRowsStream>(
+          sortBuffer.get(), rangeStart, rangeEnd));
+    }
+  }
+
+  mergedRows_.reserve(numRows);
+  if (!streams.empty()) {
+    TreeOfLosers<SortedRowsStream> merger(std::move(streams));
+    while (auto* stream = merger.next()) {
+      mergedRows_.push_back(stream->current());
+      stream->pop();
+    }
+  }
+  VELOX_CHECK_EQ(mergedRows_.size(), numRows);
+  rangeMerged_ = true;
+}
+
+RowVectorPtr OrderBy::getRangeMergeOutput() {
+  if (!rangeMerged_) {
+    if (peerSortBuffers_.empty()) {
+      return nullptr;
+    }
+    // Merges the whole range before producing any output. The LocalMerge on
+    // top consumes the drivers one after another, so merging the range in
+    // batches on demand would serialize the merge work of the drivers.
+    mergeRange();
+  }
+
+  if (numOutputRows_ == mergedRows_.size()) {
+    return nullptr;
+  }
+  const auto batchSize =
+      std::min<size_t>(maxOutputRows_, mergedRows_.size() - numOutputRows_);
+  auto output = BaseVector::create<RowVector>(outputType_, batchSize, pool());
+  sortBuffer_->extractRows(
+      folly::Range<char* const*>(
+          mergedRows_.data() + numOutputRows_, batchSize),
+      output);
+  numOutputRows_ += batchSize;
+  return output;
 }
 
 RowVectorPtr OrderBy::getOutput() {
-  if (finished_ || !noMoreInput_) {
+  if (finished_ || !noMoreInput_ || future_.valid()) {
     return nullptr;
   }
 
-  RowVectorPtr output = sortBuffer_->getOutput(maxOutputRows_);
+  RowVectorPtr output = parallelMerge_ ? getRangeMergeOutput()
+                                       : sortBuffer_->getOutput(maxOutputRows_);
   finished_ = (output == nullptr);
   return output;
 }
 
 void OrderBy::close() {
   Operator::close();
+  mergedRows_.clear();
+  mergedRows_.shrink_to_fit();
+  peerSortBuffers_.clear();
+  splitters_.clear();
   sortBuffer_.reset();
 }
 } // namespace facebook::velox::exec
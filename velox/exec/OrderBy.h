@@ -20,6 +20,7 @@
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/SortBuffer.h"
 #include "velox/exec/Spiller.h"
+#include "velox/exec/TreeOfLosers.h"
 
 namespace facebook::velox::exec {
 /// OrderBy operator implementation: OrderBy stores all its inputs in a
@@ -28,6 +29,18 @@ namespace facebook::velox::exec {
 /// to the rows using the RowContainer's compare() function. And finally it
 /// constructs and returns the sorted output RowVector using the data in the
 /// RowContainer.
+///
+/// A partial OrderBy with multiple drivers runs in parallel merge mode if
+/// QueryConfig::kOrderByParallelMergeEnabled is set. Each driver sorts its
+/// input, then the last driver to finish input samples the sorted rows of all
+/// the drivers to pick splitters that divide the key space into one range per
+/// driver. The i-th driver then merges the rows of the i-th range from all the
+/// drivers, so the outputs of the drivers in driver order form a single sorted
+/// stream. Each driver merges its whole range before output, so the drivers
+/// merge concurrently even though the LocalMerge on top consumes them one
+/// after another. The LocalMerge concatenates them instead of merging. The
+/// mode is not used if OrderBy may spill.
+///
 /// Limitations:
 /// * It memcopies twice: 1) input to RowContainer and 2) RowContainer to
 /// output.
@@ -48,9 +61,7 @@ class OrderBy : public Operator {
 
   RowVectorPtr getOutput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /*future*/) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override {
     return finished_;
@@ -61,9 +72,88 @@ class OrderBy : public Operator {
 
   void close() override;
 
+  /// Returns true if the partial OrderBy 'orderByNode' running with
+  /// 'numDrivers' drivers range partitions its output across the drivers.
+  static bool isParallelMerge(
+      const core::OrderByNode& orderByNode,
+      const core::QueryConfig& queryConfig,
+      uint32_t numDrivers);
+
+  /// The number of samples taken from the sorted rows of each driver to pick
+  /// the range splitters in parallel merge mode.
+  static constexpr int32_t kNumSamplesPerDriver = 64;
+
  private:
-  std::unique_ptr<SortBuffer> sortBuffer_;
+  // A sorted range of rows from the sort buffer of a driver.
+  class SortedRowsStream : public MergeStream {
+   public:
+    SortedRowsStream(
+        const SortBuffer* sortBuffer,
+        const char* const* rows,
+        const char* const* rowsEnd)
+        : sortBuffer_(sortBuffer), rows_(rows), rowsEnd_(rowsEnd) {}
+
+    bool hasData() const override {
+      return rows_ < rowsEnd_;
+    }
+
+    bool operator<(const MergeStream& other) const override {
+      return sortBuffer_->compare(
+                 *rows_, *static_cast<const SortedRowsStream&>(other).rows_) <
+          0;
+    }
+
+    char* current() const {
+      return const_cast<char*>(*rows_);
+    }
+
+    void pop() {
+      ++rows_;
+    }
+
+   private:
+    const SortBuffer* const sortBuffer_;
+    const char* const* rows_;
+    const char* const* const rowsEnd_;
+  };
+
+  // Invoked by the last driver to finish input in parallel merge mode to
+  // compute the splitters and hand over the sort buffers of all the peers to
+  // each of them.
+  void setupParallelMerge(const std::vector<std::shared_ptr<Driver>>& peers);
+
+  // Merges this driver's key range of all the peers' sorted rows into
+  // 'mergedRows_'.
+  void mergeRange();
+
+  RowVectorPtr getRangeMergeOutput();
+
+  // True if running in parallel merge mode.
+  const bool parallelMerge_;
+
+  // The rows of this driver's key range in sorted order in parallel merge
+  // mode.
+  std::vector<char*, memory::StlAllocator<char*>> mergedRows_;
+
+  // True if 'mergedRows_' is set.
+  bool rangeMerged_{false};
+
+  // The number of rows of 'mergedRows_' output so far.
+  size_t numOutputRows_{0};
+
+  std::shared_ptr<SortBuffer> sortBuffer_;
   bool finished_ = false;
   vector_size_t maxOutputRows_;
+
+  // The future to wait for the peers to finish input in parallel merge mode.
+  ContinueFuture future_{ContinueFuture::makeEmpty()};
+
+  // The sort buffers of all the peers in driver order. Set by the last driver
+  // to finish input in parallel merge mode.
+  std::vector<std::shared_ptr<SortBuffer>> peerSortBuffers_;
+
+  // The rows that divide the key space into one range per peer. The i-th peer
+  // outputs the rows in [splitters_[i - 1], splitters_[i]).
+  std::vector<char*> splitters_;
 };
 } // namespace facebook::velox::exec
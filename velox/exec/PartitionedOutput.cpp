@@ -23,10 +23,16 @@ namespace {
 std::unique_ptr<VectorSerde::Options> getVectorSerdeOptions(
     const core::QueryConfig& queryConfig,
     VectorSerde::Kind kind) {
-  std::unique_ptr<VectorSerde::Options> options =
-      kind == VectorSerde::Kind::kPresto
-      ? std::make_unique<serializer::presto::PrestoVectorSerde::PrestoOptions>()
-      : std::make_unique<VectorSerde::Options>();
+  std::unique_ptr<VectorSerde::Options> options;
+  if (kind == VectorSerde::Kind::kPresto) {
+    auto prestoOptions = std::make_unique<
+        serializer::presto::PrestoVectorSerde::PrestoOptions>();
+    prestoOptions->preserveDictionaries =
+        queryConfig.shufflePreserveDictionaries();
+    options = std::move(prestoOptions);
+  } else {
+    options = std::make_unique<VectorSerde::Options>();
+  }
   options->compressionKind =
       common::stringToCompressionKind(queryConfig.shuffleCompressionKind());
   options->minCompressionRatio = PartitionedOutput::minCompressionRatio();
@@ -277,8 +277,12 @@ int PrefixSort::comparePartNormalizedKeys(char* left, char* right) {
 PrefixSort::PrefixSort(
     const RowContainer* rowContainer,
     const PrefixSortLayout& sortLayout,
-    memory::MemoryPool* pool)
-    : rowContainer_(rowContainer), sortLayout_(sortLayout), pool_(pool) {}
+    memory::MemoryPool* pool,
+    const velox::common::PrefixSortConfig& config)
+    : rowContainer_(rowContainer),
+      sortLayout_(sortLayout),
+      pool_(pool),
+      config_(config) {}
 
 void PrefixSort::extractRowAndEncodePrefixKeys(char* row, char* prefixBuffer) {
   for (auto i = 0; i < sortLayout_.numNormalizedKeys; ++i) {
@@ -324,7 +328,7 @@ uint32_t PrefixSort::maxRequiredBytes(
     return 0;
   }
 
-  const PrefixSort prefixSort(rowContainer, sortLayout, pool);
+  const PrefixSort prefixSort(rowContainer, sortLayout, pool, config);
   return prefixSort.maxRequiredBytes();
 }
 
@@ -349,13 +353,56 @@ uint32_t PrefixSort::maxRequiredBytes() const {
   const auto numRows = rowContainer_->numRows();
   const auto numPages =
       memory::AllocationTraits::numPages(numRows * sortLayout_.entrySize);
-  // Prefix data size + swap buffer size.
-  return memory::AllocationTraits::pageBytes(numPages) +
+  // Prefix data size + temp buffer size + swap buffer size.
+  return memory::AllocationTraits::pageBytes(numPages) *
+      (needsTempBuffer() ? 2 : 1) +
       pool_->preferredSize(checkedPlus<size_t>(
           sortLayout_.entrySize, AlignedBuffer::kPaddedSize)) +
       2 * pool_->alignment();
 }
 
+template <typename TCompare>
+void PrefixSort::sortPrefixes(
+    char* start,
+    char* end,
+    const PrefixSortRunner& sortRunner,
+    TCompare compare) {
+  const auto numRows = (end - start) / sortLayout_.entrySize;
+  // Allocates the temp buffer only if the sort needs it.
+  memory::ContiguousAllocation tempBufferAlloc;
+  const auto tempBuffer = [&]() {
+    pool_->allocateContiguous(
+        memory::AllocationTraits::numPages(end - start), tempBufferAlloc);
+    return tempBufferAlloc.data<char>();
+  };
+
+  if (config_.maxMergeRuns > 0) {
+    auto runBounds =
+        sortRunner.findSortedRuns(start, end, config_.maxMergeRuns, compare);
+    if (!runBounds.empty()) {
+      addThreadLocalRuntimeStat(
+          PrefixSort::kNumPrefixSortMergedRuns,
+          RuntimeCounter(runBounds.size() - 1, RuntimeCounter::Unit::kNone));
+      if (runBounds.size() > 2) {
+        sortRunner.mergeSortedRuns(
+            start, std::move(runBounds), tempBuffer(), compare);
+      }
+      return;
+    }
+  }
+
+  if (config_.radixSortEnabled && allKeysNormalized()) {
+    addThreadLocalRuntimeStat(
+        PrefixSort::kNumPrefixSortRadixSortRows,
+        RuntimeCounter(numRows, RuntimeCounter::Unit::kNone));
+    sortRunner.radixSort(
+        start, end, sortLayout_.normalizedBufferSize, tempBuffer());
+    return;
+  }
+
+  sortRunner.quickSort(start, end, compare);
+}
+
 void PrefixSort::sortInternal(
     std::vector<char*, memory::StlAllocator<char*>>& rows) {
   const auto numRows = rows.size();
@@ -387,15 +434,20 @@ void PrefixSort::sortInternal(
           RuntimeCounter(
               sortLayout_.numNormalizedKeys, RuntimeCounter::Unit::kNone));
     }
-    if (sortLayout_.hasNonNormalizedKey ||
-        sortLayout_.nonPrefixSortStartIndex < sortLayout_.numNormalizedKeys) {
-      sortRunner.quickSort(
-          prefixBufferStart, prefixBufferEnd, [&](char* lhs, char* rhs) {
+    if (!allKeysNormalized()) {
+      sortPrefixes(
+          prefixBufferStart,
+          prefixBufferEnd,
+          sortRunner,
+          [&](char* lhs, char* rhs) {
             return comparePartNormalizedKeys(lhs, rhs);
           });
     } else {
-      sortRunner.quickSort(
-          prefixBufferStart, prefixBufferEnd, [&](char* lhs, char* rhs) {
+      sortPrefixes(
+          prefixBufferStart,
+          prefixBufferEnd,
+          sortRunner,
+          [&](char* lhs, char* rhs) {
             return compareAllNormalizedKeys(lhs, rhs);
           });
     }
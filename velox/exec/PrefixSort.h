@@ -102,7 +102,8 @@ class PrefixSort {
   PrefixSort(
       const RowContainer* rowContainer,
       const PrefixSortLayout& sortLayout,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      const velox::common::PrefixSortConfig& config = {});
 
   /// Follow the steps below to sort the data in RowContainer:
   /// 1. Allocate a contiguous block of memory to store normalized keys.
@@ -110,7 +111,10 @@ class PrefixSort {
   /// normalized, normalize it. For this kind of keys can be normalized，we
   /// combine them with the original row address ptr and store them
   /// together into a buffer, called 'Prefix'.
-  /// 3. Sort the prefixes data we got in step 2.
+  /// 3. Sort the prefixes data we got in step 2. If the input consists of at
+  /// most 'config.maxMergeRuns' sorted runs, the runs are merged. Otherwise, if
+  /// 'config.radixSortEnabled' is set and all the keys are fully normalized,
+  /// the prefixes are radix sorted. Quick sort is used in other cases.
   /// For keys can normalized(All fixed width types), we use 'memcmp' to compare
   /// the normalized binary string.
   /// For keys can not normalized, we use RowContainer`s compare method to
@@ -146,7 +150,7 @@ class PrefixSort {
       return;
     }
 
-    PrefixSort prefixSort(rowContainer, sortLayout, pool);
+    PrefixSort prefixSort(rowContainer, sortLayout, pool, config);
     prefixSort.sortInternal(rows);
   }
 
@@ -162,6 +166,12 @@ class PrefixSort {
   /// The runtime stats name collected for prefix sort.
   /// The number of prefix sort keys.
   static inline const std::string kNumPrefixSortKeys{"numPrefixSortKeys"};
+  /// The number of sorted runs merged instead of sorting the input.
+  static inline const std::string kNumPrefixSortMergedRuns{
+      "numPrefixSortMergedRuns"};
+  /// The number of rows sorted using radix sort.
+  static inline const std::string kNumPrefixSortRadixSortRows{
+      "numPrefixSortRadixSortRows"};
 
  private:
   /// Fallback to stdSort when prefix sort conditions such as config and memory
@@ -207,6 +217,28 @@ class PrefixSort {
   // swap buffer.
   uint32_t maxRequiredBytes() const;
 
+  // Returns true if all the sort keys are fully stored in the normalized keys
+  // so prefixes can be compared without accessing the row container.
+  bool allKeysNormalized() const {
+    return !sortLayout_.hasNonNormalizedKey &&
+        sortLayout_.nonPrefixSortStartIndex == sortLayout_.numNormalizedKeys;
+  }
+
+  // Returns true if sorting may need a temporary buffer as large as the prefix
+  // buffer for radix sort or sorted runs merge.
+  bool needsTempBuffer() const {
+    return config_.maxMergeRuns > 0 ||
+        (config_.radixSortEnabled && allKeysNormalized());
+  }
+
+  // Sorts the prefixes in [start, end) with 'compare'.
+  template <typename TCompare>
+  void sortPrefixes(
+      char* start,
+      char* end,
+      const prefixsort::PrefixSortRunner& sortRunner,
+      TCompare compare);
+
   void sortInternal(std::vector<char*, memory::StlAllocator<char*>>& rows);
 
   int compareAllNormalizedKeys(char* left, char* right);
@@ -225,5 +257,6 @@ class PrefixSort {
   const RowContainer* const rowContainer_;
   const PrefixSortLayout sortLayout_;
   memory::MemoryPool* const pool_;
+  const velox::common::PrefixSortConfig config_;
 };
 } // namespace facebook::velox::exec
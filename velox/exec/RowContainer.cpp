@@ -688,7 +688,10 @@ int32_t RowContainer::storeVariableSizeAt(
 
 void RowContainer::extractSerializedRows(
     folly::Range<char**> rows,
-    const VectorPtr& result) const {
+    const VectorPtr& result,
+    size_t prefixSize,
+    const std::function<void(const char* row, char* prefix)>& writePrefix)
+    const {
   // The format of the extracted row is: null bytes followed by keys and
   // dependent columns. Fixed-width columns are serialized into fixed number of
   // bytes (see typeKindSize). Variable-width columns are serialized as 4 bytes
@@ -708,7 +711,7 @@ void RowContainer::extractSerializedRows(
   }
 
   size_t totalBytes =
-      flagBytes_ * rows.size() + fixedWidthRowSize * rows.size();
+      (prefixSize + flagBytes_ + fixedWidthRowSize) * rows.size();
   if (hasVariableWidth) {
     for (const char* row : rows) {
       for (auto i = 0; i < types_.size(); ++i) {
@@ -732,6 +735,11 @@ void RowContainer::extractSerializedRows(
     auto* row = rows[i];
     size_t offset = 0;
 
+    if (prefixSize > 0) {
+      writePrefix(row, rawBuffer);
+      offset += prefixSize;
+    }
+
     // Copy nulls and other flags.
     ::memcpy(rawBuffer + offset, row + rowColumns_[0].nullByte(), flagBytes_);
     offset += flagBytes_;
@@ -757,12 +765,7 @@ void RowContainer::extractSerializedRows(
   VELOX_CHECK_EQ(totalWritten, totalBytes);
 }
 
-void RowContainer::storeSerializedRow(
-    const FlatVector<StringView>& vector,
-    vector_size_t index,
-    char* row) {
-  VELOX_CHECK(!vector.isNullAt(index));
-  const auto serialized = vector.valueAt(index);
+void RowContainer::storeSerializedRow(std::string_view serialized, char* row) {
   size_t offset = 0;
 
   ::memcpy(row + rowColumns_[0].nullByte(), serialized.data(), flagBytes_);
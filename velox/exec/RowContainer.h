@@ -401,6 +401,19 @@ class RowContainer {
   /// Used for spilling as it is more efficient than converting from row to
   /// columnar format.
   void extractSerializedRows(folly::Range<char**> rows, const VectorPtr& result)
+      const {
+    extractSerializedRows(rows, result, 0, nullptr);
+  }
+
+  /// Same as above but reserves 'prefixSize' bytes in front of each serialized
+  /// row. 'writePrefix' is called with each row and the start of its reserved
+  /// bytes to fill them in. Used by row format spilling to put the normalized
+  /// sorting keys in front of the rows.
+  void extractSerializedRows(
+      folly::Range<char**> rows,
+      const VectorPtr& result,
+      size_t prefixSize,
+      const std::function<void(const char* row, char* prefix)>& writePrefix)
       const;
 
   /// Copies serialized row produced by 'extractSerializedRow' into the
@@ -408,7 +421,16 @@ class RowContainer {
   void storeSerializedRow(
       const FlatVector<StringView>& vector,
       vector_size_t index,
-      char* row);
+      char* row) {
+    VELOX_CHECK(!vector.isNullAt(index));
+    const auto serialized = vector.valueAt(index);
+    storeSerializedRow(
+        std::string_view(serialized.data(), serialized.size()), row);
+  }
+
+  /// Copies the 'serialized' bytes of a row produced by 'extractSerializedRow'
+  /// into the container.
+  void storeSerializedRow(std::string_view serialized, char* row);
 
   /// Copies the values at 'col' into 'result' (starting at 'resultOffset')
   /// for the 'numRows' rows pointed to by 'rows'. If a 'row' is null, sets
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/Sample.h"
+
+namespace facebook::velox::exec {
+Sample::Sample(
+    int32_t operatorId,
+    DriverCtx* driverCtx,
+    const std::shared_ptr<const core::SampleNode>& sampleNode)
+    : Operator(
+          driverCtx,
+          sampleNode->outputType(),
+          operatorId,
+          sampleNode->id(),
+          "Sample"),
+      method_(sampleNode->method()) {
+  if (sampleNode->sampleRate() < 1) {
+    randomSkip_ =
+        std::make_unique<random::RandomSkipTracker>(sampleNode->sampleRate());
+  }
+
+  isIdentityProjection_ = true;
+  const auto numColumns = sampleNode->outputType()->size();
+  identityProjections_.reserve(numColumns);
+  for (column_index_t i = 0; i < numColumns; ++i) {
+    identityProjections_.emplace_back(i, i);
+  }
+}
+
+void Sample::addInput(RowVectorPtr input) {
+  VELOX_CHECK_NULL(input_);
+  input_ = std::move(input);
+}
+
+RowVectorPtr Sample::getOutput() {
+  if (input_ == nullptr) {
+    return nullptr;
+  }
+  if (randomSkip_ == nullptr) {
+    return std::move(input_);
+  }
+  if (method_ == core::SampleNode::Method::kSystem) {
+    auto output = randomSkip_->testOne() ? std::move(input_) : nullptr;
+    input_ = nullptr;
+    return output;
+  }
+  auto output = sampleRows();
+  input_ = nullptr;
+  return output;
+}
+
+RowVectorPtr Sample::sampleRows() {
+  const auto numInput = input_->size();
+  BufferPtr indices = allocateIndices(numInput, pool());
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  vector_size_t numSelected = 0;
+  // The gaps between selected rows are drawn from a geometric distribution, so
+  // the random generator is called once per selected row instead of once per
+  // input row.
+  vector_size_t row = 0;
+  while (row < numInput) {
+    const auto skip = randomSkip_->nextSkip();
+    const uint64_t numRemaining = numInput - row;
+    if (skip >= numRemaining) {
+      randomSkip_->consume(numRemaining);
+      break;
+    }
+    row += skip;
+    rawIndices[numSelected++] = row++;
+    randomSkip_->consume(skip + 1);
+  }
+
+  if (numSelected == 0) {
+    return nullptr;
+  }
+  if (numSelected == numInput) {
+    return std::move(input_);
+  }
+  return fillOutput(numSelected, indices);
+}
+} // namespace facebook::velox::exec
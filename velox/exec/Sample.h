@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/common/base/RandomUtil.h"
+#include "velox/exec/Operator.h"
+
+namespace facebook::velox::exec {
+
+/// Keeps a random sample of the input. For BERNOULLI sampling each row is a
+/// separate trial. For SYSTEM sampling each input vector is kept or dropped
+/// as a whole. SYSTEM sampling directly above a table scan is done by the
+/// TableScan operator instead, see LocalPlanner.
+class Sample : public Operator {
+ public:
+  Sample(
+      int32_t operatorId,
+      DriverCtx* driverCtx,
+      const std::shared_ptr<const core::SampleNode>& sampleNode);
+
+  bool needsInput() const override {
+    return input_ == nullptr;
+  }
+
+  void addInput(RowVectorPtr input) override;
+
+  RowVectorPtr getOutput() override;
+
+  BlockingReason isBlocked(ContinueFuture* /*future*/) override {
+    return BlockingReason::kNotBlocked;
+  }
+
+  bool isFinished() override {
+    return noMoreInput_ && input_ == nullptr;
+  }
+
+ private:
+  // Returns the sampled rows of 'input_' for BERNOULLI sampling.
+  RowVectorPtr sampleRows();
+
+  const core::SampleNode::Method method_;
+
+  // Null if all input is kept.
+  std::unique_ptr<random::RandomSkipTracker> randomSkip_;
+};
+} // namespace facebook::velox::exec
@@ -101,7 +101,8 @@ void SerializedPageSpiller::flushBuffer(
   flushTimeNs = 0;
   {
     NanosecondTimer timer(&writeTimeNs);
-    writtenBytes = file->write(bufferStream_->getIOBuf());
+    const auto retainedBytes = bufferStream_->retainedSize();
+    writtenBytes = file->write(bufferStream_->getIOBuf(), retainedBytes);
   }
 }
 
@@ -163,7 +163,9 @@ RowVectorPtr SortBuffer::getOutput(vector_size_t maxOutputRows) {
       std::min<uint64_t>(numInputRows_ - numOutputRows_, maxOutputRows);
   ensureOutputFits(batchSize);
   prepareOutput(batchSize);
-  if (hasSpilled()) {
+  if (rowSpiller_ != nullptr) {
+    getOutputWithRowSpill();
+  } else if (hasSpilled()) {
     getOutputWithSpill();
   } else {
     getOutputWithoutSpill();
@@ -346,9 +348,21 @@ void SortBuffer::updateEstimatedOutputRowSize() {
 void SortBuffer::spillInput() {
   if (inputSpiller_ == nullptr) {
     VELOX_CHECK(!noMoreInput_);
-    const auto sortingKeys = SpillState::makeSortingKeys(sortCompareFlags_);
-    inputSpiller_ = std::make_unique<SortInputSpiller>(
-        data_.get(), spillerStoreType_, sortingKeys, spillConfig_, spillStats_);
+    if (spillConfig_->rowFormatEnabled &&
+        SortRowSpiller::supported(*data_, sortCompareFlags_.size())) {
+      auto spiller = std::make_unique<SortRowSpiller>(
+          data_.get(), sortCompareFlags_, spillConfig_, spillStats_);
+      rowSpiller_ = spiller.get();
+      inputSpiller_ = std::move(spiller);
+    } else {
+      const auto sortingKeys = SpillState::makeSortingKeys(sortCompareFlags_);
+      inputSpiller_ = std::make_unique<SortInputSpiller>(
+          data_.get(),
+          spillerStoreType_,
+          sortingKeys,
+          spillConfig_,
+          spillStats_);
+    }
   }
   inputSpiller_->spill();
   data_->clear();
@@ -415,21 +429,54 @@ void SortBuffer::getOutputWithoutSpill() {
   numOutputRows_ += output_->size();
 }
 
+int32_t SortBuffer::compare(const char* left, const char* right) const {
+  for (auto i = 0; i < sortCompareFlags_.size(); ++i) {
+    if (const auto result =
+            data_->compare(left, right, i, sortCompareFlags_[i])) {
+      return result;
+    }
+  }
+  return 0;
+}
+
+void SortBuffer::extractRows(
+    folly::Range<char* const*> rows,
+    RowVectorPtr& output) const {
+  VELOX_CHECK_EQ(output->size(), rows.size());
+  // The rows of the sort buffers with the same type have the same layout so
+  // the columns of 'data_' apply to the rows of the other sort buffers. The
+  // null flags of 'data_' columns don't cover the other sort buffers' rows.
+  for (const auto& columnProjection : columnMap_) {
+    RowContainer::extractColumn(
+        rows.data(),
+        rows.size(),
+        data_->columnAt(columnProjection.inputChannel),
+        /*columnHasNulls=*/true,
+        output->childAt(columnProjection.outputChannel));
+  }
+}
+
 void SortBuffer::getOutputWithSpill() {
   VELOX_CHECK_NOT_NULL(spillMerger_);
   VELOX_DCHECK_EQ(sortedRows_.size(), 0);
 
   int32_t outputRow = 0;
   int32_t outputSize = 0;
-  bool isEndOfBatch = false;
   while (outputRow + outputSize < output_->size()) {
-    SpillMergeStream* stream = spillMerger_->next();
+    // Takes the consecutive rows of the stream that come before the first row
+    // of any other stream in one step.
+    const auto [stream, numRows] =
+        spillMerger_->nextRun(output_->size() - outputRow - outputSize);
     VELOX_CHECK_NOT_NULL(stream);
 
-    spillSources_[outputSize] = &stream->current();
-    spillSourceRows_[outputSize] = stream->currentIndex(&isEndOfBatch);
-    ++outputSize;
-    if (FOLLY_UNLIKELY(isEndOfBatch)) {
+    const auto* source = &stream->current();
+    const auto firstRow = stream->currentIndex();
+    for (uint32_t i = 0; i < numRows; ++i) {
+      spillSources_[outputSize] = source;
+      spillSourceRows_[outputSize] = firstRow + i;
+      ++outputSize;
+    }
+    if (FOLLY_UNLIKELY(firstRow + numRows == source->size())) {
       // The stream is at end of input batch. Need to copy out the rows before
       // fetching next batch in 'pop'.
       gatherCopy(
@@ -443,7 +490,7 @@ void SortBuffer::getOutputWithSpill() {
       outputSize = 0;
     }
     // Advance the stream.
-    stream->pop();
+    stream->pop(numRows);
   }
   VELOX_CHECK_EQ(outputRow + outputSize, output_->size());
 
@@ -460,6 +507,41 @@ void SortBuffer::getOutputWithSpill() {
   numOutputRows_ += output_->size();
 }
 
+void SortBuffer::getOutputWithRowSpill() {
+  VELOX_CHECK_NOT_NULL(spillMerger_);
+  VELOX_DCHECK_EQ(sortedRows_.size(), 0);
+
+  const auto keyPrefixSize = rowSpiller_->keyPrefixSize();
+  restoredRows_.resize(output_->size());
+  for (vector_size_t i = 0; i < output_->size(); ++i) {
+    auto* stream = spillMerger_->next();
+    VELOX_CHECK_NOT_NULL(stream);
+    const auto* spilledRows =
+        stream->current().childAt(0)->asUnchecked<FlatVector<StringView>>();
+    const auto serialized = spilledRows->valueAt(stream->currentIndex());
+    VELOX_DCHECK_GE(serialized.size(), keyPrefixSize);
+    restoredRows_[i] = data_->newRow();
+    data_->storeSerializedRow(
+        std::string_view(
+            serialized.data() + keyPrefixSize,
+            serialized.size() - keyPrefixSize),
+        restoredRows_[i]);
+    stream->pop();
+  }
+
+  for (const auto& columnProjection : columnMap_) {
+    data_->extractColumn(
+        restoredRows_.data(),
+        output_->size(),
+        columnProjection.inputChannel,
+        output_->childAt(columnProjection.outputChannel));
+  }
+  // The restored rows have been copied into 'output_'. Keeps 'data_' empty so
+  // that there is nothing to spill again.
+  data_->clear();
+  numOutputRows_ += output_->size();
+}
+
 void SortBuffer::finishSpill() {
   VELOX_CHECK_NULL(spillMerger_);
   VELOX_CHECK(spillPartitionSet_.empty());
@@ -488,7 +570,7 @@ void SortBuffer::prepareOutputWithSpill() {
 
   VELOX_CHECK_EQ(spillPartitionSet_.size(), 1);
   spillMerger_ = spillPartitionSet_.begin()->second->createOrderedReader(
-      spillConfig_->readBufferSize, pool(), spillStats_);
+      *spillConfig_, pool(), spillStats_);
   spillPartitionSet_.clear();
 }
 } // namespace facebook::velox::exec
@@ -26,6 +26,7 @@
 namespace facebook::velox::exec {
 class SortInputSpiller;
 class SortOutputSpiller;
+class SortRowSpiller;
 
 /// A utility class to accumulate data inside and output the sorted result.
 /// Spilling would be triggered if spilling is enabled and memory usage exceeds
@@ -69,6 +70,24 @@ class SortBuffer {
 
   std::optional<uint64_t> estimateOutputRowSize() const;
 
+  /// Returns the rows sorted by noMoreInput(). Empty if the sort buffer has
+  /// spilled.
+  const std::vector<char*, memory::StlAllocator<char*>>& sortedRows() const {
+    VELOX_CHECK(noMoreInput_);
+    return sortedRows_;
+  }
+
+  /// Compares 'left' and 'right' rows by the sort keys. The rows may come from
+  /// different sort buffers with the same input type and sort keys. Returns 0
+  /// for equal, < 0 for left < right, > 0 otherwise.
+  int32_t compare(const char* left, const char* right) const;
+
+  /// Extracts 'rows' into 'output' in order. 'rows' may come from different
+  /// sort buffers with the same input type and sort keys. 'output' must have
+  /// the input type and the size of 'rows'.
+  void extractRows(folly::Range<char* const*> rows, RowVectorPtr& output)
+      const;
+
  private:
   // Ensures there is sufficient memory reserved to process 'input'.
   void ensureInputFits(const VectorPtr& input);
@@ -94,6 +113,10 @@ class SortBuffer {
 
   void getOutputWithSpill();
 
+  // Same as above for input spilled in row format. The rows are restored into
+  // 'data_' and extracted from there.
+  void getOutputWithRowSpill();
+
   // Spill during input stage.
   void spillInput();
 
@@ -149,6 +172,9 @@ class SortBuffer {
 
   std::unique_ptr<SortInputSpiller> inputSpiller_;
 
+  // Set to 'inputSpiller_' if it spills in row format.
+  const SortRowSpiller* rowSpiller_{nullptr};
+
   std::unique_ptr<SortOutputSpiller> outputSpiller_;
 
   SpillPartitionSet spillPartitionSet_;
@@ -161,6 +187,9 @@ class SortBuffer {
 
   std::vector<vector_size_t> spillSourceRows_;
 
+  // The rows restored into 'data_' for an output batch from row format spill.
+  std::vector<char*> restoredRows_;
+
   // Reusable output vector.
   RowVectorPtr output_;
 
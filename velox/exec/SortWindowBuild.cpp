@@ -179,6 +179,14 @@ void SortWindowBuild::ensureSortFits() {
 
 void SortWindowBuild::setupSpiller() {
   VELOX_CHECK_NULL(spiller_);
+  if (spillConfig_->rowFormatEnabled &&
+      SortRowSpiller::supported(*data_, compareFlags_.size())) {
+    auto spiller = std::make_unique<SortRowSpiller>(
+        data_.get(), compareFlags_, spillConfig_, spillStats_);
+    rowSpiller_ = spiller.get();
+    spiller_ = std::move(spiller);
+    return;
+  }
   const auto sortingKeys = SpillState::makeSortingKeys(compareFlags_);
   spiller_ = std::make_unique<SortInputSpiller>(
       data_.get(), inputType_, sortingKeys, spillConfig_, spillStats_);
@@ -280,7 +288,7 @@ void SortWindowBuild::noMoreInput() {
     spiller_->finishSpill(spillPartitionSet);
     VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
     merge_ = spillPartitionSet.begin()->second->createOrderedReader(
-        spillConfig_->readBufferSize, pool_, spillStats_);
+        *spillConfig_, pool_, spillStats_);
   } else {
     // At this point we have seen all the input rows. The operator is
     // being prepared to output rows now.
@@ -299,6 +307,11 @@ void SortWindowBuild::loadNextPartitionFromSpill() {
   sortedRows_.shrink_to_fit();
   data_->clear();
 
+  if (rowSpiller_ != nullptr) {
+    loadNextPartitionFromRowSpill();
+    return;
+  }
+
   for (;;) {
     auto next = merge_->next();
     if (next == nullptr) {
@@ -336,6 +349,41 @@ void SortWindowBuild::loadNextPartitionFromSpill() {
   }
 }
 
+void SortWindowBuild::loadNextPartitionFromRowSpill() {
+  const auto keyPrefixSize = rowSpiller_->keyPrefixSize();
+  const auto partitionKeyPrefixSize =
+      rowSpiller_->keyPrefixSize(numPartitionKeys_);
+  // Normalized partition keys of the rows in 'sortedRows_'.
+  std::string partitionKeys;
+  for (;;) {
+    auto next = merge_->next();
+    if (next == nullptr) {
+      break;
+    }
+
+    const auto* spilledRows =
+        next->current().childAt(0)->asUnchecked<FlatVector<StringView>>();
+    const auto serialized = spilledRows->valueAt(next->currentIndex());
+    VELOX_DCHECK_GE(serialized.size(), keyPrefixSize);
+    const std::string_view rowPartitionKeys(
+        serialized.data(), partitionKeyPrefixSize);
+    if (sortedRows_.empty()) {
+      partitionKeys = rowPartitionKeys;
+    } else if (rowPartitionKeys != partitionKeys) {
+      break;
+    }
+
+    auto* newRow = data_->newRow();
+    data_->storeSerializedRow(
+        std::string_view(
+            serialized.data() + keyPrefixSize,
+            serialized.size() - keyPrefixSize),
+        newRow);
+    sortedRows_.push_back(newRow);
+    next->pop();
+  }
+}
+
 std::shared_ptr<WindowPartition> SortWindowBuild::nextPartition() {
   if (merge_ != nullptr) {
     VELOX_CHECK(!sortedRows_.empty(), "No window partitions available");
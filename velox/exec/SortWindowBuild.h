@@ -78,6 +78,11 @@ class SortWindowBuild : public WindowBuild {
   // Reads next partition from spilled data into 'data_' and 'sortedRows_'.
   void loadNextPartitionFromSpill();
 
+  // Same as above for spilled data in row format. The partitions are split on
+  // the normalized partition keys and the rows are copied into 'data_'
+  // without decoding the spilled vectors.
+  void loadNextPartitionFromRowSpill();
+
   const size_t numPartitionKeys_;
 
   // Compare flags for partition and sorting keys. Compare flags for partition
@@ -119,6 +124,9 @@ class SortWindowBuild : public WindowBuild {
   // Spiller for contents of the 'data_'.
   std::unique_ptr<SortInputSpiller> spiller_;
 
+  // Set to 'spiller_' if it spills in row format.
+  const SortRowSpiller* rowSpiller_{nullptr};
+
   // Used to sort-merge spilled data.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> merge_;
 };
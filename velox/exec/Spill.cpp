@@ -30,19 +30,44 @@ void SpillMergeStream::pop() {
   }
 }
 
+void SpillMergeStream::pop(uint32_t count) {
+  VELOX_CHECK(!closed_);
+  VELOX_DCHECK_LE(index_ + count, size_);
+  index_ += count;
+  if (index_ >= size_) {
+    setNextBatch();
+  }
+}
+
 int32_t SpillMergeStream::compare(const MergeStream& other) const {
   VELOX_CHECK(!closed_);
-  const auto& otherStream = static_cast<const SpillMergeStream&>(other);
+  return compareRow(index_, static_cast<const SpillMergeStream&>(other));
+}
+
+uint32_t SpillMergeStream::upperBound(
+    const MergeStream* other,
+    uint32_t maxElements) const {
+  VELOX_CHECK(!closed_);
+  const uint32_t numRows = std::min<uint32_t>(maxElements, size_ - index_);
+  if (other == nullptr) {
+    return numRows;
+  }
+  const auto& otherStream = static_cast<const SpillMergeStream&>(*other);
+  return runLength(numRows, [&](uint32_t offset) {
+    return compareRow(index_ + offset, otherStream) <= 0;
+  });
+}
+
+int32_t SpillMergeStream::compareRow(
+    vector_size_t row,
+    const SpillMergeStream& other) const {
   const auto& children = rowVector_->children();
-  const auto& otherChildren = otherStream.current().children();
+  const auto& otherChildren = other.current().children();
   for (const auto& [key, compareFlags] : sortingKeys()) {
-    const auto result = children[key]
-                            ->compare(
-                                otherChildren[key].get(),
-                                index_,
-                                otherStream.index_,
-                                compareFlags)
-                            .value();
+    const auto result =
+        children[key]
+            ->compare(otherChildren[key].get(), row, other.index_, compareFlags)
+            .value();
     if (result != 0) {
       return result;
     }
@@ -71,7 +96,8 @@ SpillState::SpillState(
     const std::optional<common::PrefixSortConfig>& prefixSortConfig,
     memory::MemoryPool* pool,
     folly::Synchronized<common::SpillStats>* stats,
-    const std::string& fileCreateConfig)
+    const std::string& fileCreateConfig,
+    SpillMemoryTier* memoryTier)
     : getSpillDirPathCb_(getSpillDirPathCb),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       fileNamePrefix_(fileNamePrefix),
@@ -81,6 +107,7 @@ SpillState::SpillState(
       compressionKind_(compressionKind),
       prefixSortConfig_(prefixSortConfig),
       fileCreateConfig_(fileCreateConfig),
+      memoryTier_(memoryTier),
       pool_(pool),
       stats_(stats) {}
 
@@ -162,7 +189,8 @@ uint64_t SpillState::appendToPartition(
               fileCreateConfig_,
               updateAndCheckSpillLimitCb_,
               pool_,
-              stats_));
+              stats_,
+              memoryTier_));
     }
   });
 
@@ -295,12 +323,23 @@ std::unique_ptr<TreeOfLosers<SpillMergeStream>>
 SpillPartition::createOrderedReader(
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* spillStats) {
+    folly::Synchronized<common::SpillStats>* spillStats,
+    folly::Executor* readAheadExecutor,
+    uint64_t readAheadBufferSize) {
+  // Each file reading ahead holds a second buffer of 'bufferSize'.
+  const size_t numReadAheadFiles =
+      (readAheadExecutor == nullptr || bufferSize == 0)
+      ? 0
+      : readAheadBufferSize / bufferSize;
   std::vector<std::unique_ptr<SpillMergeStream>> streams;
   streams.reserve(files_.size());
   for (auto& fileInfo : files_) {
-    streams.push_back(FileSpillMergeStream::create(
-        SpillReadFile::create(fileInfo, bufferSize, pool, spillStats)));
+    streams.push_back(FileSpillMergeStream::create(SpillReadFile::create(
+        fileInfo,
+        bufferSize,
+        pool,
+        spillStats,
+        streams.size() < numReadAheadFiles ? readAheadExecutor : nullptr)));
   }
   files_.clear();
   // Check if the partition is empty or not.
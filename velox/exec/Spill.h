@@ -54,8 +54,19 @@ class SpillMergeStream : public MergeStream {
 
   int32_t compare(const MergeStream& other) const override;
 
+  /// Returns the number of consecutive rows from the current row that are not
+  /// greater than the current row of 'other'. The rows are limited to the
+  /// current batch so that the caller can copy them out before calling
+  /// pop(count).
+  uint32_t upperBound(const MergeStream* other, uint32_t maxElements)
+      const final;
+
   void pop();
 
+  /// Advances the current row by 'count' rows. The rows must be in the current
+  /// batch. Loads the next batch if reaching the end of the current one.
+  void pop(uint32_t count);
+
   const RowVector& current() const {
     VELOX_CHECK(!closed_);
     return *rowVector_;
@@ -87,6 +98,9 @@ class SpillMergeStream : public MergeStream {
 
   virtual void close();
 
+  // Compares 'row' of 'this' with the current row of 'other'.
+  int32_t compareRow(vector_size_t row, const SpillMergeStream& other) const;
+
   // loads the next 'rowVector' and sets 'decoded_' if this is initialized.
   void setNextBatch() {
     nextBatch();
@@ -465,10 +479,30 @@ class SpillPartition {
   /// system supports async read mode, then reader allocates two buffers with
   /// one buffer prefetch ahead. 'spillStats' is provided to collect the spill
   /// stats when reading data from spilled files.
+  ///
+  /// If 'readAheadExecutor' is set, up to 'readAheadBufferSize' / 'bufferSize'
+  /// of the files read ahead on 'readAheadExecutor' if the file system does
+  /// not support async read. The read-ahead buffers are allocated from 'pool'.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> createOrderedReader(
       uint64_t bufferSize,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* spillStats);
+      folly::Synchronized<common::SpillStats>* spillStats,
+      folly::Executor* readAheadExecutor = nullptr,
+      uint64_t readAheadBufferSize = 0);
+
+  /// Same as above with the read buffer and read-ahead settings from
+  /// 'spillConfig'.
+  std::unique_ptr<TreeOfLosers<SpillMergeStream>> createOrderedReader(
+      const common::SpillConfig& spillConfig,
+      memory::MemoryPool* pool,
+      folly::Synchronized<common::SpillStats>* spillStats) {
+    return createOrderedReader(
+        spillConfig.readBufferSize,
+        pool,
+        spillStats,
+        spillConfig.executor,
+        spillConfig.readAheadBufferSize);
+  }
 
   std::string toString() const;
 
@@ -529,7 +563,8 @@ class SpillState {
   /// 'numSortKeys' is the number of leading columns on which the data is
   /// sorted, 0 if only hash partitioning is used. 'targetFileSize' is the
   /// target size of a single file.  'pool' owns the memory for state and
-  /// results.
+  /// results. If 'memoryTier' is set, the spill files are kept in it while
+  /// they fit before being written to disk.
   SpillState(
       const common::GetSpillDirectoryPathCB& getSpillDirectoryPath,
       const common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
@@ -541,7 +576,8 @@ class SpillState {
       const std::optional<common::PrefixSortConfig>& prefixSortConfig,
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* stats,
-      const std::string& fileCreateConfig = {});
+      const std::string& fileCreateConfig = {},
+      SpillMemoryTier* memoryTier = nullptr);
 
   static std::vector<SpillSortKey> makeSortingKeys(
       const std::vector<CompareFlags>& compareFlags = {});
@@ -644,6 +680,7 @@ class SpillState {
   const common::CompressionKind compressionKind_;
   const std::optional<common::PrefixSortConfig> prefixSortConfig_;
   const std::string fileCreateConfig_;
+  SpillMemoryTier* const memoryTier_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
 
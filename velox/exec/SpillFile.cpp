@@ -16,9 +16,15 @@
 
 #include "velox/exec/SpillFile.h"
 #include "velox/common/base/RuntimeMetrics.h"
+#include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/testutil/TestValue.h"
 #include "velox/vector/VectorStream.h"
 
+using facebook::velox::common::testutil::TestValue;
+
+DECLARE_uint64(velox_spill_memory_tier_capacity_bytes);
+
 namespace facebook::velox::exec {
 namespace {
 // Spilling currently uses the default PrestoSerializer which by default
@@ -27,32 +33,317 @@ namespace {
 // nanosecond precision, we use this serde option to ensure the serializer
 // preserves precision.
 static const bool kDefaultUseLosslessTimestamp = true;
+
+std::unique_ptr<WriteFile> openSpillFileForWrite(
+    const std::string& path,
+    const std::string& fileCreateConfig) {
+  auto fs = filesystems::getFileSystem(path, nullptr);
+  return fs->openFileForWrite(
+      path,
+      filesystems::FileOptions{
+          {{filesystems::FileOptions::kFileCreateConfig.toString(),
+            fileCreateConfig}},
+          nullptr,
+          std::nullopt});
+}
+
+// Deletes the disk copy of a spill file which is no longer needed. Failures
+// are only logged: the file is then left to the spill directory cleanup.
+void removeSpillFile(const std::string& path) {
+  try {
+    filesystems::getFileSystem(path, nullptr)->remove(path);
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Failed to remove spill file " << path << ": " << e.what();
+  }
+}
 } // namespace
 
+bool SpillMemoryTier::Stats::operator==(const Stats& other) const {
+  return std::tie(
+             numFiles,
+             numReads,
+             numEvictions,
+             evictedBytes,
+             numReserveFailures) ==
+      std::tie(
+             other.numFiles,
+             other.numReads,
+             other.numEvictions,
+             other.evictedBytes,
+             other.numReserveFailures);
+}
+
+std::string SpillMemoryTier::Stats::toString() const {
+  return fmt::format(
+      "numFiles {} numReads {} numEvictions {} evictedBytes {} "
+      "numReserveFailures {}",
+      numFiles,
+      numReads,
+      numEvictions,
+      succinctBytes(evictedBytes),
+      numReserveFailures);
+}
+
+SpillMemoryTier::SpillMemoryTier(uint64_t capacity) : capacity_(capacity) {
+  VELOX_CHECK_GT(capacity_, 0, "Spill memory tier capacity must be positive");
+}
+
+SpillMemoryTier** SpillMemoryTier::getInstancePtr() {
+  static SpillMemoryTier* memoryTier{nullptr};
+  return &memoryTier;
+}
+
+SpillMemoryTier* SpillMemoryTier::getInstance() {
+  if (auto* memoryTier = *getInstancePtr()) {
+    return memoryTier;
+  }
+  // Never destroyed, so that it outlives the spill files at exit.
+  static SpillMemoryTier* const configuredMemoryTier =
+      FLAGS_velox_spill_memory_tier_capacity_bytes > 0
+      ? new SpillMemoryTier(FLAGS_velox_spill_memory_tier_capacity_bytes)
+      : nullptr;
+  return configuredMemoryTier;
+}
+
+void SpillMemoryTier::setInstance(SpillMemoryTier* memoryTier) {
+  *getInstancePtr() = memoryTier;
+}
+
+uint64_t SpillMemoryTier::usedBytes() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return usedBytes_;
+}
+
+bool SpillMemoryTier::tryReserve(uint64_t bytes) {
+  std::unique_lock<std::mutex> l(mutex_);
+  if (bytes > capacity_) {
+    ++stats_.numReserveFailures;
+    return false;
+  }
+  for (;;) {
+    if (usedBytes_ + bytes <= capacity_) {
+      usedBytes_ += bytes;
+      return true;
+    }
+    const auto neededBytes = usedBytes_ + bytes - capacity_;
+    if (evictingBytes_ >= neededBytes) {
+      // The files being evicted by other threads make enough room.
+      evicted_.wait(l);
+      continue;
+    }
+    auto victims = pickVictimsLocked(neededBytes - evictingBytes_);
+    if (victims.empty()) {
+      ++stats_.numReserveFailures;
+      return false;
+    }
+    l.unlock();
+    evict(victims);
+    l.lock();
+  }
+}
+
+void SpillMemoryTier::release(uint64_t bytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK_GE(usedBytes_, bytes);
+  usedBytes_ -= bytes;
+}
+
+void SpillMemoryTier::add(
+    const std::string& path,
+    const std::string& fileCreateConfig,
+    std::unique_ptr<folly::IOBuf> data,
+    uint64_t reservedBytes) {
+  VELOX_CHECK_NOT_NULL(data);
+  const auto size = data->computeChainDataLength();
+  VELOX_CHECK_GE(reservedBytes, size);
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!index_.contains(path), "Duplicate spill file {}", path);
+  entries_.push_back(
+      Entry{path, fileCreateConfig, std::move(data), size, reservedBytes});
+  index_.emplace(path, std::prev(entries_.end()));
+  ++stats_.numFiles;
+}
+
+std::unique_ptr<folly::IOBuf> SpillMemoryTier::remove(const std::string& path) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = index_.find(path);
+  if (it == index_.end()) {
+    return nullptr;
+  }
+  // A file being evicted is still complete in memory. The eviction then drops
+  // nothing.
+  auto data = std::move(it->second->data);
+  usedBytes_ -= it->second->reservedBytes;
+  entries_.erase(it->second);
+  index_.erase(it);
+  ++stats_.numReads;
+  return data;
+}
+
+void SpillMemoryTier::removeDirectory(const std::string& directory) {
+  const auto prefix = fmt::format("{}/", directory);
+  std::lock_guard<std::mutex> l(mutex_);
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->path.compare(0, prefix.size(), prefix) != 0) {
+      ++it;
+      continue;
+    }
+    usedBytes_ -= it->reservedBytes;
+    index_.erase(it->path);
+    it = entries_.erase(it);
+  }
+}
+
+SpillMemoryTier::Stats SpillMemoryTier::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return stats_;
+}
+
+std::vector<std::string> SpillMemoryTier::testingPaths() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  std::vector<std::string> paths;
+  paths.reserve(entries_.size());
+  for (const auto& entry : entries_) {
+    paths.push_back(entry.path);
+  }
+  return paths;
+}
+
+std::vector<SpillMemoryTier::Victim> SpillMemoryTier::pickVictimsLocked(
+    uint64_t bytes) {
+  std::vector<std::list<Entry>::iterator> candidates;
+  uint64_t candidateBytes{0};
+  for (auto it = entries_.begin();
+       it != entries_.end() && candidateBytes < bytes;
+       ++it) {
+    if (!it->evicting) {
+      candidates.push_back(it);
+      candidateBytes += it->reservedBytes;
+    }
+  }
+  if (candidateBytes < bytes) {
+    return {};
+  }
+  std::vector<Victim> victims;
+  victims.reserve(candidates.size());
+  for (auto& it : candidates) {
+    it->evicting = true;
+    evictingBytes_ += it->reservedBytes;
+    victims.push_back(Victim{
+        it->path, it->fileCreateConfig, it->data->clone(), it->reservedBytes});
+  }
+  return victims;
+}
+
+void SpillMemoryTier::evict(std::vector<Victim>& victims) {
+  for (size_t i = 0; i < victims.size(); ++i) {
+    auto& victim = victims[i];
+    std::exception_ptr error;
+    try {
+      auto file = openSpillFileForWrite(victim.path, victim.fileCreateConfig);
+      file->append(std::move(victim.data));
+      file->close();
+    } catch (const std::exception&) {
+      error = std::current_exception();
+    }
+    TestValue::adjust(
+        "facebook::velox::exec::SpillMemoryTier::evict", &victim.path);
+
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      evictingBytes_ -= victim.reservedBytes;
+      SCOPE_EXIT {
+        evicted_.notify_all();
+      };
+      auto it = index_.find(victim.path);
+      if (it != index_.end()) {
+        auto entry = it->second;
+        if (error != nullptr) {
+          entry->evicting = false;
+          for (auto j = i + 1; j < victims.size(); ++j) {
+            evictingBytes_ -= victims[j].reservedBytes;
+            auto remaining = index_.find(victims[j].path);
+            if (remaining != index_.end()) {
+              remaining->second->evicting = false;
+            }
+          }
+          std::rethrow_exception(error);
+        }
+        usedBytes_ -= entry->reservedBytes;
+        ++stats_.numEvictions;
+        stats_.evictedBytes += entry->size;
+        index_.erase(it);
+        entries_.erase(entry);
+        continue;
+      }
+    }
+    // The file was read or its directory was dropped while being written. A
+    // failed write does not matter then. A written file is not needed and
+    // would be orphaned if the spill directory is already removed.
+    if (error == nullptr) {
+      removeSpillFile(victim.path);
+    }
+  }
+}
+
 std::unique_ptr<SpillWriteFile> SpillWriteFile::create(
     uint32_t id,
     const std::string& pathPrefix,
-    const std::string& fileCreateConfig) {
+    const std::string& fileCreateConfig,
+    SpillMemoryTier* memoryTier) {
   return std::unique_ptr<SpillWriteFile>(
-      new SpillWriteFile(id, pathPrefix, fileCreateConfig));
+      new SpillWriteFile(id, pathPrefix, fileCreateConfig, memoryTier));
 }
 
 SpillWriteFile::SpillWriteFile(
     uint32_t id,
     const std::string& pathPrefix,
-    const std::string& fileCreateConfig)
-    : id_(id), path_(fmt::format("{}-{}", pathPrefix, ordinalCounter_++)) {
-  auto fs = filesystems::getFileSystem(path_, nullptr);
-  file_ = fs->openFileForWrite(
-      path_,
-      filesystems::FileOptions{
-          {{filesystems::FileOptions::kFileCreateConfig.toString(),
-            fileCreateConfig}},
-          nullptr,
-          std::nullopt});
+    const std::string& fileCreateConfig,
+    SpillMemoryTier* memoryTier)
+    : id_(id),
+      path_(fmt::format("{}-{}", pathPrefix, ordinalCounter_++)),
+      fileCreateConfig_(fileCreateConfig),
+      memoryTier_(memoryTier),
+      inMemory_(memoryTier_ != nullptr) {
+  if (!inMemory_) {
+    openFile();
+  }
+}
+
+SpillWriteFile::~SpillWriteFile() {
+  if (inMemory_ && memoryReservedBytes_ > 0) {
+    memoryTier_->release(memoryReservedBytes_);
+  }
+}
+
+void SpillWriteFile::openFile() {
+  file_ = openSpillFileForWrite(path_, fileCreateConfig_);
+}
+
+void SpillWriteFile::moveToFile() {
+  VELOX_CHECK(inMemory_);
+  openFile();
+  if (memoryData_ != nullptr) {
+    file_->append(std::move(memoryData_));
+    memoryTier_->release(memoryReservedBytes_);
+  }
+  memorySize_ = 0;
+  memoryReservedBytes_ = 0;
+  inMemory_ = false;
 }
 
 void SpillWriteFile::finish() {
+  if (inMemory_) {
+    VELOX_CHECK_NOT_NULL(memoryData_);
+    size_ = memorySize_;
+    // The reservation is carried over to the finished file in 'memoryTier_'.
+    memoryTier_->add(
+        path_, fileCreateConfig_, std::move(memoryData_), memoryReservedBytes_);
+    memorySize_ = 0;
+    memoryReservedBytes_ = 0;
+    inMemory_ = false;
+    return;
+  }
   VELOX_CHECK_NOT_NULL(file_);
   size_ = file_->size();
   file_->close();
@@ -60,14 +351,33 @@ void SpillWriteFile::finish() {
 }
 
 uint64_t SpillWriteFile::size() const {
+  if (inMemory_) {
+    return memorySize_;
+  }
   if (file_ != nullptr) {
     return file_->size();
   }
   return size_;
 }
 
-uint64_t SpillWriteFile::write(std::unique_ptr<folly::IOBuf> iobuf) {
+uint64_t SpillWriteFile::write(
+    std::unique_ptr<folly::IOBuf> iobuf,
+    uint64_t retainedBytes) {
   auto writtenBytes = iobuf->computeChainDataLength();
+  if (inMemory_) {
+    const auto reservedBytes = std::max(writtenBytes, retainedBytes);
+    if (memoryTier_->tryReserve(reservedBytes)) {
+      if (memoryData_ == nullptr) {
+        memoryData_ = std::move(iobuf);
+      } else {
+        memoryData_->prependChain(std::move(iobuf));
+      }
+      memorySize_ += writtenBytes;
+      memoryReservedBytes_ += reservedBytes;
+      return writtenBytes;
+    }
+    moveToFile();
+  }
   file_->append(std::move(iobuf));
   return writtenBytes;
 }
@@ -79,14 +389,16 @@ SpillWriterBase::SpillWriterBase(
     const std::string& fileCreateConfig,
     common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    SpillMemoryTier* memoryTier)
     : pool_(pool),
       stats_(stats),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       fileCreateConfig_(fileCreateConfig),
       pathPrefix_(pathPrefix),
       writeBufferSize_(writeBufferSize),
-      targetFileSize_(targetFileSize) {}
+      targetFileSize_(targetFileSize),
+      memoryTier_(memoryTier) {}
 
 SpillFiles SpillWriterBase::finish() {
   checkNotFinished();
@@ -128,7 +440,8 @@ SpillWriteFile* SpillWriterBase::ensureFile() {
     currentFile_ = SpillWriteFile::create(
         nextFileId_++,
         fmt::format("{}-{}", pathPrefix_, finishedFiles_.size()),
-        fileCreateConfig_);
+        fileCreateConfig_,
+        memoryTier_);
   }
   return currentFile_.get();
 }
@@ -199,7 +512,8 @@ SpillWriter::SpillWriter(
     const std::string& fileCreateConfig,
     common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    SpillMemoryTier* memoryTier)
     : SpillWriterBase(
           writeBufferSize,
           targetFileSize,
@@ -207,7 +521,8 @@ SpillWriter::SpillWriter(
           fileCreateConfig,
           updateAndCheckSpillLimitCb,
           pool,
-          stats),
+          stats,
+          memoryTier),
       type_(type),
       sortingKeys_(sortingKeys),
       compressionKind_(compressionKind),
@@ -226,10 +541,11 @@ void SpillWriter::flushBuffer(
   }
   batch_.reset();
 
+  const auto retainedBytes = out.retainedSize();
   auto iobuf = out.getIOBuf();
   {
     NanosecondTimer timer(&writeTimeNs);
-    writtenBytes = file->write(std::move(iobuf));
+    writtenBytes = file->write(std::move(iobuf), retainedBytes);
   }
 }
 
@@ -294,7 +610,8 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
     const SpillFileInfo& fileInfo,
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats) {
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* readAheadExecutor) {
   return std::unique_ptr<SpillReadFile>(new SpillReadFile(
       fileInfo.id,
       fileInfo.path,
@@ -304,7 +621,8 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
       fileInfo.sortingKeys,
       fileInfo.compressionKind,
       pool,
-      stats));
+      stats,
+      readAheadExecutor));
 }
 
 SpillReadFile::SpillReadFile(
@@ -316,7 +634,8 @@ SpillReadFile::SpillReadFile(
     const std::vector<SpillSortKey>& sortingKeys,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* readAheadExecutor)
     : id_(id),
       path_(path),
       size_(size),
@@ -331,10 +650,18 @@ SpillReadFile::SpillReadFile(
       pool_(pool),
       serde_(getNamedVectorSerde(VectorSerde::Kind::kPresto)),
       stats_(stats) {
+  if (auto* memoryTier = SpillMemoryTier::getInstance()) {
+    memoryData_ = memoryTier->remove(path_);
+  }
+  if (memoryData_ != nullptr) {
+    input_ = std::make_unique<BufferInputStream>(
+        byteRangesFromIOBuf(memoryData_.get()));
+    return;
+  }
   auto fs = filesystems::getFileSystem(path_, nullptr);
   auto file = fs->openFileForRead(path_);
   input_ = std::make_unique<common::FileInputStream>(
-      std::move(file), bufferSize, pool_);
+      std::move(file), bufferSize, pool_, readAheadExecutor);
 }
 
 bool SpillReadFile::nextBatch(RowVectorPtr& rowVector) {
@@ -356,12 +683,25 @@ bool SpillReadFile::nextBatch(RowVectorPtr& rowVector) {
 
 void SpillReadFile::recordSpillStats() {
   VELOX_CHECK(input_->atEnd());
-  const auto readStats = input_->stats();
+  if (memoryData_ != nullptr) {
+    // No disk reads for a file read from SpillMemoryTier.
+    return;
+  }
+  const auto readStats =
+      static_cast<common::FileInputStream*>(input_.get())->stats();
   common::updateGlobalSpillReadStats(
       readStats.numReads, readStats.readBytes, readStats.readTimeNs);
+  common::updateGlobalSpillReadAheadStats(
+      readStats.numReadAheadHits,
+      readStats.numReadAheadMisses,
+      readStats.readAheadWaitTimeNs);
   auto lockedSpillStats = stats_->wlock();
   lockedSpillStats->spillReads += readStats.numReads;
   lockedSpillStats->spillReadTimeNanos += readStats.readTimeNs;
   lockedSpillStats->spillReadBytes += readStats.readBytes;
+  lockedSpillStats->spillReadAheadHits += readStats.numReadAheadHits;
+  lockedSpillStats->spillReadAheadMisses += readStats.numReadAheadMisses;
+  lockedSpillStats->spillReadAheadWaitTimeNanos +=
+      readStats.readAheadWaitTimeNs;
 }
 } // namespace facebook::velox::exec
@@ -16,8 +16,12 @@
 
 #pragma once
 
+#include <folly/container/F14Map.h>
 #include <folly/container/F14Set.h>
 
+#include <condition_variable>
+#include <list>
+
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/SpillStats.h"
 #include "velox/common/compression/Compression.h"
@@ -32,14 +36,144 @@
 namespace facebook::velox::exec {
 using SpillSortKey = std::pair<column_index_t, CompareFlags>;
 
+/// Process wide bounded store which keeps finished spill files in memory to
+/// avoid disk writes and reads for short-lived spills. The files are kept in
+/// their serialized form and are allocated from the process wide spill memory
+/// pool. The tier does not compress by itself: the files are only compressed
+/// if the spill compression codec is set, so with the default
+/// 'spill_compression_codec' of none they take their uncompressed size. The
+/// capacity accounts for the memory allocated for the files, which may be more
+/// than their data size. When a new write does not fit into 'capacity', the
+/// oldest finished files are written to their paths on disk to make room. A
+/// file is removed from the tier when it is read back.
+class SpillMemoryTier {
+ public:
+  struct Stats {
+    /// Number of finished files added to the tier.
+    uint64_t numFiles{0};
+    /// Number of files read back from memory.
+    uint64_t numReads{0};
+    /// Number of files evicted to disk and their total size in bytes.
+    uint64_t numEvictions{0};
+    uint64_t evictedBytes{0};
+    /// Number of reservations which could not be satisfied even after
+    /// eviction, so that the writer fell back to disk.
+    uint64_t numReserveFailures{0};
+
+    bool operator==(const Stats& other) const;
+
+    std::string toString() const;
+  };
+
+  explicit SpillMemoryTier(uint64_t capacity);
+
+  /// Returns the process wide memory tier or nullptr if not set. If no tier is
+  /// set with setInstance(), a tier with a capacity of
+  /// 'velox_spill_memory_tier_capacity_bytes' is created on first use if that
+  /// flag is positive.
+  static SpillMemoryTier* getInstance();
+
+  /// Sets the process wide memory tier. The caller owns 'memoryTier' and must
+  /// keep it alive until unset.
+  static void setInstance(SpillMemoryTier* memoryTier);
+
+  uint64_t capacity() const {
+    return capacity_;
+  }
+
+  /// Returns the bytes of the finished and the reserved in-progress files.
+  uint64_t usedBytes() const;
+
+  /// Reserves 'bytes' for a spill file being written. Evicts the oldest
+  /// finished files if needed. Returns false if 'bytes' does not fit.
+  bool tryReserve(uint64_t bytes);
+
+  /// Releases 'bytes' reserved by tryReserve().
+  void release(uint64_t bytes);
+
+  /// Adds the finished spill file 'path' with its data. 'reservedBytes' must
+  /// have been reserved by tryReserve() and are released when the file is
+  /// removed. 'fileCreateConfig' is used to create the disk file on eviction.
+  void add(
+      const std::string& path,
+      const std::string& fileCreateConfig,
+      std::unique_ptr<folly::IOBuf> data,
+      uint64_t reservedBytes);
+
+  /// Removes and returns the data of spill file 'path', or nullptr if the file
+  /// is not in memory. The reservation of the data is released.
+  std::unique_ptr<folly::IOBuf> remove(const std::string& path);
+
+  /// Drops all the spill files under 'directory'. Invoked when a query removes
+  /// its spill directory. A file being evicted to disk is deleted once its
+  /// write finishes.
+  void removeDirectory(const std::string& directory);
+
+  Stats stats() const;
+
+  /// Returns the paths of the spill files in memory.
+  std::vector<std::string> testingPaths() const;
+
+ private:
+  struct Entry {
+    std::string path;
+    std::string fileCreateConfig;
+    std::unique_ptr<folly::IOBuf> data;
+    // Data size in bytes.
+    uint64_t size;
+    // Bytes reserved for 'data'. At least 'size'.
+    uint64_t reservedBytes;
+    // True while the file is being written to disk by evict().
+    bool evicting{false};
+  };
+
+  // A file picked for eviction. 'data' shares the buffers of the entry.
+  struct Victim {
+    std::string path;
+    std::string fileCreateConfig;
+    std::unique_ptr<folly::IOBuf> data;
+    uint64_t reservedBytes;
+  };
+
+  static SpillMemoryTier** getInstancePtr();
+
+  // Marks the oldest files which are not being evicted for eviction until
+  // they free at least 'bytes'. Returns nothing if they can not free 'bytes'.
+  std::vector<Victim> pickVictimsLocked(uint64_t bytes);
+
+  // Writes 'victims' to disk without holding 'mutex_' and then drops them.
+  // The entries stay readable from memory until they are written. If a write
+  // fails, the failed and the remaining victims stay in memory and the error
+  // is rethrown.
+  void evict(std::vector<Victim>& victims);
+
+  const uint64_t capacity_;
+
+  mutable std::mutex mutex_;
+  // Signaled when an eviction finishes.
+  std::condition_variable evicted_;
+  uint64_t usedBytes_{0};
+  // Reserved bytes of the files being evicted.
+  uint64_t evictingBytes_{0};
+  // Finished files in the order they were added.
+  std::list<Entry> entries_;
+  folly::F14FastMap<std::string, std::list<Entry>::iterator> index_;
+  Stats stats_;
+};
+
 /// Represents a spill file for writing the serialized spilled data into a disk
-/// file.
+/// file. If 'memoryTier' is set, the data is kept in memory as long as it fits
+/// into 'memoryTier' and the finished file is added to it. The file is written
+/// to disk on the first write which does not fit.
 class SpillWriteFile {
  public:
   static std::unique_ptr<SpillWriteFile> create(
       uint32_t id,
       const std::string& pathPrefix,
-      const std::string& fileCreateConfig);
+      const std::string& fileCreateConfig,
+      SpillMemoryTier* memoryTier = nullptr);
+
+  ~SpillWriteFile();
 
   uint32_t id() const {
     return id_;
@@ -52,7 +186,13 @@ class SpillWriteFile {
     return path_;
   }
 
-  uint64_t write(std::unique_ptr<folly::IOBuf> iobuf);
+  /// Writes 'iobuf' and returns its data size. 'retainedBytes' is the memory
+  /// kept allocated by 'iobuf' if more than its data size, e.g. the whole
+  /// StreamArena chunks behind IOBufOutputStream::getIOBuf(). The memory tier
+  /// reserves the larger of the two.
+  uint64_t write(
+      std::unique_ptr<folly::IOBuf> iobuf,
+      uint64_t retainedBytes = 0);
 
   void write(const char* data, uint64_t bytes);
 
@@ -60,6 +200,11 @@ class SpillWriteFile {
     return file_.get();
   }
 
+  /// Returns true if the data written so far is held in memory.
+  bool inMemory() const {
+    return inMemory_;
+  }
+
   /// Finishes writing and flushes any unwritten data.
   void finish();
 
@@ -69,16 +214,33 @@ class SpillWriteFile {
   SpillWriteFile(
       uint32_t id,
       const std::string& pathPrefix,
-      const std::string& fileCreateConfig);
+      const std::string& fileCreateConfig,
+      SpillMemoryTier* memoryTier);
+
+  void openFile();
+
+  // Opens the disk file, writes the data held in memory to it and releases
+  // its reservation from 'memoryTier_'.
+  void moveToFile();
 
   // The spill file id which is monotonically increasing and unique for each
   // associated spill partition.
   const uint32_t id_;
   const std::string path_;
+  const std::string fileCreateConfig_;
+  SpillMemoryTier* const memoryTier_;
 
   std::unique_ptr<WriteFile> file_;
   // Byte size of the backing file. Set when finishing writing.
   uint64_t size_{0};
+
+  // True while the written data is held in 'memoryData_'.
+  bool inMemory_;
+  std::unique_ptr<folly::IOBuf> memoryData_;
+  uint64_t memorySize_{0};
+  // Bytes reserved from 'memoryTier_' for 'memoryData_'. At least
+  // 'memorySize_'.
+  uint64_t memoryReservedBytes_{0};
 };
 
 /// Records info of a finished spill file which is used for read.
@@ -110,7 +272,8 @@ class SpillWriterBase {
       const std::string& fileCreateConfig,
       common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      SpillMemoryTier* memoryTier = nullptr);
 
   virtual ~SpillWriterBase() = default;
 
@@ -193,6 +356,8 @@ class SpillWriterBase {
 
   const uint64_t targetFileSize_;
 
+  SpillMemoryTier* const memoryTier_;
+
   uint64_t nextFileId_{0};
 
   bool finished_{false};
@@ -209,7 +374,8 @@ class SpillWriter : public SpillWriterBase {
   /// write to file. 'fileOptions' specifies the file layout on remote storage
   /// which is storage system specific. 'pool' is used for buffering and
   /// constructing the result data read from 'this'. 'stats' is used to collect
-  /// the spill write stats.
+  /// the spill write stats. If 'memoryTier' is set, the spill files are kept
+  /// in it while they fit.
   ///
   /// When writing sorted spill runs, the caller is responsible for buffering
   /// and sorting the data. write is called multiple times, followed by flush().
@@ -223,7 +389,8 @@ class SpillWriter : public SpillWriterBase {
       const std::string& fileCreateConfig,
       common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      SpillMemoryTier* memoryTier = nullptr);
 
   /// Adds 'rows' for the positions in 'indices' into 'this'. The indices
   /// must produce a view where the rows are sorted if sorting is desired.
@@ -267,7 +434,8 @@ class SpillWriter : public SpillWriterBase {
 };
 
 /// Represents a spill file for read which turns the serialized spilled data
-/// on disk back into a sequence of spilled row vectors.
+/// on disk back into a sequence of spilled row vectors. If the file is held in
+/// the process wide SpillMemoryTier, it is read from memory instead.
 ///
 /// NOTE: The class will not delete spill file upon destruction, so the user
 /// needs to remove the unused spill files at some point later. For example, a
@@ -275,11 +443,14 @@ class SpillWriter : public SpillWriterBase {
 /// rmdir() call.
 class SpillReadFile {
  public:
+  /// If 'readAheadExecutor' is set, the next 'bufferSize' bytes are read ahead
+  /// on it when the file system does not support async reads.
   static std::unique_ptr<SpillReadFile> create(
       const SpillFileInfo& fileInfo,
       uint64_t bufferSize,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* readAheadExecutor = nullptr);
 
   uint32_t id() const {
     return id_;
@@ -310,7 +481,8 @@ class SpillReadFile {
       const std::vector<SpillSortKey>& sortingKeys,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* readAheadExecutor);
 
   // Invoked to record spill read stats at the end of read input.
   void recordSpillStats();
@@ -330,6 +502,8 @@ class SpillReadFile {
   VectorSerde* const serde_;
   folly::Synchronized<common::SpillStats>* const stats_;
 
-  std::unique_ptr<common::FileInputStream> input_;
+  // The file data if read from SpillMemoryTier.
+  std::unique_ptr<folly::IOBuf> memoryData_;
+  std::unique_ptr<ByteInputStream> input_;
 };
 } // namespace facebook::velox::exec
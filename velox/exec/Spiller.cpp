@@ -33,6 +33,7 @@ SpillerBase::SpillerBase(
     RowTypePtr rowType,
     HashBitRange bits,
     const std::vector<SpillSortKey>& sortingKeys,
+    const std::vector<SpillSortKey>& fileSortingKeys,
     uint64_t targetFileSize,
     uint64_t maxSpillRunRows,
     std::optional<SpillPartitionId> parentId,
@@ -57,14 +58,15 @@ SpillerBase::SpillerBase(
           spillConfig->getSpillDirPathCb,
           spillConfig->updateAndCheckSpillLimitCb,
           spillConfig->fileNamePrefix,
-          sortingKeys,
+          fileSortingKeys,
           targetFileSize,
           spillConfig->writeBufferSize,
           spillConfig->compressionKind,
           spillConfig->prefixSortConfig,
           memory::spillMemoryPool(),
           spillStats,
-          spillConfig->fileCreateConfig) {
+          spillConfig->fileCreateConfig,
+          SpillMemoryTier::getInstance()) {
   TestValue::adjust("facebook::velox::exec::SpillerBase", this);
 }
 
@@ -431,6 +433,148 @@ void SortInputSpiller::spill() {
   SpillerBase::spill(nullptr);
 }
 
+namespace {
+std::vector<prefixsort::PrefixSortEncoder> makeRowSpillEncoders(
+    const std::vector<CompareFlags>& compareFlags) {
+  std::vector<prefixsort::PrefixSortEncoder> encoders;
+  encoders.reserve(compareFlags.size());
+  for (const auto& flags : compareFlags) {
+    encoders.emplace_back(flags.ascending, flags.nullsFirst);
+  }
+  return encoders;
+}
+
+std::vector<uint32_t> makeRowSpillKeyOffsets(
+    const RowContainer& container,
+    size_t numSortingKeys) {
+  std::vector<uint32_t> offsets;
+  offsets.reserve(numSortingKeys + 1);
+  offsets.push_back(0);
+  for (auto i = 0; i < numSortingKeys; ++i) {
+    // Always reserve the null byte as the spilled rows come from multiple
+    // spill runs with different null stats.
+    const auto size = prefixsort::PrefixSortEncoder::encodedSize(
+        container.keyTypes()[i]->kind(), 0, /*columnHasNulls=*/true);
+    VELOX_CHECK(size.has_value());
+    offsets.push_back(offsets.back() + size.value());
+  }
+  return offsets;
+}
+
+template <typename T>
+FOLLY_ALWAYS_INLINE void encodeRowSpillKey(
+    const prefixsort::PrefixSortEncoder& encoder,
+    const RowColumn& column,
+    const char* row,
+    char* dest,
+    uint32_t size) {
+  std::optional<T> value;
+  if (!RowContainer::isNullAt(row, column)) {
+    value = *reinterpret_cast<const T*>(row + column.offset());
+  }
+  encoder.encode(value, dest, size, /*includeNullByte=*/true);
+}
+} // namespace
+
+// static
+bool SortRowSpiller::supported(
+    const RowContainer& container,
+    size_t numSortingKeys) {
+  if (numSortingKeys == 0 || numSortingKeys > container.keyTypes().size()) {
+    return false;
+  }
+  for (auto i = 0; i < numSortingKeys; ++i) {
+    switch (container.keyTypes()[i]->kind()) {
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+      case TypeKind::HUGEINT:
+      case TypeKind::REAL:
+      case TypeKind::DOUBLE:
+      case TypeKind::TIMESTAMP:
+        break;
+      default:
+        // Strings only have a truncated normalized key.
+        return false;
+    }
+  }
+  return true;
+}
+
+// static
+const RowTypePtr& SortRowSpiller::rowType() {
+  static const RowTypePtr kRowType = ROW({"row"}, {VARBINARY()});
+  return kRowType;
+}
+
+SortRowSpiller::SortRowSpiller(
+    RowContainer* container,
+    const std::vector<CompareFlags>& compareFlags,
+    const common::SpillConfig* spillConfig,
+    folly::Synchronized<common::SpillStats>* spillStats)
+    : SortInputSpiller(
+          container,
+          rowType(),
+          SpillState::makeSortingKeys(compareFlags),
+          SpillState::makeSortingKeys({CompareFlags{}}),
+          spillConfig,
+          spillStats),
+      encoders_(makeRowSpillEncoders(compareFlags)),
+      keyOffsets_(makeRowSpillKeyOffsets(*container, compareFlags.size())) {
+  VELOX_CHECK(supported(*container, compareFlags.size()));
+}
+
+void SortRowSpiller::encodeKeys(const char* row, char* prefix) const {
+  for (auto i = 0; i < encoders_.size(); ++i) {
+    const auto column = container_->columnAt(i);
+    char* dest = prefix + keyOffsets_[i];
+    const uint32_t size = keyOffsets_[i + 1] - keyOffsets_[i];
+    switch (container_->keyTypes()[i]->kind()) {
+      case TypeKind::SMALLINT:
+        encodeRowSpillKey<int16_t>(encoders_[i], column, row, dest, size);
+        break;
+      case TypeKind::INTEGER:
+        encodeRowSpillKey<int32_t>(encoders_[i], column, row, dest, size);
+        break;
+      case TypeKind::BIGINT:
+        encodeRowSpillKey<int64_t>(encoders_[i], column, row, dest, size);
+        break;
+      case TypeKind::HUGEINT:
+        encodeRowSpillKey<int128_t>(encoders_[i], column, row, dest, size);
+        break;
+      case TypeKind::REAL:
+        encodeRowSpillKey<float>(encoders_[i], column, row, dest, size);
+        break;
+      case TypeKind::DOUBLE:
+        encodeRowSpillKey<double>(encoders_[i], column, row, dest, size);
+        break;
+      case TypeKind::TIMESTAMP:
+        encodeRowSpillKey<Timestamp>(encoders_[i], column, row, dest, size);
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+}
+
+void SortRowSpiller::extractSpill(
+    folly::Range<char**> rows,
+    RowVectorPtr& resultPtr) {
+  if (resultPtr == nullptr) {
+    resultPtr = BaseVector::create<RowVector>(
+        rowType_, rows.size(), memory::spillMemoryPool());
+  } else {
+    resultPtr->prepareForReuse();
+    resultPtr->resize(rows.size());
+  }
+  container_->extractSerializedRows(
+      rows,
+      resultPtr->childAt(0),
+      keyPrefixSize(),
+      [this](const char* row, char* prefix) { encodeKeys(row, prefix); });
+  spillStats_->wlock()->spilledRowFormatRows += rows.size();
+}
+
 SortOutputSpiller::SortOutputSpiller(
     RowContainer* container,
     RowTypePtr rowType,
@@ -19,6 +19,7 @@
 #include "velox/common/compression/Compression.h"
 #include "velox/exec/HashBitRange.h"
 #include "velox/exec/RowContainer.h"
+#include "velox/exec/prefixsort/PrefixSortEncoder.h"
 
 namespace facebook::velox::exec {
 namespace test {
@@ -60,6 +61,32 @@ class SpillerBase {
       uint64_t maxSpillRunRows,
       std::optional<SpillPartitionId> parentId,
       const common::SpillConfig* spillConfig,
+      folly::Synchronized<common::SpillStats>* spillStats)
+      : SpillerBase(
+            container,
+            std::move(rowType),
+            bits,
+            sortingKeys,
+            sortingKeys,
+            targetFileSize,
+            maxSpillRunRows,
+            parentId,
+            spillConfig,
+            spillStats) {}
+
+  // Same as above but the spill files are sorted on 'fileSortingKeys' of
+  // 'rowType' while 'sortingKeys' sort the rows in 'container'. Used if the
+  // spilled data has a different layout than 'container'.
+  SpillerBase(
+      RowContainer* container,
+      RowTypePtr rowType,
+      HashBitRange bits,
+      const std::vector<SpillSortKey>& sortingKeys,
+      const std::vector<SpillSortKey>& fileSortingKeys,
+      uint64_t targetFileSize,
+      uint64_t maxSpillRunRows,
+      std::optional<SpillPartitionId> parentId,
+      const common::SpillConfig* spillConfig,
       folly::Synchronized<common::SpillStats>* spillStats);
 
   // Invoked to spill. If 'startRowIter' is not null, then we only spill rows
@@ -260,6 +287,26 @@ class SortInputSpiller : public SpillerBase {
 
   void spill();
 
+ protected:
+  SortInputSpiller(
+      RowContainer* container,
+      RowTypePtr rowType,
+      const std::vector<SpillSortKey>& sortingKeys,
+      const std::vector<SpillSortKey>& fileSortingKeys,
+      const common::SpillConfig* spillConfig,
+      folly::Synchronized<common::SpillStats>* spillStats)
+      : SpillerBase(
+            container,
+            std::move(rowType),
+            HashBitRange{},
+            sortingKeys,
+            fileSortingKeys,
+            std::numeric_limits<uint64_t>::max(),
+            spillConfig->maxSpillRunRows,
+            std::nullopt,
+            spillConfig,
+            spillStats) {}
+
  private:
   std::string type() const override {
     return std::string(kType);
@@ -270,6 +317,71 @@ class SortInputSpiller : public SpillerBase {
   }
 };
 
+/// Sort input spiller which writes the rows of 'container' in row format
+/// instead of converting them into columnar vectors. The spilled data has a
+/// single VARBINARY column. Each value consists of the normalized sorting keys
+/// followed by the row serialized by RowContainer::extractSerializedRows().
+/// The normalized keys compare bytewise in the order of the sorting keys, so
+/// the spill merge compares raw bytes and the reader restores the rows with
+/// RowContainer::storeSerializedRow().
+///
+/// The sorting keys must be the leading key columns of 'container' and all of
+/// them must have a fixed size normalized key, see supported().
+///
+/// Scope: the spilled batches still go through the spill file writer and
+/// reader, so each batch is one flat VARBINARY vector serialized with the
+/// Presto serde. This keeps compression, the memory tier and the spill stats
+/// unchanged. Rows with string keys and GroupingSet rows, whose accumulators
+/// are not covered by the serialized row format, are spilled as columnar
+/// vectors.
+class SortRowSpiller : public SortInputSpiller {
+ public:
+  static constexpr std::string_view kType = "SortRowSpiller";
+
+  /// Returns true if the leading 'numSortingKeys' columns of 'container' can
+  /// be spilled in row format.
+  static bool supported(const RowContainer& container, size_t numSortingKeys);
+
+  /// The type of the spilled data.
+  static const RowTypePtr& rowType();
+
+  SortRowSpiller(
+      RowContainer* container,
+      const std::vector<CompareFlags>& compareFlags,
+      const common::SpillConfig* spillConfig,
+      folly::Synchronized<common::SpillStats>* spillStats);
+
+  /// Returns the byte size of the normalized keys of the leading 'numKeys'
+  /// sorting keys in each spilled row.
+  uint32_t keyPrefixSize(size_t numKeys) const {
+    VELOX_CHECK_LE(numKeys, encoders_.size());
+    return keyOffsets_[numKeys];
+  }
+
+  /// Returns the byte size of the normalized keys of all the sorting keys in
+  /// each spilled row. The serialized row starts at this offset.
+  uint32_t keyPrefixSize() const {
+    return keyOffsets_.back();
+  }
+
+ private:
+  void extractSpill(folly::Range<char**> rows, RowVectorPtr& resultPtr)
+      override;
+
+  std::string type() const override {
+    return std::string(kType);
+  }
+
+  // Writes the normalized sorting keys of 'row' into 'prefix'.
+  void encodeKeys(const char* row, char* prefix) const;
+
+  const std::vector<prefixsort::PrefixSortEncoder> encoders_;
+
+  // Offsets of the normalized keys in the prefix of a spilled row. The last
+  // element is the size of the prefix.
+  const std::vector<uint32_t> keyOffsets_;
+};
+
 class SortOutputSpiller : public SpillerBase {
  public:
   static constexpr std::string_view kType = "SortOutputSpiller";
@@ -27,7 +27,8 @@ namespace facebook::velox::exec {
 TableScan::TableScan(
     int32_t operatorId,
     DriverCtx* driverCtx,
-    const std::shared_ptr<const core::TableScanNode>& tableScanNode)
+    const std::shared_ptr<const core::TableScanNode>& tableScanNode,
+    const std::shared_ptr<const core::SampleNode>& sampleNode)
     : SourceOperator(
           driverCtx,
           tableScanNode->outputType(),
@@ -49,6 +50,8 @@ TableScan::TableScan(
       connector_(connector::getConnector(tableHandle_->connectorId())),
       getOutputTimeLimitMs_(
           driverCtx_->queryConfig().tableScanGetOutputTimeLimitMs()),
+      blockSampleRate_(
+          sampleNode != nullptr ? sampleNode->sampleRate() : 1.0),
       scaledController_(driverCtx_->task->getScaledScanControllerLocked(
           driverCtx_->splitGroupId,
           planNodeId())) {
@@ -187,6 +190,9 @@ RowVectorPtr TableScan::getOutput() {
           }
           RECORD_HISTOGRAM_METRIC_VALUE(
               velox::kMetricTableScanBatchBytes, data->estimateFlatSize());
+          if (sampleBatches_ && !batchRandomSkip_->testOne()) {
+            continue;
+          }
           return data;
         }
         continue;
@@ -290,6 +296,25 @@ bool TableScan::getSplit() {
     for (const auto& entry : dynamicFilters_) {
       dataSource_->addDynamicFilter(entry.first, entry.second);
     }
+    if (blockSampleRate_ < 1) {
+      if (dataSource_->setBlockSampleRate(blockSampleRate_)) {
+        batchRandomSkip_ =
+            std::make_unique<random::RandomSkipTracker>(blockSampleRate_);
+      } else {
+        splitRandomSkip_ =
+            std::make_unique<random::RandomSkipTracker>(blockSampleRate_);
+      }
+    }
+  }
+
+  if (splitRandomSkip_ != nullptr && !splitRandomSkip_->testOne()) {
+    if (connectorSplit->dataSource != nullptr) {
+      connectorSplit->dataSource->close();
+    }
+    driverCtx_->task->splitFinished(true, currentSplitWeight_);
+    needNewSplit_ = true;
+    stats_.wlock()->addRuntimeStat(kNumSampledOutSplits, RuntimeCounter(1));
+    return false;
   }
 
   debugString_ = fmt::format(
@@ -327,6 +352,8 @@ bool TableScan::getSplit() {
         "dataSourceAddSplitWallNanos",
         RuntimeCounter(addSplitTimeUs * 1'000, RuntimeCounter::Unit::kNanos));
   }
+  sampleBatches_ =
+      batchRandomSkip_ != nullptr && !dataSource_->isBlockSampled();
   ++stats_.wlock()->numSplits;
   return true;
 }
@@ -370,6 +397,7 @@ void TableScan::preload(
            split->connectorId, planNodeId(), connectorPool_),
        task = operatorCtx_->task(),
        dynamicFilters = dynamicFilters_,
+       blockSampleRate = blockSampleRate_,
        split]() -> std::unique_ptr<connector::DataSource> {
         if (task->isCancelled()) {
           return nullptr;
@@ -390,6 +418,9 @@ void TableScan::preload(
         for (const auto& entry : dynamicFilters) {
           dataSource->addDynamicFilter(entry.first, entry.second);
         }
+        if (blockSampleRate < 1) {
+          dataSource->setBlockSampleRate(blockSampleRate);
+        }
         dataSource->addSplit(split);
         return dataSource;
       });
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/base/RandomUtil.h"
 #include "velox/core/PlanNode.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/ScaledScanController.h"
@@ -23,10 +24,14 @@ namespace facebook::velox::exec {
 
 class TableScan : public SourceOperator {
  public:
+  /// @param sampleNode Optional SYSTEM sample node fused into the scan. The
+  /// connector skips whole stripes or row groups if it supports block
+  /// sampling, otherwise whole splits are skipped.
   TableScan(
       int32_t operatorId,
       DriverCtx* driverCtx,
-      const std::shared_ptr<const core::TableScanNode>& tableScanNode);
+      const std::shared_ptr<const core::TableScanNode>& tableScanNode,
+      const std::shared_ptr<const core::SampleNode>& sampleNode = nullptr);
 
   RowVectorPtr getOutput() override;
 
@@ -63,6 +68,10 @@ class TableScan : public SourceOperator {
   static inline const std::string kNumRunningScaleThreads{
       "numRunningScaleThreads"};
 
+  /// The number of splits dropped by SYSTEM sampling when the connector does
+  /// not support block sampling.
+  static inline const std::string kNumSampledOutSplits{"numSampledOutSplits"};
+
   std::shared_ptr<ScaledScanController> testingScaledController() const {
     return scaledController_;
   }
@@ -111,6 +120,9 @@ class TableScan : public SourceOperator {
   // limit'.
   const size_t getOutputTimeLimitMs_{0};
 
+  // Fraction of blocks to read under SYSTEM sampling. 1 if not sampled.
+  const double blockSampleRate_;
+
   // If set, used for scan scale processing. It is shared by all the scan
   // operators instantiated from the same table scan node.
   const std::shared_ptr<ScaledScanController> scaledController_;
@@ -143,6 +155,19 @@ class TableScan : public SourceOperator {
   // Count of splits that finished preloading before being read.
   int32_t numReadyPreloadedSplits_{0};
 
+  // Decides which splits are read under SYSTEM sampling if the connector does
+  // not support block sampling.
+  std::unique_ptr<random::RandomSkipTracker> splitRandomSkip_;
+
+  // Decides which output batches are kept under SYSTEM sampling for splits
+  // whose format does not support block sampling. Such splits are sampled the
+  // same way the Sample operator samples its input.
+  std::unique_ptr<random::RandomSkipTracker> batchRandomSkip_;
+
+  // True if the batches of the current split are sampled with
+  // 'batchRandomSkip_'.
+  bool sampleBatches_{false};
+
   double maxFilteringRatio_{0};
 
   // String shown in ExceptionContext inside DataSource and LazyVector loading.
@@ -21,6 +21,7 @@
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/process/Numa.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
 #include "velox/exec/Exchange.h"
@@ -31,8 +32,10 @@
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/SpillFile.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/TraceUtil.h"
+#include "velox/expression/ConjunctExpr.h"
 
 using facebook::velox::common::testutil::TestValue;
 
@@ -178,6 +181,17 @@ void movePromisesOut(
   }
   from.clear();
 }
+
+// Returns the NUMA node to pin the drivers of a new task to, or -1 if the
+// machine has a single node. The nodes are assigned round-robin.
+int32_t pickNumaNode() {
+  const auto numNodes = process::numaNodeCount();
+  if (numNodes <= 1) {
+    return -1;
+  }
+  static std::atomic<uint32_t> nextNode{0};
+  return nextNode++ % numNodes;
+}
 } // namespace
 
 std::string executionModeString(Task::ExecutionMode mode) {
@@ -316,6 +330,9 @@ Task::Task(
   if (mode_ == Task::ExecutionMode::kParallel) {
     VELOX_CHECK_NULL(
         dynamic_cast<const folly::InlineLikeExecutor*>(queryCtx_->executor()));
+    if (queryCtx_->queryConfig().numaNodePinningEnabled()) {
+      numaNode_ = pickNumaNode();
+    }
   }
   maybeInitTrace();
 }
@@ -482,6 +499,9 @@ void Task::removeSpillDirectoryIfExists() {
     return;
   }
   try {
+    if (auto* memoryTier = SpillMemoryTier::getInstance()) {
+      memoryTier->removeDirectory(spillDirectory_);
+    }
     auto fs = filesystems::getFileSystem(spillDirectory_, nullptr);
     fs->rmdir(spillDirectory_);
   } catch (const std::exception& e) {
@@ -2234,6 +2254,16 @@ std::shared_ptr<NestedLoopJoinBridge> Task::getNestedLoopJoinBridge(
   return getJoinBridgeInternal<NestedLoopJoinBridge>(splitGroupId, planNodeId);
 }
 
+std::shared_ptr<SharedConjunctSelectivity> Task::getSharedConjunctSelectivity(
+    const core::PlanNodeId& planNodeId) {
+  std::lock_guard<std::timed_mutex> l(mutex_);
+  auto& shared = sharedConjunctSelectivity_[planNodeId];
+  if (shared == nullptr) {
+    shared = std::make_shared<SharedConjunctSelectivity>();
+  }
+  return shared;
+}
+
 template <class TBridgeType>
 std::shared_ptr<TBridgeType> Task::getJoinBridgeInternal(
     uint32_t splitGroupId,
@@ -2845,10 +2875,19 @@ folly::dynamic Task::toJson() const {
 std::shared_ptr<MergeSource> Task::addLocalMergeSource(
     uint32_t splitGroupId,
     const core::PlanNodeId& planNodeId,
-    const RowTypePtr& rowType) {
+    const RowTypePtr& rowType,
+    uint32_t sourceId) {
   auto source = MergeSource::createLocalMergeSource();
-  splitGroupStates_[splitGroupId].localMergeSources[planNodeId].push_back(
-      source);
+  auto& sources = splitGroupStates_[splitGroupId].localMergeSources[planNodeId];
+  if (sources.size() <= sourceId) {
+    sources.resize(sourceId + 1);
+  }
+  VELOX_CHECK_NULL(
+      sources[sourceId],
+      "Duplicate local merge source {} for plan node {}",
+      sourceId,
+      planNodeId);
+  sources[sourceId] = source;
   return source;
 }
 
@@ -3297,7 +3336,8 @@ void Task::createExchangeClientLocked(
       queryCtx()->queryConfig().minExchangeOutputBatchBytes(),
       addExchangeClientPool(planNodeId, pipelineId),
       queryCtx()->executor(),
-      queryCtx()->queryConfig().requestDataSizesMaxWaitSec());
+      queryCtx()->queryConfig().requestDataSizesMaxWaitSec(),
+      queryCtx()->queryConfig().exchangeAdaptiveBatching());
   exchangeClientByPlanNode_.emplace(planNodeId, exchangeClients_[pipelineId]);
 }
 
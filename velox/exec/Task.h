@@ -35,6 +35,7 @@ namespace facebook::velox::exec {
 class OutputBufferManager;
 
 class HashJoinBridge;
+class SharedConjunctSelectivity;
 class NestedLoopJoinBridge;
 
 using ConnectorSplitPreloadFunc =
@@ -151,6 +152,12 @@ class Task : public std::enable_shared_from_this<Task> {
   /// disabled) when task is under serial mode.
   uint64_t driverCpuTimeSliceLimitMs() const;
 
+  /// Returns the NUMA node the drivers of this task are pinned to while
+  /// running, or -1 if not pinned. See QueryConfig::kNumaNodePinningEnabled.
+  int32_t numaNode() const {
+    return numaNode_;
+  }
+
   /// Returns QueryCtx specified in the constructor.
   const std::shared_ptr<core::QueryCtx>& queryCtx() const {
     return queryCtx_;
@@ -461,13 +468,16 @@ class Task : public std::enable_shared_from_this<Task> {
       int32_t numSplits,
       int64_t splitsWeight);
 
-  /// Adds a MergeSource for the specified splitGroupId and planNodeId.
+  /// Adds a MergeSource for the specified splitGroupId and planNodeId. The
+  /// source is fed by the producer driver with partition id 'sourceId'.
   std::shared_ptr<MergeSource> addLocalMergeSource(
       uint32_t splitGroupId,
       const core::PlanNodeId& planNodeId,
-      const RowTypePtr& rowType);
+      const RowTypePtr& rowType,
+      uint32_t sourceId);
 
-  /// Returns all MergeSource's for the specified splitGroupId and planNodeId.
+  /// Returns all MergeSource's for the specified splitGroupId and planNodeId
+  /// ordered by their source ids.
   const std::vector<std::shared_ptr<MergeSource>>& getLocalMergeSources(
       uint32_t splitGroupId,
       const core::PlanNodeId& planNodeId);
@@ -582,6 +592,12 @@ class Task : public std::enable_shared_from_this<Task> {
       uint32_t splitGroupId,
       const core::PlanNodeId& planNodeId);
 
+  /// Returns the selectivity statistics shared by the filter conjuncts of
+  /// 'planNodeId' in all the drivers of the task. See
+  /// SharedConjunctSelectivity.
+  std::shared_ptr<SharedConjunctSelectivity> getSharedConjunctSelectivity(
+      const core::PlanNodeId& planNodeId);
+
   /// Transitions this to kFinished state if all Drivers are
   /// finished. Otherwise sets a flag so that the last Driver to finish
   /// will transition the state.
@@ -1135,6 +1151,9 @@ class Task : public std::enable_shared_from_this<Task> {
   // arbitration to determine which task to reclaim first.
   const int32_t memoryArbitrationPriority_;
 
+  // The NUMA node to pin the drivers to or -1 if not pinned.
+  int32_t numaNode_{-1};
+
   std::shared_ptr<core::QueryCtx> queryCtx_;
 
   core::PlanFragment planFragment_;
@@ -1189,6 +1208,13 @@ class Task : public std::enable_shared_from_this<Task> {
   std::unordered_map<core::PlanNodeId, std::shared_ptr<ExchangeClient>>
       exchangeClientByPlanNode_;
 
+  // Filter selectivity statistics shared by the drivers, keyed by plan node
+  // ID. See getSharedConjunctSelectivity().
+  std::unordered_map<
+      core::PlanNodeId,
+      std::shared_ptr<SharedConjunctSelectivity>>
+      sharedConjunctSelectivity_;
+
   ConsumerSupplier consumerSupplier_;
 
   // The function that is executed when the task encounters its first error,
@@ -52,6 +52,90 @@ class MergeStream {
   virtual int32_t compare(const MergeStream& /*other*/) const {
     VELOX_UNSUPPORTED();
   }
+
+  /// Returns the number of consecutive elements at the start of 'this' that
+  /// are not greater than the first element of 'other', at most
+  /// 'maxElements'. If 'other' is nullptr, returns the number of elements
+  /// that are available without loading more data, at most 'maxElements'.
+  /// The first element of 'this' must not be greater than the first element
+  /// of 'other'. The result is at least 1. Used by TreeOfLosers::nextRun()
+  /// and MergeArray::nextRun(). The default returns 1, which makes nextRun()
+  /// equivalent to next().
+  virtual uint32_t upperBound(
+      const MergeStream* /*other*/,
+      uint32_t /*maxElements*/) const {
+    return 1;
+  }
+
+ protected:
+  /// Returns the length of the run of elements at offsets [0, size) for which
+  /// 'inRun(offset)' is true. 'inRun' must be true for offset 0 and must not
+  /// be true after the first offset for which it is false. Gallops forward
+  /// from the start and then binary searches, so that short runs take few
+  /// comparisons.
+  template <typename TInRun>
+  static uint32_t runLength(uint32_t size, TInRun inRun) {
+    // 'inRun' is true for all offsets below 'low' and false for 'high'
+    // unless 'high' is 'size'.
+    uint32_t low = 1;
+    uint32_t high = size;
+    uint32_t step = 1;
+    while (low < high) {
+      const auto probe = std::min(low + step - 1, high - 1);
+      if (!inRun(probe)) {
+        high = probe;
+        break;
+      }
+      low = probe + 1;
+      step *= 2;
+    }
+    while (low < high) {
+      const auto middle = low + (high - low) / 2;
+      if (inRun(middle)) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    return low;
+  }
+};
+
+/// Decides when TreeOfLosers::nextRun() and MergeArray::nextRun() look for a
+/// run of more than one element. Looking for a run takes comparisons that are
+/// wasted if the run has a single element, which is the common case when the
+/// streams are not clustered. After a single element run, nextRun() returns
+/// single elements without looking for a number of calls. This number doubles
+/// with each further single element run up to kMaxSkip. A longer run resets
+/// it.
+class RunLengthPredictor {
+ public:
+  static constexpr uint32_t kMaxSkip = 64;
+
+  /// Returns true if the caller should look for a run.
+  bool shouldProbe() {
+    if (numToSkip_ > 0) {
+      --numToSkip_;
+      return false;
+    }
+    return true;
+  }
+
+  /// Records the 'length' of a run found after shouldProbe() returned true.
+  void recordRun(uint32_t length) {
+    if (length > 1) {
+      skip_ = 0;
+    } else {
+      skip_ = std::min(std::max<uint32_t>(1, 2 * skip_), kMaxSkip);
+    }
+    numToSkip_ = skip_;
+  }
+
+ private:
+  // The number of calls to skip after the next single element run.
+  uint32_t skip_{0};
+  // The number of calls left to skip.
+  uint32_t numToSkip_{0};
 };
 
 /// Implements a tree of losers algorithm for merging ordered streams. The
@@ -123,6 +207,27 @@ class TreeOfLosers {
     return lastIndex_ == kEmpty ? nullptr : streams_[lastIndex_].get();
   }
 
+  /// Returns the stream with the lowest first element and the number of
+  /// consecutive elements, at most 'maxElements', that can be taken from the
+  /// start of the stream before another stream has a lower first element. The
+  /// caller is expected to pop off these elements before calling this again.
+  /// Returns {nullptr, 0} when all streams are at end. The run lengths are
+  /// determined by Stream::upperBound(). Runs of one element may be returned
+  /// without looking for longer runs, see RunLengthPredictor.
+  std::pair<Stream*, uint32_t> nextRun(uint32_t maxElements) {
+    VELOX_DCHECK_GT(maxElements, 0);
+    auto* stream = next();
+    if (stream == nullptr) {
+      return {nullptr, 0};
+    }
+    if (!runLengthPredictor_.shouldProbe()) {
+      return {stream, 1};
+    }
+    const auto numElements = stream->upperBound(runnerUp(), maxElements);
+    runLengthPredictor_.recordRun(numElements);
+    return {stream, numElements};
+  }
+
   /// Returns the stream with the lowest first element and a flag that is true
   /// if there is another equal value to come from some other stream. The
   /// streams should have ordered unique values when using this function. This
@@ -281,6 +386,28 @@ class TreeOfLosers {
     }
   }
 
+  // Returns the stream with the second lowest first element after next() or
+  // nullptr if there is no other stream with data. This is the lowest of the
+  // streams that lost against the winner on its path to the root.
+  Stream* runnerUp() const {
+    if (values_.empty()) {
+      return nullptr;
+    }
+    Stream* result = nullptr;
+    TIndex node = firstStream_ + lastIndex_;
+    do {
+      node = parent(node);
+      if (values_[node] == kEmpty) {
+        continue;
+      }
+      auto* loser = streams_[values_[node]].get();
+      if (result == nullptr || *loser < *result) {
+        result = loser;
+      }
+    } while (node != 0);
+    return result;
+  }
+
   static TIndex parent(TIndex node) {
     return (node - 1) / 2;
   }
@@ -302,6 +429,7 @@ class TreeOfLosers {
   std::vector<uint8_t> equals_;
   TIndex lastIndex_ = kEmpty;
   int32_t firstStream_;
+  RunLengthPredictor runLengthPredictor_;
 };
 
 // Array-based merging structure implementing the same interface as
@@ -356,7 +484,30 @@ class MergeArray {
     return streams_[0].get();
   }
 
+  // Returns the stream with the lowest first element and the number of
+  // consecutive elements, at most 'maxElements', that can be taken from the
+  // start of the stream before another stream has a lower first element. The
+  // caller is expected to pop off these elements before calling this
+  // again. Returns {nullptr, 0} when all streams are at end. Runs of one
+  // element may be returned without looking for longer runs, see
+  // RunLengthPredictor.
+  std::pair<Stream*, uint32_t> nextRun(uint32_t maxElements) {
+    VELOX_DCHECK_GT(maxElements, 0);
+    auto* stream = next();
+    if (stream == nullptr) {
+      return {nullptr, 0};
+    }
+    if (!runLengthPredictor_.shouldProbe()) {
+      return {stream, 1};
+    }
+    const auto numElements = stream->upperBound(
+        streams_.size() > 1 ? streams_[1].get() : nullptr, maxElements);
+    runLengthPredictor_.recordRun(numElements);
+    return {stream, numElements};
+  }
+
  private:
+  RunLengthPredictor runLengthPredictor_;
   bool isFirst_{true};
   std::vector<std::unique_ptr<Stream>> streams_;
 };
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/SelectivityInfo.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/memory/MmapAllocator.h"
@@ -24,10 +25,12 @@
 
 #include <folly/Benchmark.h>
 #include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/hash/Hash.h>
 #include <folly/init/Init.h>
 #include <gtest/gtest.h>
 #include <memory>
 
+#include "velox/common/process/Numa.h"
 #include "velox/common/process/Profiler.h"
 
 DEFINE_int64(custom_size, 0, "Custom number of entries");
@@ -38,6 +41,12 @@ DEFINE_int32(custom_num_ways, 10, "Number of build threads");
 
 DEFINE_bool(profile, false, "Generate perf profiles and memory stats");
 
+DEFINE_int64(group_by_rows, 8'000'000, "Number of rows in group by cases");
+DEFINE_int64(
+    group_by_distinct,
+    2'000'000,
+    "Number of groups in group by cases");
+
 DECLARE_bool(velox_time_allocations);
 
 using namespace facebook::velox;
@@ -358,6 +367,88 @@ class HashTableBenchmark : public VectorTestBase {
     }
   }
 
+  // Makes BIGINT keys for the group by cases. The keys are spread over the
+  // 64 bit range, so that the tables are in kHash mode.
+  void makeGroupByData(int64_t numRows, int64_t numDistinct) {
+    constexpr int32_t kBatchSize = 10'000;
+    groupByBatches_.clear();
+    for (int64_t start = 0; start < numRows; start += kBatchSize) {
+      groupByBatches_.push_back(
+          vectorMaker_->rowVector({vectorMaker_->flatVector<int64_t>(
+              kBatchSize, [&](vector_size_t row) {
+                return static_cast<int64_t>(
+                    folly::hash::twang_mix64((start + row) % numDistinct));
+              })}));
+    }
+  }
+
+  // Inserts the group by keys into 'numPartitions' group by tables. With more
+  // than one partition, the rows are split on the high bits of the mixed hash
+  // of the key and the partitions are filled in parallel, like a final
+  // aggregation in parallel insert mode does. Returns the number of groups.
+  int64_t groupBy(int32_t numPartitions) {
+    std::vector<std::unique_ptr<HashTable<false>>> tables;
+    std::vector<std::unique_ptr<HashLookup>> lookups;
+    for (auto i = 0; i < numPartitions; ++i) {
+      std::vector<std::unique_ptr<VectorHasher>> hashers;
+      hashers.push_back(std::make_unique<VectorHasher>(BIGINT(), 0));
+      tables.push_back(HashTable<false>::createForAggregation(
+          std::move(hashers), {}, pool_.get()));
+      lookups.push_back(
+          std::make_unique<HashLookup>(tables.back()->hashers(), pool_.get()));
+    }
+    if (numPartitions == 1) {
+      for (const auto& batch : groupByBatches_) {
+        insertGroups(*batch, *lookups[0], *tables[0]);
+      }
+      return tables[0]->numDistinct();
+    }
+
+    // The rows of each batch that go to each partition.
+    std::vector<std::vector<SelectivityVector>> partitionRows(numPartitions);
+    VectorHasher hasher(BIGINT(), 0);
+    raw_vector<uint64_t> hashes;
+    const auto shift = 64 - __builtin_ctz(numPartitions);
+    for (const auto& batch : groupByBatches_) {
+      const SelectivityVector allRows(batch->size());
+      hashes.resize(batch->size());
+      hasher.decode(*batch->childAt(0), allRows);
+      hasher.hash(allRows, false, hashes);
+      for (auto& rows : partitionRows) {
+        rows.emplace_back(batch->size(), false);
+      }
+      for (auto row = 0; row < batch->size(); ++row) {
+        partitionRows[folly::hash::twang_mix64(hashes[row]) >> shift]
+            .back()
+            .setValid(row, true);
+      }
+      for (auto& rows : partitionRows) {
+        rows.back().updateBounds();
+      }
+    }
+
+    std::vector<std::shared_ptr<AsyncSource<bool>>> steps;
+    for (auto i = 0; i < numPartitions; ++i) {
+      steps.push_back(std::make_shared<AsyncSource<bool>>([&, i]() {
+        for (auto batch = 0; batch < groupByBatches_.size(); ++batch) {
+          const auto& rows = partitionRows[i][batch];
+          if (rows.hasSelections()) {
+            insertGroups(
+                *groupByBatches_[batch], rows, *lookups[i], *tables[i]);
+          }
+        }
+        return std::make_unique<bool>(true);
+      }));
+      executor_->add([step = steps.back()]() { step->prepare(); });
+    }
+    int64_t numDistinct = 0;
+    for (auto i = 0; i < numPartitions; ++i) {
+      steps[i]->move();
+      numDistinct += tables[i]->numDistinct();
+    }
+    return numDistinct;
+  }
+
   // Makes a vector of 'type' with 'size' unique elements, initialized
   // based on 'sequence'. If 'sequence' is incremented by 'size'
   // between the next call will not overlap with the results of the
@@ -572,6 +663,8 @@ class HashTableBenchmark : public VectorTestBase {
 
   std::shared_ptr<memory::MemoryPool> pool_{
       memory::memoryManager()->addLeafPool()};
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_{
+      std::make_unique<folly::CPUThreadPoolExecutor>(FLAGS_custom_num_ways)};
   std::unique_ptr<VectorMaker> vectorMaker_{
       std::make_unique<VectorMaker>(pool_.get())};
   // Bitmap of positions in batches_ that end up in the table.
@@ -579,6 +672,9 @@ class HashTableBenchmark : public VectorTestBase {
   // Test payload, keys first.
   std::vector<RowVectorPtr> batches_;
 
+  // Keys for the group by cases.
+  std::vector<RowVectorPtr> groupByBatches_;
+
   // Corresponds 1:1 to data in 'batches_'. nullptr if the key is not
   // inserted, otherwise pointer into the RowContainer.
   std::vector<char*> rowOfKey_;
@@ -628,6 +724,7 @@ int main(int argc, char** argv) {
   options.allocatorCapacity = 64UL << 30;
   options.useMmapArena = true;
   options.mmapArenaCapacityRatio = 1;
+  options.numaAware = true;
   memory::MemoryManager::initialize(options);
   if (FLAGS_profile) {
     auto allocator = memory::MemoryManager::getInstance()->allocator();
@@ -679,6 +776,39 @@ int main(int argc, char** argv) {
       return 1;
     });
   }
+
+  // Probe of a table built on NUMA node 0 from the same node vs. from a remote
+  // node. Only runs on machines with more than one NUMA node.
+  const auto numNumaNodes = process::numaNodeCount();
+  if (numNumaNodes > 1) {
+    for (const auto probeNode : {0, numNumaNodes - 1}) {
+      const HashTableBenchmarkParams param(
+          fmt::format("Hit32MProbeNode{}", probeNode), 32000000, 100);
+      folly::addBenchmark(
+          __FILE__, param.title, [param, probeNode, &bm, &results]() {
+            {
+              folly::BenchmarkSuspender suspender;
+              process::ScopedNumaNode buildNode(0);
+              bm->makeData(param);
+            }
+            process::ScopedNumaNode numaNode(probeNode);
+            combineResults(results, bm->run());
+            return 1;
+          });
+    }
+  }
+
+  // Single table vs. radix partitioned tables filled in parallel.
+  bm->makeGroupByData(FLAGS_group_by_rows, FLAGS_group_by_distinct);
+  for (const auto numPartitions : {1, 4, 8, 16}) {
+    folly::addBenchmark(
+        __FILE__,
+        fmt::format("GroupBy_{}_partitions", numPartitions),
+        [numPartitions, &bm]() {
+          VELOX_CHECK_EQ(bm->groupBy(numPartitions), FLAGS_group_by_distinct);
+          return 1;
+        });
+  }
   folly::runBenchmarks();
   std::cout << "*** Results:" << std::endl;
   for (auto& result : results) {
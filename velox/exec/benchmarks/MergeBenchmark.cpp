@@ -28,6 +28,8 @@ using namespace facebook::velox::exec::test;
 TestData narrow;
 TestData medium;
 TestData wide;
+TestData narrowClustered;
+TestData wideClustered;
 
 BENCHMARK(narrowTree) {
   MergeTestBase::test<TreeOfLosers<TestingStream>>(narrow, false);
@@ -37,6 +39,14 @@ BENCHMARK_RELATIVE(narrowArray) {
   MergeTestBase::test<MergeArray<TestingStream>>(narrow, false);
 }
 
+BENCHMARK_RELATIVE(narrowTreeRuns) {
+  MergeTestBase::testRuns<TreeOfLosers<TestingStream>>(narrow, 1'024, false);
+}
+
+BENCHMARK_RELATIVE(narrowArrayRuns) {
+  MergeTestBase::testRuns<MergeArray<TestingStream>>(narrow, 1'024, false);
+}
+
 BENCHMARK(mediumTree) {
   MergeTestBase::test<TreeOfLosers<TestingStream>>(medium, false);
 }
@@ -45,6 +55,14 @@ BENCHMARK_RELATIVE(mediumArray) {
   MergeTestBase::test<MergeArray<TestingStream>>(medium, false);
 }
 
+BENCHMARK_RELATIVE(mediumTreeRuns) {
+  MergeTestBase::testRuns<TreeOfLosers<TestingStream>>(medium, 1'024, false);
+}
+
+BENCHMARK_RELATIVE(mediumArrayRuns) {
+  MergeTestBase::testRuns<MergeArray<TestingStream>>(medium, 1'024, false);
+}
+
 BENCHMARK(wideTree) {
   MergeTestBase::test<TreeOfLosers<TestingStream>>(wide, false);
 }
@@ -53,6 +71,43 @@ BENCHMARK_RELATIVE(wideArray) {
   MergeTestBase::test<MergeArray<TestingStream>>(wide, false);
 }
 
+BENCHMARK_RELATIVE(wideTreeRuns) {
+  MergeTestBase::testRuns<TreeOfLosers<TestingStream>>(wide, 1'024, false);
+}
+
+BENCHMARK_RELATIVE(wideArrayRuns) {
+  MergeTestBase::testRuns<MergeArray<TestingStream>>(wide, 1'024, false);
+}
+
+// The clustered data sets have runs of about 100 values from each stream, as
+// when merging partially ordered input.
+BENCHMARK(narrowClusteredTree) {
+  MergeTestBase::test<TreeOfLosers<TestingStream>>(narrowClustered, false);
+}
+
+BENCHMARK_RELATIVE(narrowClusteredTreeRuns) {
+  MergeTestBase::testRuns<TreeOfLosers<TestingStream>>(
+      narrowClustered, 1'024, false);
+}
+
+BENCHMARK(narrowClusteredArray) {
+  MergeTestBase::test<MergeArray<TestingStream>>(narrowClustered, false);
+}
+
+BENCHMARK_RELATIVE(narrowClusteredArrayRuns) {
+  MergeTestBase::testRuns<MergeArray<TestingStream>>(
+      narrowClustered, 1'024, false);
+}
+
+BENCHMARK(wideClusteredTree) {
+  MergeTestBase::test<TreeOfLosers<TestingStream>>(wideClustered, false);
+}
+
+BENCHMARK_RELATIVE(wideClusteredTreeRuns) {
+  MergeTestBase::testRuns<TreeOfLosers<TestingStream>>(
+      wideClustered, 1'024, false);
+}
+
 int main(int argc, char* argv[]) {
   folly::Init init{&argc, &argv};
   ::gflags::ParseCommandLineFlags(&argc, &argv, true);
@@ -61,6 +116,8 @@ int main(int argc, char* argv[]) {
   narrow = test.makeTestData(100'000'000, 7);
   medium = test.makeTestData(10'000'0000, 37);
   wide = test.makeTestData(10'000'0000, 1029);
+  narrowClustered = test.makeClusteredTestData(100'000'000, 7, 100);
+  wideClustered = test.makeClusteredTestData(100'000'000, 1029, 100);
   folly::runBenchmarks();
   return 0;
 }
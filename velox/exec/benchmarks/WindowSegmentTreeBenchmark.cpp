@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fmt/format.h>
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <string>
+
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+
+DEFINE_int64(fuzzer_seed, 99887766, "Seed for random input dataset generator");
+
+using namespace facebook::velox;
+using namespace facebook::velox::test;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+static constexpr int32_t kNumVectors = 10;
+static constexpr int32_t kRowsPerVector = 10'000;
+
+namespace {
+
+/// Compares the per-row re-aggregation of sliding window frames with the
+/// segment tree evaluation enabled by
+/// 'window_aggregate_segment_tree_enabled'.
+class WindowSegmentTreeBenchmark : public OperatorTestBase {
+ public:
+  explicit WindowSegmentTreeBenchmark() {
+    OperatorTestBase::SetUp();
+    aggregate::prestosql::registerAllAggregateFunctions();
+    window::prestosql::registerAllWindowFunctions();
+
+    inputType_ = ROW({
+        {"p", INTEGER()},
+        {"s", INTEGER()},
+        {"i64", BIGINT()},
+        {"f64", DOUBLE()},
+    });
+
+    VectorFuzzer::Options opts;
+    opts.vectorSize = kRowsPerVector;
+    opts.nullRatio = 0;
+    VectorFuzzer fuzzer(opts, pool_.get(), FLAGS_fuzzer_seed);
+    for (auto i = 0; i < kNumVectors; ++i) {
+      std::vector<VectorPtr> children;
+      // A few large partitions.
+      children.emplace_back(makeFlatVector<int32_t>(
+          kRowsPerVector, [](auto row) { return row % 4; }));
+      // Increasing values for a deterministic sort order.
+      children.emplace_back(makeFlatVector<int32_t>(
+          kRowsPerVector, [i](auto row) { return i * kRowsPerVector + row; }));
+      children.emplace_back(fuzzer.fuzzFlat(BIGINT()));
+      children.emplace_back(fuzzer.fuzzFlat(DOUBLE()));
+      inputVectors_.emplace_back(makeRowVector(inputType_->names(), children));
+    }
+  }
+
+  ~WindowSegmentTreeBenchmark() override {
+    OperatorTestBase::TearDown();
+  }
+
+  void TestBody() override {}
+
+  void run(const std::string& aggregate, int32_t preceding, bool segmentTree) {
+    folly::BenchmarkSuspender suspender;
+    const auto functionSql = fmt::format(
+        "{} over (partition by p order by s rows between {} preceding and current row)",
+        aggregate,
+        preceding);
+    auto plan = PlanBuilder()
+                    .values(inputVectors_)
+                    .window({functionSql})
+                    .planFragment();
+
+    const std::unordered_map<std::string, std::string> queryConfigMap(
+        {{core::QueryConfig::kWindowAggregateSegmentTreeEnabled,
+          segmentTree ? "true" : "false"}});
+    auto task = exec::Task::create(
+        "t",
+        std::move(plan),
+        0,
+        core::QueryCtx::create(
+            executor_.get(), core::QueryConfig(queryConfigMap)),
+        Task::ExecutionMode::kSerial);
+    suspender.dismiss();
+
+    vector_size_t numResultRows = 0;
+    while (auto result = task->next()) {
+      numResultRows += result->size();
+    }
+    folly::doNotOptimizeAway(numResultRows);
+  }
+
+ private:
+  RowTypePtr inputType_;
+  std::vector<RowVectorPtr> inputVectors_;
+};
+
+std::unique_ptr<WindowSegmentTreeBenchmark> benchmark;
+
+void doSimpleRun(uint32_t, const std::string& aggregate, int32_t preceding) {
+  benchmark->run(aggregate, preceding, false);
+}
+
+void doSegmentTreeRun(
+    uint32_t,
+    const std::string& aggregate,
+    int32_t preceding) {
+  benchmark->run(aggregate, preceding, true);
+}
+
+#define SLIDING_FRAME_BENCHMARKS(_name_, _column_, _preceding_) \
+  BENCHMARK_NAMED_PARAM(                                        \
+      doSimpleRun,                                              \
+      _name_##_##_column_##_##_preceding_,                      \
+      fmt::format("{}({})", (#_name_), (#_column_)),            \
+      _preceding_);                                             \
+  BENCHMARK_RELATIVE_NAMED_PARAM(                               \
+      doSegmentTreeRun,                                         \
+      _name_##_##_column_##_##_preceding_,                      \
+      fmt::format("{}({})", (#_name_), (#_column_)),            \
+      _preceding_);                                             \
+  BENCHMARK_DRAW_LINE();
+
+SLIDING_FRAME_BENCHMARKS(sum, i64, 10)
+SLIDING_FRAME_BENCHMARKS(sum, i64, 100)
+SLIDING_FRAME_BENCHMARKS(sum, i64, 1000)
+SLIDING_FRAME_BENCHMARKS(avg, f64, 10)
+SLIDING_FRAME_BENCHMARKS(avg, f64, 100)
+SLIDING_FRAME_BENCHMARKS(avg, f64, 1000)
+SLIDING_FRAME_BENCHMARKS(min, i64, 100)
+SLIDING_FRAME_BENCHMARKS(min, i64, 1000)
+SLIDING_FRAME_BENCHMARKS(max, f64, 100)
+SLIDING_FRAME_BENCHMARKS(max, f64, 1000)
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init(&argc, &argv);
+  facebook::velox::memory::MemoryManager::initialize(
+      facebook::velox::memory::MemoryManager::Options{});
+
+  benchmark = std::make_unique<WindowSegmentTreeBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
@@ -122,6 +122,11 @@ class DuckQueryRunnerToSqlPlanNodeVisitor : public PrestoSqlPlanNodeVisitor {
   void visit(const core::RowNumberNode& node, core::PlanNodeVisitorContext& ctx)
       const override;
 
+  void visit(const core::SampleNode&, core::PlanNodeVisitorContext&)
+      const override {
+    VELOX_NYI();
+  }
+
   void visit(const core::TableScanNode& node, core::PlanNodeVisitorContext& ctx)
       const override;
 
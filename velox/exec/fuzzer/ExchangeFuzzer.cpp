@@ -597,6 +597,5 @@ int main(int argc, char** argv) {
     fuzzer.seed(seed);
   }
   fuzzer.run();
-  exec::test::testingShutdownLocalExchangeSource();
   return 0;
 }
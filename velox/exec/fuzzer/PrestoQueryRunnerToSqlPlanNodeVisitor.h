@@ -127,6 +127,11 @@ class PrestoQueryRunnerToSqlPlanNodeVisitor : public PrestoSqlPlanNodeVisitor {
   void visit(const core::RowNumberNode& node, core::PlanNodeVisitorContext& ctx)
       const override;
 
+  void visit(const core::SampleNode&, core::PlanNodeVisitorContext&)
+      const override {
+    VELOX_NYI();
+  }
+
   void visit(const core::TableScanNode& node, core::PlanNodeVisitorContext& ctx)
       const override {
     PrestoSqlPlanNodeVisitor::visit(node, ctx);
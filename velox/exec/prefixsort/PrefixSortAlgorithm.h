@@ -18,6 +18,9 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <vector>
+
+#include <folly/Portability.h>
 
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
@@ -151,6 +154,9 @@ class PrefixSortRunner {
   static const int kSmallSort = 7;
   static const int kMediumSort = 40;
 
+  // Number of buckets of a radix sort pass, one per byte value.
+  static const int kRadixSize = 256;
+
   template <typename TCompare>
   void quickSort(char* start, char* end, TCompare compare) const {
     quickSort(
@@ -159,6 +165,142 @@ class PrefixSortRunner {
         compare);
   }
 
+  /// Sorts the entries in [start, end) with a least significant digit first
+  /// radix sort on the first 'keyBytes' bytes of each entry. The keys are
+  /// ordered as sequences of native uint64_t words, which is how PrefixSort
+  /// compares fully normalized keys. The passes over the key bytes that have
+  /// the same value in all the entries are skipped. The sort is stable.
+  /// @param keyBytes Must be a multiple of 8 and at most the entry size.
+  /// @param tempBuffer The buffer must be at least (end - start) bytes long.
+  void radixSort(char* start, char* end, uint32_t keyBytes, char* tempBuffer)
+      const {
+    VELOX_CHECK(end >= start, "Invalid sort range.");
+    VELOX_CHECK_EQ(keyBytes % sizeof(uint64_t), 0);
+    VELOX_CHECK_LE(keyBytes, entrySize_);
+    VELOX_CHECK_NOT_NULL(tempBuffer);
+    const uint64_t numEntries = (end - start) / entrySize_;
+    if (numEntries < 2) {
+      return;
+    }
+
+    // Builds the histograms of all the key bytes in a single pass.
+    std::vector<uint64_t> counts(keyBytes * kRadixSize, 0);
+    for (auto* entry = start; entry < end; entry += entrySize_) {
+      for (uint32_t i = 0; i < keyBytes; ++i) {
+        ++counts[i * kRadixSize + static_cast<uint8_t>(entry[i])];
+      }
+    }
+
+    char* source = start;
+    char* target = tempBuffer;
+    // The least significant byte is the low order byte of the last word.
+    for (int32_t word = keyBytes / sizeof(uint64_t) - 1; word >= 0; --word) {
+      for (uint32_t byte = 0; byte < sizeof(uint64_t); ++byte) {
+        const uint32_t offset = word * sizeof(uint64_t) +
+            (folly::kIsLittleEndian ? byte : sizeof(uint64_t) - 1 - byte);
+        uint64_t* byteCounts = counts.data() + offset * kRadixSize;
+        if (byteCounts[static_cast<uint8_t>(source[offset])] == numEntries) {
+          continue;
+        }
+        uint64_t position = 0;
+        for (int32_t i = 0; i < kRadixSize; ++i) {
+          const auto count = byteCounts[i];
+          byteCounts[i] = position;
+          position += count;
+        }
+        const auto* sourceEnd = source + numEntries * entrySize_;
+        for (auto* entry = source; entry < sourceEnd; entry += entrySize_) {
+          auto& index = byteCounts[static_cast<uint8_t>(entry[offset])];
+          simd::memcpy(target + index * entrySize_, entry, entrySize_);
+          ++index;
+        }
+        std::swap(source, target);
+      }
+    }
+    if (source != start) {
+      simd::memcpy(start, source, numEntries * entrySize_);
+    }
+  }
+
+  /// Finds the sorted runs of the entries in [start, end). A run is a maximal
+  /// range of non-descending or of strictly descending entries. Descending runs
+  /// are reversed in place. Returns the run boundaries as entry indices, i.e.
+  /// the i-th run is [result[i], result[i + 1]). Returns an empty vector if
+  /// there are more than 'maxRuns' runs. Stops at the first run exceeding
+  /// 'maxRuns' so the cost is low for unsorted input.
+  template <typename TCompare>
+  std::vector<uint64_t> findSortedRuns(
+      char* start,
+      char* end,
+      uint32_t maxRuns,
+      TCompare compare) const {
+    VELOX_CHECK(end >= start, "Invalid sort range.");
+    std::vector<uint64_t> runBounds{0};
+    for (auto* runStart = start; runStart < end;) {
+      if (runBounds.size() > maxRuns) {
+        return {};
+      }
+      auto* runEnd = runStart + entrySize_;
+      if (runEnd < end && compare(runStart, runEnd) > 0) {
+        do {
+          runEnd += entrySize_;
+        } while (runEnd < end && compare(runEnd - entrySize_, runEnd) > 0);
+        reverse(
+            detail::PrefixSortIterator(runStart, entrySize_),
+            detail::PrefixSortIterator(runEnd, entrySize_));
+      } else if (runEnd < end) {
+        do {
+          runEnd += entrySize_;
+        } while (runEnd < end && compare(runEnd - entrySize_, runEnd) <= 0);
+      }
+      runBounds.push_back((runEnd - start) / entrySize_);
+      runStart = runEnd;
+    }
+    return runBounds;
+  }
+
+  /// Sorts the entries starting at 'start' by merging adjacent pairs of the
+  /// sorted runs returned by findSortedRuns() until a single run is left.
+  /// @param tempBuffer The buffer must be at least as long as the entries.
+  template <typename TCompare>
+  void mergeSortedRuns(
+      char* start,
+      std::vector<uint64_t> runBounds,
+      char* tempBuffer,
+      TCompare compare) const {
+    VELOX_CHECK(!runBounds.empty());
+    VELOX_CHECK_NOT_NULL(tempBuffer);
+    char* source = start;
+    char* target = tempBuffer;
+    while (runBounds.size() > 2) {
+      size_t numBounds = 0;
+      size_t i = 0;
+      for (; i + 2 < runBounds.size(); i += 2) {
+        merge(
+            source + runBounds[i] * entrySize_,
+            source + runBounds[i + 1] * entrySize_,
+            source + runBounds[i + 2] * entrySize_,
+            target + runBounds[i] * entrySize_,
+            compare);
+        runBounds[numBounds++] = runBounds[i];
+      }
+      // Copies the last run if it has no pair.
+      if (i + 1 < runBounds.size()) {
+        simd::memcpy(
+            target + runBounds[i] * entrySize_,
+            source + runBounds[i] * entrySize_,
+            (runBounds[i + 1] - runBounds[i]) * entrySize_);
+        runBounds[numBounds++] = runBounds[i];
+      }
+      runBounds[numBounds++] = runBounds.back();
+      runBounds.resize(numBounds);
+      std::swap(source, target);
+    }
+    if (source != start) {
+      simd::memcpy(start, source, runBounds.back() * entrySize_);
+    }
+  }
+
   /// For testing only.
   template <typename TCompare>
   FOLLY_ALWAYS_INLINE static char* testingMedian3(
@@ -192,6 +334,45 @@ class PrefixSortRunner {
     }
   }
 
+  FOLLY_ALWAYS_INLINE void reverse(
+      detail::PrefixSortIterator start,
+      detail::PrefixSortIterator end) const {
+    while (start < end && start < --end) {
+      swap(start++, end);
+    }
+  }
+
+  // Merges the sorted runs [left, right) and [right, rightEnd) into 'target'.
+  // Takes the entry of the left run on ties.
+  template <typename TCompare>
+  FOLLY_ALWAYS_INLINE void merge(
+      char* left,
+      char* right,
+      char* rightEnd,
+      char* target,
+      TCompare compare) const {
+    char* const leftEnd = right;
+    // The runs are already in order, e.g. the input is a sorted sequence of
+    // runs that were split by a few out of order entries.
+    if (compare(leftEnd - entrySize_, right) <= 0) {
+      simd::memcpy(target, left, rightEnd - left);
+      return;
+    }
+    while (left < leftEnd && right < rightEnd) {
+      if (compare(right, left) < 0) {
+        simd::memcpy(target, right, entrySize_);
+        right += entrySize_;
+      } else {
+        simd::memcpy(target, left, entrySize_);
+        left += entrySize_;
+      }
+      target += entrySize_;
+    }
+    simd::memcpy(target, left, leftEnd - left);
+    target += leftEnd - left;
+    simd::memcpy(target, right, rightEnd - right);
+  }
+
   // Calculate which one has median of three input iterators.
   // The compare logic is (the symbol '<' and '>' means value compare result):
   //            ---------cmp(a, b)--------
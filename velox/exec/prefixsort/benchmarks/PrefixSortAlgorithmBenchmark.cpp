@@ -44,6 +44,42 @@ class PrefixSortAlgorithmBenchmark {
         });
   }
 
+  void runRadixSort(std::vector<int64_t> vec) {
+    char* start = (char*)vec.data();
+    uint32_t entrySize = sizeof(int64_t);
+    auto swapBuffer = AlignedBuffer::allocate<char>(entrySize, pool_.get());
+    auto tempBuffer =
+        AlignedBuffer::allocate<char>(entrySize * vec.size(), pool_.get());
+    auto sortRunner =
+        prefixsort::PrefixSortRunner(entrySize, swapBuffer->asMutable<char>());
+    sortRunner.radixSort(
+        start,
+        start + entrySize * vec.size(),
+        entrySize,
+        tempBuffer->asMutable<char>());
+  }
+
+  // Merges the sorted runs of 'vec', falls back to quick sort if there are
+  // more than 'maxRuns' runs.
+  void runMergeSortedRuns(std::vector<int64_t> vec, uint32_t maxRuns) {
+    char* start = (char*)vec.data();
+    char* end = start + sizeof(int64_t) * vec.size();
+    uint32_t entrySize = sizeof(int64_t);
+    auto swapBuffer = AlignedBuffer::allocate<char>(entrySize, pool_.get());
+    auto sortRunner =
+        prefixsort::PrefixSortRunner(entrySize, swapBuffer->asMutable<char>());
+    const auto compare = [&](char* a, char* b) { return memcmp(a, b, 8); };
+    auto runBounds = sortRunner.findSortedRuns(start, end, maxRuns, compare);
+    if (runBounds.empty()) {
+      sortRunner.quickSort(start, end, compare);
+      return;
+    }
+    auto tempBuffer =
+        AlignedBuffer::allocate<char>(entrySize * vec.size(), pool_.get());
+    sortRunner.mergeSortedRuns(
+        start, std::move(runBounds), tempBuffer->asMutable<char>(), compare);
+  }
+
   std::vector<int64_t> generateTestVector(int32_t size) {
     std::vector<int64_t> randomTestVec(size);
     std::generate(randomTestVec.begin(), randomTestVec.end(), [&]() {
@@ -53,6 +89,32 @@ class PrefixSortAlgorithmBenchmark {
     return randomTestVec;
   }
 
+  // Generates 'numRuns' ascending runs of random data, e.g. time ordered data
+  // from a few sources.
+  std::vector<int64_t> generateSortedRunsVector(int32_t size, int32_t numRuns) {
+    std::vector<int64_t> testVec(size);
+    std::generate(testVec.begin(), testVec.end(), [&]() {
+      return folly::Random::rand64(rng_);
+    });
+    const auto runSize = size / numRuns;
+    for (auto i = 0; i < numRuns; ++i) {
+      const auto runStart = testVec.begin() + i * runSize;
+      std::sort(
+          runStart, i == numRuns - 1 ? testVec.end() : runStart + runSize);
+    }
+    prefixsort::test::encodeInPlace(testVec);
+    return testVec;
+  }
+
+  // Radix sort compares native words, so the data is not encoded.
+  std::vector<int64_t> generateRadixTestVector(int32_t size) {
+    std::vector<int64_t> randomTestVec(size);
+    std::generate(randomTestVec.begin(), randomTestVec.end(), [&]() {
+      return folly::Random::rand64(rng_);
+    });
+    return randomTestVec;
+  }
+
  private:
   std::shared_ptr<memory::MemoryPool> pool_{
       memory::memoryManager()->addLeafPool()};
@@ -65,6 +127,14 @@ std::vector<int64_t> data10k;
 std::vector<int64_t> data100k;
 std::vector<int64_t> data1000k;
 std::vector<int64_t> data10000k;
+std::vector<int64_t> radixData10k;
+std::vector<int64_t> radixData100k;
+std::vector<int64_t> radixData1000k;
+std::vector<int64_t> radixData10000k;
+std::vector<int64_t> sortedRuns1000k;
+std::vector<int64_t> sortedRuns10000k;
+
+constexpr uint32_t kNumSortedRuns = 8;
 
 BENCHMARK(PrefixSort_algorithm_10k) {
   bm->runQuickSort(data10k);
@@ -82,6 +152,51 @@ BENCHMARK(PrefixSort_algorithm_10000k) {
   bm->runQuickSort(data10000k);
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(PrefixSort_radix_10k) {
+  bm->runRadixSort(radixData10k);
+}
+
+BENCHMARK(PrefixSort_radix_100k) {
+  bm->runRadixSort(radixData100k);
+}
+
+BENCHMARK(PrefixSort_radix_1000k) {
+  bm->runRadixSort(radixData1000k);
+}
+
+BENCHMARK(PrefixSort_radix_10000k) {
+  bm->runRadixSort(radixData10000k);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(PrefixSort_sortedRuns_quickSort_1000k) {
+  bm->runQuickSort(sortedRuns1000k);
+}
+
+BENCHMARK_RELATIVE(PrefixSort_sortedRuns_merge_1000k) {
+  bm->runMergeSortedRuns(sortedRuns1000k, kNumSortedRuns);
+}
+
+BENCHMARK(PrefixSort_sortedRuns_quickSort_10000k) {
+  bm->runQuickSort(sortedRuns10000k);
+}
+
+BENCHMARK_RELATIVE(PrefixSort_sortedRuns_merge_10000k) {
+  bm->runMergeSortedRuns(sortedRuns10000k, kNumSortedRuns);
+}
+
+// Measures the run detection overhead on random data.
+BENCHMARK(PrefixSort_random_quickSort_1000k) {
+  bm->runQuickSort(data1000k);
+}
+
+BENCHMARK_RELATIVE(PrefixSort_random_merge_1000k) {
+  bm->runMergeSortedRuns(data1000k, kNumSortedRuns);
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -93,6 +208,12 @@ int main(int argc, char** argv) {
   data100k = bm->generateTestVector(100'000);
   data1000k = bm->generateTestVector(1'000'000);
   data10000k = bm->generateTestVector(10'000'000);
+  radixData10k = bm->generateRadixTestVector(10'000);
+  radixData100k = bm->generateRadixTestVector(100'000);
+  radixData1000k = bm->generateRadixTestVector(1'000'000);
+  radixData10000k = bm->generateRadixTestVector(10'000'000);
+  sortedRuns1000k = bm->generateSortedRunsVector(1'000'000, kNumSortedRuns);
+  sortedRuns10000k = bm->generateSortedRunsVector(10'000'000, kNumSortedRuns);
   folly::runBenchmarks();
   return 0;
 }
@@ -55,6 +55,88 @@ class PrefixSortAlgorithmTest : public testing::Test,
     ASSERT_EQ(data1, data2);
   }
 
+  void testRadixSort(size_t size) {
+    // Two key words and a payload word which is not part of the key.
+    struct Entry {
+      uint64_t keys[2];
+      uint64_t payload;
+    };
+    std::vector<Entry> data1(size);
+    for (size_t i = 0; i < size; ++i) {
+      // Few distinct high order values to have ties and constant key bytes.
+      data1[i] = {{folly::Random::rand64() % 16, folly::Random::rand64()}, i};
+    }
+    std::vector<Entry> data2 = data1;
+
+    {
+      char* start = (char*)data1.data();
+      char* end = start + sizeof(Entry) * data1.size();
+      const uint32_t entrySize = sizeof(Entry);
+      auto swapBuffer = AlignedBuffer::allocate<char>(entrySize, pool());
+      auto tempBuffer =
+          AlignedBuffer::allocate<char>(entrySize * size, pool());
+      PrefixSortRunner sortRunner(entrySize, swapBuffer->asMutable<char>());
+      sortRunner.radixSort(
+          start, end, sizeof(Entry::keys), tempBuffer->asMutable<char>());
+    }
+
+    // Radix sort is stable.
+    std::stable_sort(
+        data2.begin(), data2.end(), [](const Entry& lhs, const Entry& rhs) {
+          return std::make_pair(lhs.keys[0], lhs.keys[1]) <
+              std::make_pair(rhs.keys[0], rhs.keys[1]);
+        });
+    for (size_t i = 0; i < size; ++i) {
+      ASSERT_EQ(data1[i].keys[0], data2[i].keys[0]);
+      ASSERT_EQ(data1[i].keys[1], data2[i].keys[1]);
+      ASSERT_EQ(data1[i].payload, data2[i].payload);
+    }
+  }
+
+  // Generates 'numRuns' sorted runs, every other one in descending order, and
+  // sorts them with sorted runs merge.
+  void testMergeSortedRuns(size_t size, uint32_t numRuns) {
+    std::vector<int64_t> data1(size);
+    std::generate(
+        data1.begin(), data1.end(), [&]() { return folly::Random::rand64(); });
+    const auto runSize = size / numRuns;
+    for (uint32_t i = 0; i < numRuns; ++i) {
+      const auto runStart = data1.begin() + i * runSize;
+      const auto runEnd = i == numRuns - 1 ? data1.end() : runStart + runSize;
+      if (i % 2 == 0) {
+        std::sort(runStart, runEnd);
+      } else {
+        std::sort(runStart, runEnd, std::greater<int64_t>());
+      }
+    }
+    std::vector<int64_t> data2 = data1;
+
+    {
+      char* start = (char*)data1.data();
+      char* end = start + sizeof(int64_t) * data1.size();
+      const uint32_t entrySize = sizeof(int64_t);
+      auto swapBuffer = AlignedBuffer::allocate<char>(entrySize, pool());
+      auto tempBuffer =
+          AlignedBuffer::allocate<char>(entrySize * size, pool());
+      PrefixSortRunner sortRunner(entrySize, swapBuffer->asMutable<char>());
+      encodeInPlace(data1);
+      const auto compare = [&](char* a, char* b) { return memcmp(a, b, 8); };
+      ASSERT_TRUE(
+          sortRunner.findSortedRuns(start, end, numRuns - 1, compare).empty());
+      // Reversing the descending runs does not change the runs.
+      auto runBounds = sortRunner.findSortedRuns(start, end, numRuns, compare);
+      ASSERT_EQ(runBounds.size(), numRuns + 1);
+      ASSERT_EQ(runBounds.front(), 0);
+      ASSERT_EQ(runBounds.back(), size);
+      sortRunner.mergeSortedRuns(
+          start, std::move(runBounds), tempBuffer->asMutable<char>(), compare);
+    }
+
+    std::sort(data2.begin(), data2.end());
+    decodeInPlace(data1);
+    ASSERT_EQ(data1, data2);
+  }
+
  protected:
   static void SetUpTestCase() {
     memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
@@ -70,6 +152,21 @@ TEST_F(PrefixSortAlgorithmTest, quickSort) {
   testQuickSort(PrefixSortRunner::kMediumSort + 1000);
 }
 
+TEST_F(PrefixSortAlgorithmTest, radixSort) {
+  testRadixSort(0);
+  testRadixSort(1);
+  testRadixSort(PrefixSortRunner::kSmallSort);
+  testRadixSort(PrefixSortRunner::kRadixSize + 1);
+  testRadixSort(10'000);
+}
+
+TEST_F(PrefixSortAlgorithmTest, mergeSortedRuns) {
+  testMergeSortedRuns(1'000, 2);
+  testMergeSortedRuns(1'000, 3);
+  testMergeSortedRuns(1'000, 7);
+  testMergeSortedRuns(10'000, 16);
+}
+
 TEST_F(PrefixSortAlgorithmTest, testingMedian3) {
   // Generate 3 elements randomly as input data.
   std::vector<int64_t> data1(3);
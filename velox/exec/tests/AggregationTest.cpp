@@ -915,6 +915,54 @@ TEST_F(AggregationTest, partialAggregationMemoryLimit) {
           .customStats.count("flushRowCount"));
 }
 
+TEST_F(AggregationTest, partialAggregationCacheTable) {
+  // Every third row has a unique key. The other rows have one of 7 frequent
+  // keys.
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 20; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000,
+            [&](auto row) {
+              return row % 3 == 0 ? 100 + i * 1'000 + row : row % 7;
+            },
+            nullEvery(11)),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  const auto runQuery = [&](const std::string& configName,
+                            uint64_t tableBytes) {
+    core::PlanNodeId aggNodeId;
+    auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                    .config(configName, tableBytes)
+                    .plan(PlanBuilder()
+                              .values(vectors)
+                              .partialAggregation(
+                                  {"c0"}, {"count(1)", "sum(c1)", "max(c1)"})
+                              .capturePlanNodeId(aggNodeId)
+                              .finalAggregation()
+                              .planNode())
+                    .assertResults(
+                        "SELECT c0, count(1), sum(c1), max(c1) FROM tmp GROUP BY 1");
+    const auto planStats = toPlanStats(task->taskStats());
+    EXPECT_GT(planStats.at(aggNodeId).customStats.at("flushRowCount").sum, 0);
+    return planStats.at(aggNodeId).outputRows;
+  };
+
+  for (const uint64_t tableBytes : {1, 64 << 10}) {
+    SCOPED_TRACE(fmt::format("tableBytes: {}", tableBytes));
+    const auto numEvictedRows =
+        runQuery(QueryConfig::kPartialAggregationCacheTableBytes, tableBytes);
+    const auto numFlushedRows =
+        runQuery(QueryConfig::kMaxPartialAggregationMemory, tableBytes);
+    // The frequent keys stay in the table when the other groups are evicted,
+    // while each flush outputs them again.
+    EXPECT_LT(numEvictedRows, numFlushedRows);
+  }
+}
+
 TEST_F(AggregationTest, partialDistinctWithAbandon) {
   auto vectors = {
       // 1st batch will produce 100 distinct groups from 10 rows.
@@ -1053,6 +1101,61 @@ TEST_F(AggregationTest, largeValueRangeArray) {
   EXPECT_EQ(1, stats.at(finalAggId).inputVectors);
 }
 
+TEST_F(AggregationTest, parallelInsert) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            10'000, [&](auto row) { return (i * 10'000 + row) % 20'011; }),
+        makeFlatVector<std::string>(
+            10'000,
+            [&](auto row) { return fmt::format("{}", (i + row) % 7); }),
+        makeFlatVector<int64_t>(
+            10'000, [](auto row) { return row; }, nullEvery(11)),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  std::set<std::pair<int64_t, std::string>> groups;
+  for (auto i = 0; i < 10; ++i) {
+    for (auto row = 0; row < 10'000; ++row) {
+      groups.emplace(
+          (i * 10'000 + row) % 20'011, fmt::format("{}", (i + row) % 7));
+    }
+  }
+  const int64_t numGroups = groups.size();
+
+  core::PlanNodeId finalAggId;
+  const auto plan =
+      PlanBuilder()
+          .values(vectors)
+          .partialAggregation({"c0", "c1"}, {"sum(c2)", "count(c2)"})
+          .finalAggregation()
+          .capturePlanNodeId(finalAggId)
+          .planNode();
+  for (const auto numPartitions : {0, 1, 4, 16}) {
+    SCOPED_TRACE(fmt::format("numPartitions: {}", numPartitions));
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(
+                QueryConfig::kAggregationParallelInsertPartitions,
+                numPartitions)
+            .assertResults(
+                "SELECT c0, c1, sum(c2), count(c2) FROM tmp GROUP BY 1, 2");
+    // The partitions hold disjoint groups.
+    auto stats = toPlanStats(task->taskStats());
+    EXPECT_EQ(
+        numGroups,
+        stats.at(finalAggId).customStats.at("hashtable.numDistinct").max);
+  }
+
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(plan)
+          .config(QueryConfig::kAggregationParallelInsertPartitions, 3)
+          .copyResults(pool()),
+      "aggregation_parallel_insert_partitions must be a power of 2: 3");
+}
+
 TEST_F(AggregationTest, partialAggregationMemoryLimitIncrease) {
   constexpr int64_t kGB = 1 << 30;
   auto vectors = {
@@ -16,8 +16,10 @@
 #include <folly/ScopeGuard.h>
 #include <gtest/gtest.h>
 #include <atomic>
+#include <numeric>
 #include <thread>
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/InProcessExchangeSource.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/LocalExchangeSource.h"
@@ -55,7 +57,6 @@ class ExchangeClientTest
 
   void SetUp() override {
     serdeKind_ = GetParam();
-    test::testingStartLocalExchangeSource();
     executor_ = std::make_unique<folly::CPUThreadPoolExecutor>(16);
     exec::ExchangeSource::factories().clear();
     exec::ExchangeSource::registerFactory(test::createLocalExchangeSource);
@@ -69,7 +70,6 @@ class ExchangeClientTest
 
   void TearDown() override {
     exec::test::waitForAllTasksToBeDeleted();
-    test::testingShutdownLocalExchangeSource();
   }
 
   std::shared_ptr<Task> makeTask(
@@ -360,6 +360,107 @@ TEST_P(ExchangeClientTest, largeSinglePage) {
   client->close();
 }
 
+TEST_P(ExchangeClientTest, inProcessExchangeSource) {
+  InProcessExchangeSource::registerFactory();
+
+  auto data = {
+      makeRowVector({makeFlatVector<int32_t>({1, 2, 3})}),
+      makeRowVector({makeFlatVector<int32_t>({1, 2, 3, 4, 5})}),
+      makeRowVector({makeFlatVector<int32_t>({1, 2})}),
+  };
+
+  // The task id does not match the factory of the test LocalExchangeSource.
+  const std::string taskId = "in-process-producer";
+  auto task = makeTask(taskId);
+  bufferManager_->initializeTask(
+      task, core::PartitionedOutputNode::Kind::kPartitioned, 1, 1);
+  ASSERT_EQ(
+      InProcessExchangeSource::create(
+          "unknown-producer",
+          0,
+          std::make_shared<ExchangeQueue>(1, 0),
+          pool()),
+      nullptr);
+
+  auto client = std::make_shared<ExchangeClient>(
+      "t",
+      0,
+      ExchangeClient::kDefaultMaxQueuedBytes,
+      1,
+      kDefaultMinExchangeOutputBatchBytes,
+      pool(),
+      executor());
+  client->addRemoteTaskId(taskId);
+  client->noMoreRemoteTasks();
+
+  std::vector<int32_t> pageBytes;
+  for (auto vector : data) {
+    pageBytes.push_back(enqueue(taskId, 0, vector));
+  }
+  bufferManager_->noMoreData(taskId);
+
+  const auto pages = fetchPages(1, *client, data.size());
+  for (auto i = 0; i < pages.size(); ++i) {
+    ASSERT_EQ(pages[i]->size(), pageBytes[i]);
+  }
+  bool atEnd{false};
+  while (!atEnd) {
+    ContinueFuture future;
+    ASSERT_TRUE(client->next(1, 1, &atEnd, &future).empty());
+    if (!atEnd) {
+      auto& exec = folly::QueuedImmediateExecutor::instance();
+      std::move(future).via(&exec).wait();
+    }
+  }
+
+  const auto stats = client->stats();
+  ASSERT_EQ(data.size(), stats.at("inProcessExchangeSource.numPages").sum);
+  ASSERT_EQ(
+      std::accumulate(pageBytes.begin(), pageBytes.end(), 0),
+      stats.at("inProcessExchangeSource.totalBytes").sum);
+
+  task->requestCancel();
+  bufferManager_->removeTask(taskId);
+  client->close();
+}
+
+TEST_P(ExchangeClientTest, inProcessExchangeSourceTimeout) {
+  const std::string taskId = "in-process-timeout-producer";
+  auto task = makeTask(taskId);
+  bufferManager_->initializeTask(
+      task, core::PartitionedOutputNode::Kind::kPartitioned, 1, 1);
+
+  auto queue = std::make_shared<ExchangeQueue>(1, 0);
+  auto source = InProcessExchangeSource::create(taskId, 0, queue, pool());
+  ASSERT_NE(source, nullptr);
+
+  // The producer has no data. The request completes empty after 'maxWait'.
+  {
+    std::lock_guard<std::mutex> l(queue->mutex());
+    ASSERT_TRUE(source->shouldRequestLocked());
+  }
+  auto response =
+      source->request(1 << 20, std::chrono::milliseconds(10)).get();
+  ASSERT_EQ(response.bytes, 0);
+  ASSERT_FALSE(response.atEnd);
+
+  // The data notification for the timed out request is ignored. The next
+  // request fetches the data.
+  const auto pageBytes = enqueue(
+      taskId, 0, makeRowVector({makeFlatVector<int32_t>({1, 2, 3})}));
+  {
+    std::lock_guard<std::mutex> l(queue->mutex());
+    ASSERT_TRUE(source->shouldRequestLocked());
+  }
+  response = source->request(1 << 20, std::chrono::seconds(10)).get();
+  ASSERT_EQ(response.bytes, pageBytes);
+  ASSERT_EQ(queue->receivedPages(), 1);
+
+  source->close();
+  task->requestCancel();
+  bufferManager_->removeTask(taskId);
+}
+
 TEST_P(ExchangeClientTest, multiPageFetch) {
   auto client = std::make_shared<ExchangeClient>(
       "test",
@@ -447,7 +548,7 @@ TEST_P(ExchangeClientTest, sourceTimeout) {
   std::mutex mutex;
   std::unordered_set<void*> sourcesWithTimeout;
   SCOPED_TESTVALUE_SET(
-      "facebook::velox::exec::test::LocalExchangeSource::timeout",
+      "facebook::velox::exec::InProcessExchangeSource::timeout",
       std::function<void(void*)>(([&](void* source) {
         std::lock_guard<std::mutex> l(mutex);
         sourcesWithTimeout.insert(source);
@@ -585,7 +686,7 @@ TEST_P(ExchangeClientTest, acknowledge) {
 
   std::atomic_int numberOfAcknowledgeRequests{0};
   SCOPED_TESTVALUE_SET(
-      "facebook::velox::exec::test::LocalExchangeSource::pause",
+      "facebook::velox::exec::InProcessExchangeSource::pause",
       std::function<void(void*)>(([&numberOfAcknowledgeRequests](void*) {
         numberOfAcknowledgeRequests++;
       })));
@@ -975,6 +1076,68 @@ TEST_P(ExchangeClientTest, minOutputBatchBytesMultipleConsumers) {
   client->close();
 }
 
+TEST_P(ExchangeClientTest, adaptiveBatching) {
+  const auto minOutputBatchBytes = 1 << 20;
+  auto client = std::make_shared<ExchangeClient>(
+      "test",
+      17,
+      ExchangeClient::kDefaultMaxQueuedBytes,
+      1,
+      minOutputBatchBytes,
+      pool(),
+      executor(),
+      10,
+      true);
+  const auto& queue = client->queue();
+  addSources(*queue, 1);
+
+  // Early in the exchange, a consumer does not wait for more than the bytes
+  // received so far.
+  for (auto i = 0; i < 100; ++i) {
+    enqueue(*queue, makePage(500));
+  }
+  bool atEnd;
+  ContinueFuture future = ContinueFuture::makeEmpty();
+  auto pages = client->next(1, minOutputBatchBytes, &atEnd, &future);
+  ASSERT_EQ(100, pages.size());
+
+  // A consumer waits for the bytes expected to arrive within 50ms at the
+  // average arrival rate. This is more than the 1% of the received bytes that
+  // unblocks a consumer in non-adaptive mode.
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  enqueue(*queue, makePage(1'000));
+  pages = client->next(1, minOutputBatchBytes, &atEnd, &future);
+  ASSERT_TRUE(pages.empty());
+  ASSERT_FALSE(atEnd);
+  ASSERT_FALSE(future.isReady());
+
+  enqueue(*queue, nullptr);
+  ASSERT_TRUE(future.isReady());
+  pages = client->next(1, minOutputBatchBytes, &atEnd, &future);
+  ASSERT_EQ(1, pages.size());
+  ASSERT_TRUE(atEnd);
+
+  // There is no request latency yet, so the queue limit is not reduced.
+  auto stats = client->stats();
+  ASSERT_GT(stats.at("drainBytesPerSecond").sum, 0);
+  ASSERT_EQ(
+      ExchangeClient::kDefaultMaxQueuedBytes, stats.at("maxQueuedBytes").sum);
+
+  // The consumer drains a few hundred KB per second, so 1ms requests do not
+  // need more than the minimum limit.
+  {
+    std::lock_guard<std::mutex> l(queue->mutex());
+    queue->recordResponseLocked(1'000, 1'000);
+  }
+  ASSERT_EQ(1'000, queue->averageResponseLatencyUs());
+  stats = client->stats();
+  ASSERT_EQ(
+      ExchangeClient::kDefaultMaxQueuedBytes / 8,
+      stats.at("maxQueuedBytes").sum);
+
+  client->close();
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     ExchangeClientTest,
     ExchangeClientTest,
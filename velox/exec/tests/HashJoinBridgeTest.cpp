@@ -566,6 +566,45 @@ TEST_P(HashJoinBridgeTest, multiThreading) {
   }
 }
 
+TEST_P(HashJoinBridgeTest, bloomFilters) {
+  auto futures = createEmptyFutures(numProbers_);
+  auto joinBridge = createJoinBridge();
+  for (int32_t i = 0; i < numBuilders_; ++i) {
+    joinBridge->addBuilder();
+  }
+  joinBridge->start();
+  // Can't get the bloom filters before the table is built.
+  VELOX_ASSERT_THROW(joinBridge->bloomFiltersOrFuture(&futures[0]), "");
+  joinBridge->setHashTable(createFakeHashTable(), {}, false, nullptr);
+
+  // The first prober builds the filters and the others wait for it.
+  ASSERT_FALSE(joinBridge->bloomFiltersOrFuture(&futures[0]).has_value());
+  ASSERT_FALSE(futures[0].valid());
+  for (int32_t i = 1; i < numProbers_; ++i) {
+    ASSERT_FALSE(joinBridge->bloomFiltersOrFuture(&futures[i]).has_value());
+    ASSERT_TRUE(futures[i].valid());
+  }
+
+  HashJoinBridge::BloomFilters filters;
+  filters.emplace_back(0, std::make_shared<common::IsNotNull>());
+  joinBridge->setBloomFilters(filters);
+  VELOX_ASSERT_THROW(joinBridge->setBloomFilters(filters), "");
+  for (int32_t i = 1; i < numProbers_; ++i) {
+    futures[i].wait();
+  }
+  futures = createEmptyFutures(numProbers_);
+  for (int32_t i = 0; i < numProbers_; ++i) {
+    const auto filtersOr = joinBridge->bloomFiltersOrFuture(&futures[i]);
+    ASSERT_TRUE(filtersOr.has_value());
+    ASSERT_FALSE(futures[i].valid());
+    ASSERT_EQ(filtersOr->size(), 1);
+    ASSERT_EQ(filtersOr->at(0).second.get(), filters[0].second.get());
+  }
+
+  joinBridge->probeFinished();
+  VELOX_ASSERT_THROW(joinBridge->bloomFiltersOrFuture(&futures[0]), "");
+}
+
 TEST_P(HashJoinBridgeTest, isHashJoinMemoryPools) {
   auto root = memory::memoryManager()->addRootPool("isHashBuildMemoryPool");
   struct {
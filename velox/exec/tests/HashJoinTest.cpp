@@ -24,6 +24,7 @@
 #include "velox/exec/Cursor.h"
 #include "velox/exec/HashBuild.h"
 #include "velox/exec/HashJoinBridge.h"
+#include "velox/exec/HashTableCache.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/ArbitratorTestUtil.h"
@@ -4153,6 +4154,176 @@ TEST_F(HashJoinTest, dynamicFilters) {
   }
 }
 
+TEST_F(HashJoinTest, bloomFilterDynamicFilters) {
+  const int32_t numSplits = 10;
+  const int32_t numRowsProbe = 333;
+  const int32_t numRowsBuild = 100;
+
+  // String keys have no exact dynamic filter, so they get a bloom filter.
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<std::shared_ptr<TempFilePath>> tempFiles;
+  for (int32_t i = 0; i < numSplits; ++i) {
+    auto rowVector = makeRowVector({
+        makeFlatVector<std::string>(
+            numRowsProbe,
+            [&](auto row) { return fmt::format("key{}", row - i * 10); }),
+        makeFlatVector<int64_t>(numRowsProbe, [](auto row) { return row; }),
+    });
+    probeVectors.push_back(rowVector);
+    tempFiles.push_back(TempFilePath::create());
+    writeToFile(tempFiles.back()->getPath(), rowVector);
+  }
+  auto makeInputSplits = [&](const core::PlanNodeId& nodeId) {
+    return [&] {
+      std::vector<exec::Split> probeSplits;
+      for (auto& file : tempFiles) {
+        probeSplits.push_back(
+            exec::Split(makeHiveConnectorSplit(file->getPath())));
+      }
+      SplitInput splits;
+      splits.emplace(nodeId, probeSplits);
+      return splits;
+    };
+  };
+
+  std::vector<RowVectorPtr> buildVectors = {makeRowVector({
+      makeFlatVector<std::string>(
+          numRowsBuild,
+          [](auto row) { return fmt::format("key{}", 35 + 2 * row); }),
+      makeFlatVector<int64_t>(numRowsBuild, [](auto row) { return row; }),
+  })};
+
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId probeScanId;
+  auto op = PlanBuilder(planNodeIdGenerator, pool_.get())
+                .tableScan(ROW({"c0", "c1"}, {VARCHAR(), BIGINT()}))
+                .capturePlanNodeId(probeScanId)
+                .hashJoin(
+                    {"c0"},
+                    {"u_c0"},
+                    PlanBuilder(planNodeIdGenerator, pool_.get())
+                        .values(buildVectors)
+                        .project({"c0 AS u_c0", "c1 AS u_c1"})
+                        .planNode(),
+                    "",
+                    {"c0", "c1", "u_c1"},
+                    core::JoinType::kInner)
+                .planNode();
+
+  for (const bool enabled : {false, true}) {
+    for (const int32_t numDrivers : {1, 4}) {
+      SCOPED_TRACE(
+          fmt::format("enabled: {}, numDrivers: {}", enabled, numDrivers));
+      HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+          .numDrivers(numDrivers)
+          .planNode(op)
+          .makeInputSplits(makeInputSplits(probeScanId))
+          .config(
+              core::QueryConfig::kHashProbeBloomFilterPushdownMaxSize,
+              enabled ? "1048576" : "0")
+          .referenceQuery(
+              "SELECT t.c0, t.c1, u.c1 FROM t, u WHERE t.c0 = u.c0")
+          .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+            if (!enabled || hasSpill) {
+              ASSERT_EQ(0, getFiltersProduced(task, 1).sum);
+              ASSERT_EQ(getInputPositions(task, 1), numRowsProbe * numSplits);
+              return;
+            }
+            const auto produced =
+                getOperatorRuntimeStats(task, 1, "bloomFiltersProduced");
+            ASSERT_GE(produced.sum, 1);
+            ASSERT_EQ(produced.sum, getFiltersProduced(task, 1).sum);
+            ASSERT_EQ(produced.sum, getFiltersAccepted(task, 0).sum);
+            // The filter is built by one HashProbe operator and shared with
+            // the others.
+            const auto built =
+                getOperatorRuntimeStats(task, 1, "bloomFiltersBuilt");
+            ASSERT_EQ(1, built.count);
+            ASSERT_EQ(1, built.sum);
+            // A bloom filter does not replace the join.
+            ASSERT_EQ(0, getReplacedWithFilterRows(task, 1).sum);
+            ASSERT_LT(getInputPositions(task, 1), numRowsProbe * numSplits);
+          })
+          .run();
+    }
+  }
+}
+
+TEST_F(HashJoinTest, adaptiveJoinSideSwap) {
+  // The probe side is much smaller than the build side. Both have duplicate
+  // and null keys.
+  std::vector<RowVectorPtr> probeVectors = {makeRowVector(
+      {"t0", "t1"},
+      {makeFlatVector<int64_t>(
+           50, [](auto row) { return row % 40; }, nullEvery(7)),
+       makeFlatVector<int64_t>(50, folly::identity)})};
+  std::vector<RowVectorPtr> buildVectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    buildVectors.push_back(makeRowVector(
+        {"u0", "u1"},
+        {makeFlatVector<int64_t>(
+             100, [i](auto row) { return (row + i) % 60; }, nullEvery(11)),
+         makeFlatVector<int64_t>(
+             100, [i](auto row) { return i * 100 + row; })}));
+  }
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId joinNodeId;
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(probeVectors)
+                  .hashJoin(
+                      {"t0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values(buildVectors)
+                          .planNode(),
+                      "",
+                      {"t1", "u0", "u1"},
+                      core::JoinType::kInner)
+                  .capturePlanNodeId(joinNodeId)
+                  .planNode();
+
+  struct {
+    std::string swapRows;
+    bool swapped;
+
+    std::string debugString() const {
+      return fmt::format("swapRows: {}, swapped: {}", swapRows, swapped);
+    }
+  } testSettings[] = {
+      // Disabled.
+      {"0", false},
+      // The probe side exceeds the bound.
+      {"10", false},
+      // The probe side ends within the bound, the build side exceeds it.
+      {"500", true},
+      // Both sides end within the bound.
+      {"10000", true}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(
+                core::QueryConfig::kHashJoinAdaptiveSwapRows,
+                testData.swapRows)
+            .assertResults("SELECT t1, u0, u1 FROM t, u WHERE t0 = u0");
+    const auto stats =
+        toPlanStats(task->taskStats()).at(joinNodeId).customStats;
+    ASSERT_EQ(
+        stats.count(HashJoinBridge::kJoinSidesSwapped),
+        testData.swapped ? 1 : 0);
+    ASSERT_EQ(
+        stats.count(HashJoinBridge::kSwapProbeRows),
+        testData.swapRows == "0" ? 0 : 1);
+  }
+}
+
 TEST_F(HashJoinTest, dynamicFiltersStatsWithChainedJoins) {
   const int32_t numSplits = 10;
   const int32_t numProbeRows = 333;
@@ -8139,4 +8310,190 @@ DEBUG_ONLY_TEST_F(HashJoinTest, hashTableCleanupAfterProbeFinish) {
       .run();
   ASSERT_TRUE(tableEmpty);
 }
+
+DEBUG_ONLY_TEST_F(HashJoinTest, hashTableCache) {
+  std::vector<RowVectorPtr> probeVectors;
+  for (int32_t i = 0; i < 3; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"t0", "t1"},
+        {makeFlatVector<int32_t>(1'000, [](auto row) { return row % 300; }),
+         makeFlatVector<int64_t>(1'000, [&](auto row) { return row + i; })}));
+  }
+  const std::vector<RowVectorPtr> buildVectors = {makeRowVector(
+      {"u0", "u1"},
+      {makeFlatVector<int32_t>(200, [](auto row) { return row * 2; }),
+       makeFlatVector<int64_t>(200, [](auto row) { return row; })})};
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  const auto plan = PlanBuilder(planNodeIdGenerator)
+                        .values(probeVectors)
+                        .hashJoin(
+                            {"t0"},
+                            {"u0"},
+                            PlanBuilder(planNodeIdGenerator)
+                                .values(buildVectors)
+                                .planNode(),
+                            "",
+                            {"t0", "t1", "u1"})
+                        .planNode();
+  const auto expected = AssertQueryBuilder(plan).copyResults(pool());
+
+  const auto joinNode =
+      std::dynamic_pointer_cast<const core::HashJoinNode>(plan);
+  const auto cachedPlan =
+      core::HashJoinNode::Builder(*joinNode).useHashTableCache(true).build();
+  ASSERT_TRUE(
+      std::dynamic_pointer_cast<const core::HashJoinNode>(cachedPlan)
+          ->useHashTableCache());
+
+  // Holds the building task until the other task waits for the cached table.
+  folly::EventCount buildWait;
+  std::atomic_bool buildWaitFlag{true};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::HashBuild::finishHashBuild",
+      std::function<void(Operator*)>([&](Operator* /*unused*/) {
+        buildWait.await([&]() { return !buildWaitFlag.load(); });
+      }));
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::HashBuild::finishCachedHashBuild",
+      std::function<void(Operator*)>([&](Operator* /*unused*/) {
+        buildWaitFlag = false;
+        buildWait.notifyAll();
+      }));
+
+  const auto queryCtx = core::QueryCtx::create(driverExecutor_.get());
+  std::vector<std::shared_ptr<Task>> tasks(2);
+  std::vector<RowVectorPtr> results(2);
+  std::vector<std::thread> threads;
+  for (int32_t i = 0; i < 2; ++i) {
+    threads.emplace_back([&, i]() {
+      results[i] = AssertQueryBuilder(cachedPlan)
+                       .queryCtx(queryCtx)
+                       .copyResults(pool(), tasks[i]);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  int32_t numCachedTableUsers{0};
+  for (int32_t i = 0; i < 2; ++i) {
+    assertEqualResults({expected}, {results[i]});
+    const auto& customStats =
+        toPlanStats(tasks[i]->taskStats()).at(joinNode->id()).customStats;
+    if (customStats.count(HashBuild::kUsedCachedHashTable) != 0) {
+      ++numCachedTableUsers;
+    }
+  }
+  ASSERT_EQ(numCachedTableUsers, 1);
+
+  tasks.clear();
+  ASSERT_EQ(HashTableCache::instance()->numEntries(), 0);
+
+  VELOX_ASSERT_THROW(
+      core::HashJoinNode::Builder(*joinNode)
+          .joinType(core::JoinType::kRight)
+          .useHashTableCache(true)
+          .build(),
+      "Hash table cache is not supported for joins that track probed build "
+      "side rows");
+}
+
+DEBUG_ONLY_TEST_F(HashJoinTest, hashTableCacheBuilderFailure) {
+  std::vector<RowVectorPtr> probeVectors;
+  for (int32_t i = 0; i < 3; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"t0", "t1"},
+        {makeFlatVector<int32_t>(1'000, [](auto row) { return row % 300; }),
+         makeFlatVector<int64_t>(1'000, [&](auto row) { return row + i; })}));
+  }
+  const std::vector<RowVectorPtr> buildVectors = {makeRowVector(
+      {"u0", "u1"},
+      {makeFlatVector<int32_t>(200, [](auto row) { return row * 2; }),
+       makeFlatVector<int64_t>(200, [](auto row) { return row; })})};
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  const auto plan = PlanBuilder(planNodeIdGenerator)
+                        .values(probeVectors)
+                        .hashJoin(
+                            {"t0"},
+                            {"u0"},
+                            PlanBuilder(planNodeIdGenerator)
+                                .values(buildVectors)
+                                .planNode(),
+                            "",
+                            {"t0", "t1", "u1"})
+                        .planNode();
+  const auto expected = AssertQueryBuilder(plan).copyResults(pool());
+  const auto joinNode =
+      std::dynamic_pointer_cast<const core::HashJoinNode>(plan);
+  const auto cachedPlan =
+      core::HashJoinNode::Builder(*joinNode).useHashTableCache(true).build();
+
+  // Fails the building task once the other task waits for the cached table.
+  // Only the building task builds a table until then.
+  folly::EventCount buildWait;
+  std::atomic_bool buildWaitFlag{true};
+  std::atomic_int32_t numBuilds{0};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::HashBuild::finishHashBuild",
+      std::function<void(Operator*)>([&](Operator* /*unused*/) {
+        if (numBuilds++ > 0) {
+          return;
+        }
+        buildWait.await([&]() { return !buildWaitFlag.load(); });
+        VELOX_FAIL("Injected hash build failure");
+      }));
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::HashBuild::finishCachedHashBuild",
+      std::function<void(Operator*)>([&](Operator* /*unused*/) {
+        buildWaitFlag = false;
+        buildWait.notifyAll();
+      }));
+
+  const auto queryCtx = core::QueryCtx::create(driverExecutor_.get());
+  std::vector<std::shared_ptr<Task>> tasks(2);
+  std::vector<RowVectorPtr> results(2);
+  std::vector<std::string> errors(2);
+  std::vector<std::thread> threads;
+  for (int32_t i = 0; i < 2; ++i) {
+    threads.emplace_back([&, i]() {
+      try {
+        results[i] = AssertQueryBuilder(cachedPlan)
+                         .queryCtx(queryCtx)
+                         .copyResults(pool(), tasks[i]);
+      } catch (const VeloxException& e) {
+        errors[i] = e.message();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // The building task fails and the other task builds its own table.
+  ASSERT_EQ(numBuilds, 2);
+  const int32_t failedTask = errors[0].empty() ? 1 : 0;
+  const int32_t otherTask = 1 - failedTask;
+  ASSERT_NE(
+      errors[failedTask].find("Injected hash build failure"), std::string::npos);
+  ASSERT_TRUE(errors[otherTask].empty()) << errors[otherTask];
+  assertEqualResults({expected}, {results[otherTask]});
+  const auto& customStats =
+      toPlanStats(tasks[otherTask]->taskStats()).at(joinNode->id()).customStats;
+  ASSERT_EQ(customStats.count(HashBuild::kUsedCachedHashTable), 0);
+  ASSERT_EQ(customStats.at(HashBuild::kHashTableCacheFallback).sum, 1);
+
+  // An abandoned entry is replaced by a new one with a new building task.
+  auto* cache = HashTableCache::instance();
+  const auto entry = cache->get(tasks[otherTask], 0, "abandoned");
+  ASSERT_TRUE(entry->isBuilder(tasks[otherTask]->taskId()));
+  ASSERT_EQ(cache->get(tasks[otherTask], 0, "abandoned"), entry);
+  entry->abandon();
+  ASSERT_TRUE(entry->abandoned());
+  const auto newEntry = cache->get(tasks[otherTask], 0, "abandoned");
+  ASSERT_NE(newEntry, entry);
+  ASSERT_FALSE(newEntry->abandoned());
+  ASSERT_TRUE(newEntry->isBuilder(tasks[otherTask]->taskId()));
+}
 } // namespace
@@ -377,6 +377,68 @@ TEST_F(LocalPartitionTest, partitionBufferingPreserveEncoding) {
   ASSERT_EQ(numVectors, 2);
 }
 
+TEST_F(LocalPartitionTest, unbufferedPartitionsShareInput) {
+  std::vector<RowVectorPtr> vectors = {
+      makeRowVector(
+          {"c0", "c1"},
+          {makeFlatSequence<int32_t>(0, 100), makeConstant<int64_t>(7, 100)}),
+      makeRowVector(
+          {"c0", "c1"},
+          {makeFlatSequence<int32_t>(53, 100), makeConstant<int64_t>(7, 100)}),
+      makeRowVector(
+          {"c0", "c1"},
+          {makeFlatSequence<int32_t>(-71, 1000),
+           makeConstant<int64_t>(7, 1000)}),
+  };
+  createDuckDbTable(vectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan =
+      PlanBuilder(planNodeIdGenerator)
+          .localPartition(
+              {"c0"},
+              {PlanBuilder(planNodeIdGenerator).values(vectors).planNode()})
+          .planNode();
+
+  // Partition buffering is used only for more than 4 partitions.
+  std::unordered_map<std::string, std::string> configs;
+  configs
+      [core::QueryConfig::kMinLocalExchangePartitionCountToUsePartitionBuffer] =
+          std::to_string(5);
+
+  CursorParameters params;
+  params.planNode = plan;
+  params.copyResult = false;
+  params.maxDrivers = 4;
+  params.queryConfigs = configs;
+  auto cursor = TaskCursor::create(params);
+  int numRows = 0;
+  int numVectors = 0;
+  while (cursor->moveNext()) {
+    auto* batch = cursor->current()->as<RowVector>();
+    ASSERT_EQ(batch->childrenSize(), 2);
+    ASSERT_EQ(
+        batch->childAt(0)->encoding(), VectorEncoding::Simple::DICTIONARY);
+    // The dictionary slices share the input vector.
+    auto* base = batch->childAt(0)->valueVector().get();
+    ASSERT_TRUE(
+        base == vectors[0]->childAt(0).get() ||
+        base == vectors[1]->childAt(0).get() ||
+        base == vectors[2]->childAt(0).get());
+    ASSERT_EQ(batch->childAt(1)->encoding(), VectorEncoding::Simple::CONSTANT);
+    numRows += batch->size();
+    numVectors++;
+  }
+  ASSERT_EQ(numRows, 1200);
+  // One vector per partition and input.
+  ASSERT_EQ(numVectors, 12);
+
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .maxDrivers(4)
+      .configs(configs)
+      .assertResults("SELECT * FROM tmp");
+}
+
 TEST_F(LocalPartitionTest, maxBufferSizeGather) {
   std::vector<RowVectorPtr> vectors;
   for (auto i = 0; i < 21; i++) {
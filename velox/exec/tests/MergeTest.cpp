@@ -16,8 +16,12 @@
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/Spill.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
@@ -238,3 +242,100 @@ TEST_F(MergeTest, offByOne) {
       {{core::QueryConfig::kPreferredOutputBatchRows, "6"}});
   assertQueryOrdered(params, "VALUES (0), (1), (2), (3), (4), (5), (10)", {0});
 }
+
+TEST_F(MergeTest, parallelOrderBy) {
+  vector_size_t batchSize = 1000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    auto c0 = makeFlatVector<int64_t>(
+        batchSize,
+        [&](auto row) { return (row * 7919 + i * 104729) % 5000; },
+        nullEvery(13));
+    // Few distinct values to have ties across the key ranges.
+    auto c1 = makeFlatVector<int32_t>(
+        batchSize, [&](auto row) { return (row + i) % 3; });
+    auto c2 = makeFlatVector<StringView>(batchSize, [&](auto row) {
+      return StringView::makeInline(std::to_string(row * i));
+    });
+    vectors.push_back(makeRowVector({c0, c1, c2}));
+  }
+  createDuckDbTable(vectors);
+
+  const std::vector<std::vector<std::string>> orderByClausesList = {
+      {"c0 NULLS LAST"},
+      {"c0 DESC NULLS FIRST"},
+      {"c1", "c0 DESC NULLS LAST"},
+      {"c2", "c1"},
+  };
+  for (const auto& orderByClauses : orderByClausesList) {
+    SCOPED_TRACE(folly::join(", ", orderByClauses));
+    for (const auto numDrivers : {1, 2, 5}) {
+      SCOPED_TRACE(fmt::format("numDrivers {}", numDrivers));
+      auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+      const auto plan = PlanBuilder(planNodeIdGenerator)
+                            .localMerge(
+                                orderByClauses,
+                                {PlanBuilder(planNodeIdGenerator)
+                                     .values(vectors)
+                                     .localPartitionRoundRobin()
+                                     .orderBy(orderByClauses, true)
+                                     .planNode()})
+                            .planNode();
+      const auto& rowType = vectors[0]->type()->asRow();
+      std::vector<uint32_t> sortingKeys;
+      for (const auto& clause : orderByClauses) {
+        sortingKeys.push_back(rowType.getChildIdx(clause.substr(0, 2)));
+      }
+      const auto sql =
+          "SELECT * FROM tmp ORDER BY " + folly::join(", ", orderByClauses);
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .maxDrivers(numDrivers)
+          .config(core::QueryConfig::kOrderByParallelMergeEnabled, "true")
+          .assertResults(sql, sortingKeys);
+    }
+  }
+
+  // Empty input.
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  const auto plan = PlanBuilder(planNodeIdGenerator)
+                        .localMerge(
+                            {"c0"},
+                            {PlanBuilder(planNodeIdGenerator)
+                                 .values(vectors)
+                                 .filter("c1 > 10")
+                                 .localPartitionRoundRobin()
+                                 .orderBy({"c0"}, true)
+                                 .planNode()})
+                        .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .maxDrivers(4)
+      .config(core::QueryConfig::kOrderByParallelMergeEnabled, "true")
+      .assertEmptyResults();
+
+  // The mode is not used if OrderBy may spill. The sorted runs of the drivers
+  // are spilled and merged by LocalMerge.
+  core::PlanNodeId orderById;
+  const auto spillPlan = PlanBuilder(planNodeIdGenerator)
+                             .localMerge(
+                                 {"c0 NULLS LAST"},
+                                 {PlanBuilder(planNodeIdGenerator)
+                                      .values(vectors)
+                                      .localPartitionRoundRobin()
+                                      .orderBy({"c0 NULLS LAST"}, true)
+                                      .capturePlanNodeId(orderById)
+                                      .planNode()})
+                             .planNode();
+  auto spillDirectory = TempDirectoryPath::create();
+  TestScopedSpillInjection scopedSpillInjection(100);
+  auto task = AssertQueryBuilder(spillPlan, duckDbQueryRunner_)
+                  .maxDrivers(4)
+                  .spillDirectory(spillDirectory->getPath())
+                  .config(core::QueryConfig::kSpillEnabled, "true")
+                  .config(core::QueryConfig::kOrderBySpillEnabled, "true")
+                  .config(
+                      core::QueryConfig::kOrderByParallelMergeEnabled, "true")
+                  .assertResults(
+                      "SELECT * FROM tmp ORDER BY c0 NULLS LAST",
+                      std::vector<uint32_t>{0});
+  ASSERT_GT(toPlanStats(task->taskStats()).at(orderById).spilledBytes, 0);
+}
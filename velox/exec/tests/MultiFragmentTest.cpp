@@ -2481,7 +2481,7 @@ DEBUG_ONLY_TEST_P(MultiFragmentTest, exchangeStatsOnFailure) {
   // Triggers a failure after fetching first 10 pages.
   std::atomic_uint64_t expectedReceivedPages{0};
   SCOPED_TESTVALUE_SET(
-      "facebook::velox::exec::test::LocalExchangeSource",
+      "facebook::velox::exec::InProcessExchangeSource::processData",
       std::function<void(exec::ExchangeSource * data)>(
           [&](exec::ExchangeSource* source) {
             auto* queue = source->testingQueue();
@@ -527,6 +527,68 @@ TEST_F(OrderByTest, spill) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(OrderByTest, rowFormatSpill) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(
+            1'000, [&](auto row) { return (row + i) % 97; }, nullEvery(11)),
+        makeFlatVector<double>(
+            1'000, [](auto row) { return (row % 13) * 0.5; }, nullEvery(7)),
+        makeFlatVector<std::string>(
+            1'000, [](auto row) { return fmt::format("s{}", row % 31); }),
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (row * 7'919 + i) % 1'000; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  // The last order by has a string sorting key and spills in columnar format.
+  struct {
+    std::vector<std::string> keys;
+    std::vector<uint32_t> keyIndices;
+    bool rowFormat;
+  } testSettings[] = {
+      {{"c0 ASC NULLS LAST", "c1 DESC NULLS FIRST"}, {0, 1}, true},
+      {{"c3 DESC NULLS LAST"}, {3}, true},
+      {{"c2 ASC NULLS LAST", "c0 ASC NULLS LAST"}, {2, 0}, false},
+  };
+  for (const auto& [keys, keyIndices, rowFormat] : testSettings) {
+    SCOPED_TRACE(folly::join(", ", keys));
+    core::PlanNodeId orderNodeId;
+    const auto plan = PlanBuilder()
+                          .values(vectors)
+                          .orderBy(keys, false)
+                          .capturePlanNodeId(orderNodeId)
+                          .planNode();
+
+    auto spillDirectory = exec::test::TempDirectoryPath::create();
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .spillDirectory(spillDirectory->getPath())
+            .config(core::QueryConfig::kSpillEnabled, true)
+            .config(core::QueryConfig::kOrderBySpillEnabled, true)
+            .config(core::QueryConfig::kSpillRowFormatEnabled, true)
+            .assertResults(
+                fmt::format(
+                    "SELECT * FROM tmp ORDER BY {}", folly::join(", ", keys)),
+                keyIndices);
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    auto& planStats = taskStats.at(orderNodeId);
+    ASSERT_GT(planStats.spilledRows, 0);
+    if (rowFormat) {
+      ASSERT_EQ(
+          planStats.customStats.at(Operator::kSpilledRowFormatRows).sum,
+          planStats.spilledRows);
+    } else {
+      ASSERT_EQ(
+          planStats.customStats.count(Operator::kSpilledRowFormatRows), 0);
+    }
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  }
+}
+
 DEBUG_ONLY_TEST_F(OrderByTest, reclaimDuringInputProcessing) {
   constexpr int64_t kMaxBytes = 1LL << 30; // 1GB
   auto rowType = ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), INTEGER()});
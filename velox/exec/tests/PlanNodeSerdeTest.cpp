@@ -273,6 +273,17 @@ TEST_F(PlanNodeSerdeTest, limit) {
   testSerde(plan);
 }
 
+TEST_F(PlanNodeSerdeTest, sample) {
+  auto plan = PlanBuilder().values({data_}).sample(0.25).planNode();
+  testSerde(plan);
+
+  plan = PlanBuilder()
+             .values({data_})
+             .sample(0.5, core::SampleNode::Method::kSystem)
+             .planNode();
+  testSerde(plan);
+}
+
 TEST_F(PlanNodeSerdeTest, mergeExchange) {
   for (auto serdeKind : std::vector<VectorSerde::Kind>{
            VectorSerde::Kind::kPresto,
@@ -509,6 +509,23 @@ TEST_F(PlanNodeToStringTest, limit) {
       plan->toString(true, false));
 }
 
+TEST_F(PlanNodeToStringTest, sample) {
+  auto plan = PlanBuilder().values({data_}).sample(0.25).planNode();
+
+  ASSERT_EQ("-- Sample[1]\n", plan->toString());
+  ASSERT_EQ(
+      "-- Sample[1][BERNOULLI 0.25] -> c0:SMALLINT, c1:INTEGER, c2:BIGINT\n",
+      plan->toString(true, false));
+
+  plan = PlanBuilder()
+             .values({data_})
+             .sample(0.5, core::SampleNode::Method::kSystem)
+             .planNode();
+  ASSERT_EQ(
+      "-- Sample[1][SYSTEM 0.5] -> c0:SMALLINT, c1:INTEGER, c2:BIGINT\n",
+      plan->toString(true, false));
+}
+
 TEST_F(PlanNodeToStringTest, topN) {
   auto plan = PlanBuilder()
                   .values({data_})
@@ -41,7 +41,12 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
 
   void testPrefixSort(
       const std::vector<CompareFlags>& compareFlags,
-      const RowVectorPtr& data) {
+      const RowVectorPtr& data,
+      const common::PrefixSortConfig& config = common::PrefixSortConfig{
+          1024,
+          // Set threshold to 0 to enable prefix-sort in small dataset.
+          0,
+          12}) {
     const auto numRows = data->size();
     const auto expectedResult =
         generateExpectedResult(compareFlags, numRows, data);
@@ -63,11 +68,7 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
     const auto maxBytes = PrefixSort::maxRequiredBytes(
         &rowContainer,
         compareFlags,
-        common::PrefixSortConfig{
-            1024,
-            // Set threshold to 0 to enable prefix-sort in small dataset.
-            0,
-            12},
+        config,
         sortPool.get());
     const auto beforeBytes = sortPool->peakBytes();
     ASSERT_EQ(sortPool->peakBytes(), 0);
@@ -75,11 +76,7 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
     PrefixSort::sort(
         &rowContainer,
         compareFlags,
-        common::PrefixSortConfig{
-            1024,
-            // Set threshold to 0 to enable prefix-sort in small dataset.
-            0,
-            12},
+        config,
         sortPool.get(),
         rows);
     ASSERT_GE(maxBytes, sortPool->peakBytes() - beforeBytes);
@@ -297,6 +294,54 @@ TEST_F(PrefixSortTest, fuzz) {
   runFuzzTest(0.0);
 }
 
+TEST_F(PrefixSortTest, radixSort) {
+  const common::PrefixSortConfig config{
+      1024, 0, 12, /*radixSortEnabled=*/true};
+  std::vector<TypePtr> keyTypes = {
+      INTEGER(),
+      BOOLEAN(),
+      BIGINT(),
+      DECIMAL(25, 6),
+      DOUBLE(),
+      TIMESTAMP(),
+      VARCHAR()};
+  for (const auto& type : keyTypes) {
+    SCOPED_TRACE(fmt::format("{}", type->toString()));
+    VectorFuzzer fuzzer({.vectorSize = 10'240, .nullRatio = 0.1}, pool());
+    RowVectorPtr data = fuzzer.fuzzRow(ROW({type, BIGINT()}));
+    testPrefixSort({kAsc}, data, config);
+    testPrefixSort({kDesc}, data, config);
+    testPrefixSort({kAsc, kDesc}, data, config);
+  }
+}
+
+TEST_F(PrefixSortTest, mergeSortedRuns) {
+  const common::PrefixSortConfig config{
+      1024, 0, 12, /*radixSortEnabled=*/false, /*maxMergeRuns=*/8};
+  const vector_size_t numRows = 10'000;
+  // Sorted runs of 'runSize' rows with ties and nulls.
+  auto makeRuns = [&](vector_size_t runSize) {
+    return makeRowVector({
+        makeFlatVector<int64_t>(
+            numRows,
+            [&](auto row) { return row % runSize / 3; },
+            [](auto row) { return row % 1'000 == 0; }),
+        makeFlatVector<StringView>(
+            numRows,
+            [](auto row) {
+              return StringView::makeInline(std::to_string(row % 97));
+            }),
+    });
+  };
+  for (const auto runSize : {numRows, numRows / 4, numRows / 8, 100}) {
+    SCOPED_TRACE(fmt::format("runSize {}", runSize));
+    const auto data = makeRuns(runSize);
+    testPrefixSort({kAsc}, data, config);
+    testPrefixSort({kDesc}, data, config);
+    testPrefixSort({kAsc, kAsc}, data, config);
+  }
+}
+
 TEST_F(PrefixSortTest, fuzzMulti) {
   std::vector<TypePtr> keyTypes = {
       INTEGER(),
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/dwio/dwrf/writer/FlushPolicy.h"
+#include "velox/exec/TableScan.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempFilePath.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+class SampleTest : public HiveConnectorTestBase {
+ protected:
+  static constexpr vector_size_t kBatchSize = 1'000;
+  static constexpr int32_t kNumBatches = 10;
+
+  void SetUp() override {
+    HiveConnectorTestBase::SetUp();
+    for (int32_t i = 0; i < kNumBatches; ++i) {
+      vectors_.push_back(makeRowVector({
+          makeFlatVector<int64_t>(
+              kBatchSize, [&](auto row) { return kBatchSize * i + row; }),
+          makeFlatVector<int32_t>(kBatchSize, [](auto row) { return row; }),
+      }));
+    }
+  }
+
+  // Returns the number of rows in 'result' and checks that they are distinct
+  // input rows.
+  static vector_size_t checkSampledRows(const RowVectorPtr& result) {
+    auto* c0 = result->childAt(0)->as<SimpleVector<int64_t>>();
+    std::unordered_set<int64_t> values;
+    for (auto i = 0; i < result->size(); ++i) {
+      const auto value = c0->valueAt(i);
+      EXPECT_GE(value, 0);
+      EXPECT_LT(value, kBatchSize * kNumBatches);
+      EXPECT_TRUE(values.insert(value).second);
+    }
+    return result->size();
+  }
+
+  std::vector<RowVectorPtr> vectors_;
+};
+
+TEST_F(SampleTest, bernoulli) {
+  createDuckDbTable(vectors_);
+
+  auto plan = PlanBuilder().values(vectors_).sample(1.0).planNode();
+  assertQuery(plan, "SELECT * FROM tmp");
+
+  plan = PlanBuilder().values(vectors_).sample(0.0).planNode();
+  assertQueryReturnsEmptyResult(plan);
+
+  plan = PlanBuilder().values(vectors_).sample(0.1).planNode();
+  const auto numRows =
+      checkSampledRows(AssertQueryBuilder(plan).copyResults(pool()));
+  // 10% of 10'000 rows with a generous margin.
+  ASSERT_GT(numRows, 700);
+  ASSERT_LT(numRows, 1'300);
+}
+
+TEST_F(SampleTest, systemOverValues) {
+  // Without a table scan below, each input batch is sampled as a whole.
+  auto plan = PlanBuilder()
+                  .values(vectors_)
+                  .sample(0.7, core::SampleNode::Method::kSystem)
+                  .planNode();
+  const auto numRows =
+      checkSampledRows(AssertQueryBuilder(plan).copyResults(pool()));
+  ASSERT_EQ(numRows % kBatchSize, 0);
+}
+
+TEST_F(SampleTest, systemPushedIntoTableScan) {
+  // Write one stripe per batch.
+  auto filePath = TempFilePath::create();
+  writeToFile(
+      filePath->getPath(),
+      vectors_,
+      std::make_shared<dwrf::Config>(),
+      []() {
+        return std::make_unique<dwrf::LambdaFlushPolicy>([]() { return true; });
+      });
+  auto rowType = asRowType(vectors_[0]->type());
+
+  const auto makeSplit = [&]() {
+    return makeHiveConnectorSplit(filePath->getPath());
+  };
+  const auto makePlan = [&](double sampleRate) {
+    return PlanBuilder()
+        .tableScan(rowType)
+        .sample(sampleRate, core::SampleNode::Method::kSystem)
+        .planNode();
+  };
+
+  std::shared_ptr<Task> task;
+  const auto numRows = checkSampledRows(
+      AssertQueryBuilder(makePlan(0.7))
+          .split(makeSplit())
+          .copyResults(pool(), task));
+  ASSERT_EQ(numRows % kBatchSize, 0);
+  // The sample is fused into the scan and the dropped stripes are not read.
+  auto stats = task->taskStats().pipelineStats[0].operatorStats;
+  ASSERT_EQ(stats[0].operatorType, "TableScan");
+  ASSERT_EQ(stats[0].outputPositions, static_cast<uint64_t>(numRows));
+  const auto& runtimeStats = stats[0].runtimeStats;
+  ASSERT_EQ(
+      runtimeStats.count("skippedStrides")
+          ? runtimeStats.at("skippedStrides").sum
+          : 0,
+      kNumBatches - numRows / kBatchSize);
+  ASSERT_EQ(runtimeStats.count(TableScan::kNumSampledOutSplits), 0);
+  for (const auto& operatorStats : stats) {
+    ASSERT_NE(operatorStats.operatorType, "Sample");
+  }
+
+  task = AssertQueryBuilder(makePlan(0.0))
+             .split(makeSplit())
+             .assertEmptyResults();
+  stats = task->taskStats().pipelineStats[0].operatorStats;
+  ASSERT_EQ(stats[0].runtimeStats.at("skippedStrides").sum, kNumBatches);
+
+  ASSERT_EQ(
+      checkSampledRows(AssertQueryBuilder(makePlan(1.0))
+                           .split(makeSplit())
+                           .copyResults(pool())),
+      kBatchSize * kNumBatches);
+}
+
+TEST_F(SampleTest, bernoulliOverTableScan) {
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors_);
+  auto plan = PlanBuilder()
+                  .tableScan(asRowType(vectors_[0]->type()))
+                  .sample(0.2)
+                  .planNode();
+  std::shared_ptr<Task> task;
+  const auto numRows = checkSampledRows(
+      AssertQueryBuilder(plan)
+          .split(makeHiveConnectorSplit(filePath->getPath()))
+          .copyResults(pool(), task));
+  ASSERT_GT(numRows, 1'500);
+  ASSERT_LT(numRows, 2'500);
+  // Bernoulli sampling is not pushed into the scan.
+  const auto stats = task->taskStats().pipelineStats[0].operatorStats;
+  ASSERT_EQ(stats[0].outputPositions, kBatchSize * kNumBatches);
+  ASSERT_EQ(stats[1].operatorType, "Sample");
+  ASSERT_EQ(stats[1].outputPositions, static_cast<uint64_t>(numRows));
+}
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/ScopeGuard.h>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <memory>
@@ -21,6 +22,7 @@
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/testutil/TestValue.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Spill.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
@@ -124,6 +126,7 @@ class SpillTest : public ::testing::TestWithParam<uint32_t>,
  protected:
   static void SetUpTestCase() {
     memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+    common::testutil::TestValue::enable();
     if (!isRegisteredVectorSerde()) {
       facebook::velox::serializer::presto::PrestoVectorSerde::
           registerVectorSerde();
@@ -544,7 +547,9 @@ class SpillTest : public ::testing::TestWithParam<uint32_t>,
             "spillSortTimeNanos[{}] spillExtractVectorTime[{}] spillSerializationTimeNanos[{}] spillWrites[{}] "
             "spillFlushTimeNanos[{}] spillWriteTimeNanos[{}] maxSpillExceededLimitCount[0] "
             "spillReadBytes[{}] spillReads[{}] spillReadTimeNanos[{}] "
-            "spillReadDeserializationTimeNanos[{}]",
+            "spillReadDeserializationTimeNanos[{}] spillReadAheadHits[{}] "
+            "spillReadAheadMisses[{}] spillReadAheadWaitTimeNanos[{}] "
+            "spilledRowFormatRows[0]",
             finalStats.spillRuns,
             succinctBytes(finalStats.spilledInputBytes),
             succinctBytes(finalStats.spilledBytes),
@@ -561,7 +566,10 @@ class SpillTest : public ::testing::TestWithParam<uint32_t>,
             succinctBytes(finalStats.spillReadBytes),
             finalStats.spillReads,
             succinctNanos(finalStats.spillReadTimeNanos),
-            succinctNanos(finalStats.spillDeserializationTimeNanos)));
+            succinctNanos(finalStats.spillDeserializationTimeNanos),
+            finalStats.spillReadAheadHits,
+            finalStats.spillReadAheadMisses,
+            succinctNanos(finalStats.spillReadAheadWaitTimeNanos)));
     // Verify the spilled files are still there after spill state destruction.
     for (const auto& spilledFile : spilledFileSet) {
       ASSERT_TRUE(fs->exists(spilledFile));
@@ -663,6 +671,133 @@ TEST_P(SpillTest, spillTimestamp) {
   ASSERT_EQ(nullptr, merge->next());
 }
 
+TEST_P(SpillTest, spillMemoryTier) {
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  auto fs = filesystems::getFileSystem(tempDirectory->getPath(), nullptr);
+  const auto batch =
+      makeRowVector({makeFlatVector<int64_t>(1'000, folly::identity)});
+  // Spills 'numFiles' files of 'batch' each with 'memoryTier' set.
+  const auto spill = [&](SpillMemoryTier& memoryTier, int numFiles) {
+    SpillState state(
+        [&]() -> const std::string& { return tempDirectory->getPath(); },
+        updateSpilledBytesCb_,
+        "test",
+        SpillState::makeSortingKeys(std::vector<CompareFlags>(1)),
+        kGB,
+        0,
+        compressionKind_,
+        std::nullopt,
+        pool(),
+        &spillStats_,
+        {},
+        &memoryTier);
+    SpillPartitionId partitionId{0};
+    state.setPartitionSpilled(partitionId);
+    for (auto i = 0; i < numFiles; ++i) {
+      state.appendToPartition(partitionId, batch);
+      state.finishFile(partitionId);
+    }
+    return state.finish(partitionId);
+  };
+  const auto verifyRead = [&](const SpillFiles& files) {
+    for (const auto& file : files) {
+      auto readFile =
+          SpillReadFile::create(file, 1 << 20, pool(), &spillStats_);
+      RowVectorPtr result;
+      ASSERT_TRUE(readFile->nextBatch(result));
+      facebook::velox::test::assertEqualVectors(batch, result);
+      ASSERT_FALSE(readFile->nextBatch(result));
+    }
+  };
+
+  uint64_t fileSize;
+  // Bytes reserved for a file. The serialized data is backed by a whole
+  // StreamArena allocation, so this is more than 'fileSize'.
+  uint64_t fileReservedBytes;
+  {
+    SpillMemoryTier memoryTier(kGB);
+    SpillMemoryTier::setInstance(&memoryTier);
+    SCOPE_EXIT {
+      SpillMemoryTier::setInstance(nullptr);
+    };
+    const auto files = spill(memoryTier, 2);
+    ASSERT_EQ(files.size(), 2);
+    ASSERT_EQ(files[0].size, files[1].size);
+    fileSize = files[0].size;
+    for (const auto& file : files) {
+      ASSERT_FALSE(fs->exists(file.path));
+    }
+    fileReservedBytes = memoryTier.usedBytes() / 2;
+    ASSERT_GE(fileReservedBytes, fileSize);
+    ASSERT_EQ(memoryTier.testingPaths().size(), 2);
+    verifyRead(files);
+    ASSERT_EQ(memoryTier.usedBytes(), 0);
+    const auto stats = memoryTier.stats();
+    ASSERT_EQ(stats.numFiles, 2);
+    ASSERT_EQ(stats.numReads, 2);
+    ASSERT_EQ(stats.numEvictions, 0);
+  }
+
+  // Only one file fits so the first one is evicted to disk by the second.
+  {
+    SpillMemoryTier memoryTier(fileReservedBytes);
+    SpillMemoryTier::setInstance(&memoryTier);
+    SCOPE_EXIT {
+      SpillMemoryTier::setInstance(nullptr);
+    };
+    const auto files = spill(memoryTier, 2);
+    ASSERT_TRUE(fs->exists(files[0].path));
+    ASSERT_FALSE(fs->exists(files[1].path));
+    ASSERT_EQ(memoryTier.usedBytes(), fileReservedBytes);
+    verifyRead(files);
+    ASSERT_EQ(memoryTier.usedBytes(), 0);
+    const auto stats = memoryTier.stats();
+    ASSERT_EQ(stats.numFiles, 2);
+    ASSERT_EQ(stats.numReads, 1);
+    ASSERT_EQ(stats.numEvictions, 1);
+    ASSERT_EQ(stats.evictedBytes, fileSize);
+  }
+
+  // No file fits so all are written to disk.
+  {
+    SpillMemoryTier memoryTier(fileReservedBytes - 1);
+    const auto files = spill(memoryTier, 2);
+    for (const auto& file : files) {
+      ASSERT_TRUE(fs->exists(file.path));
+    }
+    ASSERT_EQ(memoryTier.usedBytes(), 0);
+    ASSERT_EQ(memoryTier.stats().numFiles, 0);
+    ASSERT_EQ(memoryTier.stats().numReserveFailures, 2);
+    verifyRead(files);
+  }
+
+  // Files are dropped with their spill directory.
+  {
+    SpillMemoryTier memoryTier(kGB);
+    spill(memoryTier, 2);
+    ASSERT_EQ(memoryTier.usedBytes(), 2 * fileReservedBytes);
+    memoryTier.removeDirectory(tempDirectory->getPath());
+    ASSERT_EQ(memoryTier.usedBytes(), 0);
+    ASSERT_TRUE(memoryTier.testingPaths().empty());
+  }
+
+  // A file dropped with its spill directory while being evicted is deleted
+  // from disk once its write finishes.
+  {
+    SpillMemoryTier memoryTier(fileReservedBytes);
+    SCOPED_TESTVALUE_SET(
+        "facebook::velox::exec::SpillMemoryTier::evict",
+        std::function<void(std::string*)>([&](std::string* path) {
+          ASSERT_TRUE(fs->exists(*path));
+          memoryTier.removeDirectory(tempDirectory->getPath());
+        }));
+    const auto files = spill(memoryTier, 2);
+    ASSERT_FALSE(fs->exists(files[0].path));
+    ASSERT_EQ(memoryTier.usedBytes(), fileReservedBytes);
+    ASSERT_EQ(memoryTier.stats().numEvictions, 0);
+  }
+}
+
 TEST_P(SpillTest, spillStateWithSmallTargetFileSize) {
   // Set the target file size to a small value to open a new file on each batch
   // write.
@@ -22,6 +22,7 @@
 #include "velox/common/memory/MemoryArbitrator.h"
 #include "velox/common/memory/SharedArbitrator.h"
 #include "velox/common/memory/tests/SharedArbitratorTestUtil.h"
+#include "velox/common/process/Numa.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/exec/Cursor.h"
@@ -2644,6 +2645,32 @@ TEST_F(TaskTest, finishTiming) {
       orderByStats.finishTiming.wallNanos, projectStats.finishTiming.wallNanos);
 }
 
+TEST_F(TaskTest, numaNodePinning) {
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 17; }),
+  });
+  createDuckDbTable({data});
+  const auto plan = PlanBuilder()
+                        .values({data})
+                        .localPartition({"c0"})
+                        .singleAggregation({"c0"}, {"count(1)"})
+                        .planNode();
+  for (const bool enabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("enabled {}", enabled));
+    const auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(core::QueryConfig::kNumaNodePinningEnabled, enabled)
+            .maxDrivers(4)
+            .assertResults("SELECT c0, count(1) FROM tmp GROUP BY c0");
+    if (enabled && process::numaNodeCount() > 1) {
+      ASSERT_GE(task->numaNode(), 0);
+      ASSERT_LT(task->numaNode(), process::numaNodeCount());
+    } else {
+      ASSERT_EQ(task->numaNode(), -1);
+    }
+  }
+}
+
 TEST_F(TaskTest, invalidPlanNodeForBarrier) {
   auto data = makeRowVector({
       makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
@@ -40,6 +40,55 @@ TEST_F(TreeOfLosersTest, merge) {
   testBoth(500, 1);
 }
 
+TEST_F(TreeOfLosersTest, nextRun) {
+  for (auto maxRunSize : {1, 3, 1'000}) {
+    SCOPED_TRACE(fmt::format("maxRunSize: {}", maxRunSize));
+    for (auto [numValues, numStreams] :
+         std::vector<std::pair<int32_t, int32_t>>{
+             {11, 2}, {16, 32}, {17, 17}, {0, 9}, {500'000, 37}, {500, 1}}) {
+      auto testData = makeTestData(numValues, numStreams);
+      testRuns<TreeOfLosers<TestingStream>>(testData, maxRunSize, true);
+      testRuns<MergeArray<TestingStream>>(testData, maxRunSize, true);
+
+      for (auto chunkSize : {1, 7, 100}) {
+        testData = makeClusteredTestData(numValues, numStreams, chunkSize);
+        testRuns<TreeOfLosers<TestingStream>>(testData, maxRunSize, true);
+        testRuns<MergeArray<TestingStream>>(testData, maxRunSize, true);
+      }
+    }
+  }
+}
+
+TEST_F(TreeOfLosersTest, runLengthPredictor) {
+  RunLengthPredictor predictor;
+  // Counts the calls until the next probe.
+  const auto numSkipped = [&]() {
+    int32_t count = 0;
+    while (!predictor.shouldProbe()) {
+      ++count;
+    }
+    return count;
+  };
+  ASSERT_EQ(numSkipped(), 0);
+
+  // Single element runs back off exponentially up to kMaxSkip calls.
+  int32_t expectedSkip = 1;
+  for (auto i = 0; i < 10; ++i) {
+    predictor.recordRun(1);
+    ASSERT_EQ(numSkipped(), expectedSkip);
+    expectedSkip =
+        std::min<int32_t>(2 * expectedSkip, RunLengthPredictor::kMaxSkip);
+  }
+
+  // A longer run makes every call look for a run again.
+  predictor.recordRun(2);
+  ASSERT_EQ(numSkipped(), 0);
+  predictor.recordRun(100);
+  ASSERT_EQ(numSkipped(), 0);
+  predictor.recordRun(1);
+  ASSERT_EQ(numSkipped(), 1);
+}
+
 TEST_F(TreeOfLosersTest, nextWithEquals) {
   constexpr int32_t kNumStreams = 17;
   std::vector<std::vector<uint32_t>> streams(kNumStreams);
@@ -113,6 +113,70 @@ TEST_F(WindowTest, spill) {
   ASSERT_GT(stats.spilledPartitions, 0);
 }
 
+TEST_F(WindowTest, rowFormatSpill) {
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {"d", "p", "s", "t", "v"},
+      {
+          // Payload.
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          // Partition key.
+          makeFlatVector<int16_t>(
+              size, [](auto row) { return row % 11; }, nullEvery(13)),
+          // Sorting keys.
+          makeFlatVector<double>(
+              size, [](auto row) { return (row % 7) - 3.5; }, nullEvery(5)),
+          makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+          // String payload.
+          makeFlatVector<std::string>(
+              size,
+              [](auto row) { return std::string(row % 29, 'a' + row % 26); },
+              nullEvery(17)),
+      });
+
+  createDuckDbTable({data});
+
+  // The last window has a string sorting key and spills in columnar format.
+  const std::vector<std::pair<std::string, bool>> windows = {
+      {"row_number() over (partition by p order by s desc nulls first, t)",
+       true},
+      {"max(d) over (partition by p, s order by t desc)", true},
+      {"row_number() over (partition by p order by v, t)", false},
+  };
+  for (const auto& [window, rowFormat] : windows) {
+    SCOPED_TRACE(window);
+    core::PlanNodeId windowId;
+    auto plan = PlanBuilder()
+                    .values(split(data, 10))
+                    .window({window})
+                    .capturePlanNodeId(windowId)
+                    .planNode();
+
+    auto spillDirectory = TempDirectoryPath::create();
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+            .config(core::QueryConfig::kSpillEnabled, "true")
+            .config(core::QueryConfig::kWindowSpillEnabled, "true")
+            .config(core::QueryConfig::kSpillRowFormatEnabled, "true")
+            .spillDirectory(spillDirectory->getPath())
+            .assertResults(fmt::format("SELECT *, {} FROM tmp", window));
+
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    const auto& stats = taskStats.at(windowId);
+    ASSERT_GT(stats.spilledBytes, 0);
+    ASSERT_GT(stats.spilledRows, 0);
+    if (rowFormat) {
+      ASSERT_EQ(
+          stats.customStats.at(Operator::kSpilledRowFormatRows).sum,
+          stats.spilledRows);
+    } else {
+      ASSERT_EQ(stats.customStats.count(Operator::kSpilledRowFormatRows), 0);
+    }
+  }
+}
+
 TEST_F(WindowTest, spillUnsupported) {
   const vector_size_t size = 1'000;
   auto data = makeRowVector(
@@ -749,5 +813,47 @@ TEST_F(WindowTest, NaNFrameBound) {
   }
 }
 
+TEST_F(WindowTest, segmentTreeAggregation) {
+  const vector_size_t size = 10'000;
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          // Payload.
+          makeFlatVector<int64_t>(
+              size,
+              [](auto row) { return row % 97; },
+              [](auto row) { return row % 13 == 0; }),
+          // Partition key.
+          makeFlatVector<int16_t>(size, [](auto row) { return row % 3; }),
+          // Sorting key.
+          makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+      });
+
+  createDuckDbTable({data});
+
+  const std::vector<std::string> frames = {
+      "rows between 1000 preceding and current row",
+      "rows between 17 preceding and 5 following",
+      "rows between 3 preceding and 3 following",
+      "rows between current row and unbounded following",
+      "rows between 100 following and 300 following",
+  };
+  const std::vector<std::string> aggregates = {
+      "sum(d)", "count(d)", "min(d)", "max(d)", "avg(d)"};
+  for (const auto& frame : frames) {
+    for (const auto& aggregate : aggregates) {
+      SCOPED_TRACE(fmt::format("{} {}", aggregate, frame));
+      const auto window = fmt::format(
+          "{} over (partition by p order by s {})", aggregate, frame);
+      auto plan =
+          PlanBuilder().values(split(data, 10)).window({window}).planNode();
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kWindowAggregateSegmentTreeEnabled, "true")
+          .config(core::QueryConfig::kPreferredOutputBatchRows, "100")
+          .assertResults(fmt::format("SELECT *, {} FROM tmp", window));
+    }
+  }
+}
+
 } // namespace
 } // namespace facebook::velox::exec
@@ -79,6 +79,26 @@ class TestingStream final : public MergeStream {
     currentValid_ = false;
   }
 
+  // Removes the first 'count' values.
+  void pop(uint32_t count) {
+    numbers_.resize(numbers_.size() - count);
+    currentValid_ = false;
+  }
+
+  uint32_t upperBound(const MergeStream* other, uint32_t maxElements)
+      const final {
+    const uint32_t size = std::min<size_t>(maxElements, numbers_.size());
+    if (other == nullptr) {
+      return size;
+    }
+    const auto bound =
+        static_cast<const TestingStream*>(other)->current_.value();
+    const auto last = numbers_.size() - 1;
+    return runLength(size, [&](uint32_t offset) {
+      return numbers_[last - offset] <= bound;
+    });
+  }
+
   bool operator<(const MergeStream& other) const final {
     return current_.value() <
         static_cast<const TestingStream&>(other).current_.value();
@@ -175,6 +195,73 @@ class MergeTestBase {
     }
   }
 
+  // Makes 'numRuns' sorted streams totalling 'numValues' entries. The globally
+  // sorted values are dealt to random streams in chunks of 'chunkSize'
+  // consecutive values, so that the merge takes runs of about 'chunkSize'
+  // values from each stream.
+  TestData makeClusteredTestData(
+      int32_t numValues,
+      int32_t numRuns,
+      int32_t chunkSize) {
+    TestData data;
+    data.data.reserve(numValues);
+    for (auto i = 0; i < numValues; ++i) {
+      data.data.push_back(folly::Random::rand32(rng_));
+    }
+    std::sort(data.data.begin(), data.data.end());
+
+    std::vector<std::vector<uint32_t>> runs(numRuns);
+    for (auto offset = 0; offset < numValues; offset += chunkSize) {
+      auto& run = runs[folly::Random::rand32(numRuns, rng_)];
+      const auto end = std::min(offset + chunkSize, numValues);
+      run.insert(
+          run.end(), data.data.begin() + offset, data.data.begin() + end);
+    }
+    for (auto& run : runs) {
+      std::reverse(run.begin(), run.end());
+      data.sources.push_back(std::make_unique<TestingStream>(std::move(run)));
+    }
+    return data;
+  }
+
+  // Same as test() but reads runs of up to 'maxRunSize' values at a time with
+  // MergeType::nextRun().
+  template <typename MergeType>
+  static void
+  testRuns(const TestData& testData, uint32_t maxRunSize, bool check) {
+    std::vector<std::unique_ptr<TestingStream>> sources;
+    for (auto& source : testData.sources) {
+      sources.push_back(std::make_unique<TestingStream>(*source));
+    }
+    MergeType merge(std::move(sources));
+    if (check) {
+      size_t numValues = 0;
+      for (;;) {
+        auto [source, numRows] = merge.nextRun(maxRunSize);
+        if (!source) {
+          break;
+        }
+        ASSERT_GE(numRows, 1);
+        ASSERT_LE(numRows, maxRunSize);
+        for (uint32_t i = 0; i < numRows; ++i) {
+          ASSERT_TRUE(source->hasData());
+          ASSERT_LT(numValues, testData.data.size());
+          ASSERT_EQ(source->current()->value(), testData.data[numValues++]);
+          source->pop();
+        }
+      }
+      ASSERT_EQ(numValues, testData.data.size());
+    } else {
+      for (;;) {
+        auto [source, numRows] = merge.nextRun(maxRunSize);
+        if (!source) {
+          break;
+        }
+        source->pop(numRows);
+      }
+    }
+  }
+
  protected:
   folly::Random::DefaultGenerator rng_;
 };
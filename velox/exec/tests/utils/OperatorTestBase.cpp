@@ -21,7 +21,6 @@
 #include "velox/common/memory/MallocAllocator.h"
 #include "velox/common/memory/SharedArbitrator.h"
 #include "velox/common/testutil/TestValue.h"
-#include "velox/exec/tests/utils/LocalExchangeSource.h"
 #include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
 #include "velox/parse/Expressions.h"
@@ -148,16 +147,11 @@ void OperatorTestBase::SetUp() {
   options.spillMemoryPool = memory::spillMemoryPool();
   options.spillStatsIntervalMs = 2'000;
   startPeriodicStatsReporter(options);
-  testingStartLocalExchangeSource();
 }
 
 void OperatorTestBase::TearDown() {
   waitForAllTasksToBeDeleted();
   stopPeriodicStatsReporter();
-  // There might be lingering exchange source on executor even after all tasks
-  // are deleted. This can cause memory leak because exchange source holds
-  // reference to memory pool. We need to make sure they are properly cleaned.
-  testingShutdownLocalExchangeSource();
   pool_.reset();
   rootPool_.reset();
   resetMemory();
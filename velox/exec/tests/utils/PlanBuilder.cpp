@@ -1185,6 +1185,14 @@ PlanBuilder& PlanBuilder::limit(int64_t offset, int64_t count, bool isPartial) {
   return *this;
 }
 
+PlanBuilder& PlanBuilder::sample(
+    double sampleRate,
+    core::SampleNode::Method method) {
+  planNode_ = std::make_shared<core::SampleNode>(
+      nextPlanNodeId(), method, sampleRate, planNode_);
+  return *this;
+}
+
 PlanBuilder& PlanBuilder::enforceSingleRow() {
   planNode_ =
       std::make_shared<core::EnforceSingleRowNode>(nextPlanNodeId(), planNode_);
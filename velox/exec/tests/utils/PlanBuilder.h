@@ -955,6 +955,15 @@ class PlanBuilder {
   /// single-threaded.
   PlanBuilder& limit(int64_t offset, int64_t count, bool isPartial);
 
+  /// Add a SampleNode that keeps a random 'sampleRate' fraction of the input.
+  ///
+  /// @param method BERNOULLI samples individual rows, SYSTEM samples blocks of
+  /// rows. SYSTEM sampling directly above a table scan skips the dropped
+  /// stripes or row groups without reading them.
+  PlanBuilder& sample(
+      double sampleRate,
+      core::SampleNode::Method method = core::SampleNode::Method::kBernoulli);
+
   /// Add an EnforceSingleRowNode to ensure input has at most one row at
   /// runtime.
   PlanBuilder& enforceSingleRow();
@@ -117,6 +117,7 @@ void ConjunctExpr::evalSpecialForm(
   ScopedFinalSelectionSetter scopedFinalSelectionSetter(
       context, &rows, !isAnd_);
 
+  auto& selectivity = sharedSelectivity_ ? batchSelectivity_ : selectivity_;
   bool handleErrors = false;
   LocalSelectivityVector errorRows(context);
   LocalSelectivityVector activeRowsHolder(context, rows);
@@ -131,7 +132,7 @@ void ConjunctExpr::evalSpecialForm(
       context.swapErrors(errors);
     }
 
-    SelectivityTimer timer(selectivity_[inputOrder_[i]], numActive);
+    SelectivityTimer timer(selectivity[inputOrder_[i]], numActive);
     if (evaluatesArgumentsOnNonIncreasingSelection()) {
       // Exclude loading rows that we know for sure will have a false result.
       for (auto* field : inputs_[inputOrder_[i]]->distinctFields()) {
@@ -158,7 +159,7 @@ void ConjunctExpr::evalSpecialForm(
       activeRows->updateBounds();
     }
     numActive = activeRows->countSelected();
-    selectivity_[inputOrder_[i]].addOutput(numActive);
+    selectivity[inputOrder_[i]].addOutput(numActive);
 
     if (!numActive) {
       break;
@@ -166,6 +167,9 @@ void ConjunctExpr::evalSpecialForm(
   }
   // Clear errors for 'rows' that are not in 'activeRows'.
   finalizeErrors(rows, *activeRows, throwOnError, context);
+  if (sharedSelectivity_) {
+    updateSharedSelectivity();
+  }
   if (!reorderEnabledChecked_) {
     reorderEnabled_ = context.execCtx()
                           ->queryCtx()
@@ -178,6 +182,31 @@ void ConjunctExpr::evalSpecialForm(
   }
 }
 
+void ConjunctExpr::setSharedSelectivity(
+    std::shared_ptr<SharedConjunctSelectivity> shared,
+    int32_t conjunctId) {
+  sharedSelectivity_ = std::move(shared);
+  conjunctId_ = conjunctId;
+  batchSelectivity_.resize(inputs_.size());
+}
+
+void ConjunctExpr::updateSharedSelectivity() {
+  if (numSharedBatches_++ % SharedConjunctSelectivity::kMergeInterval != 0) {
+    return;
+  }
+  if (!sharedSelectivity_->update(
+          conjunctId_, batchSelectivity_, selectivity_)) {
+    // The other ExprSets have a different structure. Keeps the statistics
+    // local.
+    for (auto i = 0; i < inputs_.size(); ++i) {
+      selectivity_[i].add(batchSelectivity_[i]);
+    }
+    sharedSelectivity_.reset();
+  }
+  std::fill(
+      batchSelectivity_.begin(), batchSelectivity_.end(), SelectivityInfo());
+}
+
 void ConjunctExpr::maybeReorderInputs() {
   bool reorder = false;
   for (auto i = 1; i < inputs_.size(); ++i) {
@@ -380,6 +409,49 @@ void ConjunctExpr::updateResult(
   }
 }
 
+bool SharedConjunctSelectivity::update(
+    int32_t conjunctId,
+    const std::vector<SelectivityInfo>& batch,
+    std::vector<SelectivityInfo>& totals) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (conjunctId >= conjuncts_.size()) {
+    conjuncts_.resize(conjunctId + 1);
+  }
+  auto& selectivity = conjuncts_[conjunctId];
+  if (selectivity.empty()) {
+    selectivity.resize(batch.size());
+  }
+  if (selectivity.size() != batch.size()) {
+    return false;
+  }
+  for (auto i = 0; i < batch.size(); ++i) {
+    selectivity[i].add(batch[i]);
+  }
+  totals = selectivity;
+  return true;
+}
+
+void shareConjunctSelectivity(
+    const ExprSet& exprSet,
+    const std::shared_ptr<SharedConjunctSelectivity>& shared) {
+  int32_t conjunctId = 0;
+  std::unordered_set<const Expr*> visited;
+  std::function<void(const ExprPtr&)> visit = [&](const ExprPtr& expr) {
+    if (!visited.insert(expr.get()).second) {
+      return;
+    }
+    if (auto* conjunct = expr->as<ConjunctExpr>()) {
+      conjunct->setSharedSelectivity(shared, conjunctId++);
+    }
+    for (const auto& input : expr->inputs()) {
+      visit(input);
+    }
+  };
+  for (const auto& expr : exprSet.exprs()) {
+    visit(expr);
+  }
+}
+
 std::string ConjunctExpr::toSql(
     std::vector<VectorPtr>* complexConstants) const {
   std::stringstream out;
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <mutex>
+
 #include "velox/common/base/SelectivityInfo.h"
 #include "velox/expression/FunctionCallToSpecialForm.h"
 #include "velox/expression/SpecialForm.h"
@@ -24,6 +26,34 @@ namespace facebook::velox::exec {
 constexpr const char* kAnd = "and";
 constexpr const char* kOr = "or";
 
+/// Selectivity statistics of the inputs of the ConjunctExprs of ExprSets
+/// compiled from the same expressions, e.g. the filters of the drivers of a
+/// task. Lets each ExprSet order the inputs by the statistics of all the rows
+/// seen by any of them, so that short-lived ExprSets start with a good order.
+/// The ConjunctExprs are identified by their position in a depth first
+/// traversal of the compiled expressions. Each ConjunctExpr adds its
+/// statistics every kMergeInterval batches, so the lock is not taken for
+/// every batch. Thread safe.
+class SharedConjunctSelectivity {
+ public:
+  /// Number of batches a ConjunctExpr evaluates between adding its statistics
+  /// to the shared ones.
+  static constexpr uint64_t kMergeInterval = 16;
+
+  /// Adds 'batch' to the statistics of the inputs of conjunct 'conjunctId'
+  /// and sets 'totals' to the result. Returns false without updating
+  /// anything if the conjunct has a different number of inputs in another
+  /// ExprSet.
+  bool update(
+      int32_t conjunctId,
+      const std::vector<SelectivityInfo>& batch,
+      std::vector<SelectivityInfo>& totals);
+
+ private:
+  std::mutex mutex_;
+  std::vector<std::vector<SelectivityInfo>> conjuncts_;
+};
+
 class ConjunctExpr : public SpecialForm {
  public:
   ConjunctExpr(
@@ -67,6 +97,12 @@ class ConjunctExpr : public SpecialForm {
     return selectivity_[inputOrder_[index]];
   }
 
+  /// Makes this order the inputs by the statistics of conjunct 'conjunctId'
+  /// in 'shared' and add the statistics of each batch to them.
+  void setSharedSelectivity(
+      std::shared_ptr<SharedConjunctSelectivity> shared,
+      int32_t conjunctId);
+
   std::string toSql(
       std::vector<VectorPtr>* complexConstants = nullptr) const override;
 
@@ -83,6 +119,12 @@ class ConjunctExpr : public SpecialForm {
     propagatesNulls_ = false;
   }
 
+  // Adds the statistics of the batches since the last update to
+  // 'sharedSelectivity_' and copies the totals to 'selectivity_'. Does this
+  // for the first batch and then every
+  // SharedConjunctSelectivity::kMergeInterval batches.
+  void updateSharedSelectivity();
+
   void maybeReorderInputs();
 
   void updateResult(
@@ -106,9 +148,26 @@ class ConjunctExpr : public SpecialForm {
   std::vector<SelectivityInfo> selectivity_;
   std::vector<int32_t> inputOrder_;
 
+  // Set if the statistics are shared with other ExprSets. The statistics of
+  // the batches since the last update are then collected in
+  // 'batchSelectivity_' and added to the shared totals, which are copied to
+  // 'selectivity_'.
+  std::shared_ptr<SharedConjunctSelectivity> sharedSelectivity_;
+  int32_t conjunctId_{0};
+  std::vector<SelectivityInfo> batchSelectivity_;
+  // Number of batches evaluated with 'sharedSelectivity_'.
+  uint64_t numSharedBatches_{0};
+
   friend class ConjunctCallToSpecialForm;
 };
 
+/// Makes the ConjunctExprs of 'exprSet' share their selectivity statistics
+/// through 'shared'. 'shared' must only be used with ExprSets compiled from
+/// the same expressions.
+void shareConjunctSelectivity(
+    const ExprSet& exprSet,
+    const std::shared_ptr<SharedConjunctSelectivity>& shared);
+
 class ConjunctCallToSpecialForm : public FunctionCallToSpecialForm {
  public:
   explicit ConjunctCallToSpecialForm(bool isAnd)
@@ -20,6 +20,7 @@
 #include "velox/expression/ConjunctExpr.h"
 #include "velox/expression/ConstantExpr.h"
 #include "velox/expression/Expr.h"
+#include "velox/expression/ExprFusion.h"
 #include "velox/expression/FieldReference.h"
 #include "velox/expression/LambdaExpr.h"
 #include "velox/expression/RowConstructor.h"
@@ -518,6 +519,14 @@ ExprPtr compileRewrittenExpression(
     VELOX_UNSUPPORTED("Unknown typed expression");
   }
 
+  if (config.exprFusionEnabled()) {
+    // The inputs are compiled first, so a fusable call absorbs the fused trees
+    // of its inputs.
+    if (auto fused = tryFuseExpr(result, trackCpuUsage)) {
+      result = std::move(fused);
+    }
+  }
+
   result->computeMetadata();
 
   // If the expression is constant folding it is redundant.
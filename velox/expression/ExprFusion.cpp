@@ -0,0 +1,560 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/expression/ExprFusion.h"
+
+#include <folly/Synchronized.h>
+
+#include <map>
+
+#include "velox/common/base/CheckedArithmetic.h"
+#include "velox/expression/DecodedArgs.h"
+#include "velox/expression/VectorFunction.h"
+#include "velox/type/FloatingPointUtil.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+// Number of rows a fused program processes at a time. The intermediate
+// results of a chunk stay in the L1 cache.
+constexpr int32_t kChunkSize = 256;
+
+using FusableFunctionMap =
+    std::map<std::pair<std::string, TypeKind>, FusedOp>;
+
+folly::Synchronized<FusableFunctionMap>& fusableFunctions() {
+  static folly::Synchronized<FusableFunctionMap> kFunctions;
+  return kFunctions;
+}
+
+constexpr bool isComparison(FusedOp op) {
+  return op >= FusedOp::kEq;
+}
+
+bool isFusableType(const Type& type) {
+  // Custom types like DATE or INTERVAL DAY TO SECOND have the same kind but
+  // are not equal to the plain types.
+  return type == *INTEGER() || type == *BIGINT() || type == *REAL() ||
+      type == *DOUBLE();
+}
+
+// Calls 'func' with a value of the C++ type of 'kind'.
+template <typename TFunc>
+auto dispatchFusableKind(TypeKind kind, TFunc&& func) {
+  switch (kind) {
+    case TypeKind::INTEGER:
+      return func(int32_t{});
+    case TypeKind::BIGINT:
+      return func(int64_t{});
+    case TypeKind::REAL:
+      return func(float{});
+    case TypeKind::DOUBLE:
+      return func(double{});
+    default:
+      VELOX_UNREACHABLE("Unexpected type kind: {}", kind);
+  }
+}
+
+int32_t valueSize(TypeKind kind) {
+  return dispatchFusableKind(
+      kind, [](auto value) -> int32_t { return sizeof(value); });
+}
+
+template <FusedOp kOp, typename T>
+FOLLY_ALWAYS_INLINE bool compare(T left, T right) {
+  if constexpr (std::is_floating_point_v<T>) {
+    if constexpr (kOp == FusedOp::kEq) {
+      return util::floating_point::NaNAwareEquals<T>{}(left, right);
+    } else if constexpr (kOp == FusedOp::kNeq) {
+      return !util::floating_point::NaNAwareEquals<T>{}(left, right);
+    } else if constexpr (kOp == FusedOp::kLt) {
+      return util::floating_point::NaNAwareLessThan<T>{}(left, right);
+    } else if constexpr (kOp == FusedOp::kLte) {
+      return util::floating_point::NaNAwareLessThanEqual<T>{}(left, right);
+    } else if constexpr (kOp == FusedOp::kGt) {
+      return util::floating_point::NaNAwareGreaterThan<T>{}(left, right);
+    } else {
+      return util::floating_point::NaNAwareGreaterThanEqual<T>{}(left, right);
+    }
+  } else {
+    if constexpr (kOp == FusedOp::kEq) {
+      return left == right;
+    } else if constexpr (kOp == FusedOp::kNeq) {
+      return left != right;
+    } else if constexpr (kOp == FusedOp::kLt) {
+      return left < right;
+    } else if constexpr (kOp == FusedOp::kLte) {
+      return left <= right;
+    } else if constexpr (kOp == FusedOp::kGt) {
+      return left > right;
+    } else {
+      return left >= right;
+    }
+  }
+}
+
+// Sets 'result' to 'left' 'kOp' 'right'. Returns true on integer overflow.
+template <FusedOp kOp, typename T>
+FOLLY_ALWAYS_INLINE bool arithmetic(T left, T right, T& result) {
+  if constexpr (std::is_floating_point_v<T>) {
+    if constexpr (kOp == FusedOp::kPlus) {
+      result = left + right;
+    } else if constexpr (kOp == FusedOp::kMinus) {
+      result = left - right;
+    } else {
+      result = left * right;
+    }
+    return false;
+  } else {
+    if constexpr (kOp == FusedOp::kPlus) {
+      return __builtin_add_overflow(left, right, &result);
+    } else if constexpr (kOp == FusedOp::kMinus) {
+      return __builtin_sub_overflow(left, right, &result);
+    } else {
+      return __builtin_mul_overflow(left, right, &result);
+    }
+  }
+}
+
+// Returns 'left' 'kOp' 'right'. Throws on integer overflow with the error of
+// the unfused function.
+template <FusedOp kOp, typename T>
+FOLLY_ALWAYS_INLINE T checkedArithmetic(T left, T right) {
+  if constexpr (std::is_floating_point_v<T>) {
+    T result;
+    arithmetic<kOp>(left, right, result);
+    return result;
+  } else {
+    if constexpr (kOp == FusedOp::kPlus) {
+      return checkedPlus<T>(left, right);
+    } else if constexpr (kOp == FusedOp::kMinus) {
+      return checkedMinus<T>(left, right);
+    } else {
+      return checkedMultiply<T>(left, right);
+    }
+  }
+}
+
+// Applies an operation to 'numRows' consecutive values of 'left' and 'right'
+// and writes the results to 'result'. Comparisons write one byte per row.
+// Returns true if an integer operation overflowed, in which case 'result' is
+// undefined.
+using OpFunction = bool (*)(
+    const uint8_t* left,
+    const uint8_t* right,
+    uint8_t* result,
+    int32_t numRows);
+
+// If 'kChecked', throws on overflow instead of returning true.
+template <FusedOp kOp, typename T, bool kChecked>
+bool applyOp(
+    const uint8_t* left,
+    const uint8_t* right,
+    uint8_t* result,
+    int32_t numRows) {
+  const auto* rawLeft = reinterpret_cast<const T*>(left);
+  const auto* rawRight = reinterpret_cast<const T*>(right);
+  if constexpr (isComparison(kOp)) {
+    for (auto i = 0; i < numRows; ++i) {
+      result[i] = compare<kOp>(rawLeft[i], rawRight[i]);
+    }
+    return false;
+  } else if constexpr (kChecked) {
+    auto* rawResult = reinterpret_cast<T*>(result);
+    for (auto i = 0; i < numRows; ++i) {
+      rawResult[i] = checkedArithmetic<kOp>(rawLeft[i], rawRight[i]);
+    }
+    return false;
+  } else {
+    auto* rawResult = reinterpret_cast<T*>(result);
+    bool overflow = false;
+    for (auto i = 0; i < numRows; ++i) {
+      overflow |= arithmetic<kOp>(rawLeft[i], rawRight[i], rawResult[i]);
+    }
+    return overflow;
+  }
+}
+
+template <typename T, bool kChecked>
+OpFunction opFunction(FusedOp op) {
+  switch (op) {
+    case FusedOp::kPlus:
+      return applyOp<FusedOp::kPlus, T, kChecked>;
+    case FusedOp::kMinus:
+      return applyOp<FusedOp::kMinus, T, kChecked>;
+    case FusedOp::kMultiply:
+      return applyOp<FusedOp::kMultiply, T, kChecked>;
+    case FusedOp::kEq:
+      return applyOp<FusedOp::kEq, T, kChecked>;
+    case FusedOp::kNeq:
+      return applyOp<FusedOp::kNeq, T, kChecked>;
+    case FusedOp::kLt:
+      return applyOp<FusedOp::kLt, T, kChecked>;
+    case FusedOp::kLte:
+      return applyOp<FusedOp::kLte, T, kChecked>;
+    case FusedOp::kGt:
+      return applyOp<FusedOp::kGt, T, kChecked>;
+    case FusedOp::kGte:
+      return applyOp<FusedOp::kGte, T, kChecked>;
+  }
+  VELOX_UNREACHABLE();
+}
+
+template <bool kChecked>
+OpFunction opFunction(FusedOp op, TypeKind kind) {
+  return dispatchFusableKind(kind, [&](auto value) {
+    return opFunction<decltype(value), kChecked>(op);
+  });
+}
+
+// An argument of an Instruction. Either a leaf, i.e. an input of the fused
+// Expr, or the result of a previous Instruction.
+struct Operand {
+  bool isLeaf;
+  int32_t index;
+};
+
+struct Instruction {
+  FusedOp op;
+  Operand left;
+  Operand right;
+  // Bytes per row of the result.
+  int32_t resultSize;
+  OpFunction fast;
+  OpFunction checked;
+};
+
+Instruction
+makeInstruction(FusedOp op, TypeKind kind, Operand left, Operand right) {
+  return Instruction{
+      op,
+      left,
+      right,
+      isComparison(op) ? 1 : valueSize(kind),
+      opFunction<false>(op, kind),
+      opFunction<true>(op, kind)};
+}
+
+// Evaluates a program of binary operations over chunks of rows. The
+// operations of a chunk are applied one at a time to all the rows of the
+// chunk, so that each is a tight loop over a few cache resident arrays
+// instead of a pass over a full intermediate vector. Integer overflow is
+// detected per chunk. The rows of an overflowing chunk are then evaluated one
+// at a time with the checked operations to raise the same errors as the
+// unfused functions.
+class FusedFunction : public VectorFunction {
+ public:
+  explicit FusedFunction(std::vector<Instruction> program)
+      : program_(std::move(program)) {}
+
+  bool supportsFlatNoNullsFastPath() const override {
+    return true;
+  }
+
+  const std::vector<Instruction>& program() const {
+    return program_;
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      EvalCtx& context,
+      VectorPtr& result) const override {
+    const int32_t numLeaves = args.size();
+    const int32_t numInstructions = program_.size();
+    DecodedArgs decodedArgs(rows, args, context);
+
+    // One chunk of values per leaf and per instruction.
+    std::vector<int64_t> scratch((numLeaves + numInstructions) * kChunkSize);
+    auto scratchAt = [&](int32_t slot) {
+      return reinterpret_cast<uint8_t*>(scratch.data() + slot * kChunkSize);
+    };
+
+    // Flat leaves are read in place and constant leaves are broadcast to
+    // their scratch once. The other leaves are copied to their scratch for
+    // each chunk.
+    std::vector<const uint8_t*> flatLeaves(numLeaves, nullptr);
+    std::vector<int32_t> gatheredLeaves;
+    std::vector<int32_t> leafSizes(numLeaves);
+    for (auto i = 0; i < numLeaves; ++i) {
+      const auto* decoded = decodedArgs.at(i);
+      leafSizes[i] = valueSize(args[i]->typeKind());
+      dispatchFusableKind(args[i]->typeKind(), [&](auto value) {
+        using T = decltype(value);
+        if (decoded->isIdentityMapping()) {
+          flatLeaves[i] = reinterpret_cast<const uint8_t*>(decoded->data<T>());
+        } else if (decoded->isConstantMapping()) {
+          std::fill_n(
+              reinterpret_cast<T*>(scratchAt(i)),
+              kChunkSize,
+              decoded->valueAt<T>(rows.begin()));
+        } else {
+          gatheredLeaves.push_back(i);
+        }
+      });
+    }
+
+    auto localResult =
+        BaseVector::create(outputType, rows.end(), context.pool());
+    const bool isBoolean = isComparison(program_.back().op);
+    uint64_t* rawBits = isBoolean
+        ? localResult->asFlatVector<bool>()->mutableRawValues<uint64_t>()
+        : nullptr;
+    uint8_t* rawValues = isBoolean
+        ? nullptr
+        : dispatchFusableKind(outputType->kind(), [&](auto value) {
+            using T = decltype(value);
+            return reinterpret_cast<uint8_t*>(
+                localResult->asFlatVector<T>()->mutableRawValues());
+          });
+
+    std::vector<const uint8_t*> leafValues(numLeaves);
+    std::vector<uint8_t*> resultValues(numInstructions);
+    auto operandValues = [&](Operand operand) {
+      return operand.isLeaf ? leafValues[operand.index]
+                            : resultValues[operand.index];
+    };
+    auto operandSize = [&](Operand operand) {
+      return operand.isLeaf ? leafSizes[operand.index]
+                            : program_[operand.index].resultSize;
+    };
+
+    for (auto begin = rows.begin(); begin < rows.end(); begin += kChunkSize) {
+      const auto end = std::min<vector_size_t>(begin + kChunkSize, rows.end());
+      const auto numRows = end - begin;
+
+      for (auto i = 0; i < numLeaves; ++i) {
+        leafValues[i] = flatLeaves[i] != nullptr
+            ? flatLeaves[i] + begin * leafSizes[i]
+            : scratchAt(i);
+      }
+      for (auto i : gatheredLeaves) {
+        const auto* decoded = decodedArgs.at(i);
+        dispatchFusableKind(args[i]->typeKind(), [&](auto value) {
+          using T = decltype(value);
+          auto* values = reinterpret_cast<T*>(scratchAt(i));
+          bits::forEachSetBit(rows.allBits(), begin, end, [&](auto row) {
+            values[row - begin] = decoded->valueAt<T>(row);
+          });
+        });
+      }
+      for (auto i = 0; i < numInstructions; ++i) {
+        resultValues[i] = i == numInstructions - 1 && !isBoolean
+            ? rawValues + begin * program_[i].resultSize
+            : scratchAt(numLeaves + i);
+      }
+
+      bool overflow = false;
+      for (auto i = 0; i < numInstructions; ++i) {
+        const auto& instruction = program_[i];
+        overflow |= instruction.fast(
+            operandValues(instruction.left),
+            operandValues(instruction.right),
+            resultValues[i],
+            numRows);
+      }
+
+      if (FOLLY_UNLIKELY(overflow)) {
+        SelectivityVector chunkRows(rows);
+        chunkRows.setValidRange(0, begin, false);
+        chunkRows.setValidRange(end, rows.end(), false);
+        chunkRows.updateBounds();
+        context.applyToSelectedNoThrow(chunkRows, [&](auto row) {
+          const auto offset = row - begin;
+          for (auto i = 0; i < numInstructions; ++i) {
+            const auto& instruction = program_[i];
+            instruction.checked(
+                operandValues(instruction.left) +
+                    offset * operandSize(instruction.left),
+                operandValues(instruction.right) +
+                    offset * operandSize(instruction.right),
+                resultValues[i] + offset * instruction.resultSize,
+                1);
+          }
+        });
+      }
+
+      if (isBoolean) {
+        const auto* values = resultValues.back();
+        for (auto i = 0; i < numRows; ++i) {
+          bits::setBit(rawBits, begin + i, values[i]);
+        }
+      }
+    }
+
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+
+ private:
+  const std::vector<Instruction> program_;
+};
+
+// Evaluates a tree of fusable calls with a FusedFunction over the leaves of
+// the tree. Prints as the unfused tree.
+class FusedExpr : public Expr {
+ public:
+  FusedExpr(
+      ExprPtr unfused,
+      std::vector<ExprPtr>&& leaves,
+      std::shared_ptr<FusedFunction> function,
+      bool trackCpuUsage)
+      : Expr(
+            unfused->type(),
+            std::move(leaves),
+            function,
+            // Deterministic with default null behavior.
+            VectorFunctionMetadata{},
+            unfused->name(),
+            trackCpuUsage),
+        unfused_(std::move(unfused)),
+        function_(std::move(function)) {}
+
+  const std::vector<Instruction>& program() const {
+    return function_->program();
+  }
+
+  std::string toString(bool recursive = true) const override {
+    return unfused_->toString(recursive);
+  }
+
+  std::string toSql(
+      std::vector<VectorPtr>* complexConstants = nullptr) const override {
+    return unfused_->toSql(complexConstants);
+  }
+
+ private:
+  const ExprPtr unfused_;
+  const std::shared_ptr<FusedFunction> function_;
+};
+
+// Returns the operation of 'expr' if it is a call of a fusable function.
+std::optional<FusedOp> fusableOp(const Expr& expr) {
+  if (expr.isSpecialForm() || expr.vectorFunction() == nullptr ||
+      !expr.vectorFunctionMetadata().deterministic ||
+      !expr.vectorFunctionMetadata().defaultNullBehavior ||
+      expr.inputs().size() != 2) {
+    return std::nullopt;
+  }
+  const auto& type = expr.inputs()[0]->type();
+  if (!isFusableType(*type) || *expr.inputs()[1]->type() != *type) {
+    return std::nullopt;
+  }
+  std::optional<FusedOp> op;
+  fusableFunctions().withRLock([&](const auto& functions) {
+    auto it = functions.find({expr.name(), type->kind()});
+    if (it != functions.end()) {
+      op = it->second;
+    }
+  });
+  if (!op.has_value() ||
+      *expr.type() != (isComparison(*op) ? *BOOLEAN() : *type)) {
+    return std::nullopt;
+  }
+  return op;
+}
+
+// Flattens a tree of fusable calls into a program. Calls are added after
+// their arguments, so the last instruction computes the root.
+class ProgramBuilder {
+ public:
+  Operand add(const ExprPtr& expr) {
+    if (auto* fused = dynamic_cast<const FusedExpr*>(expr.get())) {
+      return addFused(*fused);
+    }
+    if (auto op = fusableOp(*expr)) {
+      const auto left = add(expr->inputs()[0]);
+      const auto right = add(expr->inputs()[1]);
+      program_.push_back(makeInstruction(
+          *op, expr->inputs()[0]->type()->kind(), left, right));
+      return Operand{false, static_cast<int32_t>(program_.size() - 1)};
+    }
+    return addLeaf(expr);
+  }
+
+  std::vector<ExprPtr>& leaves() {
+    return leaves_;
+  }
+
+  std::vector<Instruction>& program() {
+    return program_;
+  }
+
+ private:
+  // Adds the program of an already fused argument.
+  Operand addFused(const FusedExpr& fused) {
+    std::vector<Operand> leaves;
+    for (const auto& input : fused.inputs()) {
+      leaves.push_back(addLeaf(input));
+    }
+    const int32_t offset = program_.size();
+    auto remap = [&](Operand operand) {
+      return operand.isLeaf ? leaves[operand.index]
+                            : Operand{false, operand.index + offset};
+    };
+    for (auto instruction : fused.program()) {
+      instruction.left = remap(instruction.left);
+      instruction.right = remap(instruction.right);
+      program_.push_back(instruction);
+    }
+    return Operand{false, static_cast<int32_t>(program_.size() - 1)};
+  }
+
+  Operand addLeaf(const ExprPtr& expr) {
+    for (auto i = 0; i < leaves_.size(); ++i) {
+      if (leaves_[i] == expr) {
+        return Operand{true, i};
+      }
+    }
+    leaves_.push_back(expr);
+    return Operand{true, static_cast<int32_t>(leaves_.size() - 1)};
+  }
+
+  std::vector<ExprPtr> leaves_;
+  std::vector<Instruction> program_;
+};
+} // namespace
+
+void registerFusableFunction(
+    const std::string& name,
+    FusedOp op,
+    TypeKind kind) {
+  VELOX_CHECK(
+      kind == TypeKind::INTEGER || kind == TypeKind::BIGINT ||
+          kind == TypeKind::REAL || kind == TypeKind::DOUBLE,
+      "Fusable function {} must take INTEGER, BIGINT, REAL or DOUBLE",
+      name);
+  fusableFunctions().withWLock(
+      [&](auto& functions) { functions[{name, kind}] = op; });
+}
+
+ExprPtr tryFuseExpr(const ExprPtr& expr, bool trackCpuUsage) {
+  if (dynamic_cast<const FusedExpr*>(expr.get()) != nullptr ||
+      !fusableOp(*expr).has_value()) {
+    return nullptr;
+  }
+  ProgramBuilder builder;
+  builder.add(expr);
+  if (builder.program().size() < 2) {
+    return nullptr;
+  }
+  return std::make_shared<FusedExpr>(
+      expr,
+      std::move(builder.leaves()),
+      std::make_shared<FusedFunction>(std::move(builder.program())),
+      trackCpuUsage);
+}
+
+} // namespace facebook::velox::exec
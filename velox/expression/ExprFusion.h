@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/expression/Expr.h"
+
+namespace facebook::velox::exec {
+
+/// Binary operations the expression compiler can evaluate in a fused loop.
+enum class FusedOp {
+  kPlus,
+  kMinus,
+  kMultiply,
+  kEq,
+  kNeq,
+  kLt,
+  kLte,
+  kGt,
+  kGte,
+};
+
+/// Declares that the function 'name' computes 'op' for two arguments of type
+/// 'kind' with default null behavior. 'kind' must be one of INTEGER, BIGINT,
+/// REAL and DOUBLE. Integer arithmetic must fail on overflow like
+/// checkedPlus() and friends, floating point comparisons must follow
+/// util::floating_point::NaNAware* semantics. Calls with arguments of custom
+/// types, e.g. DATE, are never fused.
+void registerFusableFunction(
+    const std::string& name,
+    FusedOp op,
+    TypeKind kind);
+
+/// Returns an expression that evaluates the tree of fusable calls rooted at
+/// 'expr' in one loop over the rows, without materializing the results of the
+/// inner calls. The returned expression has the leaves of the tree as inputs
+/// and prints as 'expr'. Returns nullptr if 'expr' is not a fusable call or if
+/// the tree has a single call. Invoked by the expression compiler bottom-up,
+/// so the inputs of 'expr' may already be fused.
+ExprPtr tryFuseExpr(const ExprPtr& expr, bool trackCpuUsage);
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::test;
+
+namespace {
+
+class ExprFusionTest : public functions::test::FunctionBaseTest {
+ protected:
+  void setFusionEnabled(bool enabled) {
+    queryCtx_->testingOverrideConfigUnsafe({
+        {core::QueryConfig::kExprFusionEnabled, enabled ? "true" : "false"},
+    });
+  }
+
+  // Returns the number of inputs of the compiled 'expression'. A fused
+  // expression has the leaves of the fused tree as inputs.
+  size_t numCompiledInputs(
+      const std::string& expression,
+      const RowVectorPtr& input) {
+    auto exprSet = compileExpression(expression, asRowType(input->type()));
+    return exprSet->expr(0)->inputs().size();
+  }
+
+  // Verifies that 'expression' produces the same result with and without
+  // fusion.
+  void testFused(const std::string& expression, const RowVectorPtr& input) {
+    setFusionEnabled(false);
+    auto expected = evaluate(expression, input);
+
+    setFusionEnabled(true);
+    auto result = evaluate(expression, input);
+    assertEqualVectors(expected, result);
+  }
+};
+
+TEST_F(ExprFusionTest, arithmeticAndComparison) {
+  const vector_size_t size = 1'000;
+  auto input = makeRowVector({
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row * 7 - 300; }, nullEvery(11)),
+      makeFlatVector<int64_t>(size, [](auto row) { return row % 17; }),
+      makeFlatVector<int32_t>(
+          size, [](auto row) { return row % 23 - 5; }, nullEvery(13)),
+      makeFlatVector<double>(
+          size,
+          [](auto row) {
+            return row % 9 == 0 ? std::nan("") : row * 0.25 - 10;
+          },
+          nullEvery(7)),
+  });
+
+  std::vector<std::string> expressions = {
+      "c0 * 2 + c1 > c1 - 1",
+      "c0 * c1 - c0 * 3",
+      "c2 * c2 + c2 <= c2 - cast(1 as integer)",
+      "c3 * c3 - 1.5 >= c3 + c3",
+      "c3 * 2.0 + 1.0 = c3 + c3",
+      "c3 + 1.0 <> c3 * 2.0",
+      "cast(c2 as bigint) * 3 + c0 < c1",
+  };
+  for (const auto& expression : expressions) {
+    SCOPED_TRACE(expression);
+    testFused(expression, input);
+  }
+
+  // The fused expression has the distinct leaves of the tree as inputs.
+  setFusionEnabled(true);
+  EXPECT_EQ(numCompiledInputs("c0 * 2 + c1 > c1 - 1", input), 4);
+  EXPECT_EQ(numCompiledInputs("c0 * c1 - c0 * 3", input), 3);
+  EXPECT_EQ(numCompiledInputs("c3 * c3 - 1.5 >= c3 + c3", input), 2);
+
+  // A single call is not fused.
+  EXPECT_EQ(numCompiledInputs("c0 + c0", input), 2);
+
+  // Fused expressions print as the original tree.
+  auto exprSet = compileExpression("c0 * 2 + c1", asRowType(input->type()));
+  EXPECT_EQ(
+      exprSet->expr(0)->toString(), "plus(multiply(c0, 2:BIGINT), c1)");
+}
+
+TEST_F(ExprFusionTest, encodings) {
+  const vector_size_t size = 1'000;
+  auto input = makeRowVector({
+      wrapInDictionary(
+          makeIndicesInReverse(size),
+          makeFlatVector<int64_t>(
+              size, [](auto row) { return row; }, nullEvery(5))),
+      makeFlatVector<int64_t>(size, [](auto row) { return row % 3; }),
+      makeConstant<int64_t>(10, size),
+  });
+
+  testFused("c0 * c1 + c2 > c0", input);
+  testFused("c0 * c2 - c2", input);
+
+  // Evaluates on a subset of rows.
+  testFused("if(c1 = 1, c0 * c1 + c2, c0 - c2 * c1)", input);
+}
+
+TEST_F(ExprFusionTest, overflow) {
+  auto input = makeRowVector({
+      makeFlatVector<int64_t>(
+          {1, std::numeric_limits<int64_t>::max() / 2, 3, 4}),
+      makeFlatVector<int64_t>({10, 3, 30, 40}),
+  });
+
+  setFusionEnabled(true);
+  VELOX_ASSERT_THROW(
+      evaluate("c0 * c1 + 1", input),
+      "integer overflow: 4611686018427387903 * 3");
+
+  // Only the overflowing row is null under TRY.
+  auto result = evaluate("try(c0 * c1 + 1)", input);
+  assertEqualVectors(
+      makeNullableFlatVector<int64_t>({11, std::nullopt, 91, 161}), result);
+}
+
+} // namespace
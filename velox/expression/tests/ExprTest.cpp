@@ -483,6 +483,63 @@ TEST_P(ParameterizedExprTest, reorder) {
   }
 }
 
+TEST_P(ParameterizedExprTest, sharedReorderStats) {
+  constexpr int32_t kTestSize = 20'000;
+
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(kTestSize, [](auto row) { return row; })});
+  auto smallData = makeRowVector(
+      {makeFlatVector<int64_t>(10, [](auto row) { return row; })});
+  const std::string expression = "if (c0 % 409 < 300 and c0 % 103 < 30, 1, 2)";
+  auto shared = std::make_shared<exec::SharedConjunctSelectivity>();
+  auto exprSet = compileExpression(expression, asRowType(data->type()));
+  auto otherExprSet = compileExpression(expression, asRowType(data->type()));
+  exec::shareConjunctSelectivity(*exprSet, shared);
+  exec::shareConjunctSelectivity(*otherExprSet, shared);
+
+  auto conjunct = [](const std::unique_ptr<exec::ExprSet>& exprSet) {
+    auto condition = std::dynamic_pointer_cast<exec::ConjunctExpr>(
+        exprSet->expr(0)->inputs()[0]);
+    VELOX_CHECK_NOT_NULL(condition);
+    return condition;
+  };
+  auto totalNumIn = [](const std::shared_ptr<exec::ConjunctExpr>& condition) {
+    uint64_t numIn = 0;
+    for (auto i = 0; i < condition->inputs().size(); ++i) {
+      numIn += condition->selectivityAt(i).numIn();
+    }
+    return numIn;
+  };
+
+  evaluate(exprSet.get(), data);
+  auto condition = conjunct(exprSet);
+  EXPECT_GT(totalNumIn(condition), kTestSize);
+
+  // The ExprSet that has seen a single small batch has the statistics of both
+  // ExprSets. Rows 0 to 9 pass both inputs.
+  evaluate(otherExprSet.get(), smallData);
+  auto otherCondition = conjunct(otherExprSet);
+  EXPECT_EQ(totalNumIn(otherCondition), totalNumIn(condition) + 20);
+  for (auto i = 1; i < otherCondition->inputs().size(); ++i) {
+    EXPECT_LE(
+        otherCondition->selectivityAt(i - 1).timeToDropValue(),
+        otherCondition->selectivityAt(i).timeToDropValue());
+  }
+
+  // The statistics of the next batches are added to the shared ones after
+  // kMergeInterval batches.
+  const auto numIn = totalNumIn(otherCondition);
+  for (uint64_t i = 1; i < exec::SharedConjunctSelectivity::kMergeInterval;
+       ++i) {
+    evaluate(otherExprSet.get(), smallData);
+  }
+  EXPECT_EQ(totalNumIn(otherCondition), numIn);
+  evaluate(otherExprSet.get(), smallData);
+  EXPECT_EQ(
+      totalNumIn(otherCondition),
+      numIn + 20 * exec::SharedConjunctSelectivity::kMergeInterval);
+}
+
 TEST_P(ParameterizedExprTest, constant) {
   auto exprSet = compileExpression("1 + 2 + 3 + 4", ROW({}));
   auto constExpr = dynamic_cast<exec::ConstantExpr*>(exprSet->expr(0).get());
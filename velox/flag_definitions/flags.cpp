@@ -132,6 +132,15 @@ DEFINE_bool(
     false,
     "Read back data after writing to SSD");
 
+// Used in exec/SpillFile.cpp
+DEFINE_uint64(
+    velox_spill_memory_tier_capacity_bytes,
+    0,
+    "Capacity in bytes of the process wide spill memory tier which keeps "
+    "finished spill files in memory. The tier is created on first use if "
+    "positive and no tier is set with SpillMemoryTier::setInstance(). "
+    "Disabled if 0");
+
 // Used in /connectors/tpch
 DEFINE_int32(
     velox_tpch_text_pool_size_mb,
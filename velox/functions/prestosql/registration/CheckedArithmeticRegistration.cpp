@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "velox/expression/ExprFusion.h"
 #include "velox/functions/lib/CheckedArithmetic.h"
 #include "velox/functions/lib/RegistrationHelpers.h"
 
@@ -26,6 +27,14 @@ void registerCheckedArithmeticFunctions(const std::string& prefix) {
   registerBinaryIntegral<CheckedModulusFunction>({prefix + "mod"});
   registerBinaryIntegral<CheckedDivideFunction>({prefix + "divide"});
   registerUnaryIntegral<CheckedNegateFunction>({prefix + "negate"});
+
+  for (auto kind : {TypeKind::INTEGER, TypeKind::BIGINT}) {
+    exec::registerFusableFunction(prefix + "plus", exec::FusedOp::kPlus, kind);
+    exec::registerFusableFunction(
+        prefix + "minus", exec::FusedOp::kMinus, kind);
+    exec::registerFusableFunction(
+        prefix + "multiply", exec::FusedOp::kMultiply, kind);
+  }
 }
 
 } // namespace facebook::velox::functions
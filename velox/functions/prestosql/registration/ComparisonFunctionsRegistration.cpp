@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/expression/ExprFusion.h"
 #include "velox/functions/Registerer.h"
 #include "velox/functions/prestosql/Comparisons.h"
 #include "velox/functions/prestosql/types/IPAddressRegistration.h"
@@ -73,6 +74,19 @@ void registerComparisonFunctions(const std::string& prefix) {
   registerFunction<GteFunction, bool, Orderable<T1>, Orderable<T1>>(
       {prefix + "gte"});
 
+  for (auto kind :
+       {TypeKind::INTEGER,
+        TypeKind::BIGINT,
+        TypeKind::REAL,
+        TypeKind::DOUBLE}) {
+    exec::registerFusableFunction(prefix + "eq", exec::FusedOp::kEq, kind);
+    exec::registerFusableFunction(prefix + "neq", exec::FusedOp::kNeq, kind);
+    exec::registerFusableFunction(prefix + "lt", exec::FusedOp::kLt, kind);
+    exec::registerFusableFunction(prefix + "lte", exec::FusedOp::kLte, kind);
+    exec::registerFusableFunction(prefix + "gt", exec::FusedOp::kGt, kind);
+    exec::registerFusableFunction(prefix + "gte", exec::FusedOp::kGte, kind);
+  }
+
   registerFunction<DistinctFromFunction, bool, Generic<T1>, Generic<T1>>(
       {prefix + "distinct_from"});
 
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/expression/ExprFusion.h"
 #include "velox/functions/Registerer.h"
 #include "velox/functions/lib/RegistrationHelpers.h"
 #include "velox/functions/prestosql/Arithmetic.h"
@@ -91,6 +92,14 @@ void registerMathOperators(const std::string& prefix = "") {
       IntervalYearMonth,
       double>({prefix + "divide"});
   registerBinaryFloatingPoint<ModulusFunction>({prefix + "mod"});
+
+  for (auto kind : {TypeKind::REAL, TypeKind::DOUBLE}) {
+    exec::registerFusableFunction(prefix + "plus", exec::FusedOp::kPlus, kind);
+    exec::registerFusableFunction(
+        prefix + "minus", exec::FusedOp::kMinus, kind);
+    exec::registerFusableFunction(
+        prefix + "multiply", exec::FusedOp::kMultiply, kind);
+  }
 }
 
 } // namespace
@@ -15,9 +15,25 @@
  */
 
 #include "velox/serializers/PrestoIterativeVectorSerializer.h"
+
+#include <numeric>
+
 #include "velox/serializers/PrestoSerializerSerializationUtils.h"
 
 namespace facebook::velox::serializer::presto::detail {
+namespace {
+// Returns true if 'column' is worth writing as a dictionary. Dictionary indices
+// are 4 bytes, so a dictionary of a narrower fixed width type is not smaller
+// than the flat values.
+bool isDictionaryCandidate(const VectorPtr& column) {
+  if (column->encoding() != VectorEncoding::Simple::DICTIONARY) {
+    return false;
+  }
+  const auto& type = column->type();
+  return !type->isFixedWidth() || type->cppSizeInBytes() > sizeof(int32_t);
+}
+} // namespace
+
 PrestoIterativeVectorSerializer::PrestoIterativeVectorSerializer(
     const RowTypePtr& rowType,
     int32_t numRows,
@@ -45,6 +61,18 @@ void PrestoIterativeVectorSerializer::append(
   if (numNewRows == 0) {
     return;
   }
+  if (opts_.preserveDictionaries) {
+    ScratchPtr<vector_size_t, 64> rowsHolder(scratch);
+    auto* rows = rowsHolder.get(numNewRows);
+    auto* nextRow = rows;
+    for (const auto& range : ranges) {
+      std::iota(nextRow, nextRow + range.size, range.begin);
+      nextRow += range.size;
+    }
+    append(
+        vector, folly::Range<const vector_size_t*>(rows, numNewRows), scratch);
+    return;
+  }
   numRows_ += numNewRows;
   for (int32_t i = 0; i < vector->childrenSize(); ++i) {
     serializeColumn(vector->childAt(i), ranges, &streams_[i], scratch);
@@ -59,9 +87,21 @@ void PrestoIterativeVectorSerializer::append(
   if (numNewRows == 0) {
     return;
   }
+  const bool firstAppend = numRows_ == 0;
   numRows_ += numNewRows;
   for (int32_t i = 0; i < vector->childrenSize(); ++i) {
-    serializeColumn(vector->childAt(i), rows, &streams_[i], scratch);
+    const auto& column = vector->childAt(i);
+    auto& stream = streams_[i];
+    if (opts_.preserveDictionaries) {
+      if (firstAppend && isDictionaryCandidate(column)) {
+        stream.initializeDictionaryStream(numNewRows);
+      }
+      if (stream.isDictionaryStream()) {
+        stream.appendDictionary(column, rows, scratch);
+        continue;
+      }
+    }
+    serializeColumn(column, rows, &stream, scratch);
   }
 }
 
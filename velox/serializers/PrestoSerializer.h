@@ -80,6 +80,16 @@ class PrestoVectorSerde : public VectorSerde {
     /// affect the encoding of the input vectors. This is only relevant when
     /// using BatchVectorSerializer.
     bool preserveEncodings{false};
+
+    /// If true, IterativeVectorSerializer writes a column as a dictionary if
+    /// the column is dictionary encoded in the first vector appended to the
+    /// page. The values of a dictionary shared by the vectors appended to the
+    /// page are written once. The deserializer returns such a column as a
+    /// dictionary over the written values. The dictionaries are per page and
+    /// column: the Presto wire format has no dictionaries shared across pages
+    /// and no bit-packed or frame-of-reference blocks, so these are not
+    /// produced.
+    bool preserveDictionaries{false};
   };
 
   PrestoVectorSerde() : VectorSerde(Kind::kPresto) {}
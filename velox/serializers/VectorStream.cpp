@@ -75,7 +75,9 @@ VectorStream::VectorStream(
       nulls_(streamArena, true, true),
       lengths_(streamArena),
       values_(streamArena),
-      children_(memory::StlAllocator<VectorStream>(*streamArena->pool())) {
+      children_(memory::StlAllocator<VectorStream>(*streamArena->pool())),
+      dictionaryPositions_(
+          memory::StlAllocator<DictionaryPosition>(*streamArena->pool())) {
   if (initialNumRows == 0) {
     initializeHeader(typeToEncodingName(type), *streamArena);
     if (type_->size() > 0 && !isIpPrefix_) {
@@ -205,6 +207,90 @@ void VectorStream::flattenStream(
   initializeFlatStream(vector, initialNumRows);
 }
 
+void VectorStream::initializeDictionaryStream(int32_t initialNumRows) {
+  VELOX_CHECK(!isDictionaryStream_);
+  VELOX_CHECK(!isConstantStream_);
+  VELOX_CHECK_EQ(nullCount_, 0);
+  VELOX_CHECK_EQ(nonNullCount_, 0);
+
+  encoding_ = VectorEncoding::Simple::DICTIONARY;
+  initializeHeader(kDictionary, *streamArena_);
+  values_.startWrite(initialNumRows * 4);
+  isDictionaryStream_ = true;
+  hasLengths_ = false;
+  children_.clear();
+  children_.emplace_back(
+      type_, std::nullopt, std::nullopt, streamArena_, initialNumRows, opts_);
+}
+
+void VectorStream::appendDictionary(
+    const VectorPtr& vector,
+    folly::Range<const vector_size_t*> rows,
+    Scratch& scratch) {
+  VELOX_CHECK(isDictionaryStream_);
+  const auto& loaded = BaseVector::loadedVectorShared(vector);
+  const auto& base = BaseVector::wrappedVectorShared(loaded);
+  const bool isWrapped = base.get() != loaded.get();
+  const bool mayHaveNulls = loaded->mayHaveNulls();
+  if (isWrapped && base != dictionaryBase_) {
+    dictionaryBase_ = base;
+    if (++dictionaryEpoch_ == 0) {
+      // Stale positions could match the wrapped around epoch.
+      dictionaryPositions_.assign(dictionaryPositions_.size(), {});
+      dictionaryEpoch_ = 1;
+    }
+    if (dictionaryPositions_.size() < base->size()) {
+      dictionaryPositions_.resize(base->size());
+    }
+  }
+
+  auto& dictionary = children_[0];
+  ScratchPtr<vector_size_t, 64> newRowsHolder(scratch);
+  ScratchPtr<int32_t, 64> indicesHolder(scratch);
+  auto* newRows = newRowsHolder.get(rows.size());
+  auto* indices = indicesHolder.get(rows.size());
+  int32_t numNew = 0;
+  // Adds the values of 'base' at 'newRows' to the dictionary.
+  auto addNewRows = [&]() {
+    if (numNew > 0) {
+      serializeColumn(
+          base,
+          folly::Range<const vector_size_t*>(newRows, numNew),
+          &dictionary,
+          scratch);
+      numNew = 0;
+    }
+  };
+
+  for (auto i = 0; i < rows.size(); ++i) {
+    if (mayHaveNulls && loaded->isNullAt(rows[i])) {
+      if (nullDictionaryPosition_ < 0) {
+        addNewRows();
+        dictionary.appendNull();
+        nullDictionaryPosition_ = dictionarySize_++;
+      }
+      indices[i] = nullDictionaryPosition_;
+      continue;
+    }
+    if (!isWrapped) {
+      newRows[numNew++] = rows[i];
+      indices[i] = dictionarySize_++;
+      continue;
+    }
+    const auto baseRow = loaded->wrappedIndex(rows[i]);
+    auto& position = dictionaryPositions_[baseRow];
+    if (position.epoch != dictionaryEpoch_) {
+      position = {dictionaryEpoch_, dictionarySize_++};
+      newRows[numNew++] = baseRow;
+    }
+    indices[i] = position.position;
+  }
+  addNewRows();
+
+  appendNonNull(rows.size());
+  append(folly::Range<const int32_t*>(indices, rows.size()));
+}
+
 void VectorStream::flush(OutputStream* out) {
   out->write(reinterpret_cast<char*>(header_.buffer), header_.size);
 
@@ -307,6 +393,23 @@ void VectorStream::flushNulls(OutputStream* out) {
 }
 
 void VectorStream::clear() {
+  if (isDictionaryStream_) {
+    // A dictionary stream goes back to flat. The encoding of the next page is
+    // decided by its first input, see initializeDictionaryStream().
+    nonNullCount_ = 0;
+    nullCount_ = 0;
+    totalLength_ = 0;
+    // The positions are invalidated by the epoch bump for the next base.
+    dictionaryBase_.reset();
+    nullDictionaryPosition_ = -1;
+    dictionarySize_ = 0;
+    encoding_ = std::nullopt;
+    isDictionaryStream_ = false;
+    children_.clear();
+    values_.startWrite(values_.size());
+    initializeFlatStream(std::nullopt, 1);
+    return;
+  }
   encoding_ = std::nullopt;
   initializeHeader(typeToEncodingName(type_), *streamArena_);
   nonNullCount_ = 0;
@@ -153,6 +153,20 @@ class VectorStream {
     return isDictionaryStream_;
   }
 
+  // Turns an empty flat stream into a dictionary stream to be filled by
+  // appendDictionary(). clear() turns the stream back into a flat stream.
+  void initializeDictionaryStream(int32_t initialNumRows);
+
+  // Appends 'rows' of 'vector' to a dictionary stream set up by
+  // initializeDictionaryStream(). The values of the base vector of 'vector'
+  // are added to the dictionary the first time they are referenced, so that
+  // vectors sharing the base vector share the dictionary entries. Nulls added
+  // by wrappers reference a single null dictionary entry.
+  void appendDictionary(
+      const VectorPtr& vector,
+      folly::Range<const vector_size_t*> rows,
+      Scratch& scratch);
+
   bool isConstantStream() const {
     return isConstantStream_;
   }
@@ -223,6 +237,25 @@ class VectorStream {
   std::vector<VectorStream, memory::StlAllocator<VectorStream>> children_;
   bool isDictionaryStream_{false};
   bool isConstantStream_{false};
+
+  // Position in the dictionary of a value of 'dictionaryBase_'. The position
+  // is only valid if 'epoch' is 'dictionaryEpoch_'.
+  struct DictionaryPosition {
+    uint32_t epoch{0};
+    vector_size_t position{0};
+  };
+
+  // State of a stream filled by appendDictionary(). The base vector of the
+  // last appended vector and the position in the dictionary of each of its
+  // values. A new base vector only bumps 'dictionaryEpoch_', so that the
+  // positions need not be reset for each base vector.
+  VectorPtr dictionaryBase_;
+  std::vector<DictionaryPosition, memory::StlAllocator<DictionaryPosition>>
+      dictionaryPositions_;
+  uint32_t dictionaryEpoch_{0};
+  // Position of the null entry in the dictionary, -1 if none.
+  vector_size_t nullDictionaryPosition_{-1};
+  vector_size_t dictionarySize_{0};
 };
 
 template <>
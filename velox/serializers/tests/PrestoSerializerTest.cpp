@@ -125,6 +125,8 @@ class PrestoSerializerTest
         serdeOptions == nullptr ? false : serdeOptions->preserveEncodings;
     serializer::presto::PrestoVectorSerde::PrestoOptions paramOptions{
         useLosslessTimestamp, kind, 0.8, nullsFirst, preserveEncodings};
+    paramOptions.preserveDictionaries =
+        serdeOptions == nullptr ? false : serdeOptions->preserveDictionaries;
 
     return paramOptions;
   }
@@ -879,6 +881,108 @@ TEST_P(PrestoSerializerTest, dictionaryWithExtraNulls) {
   testRoundTrip(dictionary);
 }
 
+TEST_P(PrestoSerializerTest, preserveDictionaries) {
+  const vector_size_t size = 1'000;
+  auto base = makeFlatVector<std::string>(
+      10, [](auto row) { return fmt::format("dictionary value {}", row); });
+  BufferPtr nulls = allocateNulls(size, pool_.get());
+  auto rawNulls = nulls->asMutable<uint64_t>();
+  auto indices = makeIndices(size, [](auto row) { return row % 10; });
+  for (auto i = 0; i < size; i += 7) {
+    bits::setNull(rawNulls, i);
+  }
+  auto dictionary = BaseVector::wrapInDictionary(nulls, indices, size, base);
+
+  serializer::presto::PrestoVectorSerde::PrestoOptions options;
+  options.preserveDictionaries = true;
+  testRoundTrip(dictionary, &options);
+
+  // Appends the even and then the odd rows to one page. The second append
+  // reuses the dictionary values written by the first.
+  auto rowVector = makeRowVector({dictionary});
+  auto rowType = asRowType(rowVector->type());
+  auto even = makeIndices(size / 2, [](auto row) { return row * 2; });
+  auto odd = makeIndices(size / 2, [](auto row) { return row * 2 + 1; });
+  auto serializeEvenOdd =
+      [&](const serializer::presto::PrestoVectorSerde::PrestoOptions& opts) {
+        StreamArena arena(pool_.get());
+        auto serializer =
+            serde_->createIterativeSerializer(rowType, size, &arena, &opts);
+        Scratch scratch;
+        for (const auto& rows : {even, odd}) {
+          serializer->append(
+              rowVector,
+              folly::Range<const vector_size_t*>(
+                  rows->as<vector_size_t>(), size / 2),
+              scratch);
+        }
+        std::ostringstream out;
+        serializer::presto::PrestoOutputStreamListener listener;
+        OStreamOutputStream output(&out, &listener);
+        serializer->flush(&output);
+        return out.str();
+      };
+
+  auto paramOptions = getParamSerdeOptions(&options);
+  const auto serialized = serializeEvenOdd(paramOptions);
+  auto deserialized = deserialize(rowType, serialized, &options);
+  ASSERT_EQ(
+      deserialized->childAt(0)->encoding(),
+      VectorEncoding::Simple::DICTIONARY);
+  auto evenOdd = makeIndices(size, [](auto row) {
+    return row < size / 2 ? row * 2 : (row - size / 2) * 2 + 1;
+  });
+  assertEqualVectors(
+      BaseVector::wrapInDictionary(nullptr, evenOdd, size, rowVector),
+      deserialized);
+
+  if (paramOptions.compressionKind == common::CompressionKind_NONE) {
+    paramOptions.preserveDictionaries = false;
+    EXPECT_LT(serialized.size(), serializeEvenOdd(paramOptions).size());
+  }
+}
+
+TEST_P(PrestoSerializerTest, preserveDictionariesMultipleBases) {
+  // Appends dictionaries over alternating base vectors to one page. Going back
+  // to a previous base adds its values to the page dictionary again.
+  const vector_size_t size = 100;
+  const auto makeInput = [&](const std::string& prefix) {
+    auto base = makeFlatVector<std::string>(
+        10, [&](auto row) { return fmt::format("{} value {}", prefix, row); });
+    auto indices = makeIndices(size, [](auto row) { return row % 10; });
+    return makeRowVector(
+        {BaseVector::wrapInDictionary(nullptr, indices, size, base)});
+  };
+  std::vector<RowVectorPtr> inputs = {makeInput("first"), makeInput("second")};
+  inputs.push_back(inputs[0]);
+  auto rowType = asRowType(inputs[0]->type());
+
+  serializer::presto::PrestoVectorSerde::PrestoOptions options;
+  options.preserveDictionaries = true;
+  auto paramOptions = getParamSerdeOptions(&options);
+  StreamArena arena(pool_.get());
+  auto serializer = serde_->createIterativeSerializer(
+      rowType, size * inputs.size(), &arena, &paramOptions);
+  Scratch scratch;
+  auto expected = BaseVector::create(rowType, 0, pool_.get());
+  const IndexRange range{0, size};
+  for (const auto& input : inputs) {
+    serializer->append(
+        input, folly::Range<const IndexRange*>(&range, 1), scratch);
+    expected->append(input.get());
+  }
+  std::ostringstream out;
+  serializer::presto::PrestoOutputStreamListener listener;
+  OStreamOutputStream output(&out, &listener);
+  serializer->flush(&output);
+
+  auto deserialized = deserialize(rowType, out.str(), &options);
+  ASSERT_EQ(
+      deserialized->childAt(0)->encoding(),
+      VectorEncoding::Simple::DICTIONARY);
+  assertEqualVectors(expected, deserialized);
+}
+
 TEST_P(PrestoSerializerTest, emptyPage) {
   auto rowVector = makeEmptyTestVector();
 
@@ -21,6 +21,7 @@
 #include <string>
 
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/encode/Base64.h"
 #include "velox/type/Filter.h"
 
 namespace facebook::velox::common {
@@ -94,6 +95,9 @@ std::string Filter::toString() const {
     case FilterKind::kHugeintValuesUsingHashTable:
       strKind = "HugeintValuesUsingHashTable";
       break;
+    case FilterKind::kBloomFilter:
+      strKind = "BloomFilter";
+      break;
   };
 
   return fmt::format(
@@ -131,6 +135,7 @@ std::unordered_map<FilterKind, std::string> filterKindNames() {
       {FilterKind::kTimestampRange, "kTimestampRange"},
       {FilterKind::kHugeintValuesUsingHashTable,
        "kHugeintValuesUsingHashTable"},
+      {FilterKind::kBloomFilter, "kBloomFilter"},
   };
 }
 
@@ -199,6 +204,7 @@ void Filter::registerSerDe() {
   registry.Register("NegatedBytesValues", NegatedBytesValues::create);
   registry.Register("MultiRange", MultiRange::create);
   registry.Register("TimestampRange", TimestampRange::create);
+  registry.Register("BloomFilterValues", BloomFilterValues::create);
 }
 
 folly::dynamic Filter::serializeBase(std::string_view name) const {
@@ -1051,6 +1057,95 @@ bool HugeintValuesUsingHashTable::testingEquals(const Filter& other) const {
   return true;
 }
 
+folly::dynamic BloomFilterValues::serialize() const {
+  auto obj = Filter::serializeBase("BloomFilterValues");
+  std::string bloom(bloom_->serializedSize(), '\0');
+  bloom_->serialize(bloom.data());
+  obj["bloom"] = encoding::Base64::encode(bloom.data(), bloom.size());
+  if (base_ != nullptr) {
+    obj["base"] = base_->serialize();
+  }
+  return obj;
+}
+
+FilterPtr BloomFilterValues::create(const folly::dynamic& obj) {
+  auto nullAllowed = deserializeNullAllowed(obj);
+  const auto serialized = encoding::Base64::decode(obj["bloom"].asString());
+  auto bloom = std::make_shared<Bloom>();
+  bloom->merge(serialized.data());
+  std::shared_ptr<const Filter> base;
+  if (obj.count("base")) {
+    base = ISerializable::deserialize<Filter>(obj["base"]);
+  }
+  return std::make_unique<BloomFilterValues>(
+      std::move(bloom), nullAllowed, std::move(base));
+}
+
+bool BloomFilterValues::testingEquals(const Filter& other) const {
+  auto otherBloomFilter = dynamic_cast<const BloomFilterValues*>(&other);
+  if (otherBloomFilter == nullptr || !Filter::testingBaseEquals(other)) {
+    return false;
+  }
+  if ((base_ == nullptr) != (otherBloomFilter->base_ == nullptr) ||
+      (base_ != nullptr &&
+       !base_->testingEquals(*otherBloomFilter->base_))) {
+    return false;
+  }
+  if (bloom_ == otherBloomFilter->bloom_) {
+    return true;
+  }
+  std::string bits(bloom_->serializedSize(), '\0');
+  bloom_->serialize(bits.data());
+  std::string otherBits(otherBloomFilter->bloom_->serializedSize(), '\0');
+  otherBloomFilter->bloom_->serialize(otherBits.data());
+  return bits == otherBits;
+}
+
+std::string BloomFilterValues::toString() const {
+  return fmt::format(
+      "BloomFilterValues: {} bytes{}{}",
+      bloom_->serializedSize(),
+      base_ != nullptr ? " AND " + base_->toString() : "",
+      nullAllowed_ ? " with nulls" : " no nulls");
+}
+
+bool BloomFilterValues::testInt64Range(int64_t min, int64_t max, bool hasNull)
+    const {
+  if (hasNull && testNull()) {
+    return true;
+  }
+  if (base_ != nullptr && !base_->testInt64Range(min, max, false)) {
+    return false;
+  }
+  // A wide range is likely to contain a value that passes the bloom filter.
+  if (static_cast<uint64_t>(max) - static_cast<uint64_t>(min) >=
+      kMaxRangeToTest) {
+    return true;
+  }
+  for (int64_t i = 0; i <= max - min; ++i) {
+    if (testInt64(min + i)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool BloomFilterValues::testBytesRange(
+    std::optional<std::string_view> min,
+    std::optional<std::string_view> max,
+    bool hasNull) const {
+  if (hasNull && testNull()) {
+    return true;
+  }
+  if (base_ != nullptr && !base_->testBytesRange(min, max, false)) {
+    return false;
+  }
+  if (min.has_value() && max.has_value() && min.value() == max.value()) {
+    return testBytes(min->data(), min->size());
+  }
+  return true;
+}
+
 NegatedBigintValuesUsingBitmask::NegatedBigintValuesUsingBitmask(
     int64_t min,
     int64_t max,
@@ -1560,6 +1655,7 @@ std::unique_ptr<Filter> MultiRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
     case FilterKind::kNegatedBytesRange:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
@@ -1836,6 +1932,7 @@ std::unique_ptr<Filter> BigintRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<BigintRange>(lower_, upper_, false);
@@ -1930,6 +2027,7 @@ std::unique_ptr<Filter> NegatedBigintRange::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return this->clone(false);
@@ -2023,6 +2121,7 @@ std::unique_ptr<Filter> BigintValuesUsingHashTable::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<BigintValuesUsingHashTable>(*this, false);
@@ -2114,6 +2213,7 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<BigintValuesUsingBitmask>(*this, false);
@@ -2197,6 +2297,7 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<NegatedBigintValuesUsingHashTable>(*this, false);
@@ -2236,6 +2337,7 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingBitmask::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<NegatedBigintValuesUsingBitmask>(*this, false);
@@ -2271,6 +2373,7 @@ std::unique_ptr<Filter> BigintMultiRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull: {
       std::vector<std::unique_ptr<BigintRange>> ranges;
@@ -2352,6 +2455,7 @@ std::unique_ptr<Filter> BytesRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return this->clone(false);
@@ -2431,6 +2535,7 @@ std::unique_ptr<Filter> NegatedBytesRange::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return this->clone(false);
@@ -2453,6 +2558,7 @@ std::unique_ptr<Filter> BytesValues::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
     case FilterKind::kMultiRange:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
@@ -2565,6 +2671,7 @@ std::unique_ptr<Filter> NegatedBytesValues::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
     case FilterKind::kBytesValues:
     case FilterKind::kNegatedBytesRange:
     case FilterKind::kMultiRange:
@@ -2659,4 +2766,31 @@ std::unique_ptr<Filter> NegatedBytesValues::mergeWith(
       VELOX_UNREACHABLE();
   }
 }
+
+std::unique_ptr<Filter> BloomFilterValues::mergeWith(
+    const Filter* other) const {
+  switch (other->kind()) {
+    case FilterKind::kAlwaysTrue:
+      return this->clone();
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kIsNull:
+      return other->mergeWith(this);
+    case FilterKind::kIsNotNull:
+      return this->clone(false);
+    default: {
+      // The bloom filter is kept and 'other' is merged into the base filter.
+      bool bothNullAllowed = nullAllowed_ && other->testNull();
+      std::unique_ptr<Filter> base;
+      if (base_ == nullptr) {
+        base = other->clone();
+      } else if (other->kind() == FilterKind::kBloomFilter) {
+        base = other->mergeWith(base_.get());
+      } else {
+        base = base_->mergeWith(other);
+      }
+      return std::make_unique<BloomFilterValues>(
+          bloom_, bothNullAllowed, std::move(base));
+    }
+  }
+}
 } // namespace facebook::velox::common
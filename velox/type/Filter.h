@@ -24,7 +24,9 @@
 
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
+#include <folly/hash/Hash.h>
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/serialization/Serializable.h"
@@ -57,6 +59,7 @@ enum class FilterKind {
   kHugeintRange,
   kTimestampRange,
   kHugeintValuesUsingHashTable,
+  kBloomFilter,
 };
 
 class Filter;
@@ -2132,6 +2135,90 @@ class MultiRange final : public Filter {
   const std::vector<std::unique_ptr<Filter>> filters_;
 };
 
+/// IN-list filter on integral or string values that tests membership in a
+/// bloom filter. Values that are not in the list may pass. Used for dynamic
+/// filters produced by join build sides that are too large or have a type
+/// that an exact IN-list filter does not support.
+///
+/// 'base' is an optional filter that values must pass in addition. This
+/// allows merging a bloom filter with any other filter.
+class BloomFilterValues final : public Filter {
+ public:
+  using Bloom = BloomFilter<std::allocator<uint64_t>>;
+
+  /// @param bloom Hashes of the values that pass the filter. Integral values
+  /// are hashed with hashInt64() and strings with hashBytes(). Shared between
+  /// the copies of the filter.
+  /// @param nullAllowed Null values are passing the filter if true.
+  /// @param base Optional filter that values must pass in addition.
+  BloomFilterValues(
+      std::shared_ptr<const Bloom> bloom,
+      bool nullAllowed,
+      std::shared_ptr<const Filter> base = nullptr)
+      : Filter(true, nullAllowed, FilterKind::kBloomFilter),
+        bloom_(std::move(bloom)),
+        base_(std::move(base)) {
+    VELOX_CHECK(bloom_->isSet(), "bloom filter must be initialized");
+  }
+
+  static uint64_t hashInt64(int64_t value) {
+    return folly::hasher<int64_t>()(value);
+  }
+
+  static uint64_t hashBytes(const char* value, int32_t length) {
+    return folly::hasher<std::string_view>()(std::string_view(value, length));
+  }
+
+  folly::dynamic serialize() const override;
+
+  static FilterPtr create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    return std::make_unique<BloomFilterValues>(
+        bloom_, nullAllowed.value_or(nullAllowed_), base_);
+  }
+
+  bool testNull() const final {
+    return nullAllowed_ && (base_ == nullptr || base_->testNull());
+  }
+
+  bool testInt64(int64_t value) const final {
+    return bloom_->mayContain(hashInt64(value)) &&
+        (base_ == nullptr || base_->testInt64(value));
+  }
+
+  bool testBytes(const char* value, int32_t length) const final {
+    return bloom_->mayContain(hashBytes(value, length)) &&
+        (base_ == nullptr || base_->testBytes(value, length));
+  }
+
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
+
+  bool testBytesRange(
+      std::optional<std::string_view> min,
+      std::optional<std::string_view> max,
+      bool hasNull) const final;
+
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  const Filter* base() const {
+    return base_.get();
+  }
+
+  std::string toString() const final;
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  // Ranges up to this many values are tested value by value in
+  // testInt64Range().
+  static constexpr int64_t kMaxRangeToTest = 64;
+
+  const std::shared_ptr<const Bloom> bloom_;
+  const std::shared_ptr<const Filter> base_;
+};
+
 // Helper for applying filters to different types
 template <typename TFilter, typename T>
 static inline bool applyFilter(TFilter& filter, T value) {
@@ -110,6 +110,19 @@ TEST_F(FilterSerDeTest, valuesFilters) {
   }
 }
 
+TEST_F(FilterSerDeTest, bloomFilterValues) {
+  auto bloom = std::make_shared<BloomFilterValues::Bloom>();
+  bloom->reset(100);
+  for (auto i = 0; i < 100; ++i) {
+    bloom->insert(BloomFilterValues::hashInt64(i * 3));
+  }
+  for (auto nullAllowed : {false, true}) {
+    testSerde(BloomFilterValues(bloom, nullAllowed));
+    testSerde(BloomFilterValues(
+        bloom, nullAllowed, std::make_shared<BigintRange>(1, 1'000, false)));
+  }
+}
+
 TEST_F(FilterSerDeTest, rangeFilters) {
   FloatRange floatRange(1.0, true, true, 124.5, false, true, false);
   testSerde(floatRange);
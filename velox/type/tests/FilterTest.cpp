@@ -994,6 +994,64 @@ TEST(FilterTest, bytesValues) {
   EXPECT_FALSE(filter->testBytesRange(std::nullopt, "Banana", false));
 }
 
+TEST(FilterTest, bloomFilterValues) {
+  auto bloom = std::make_shared<BloomFilterValues::Bloom>();
+  bloom->reset(2'000);
+  for (auto i = 0; i < 1'000; ++i) {
+    bloom->insert(BloomFilterValues::hashInt64(i * 7));
+    const auto value = std::to_string(i * 7);
+    bloom->insert(BloomFilterValues::hashBytes(value.data(), value.size()));
+  }
+  BloomFilterValues filter(bloom, false);
+  EXPECT_FALSE(filter.testNull());
+  EXPECT_TRUE(filter.clone(true)->testNull());
+
+  int32_t numFalsePositives = 0;
+  for (auto i = 0; i < 7'000; ++i) {
+    const auto value = std::to_string(i);
+    if (i % 7 == 0) {
+      EXPECT_TRUE(filter.testInt64(i));
+      EXPECT_TRUE(filter.testBytes(value.data(), value.size()));
+    } else {
+      numFalsePositives += filter.testInt64(i);
+      numFalsePositives += filter.testBytes(value.data(), value.size());
+    }
+  }
+  // ~2% false positives are expected.
+  EXPECT_LT(numFalsePositives, 2 * 6'000 / 20);
+
+  EXPECT_TRUE(filter.testInt64Range(0, 6, false));
+  EXPECT_TRUE(filter.testInt64Range(-1'000'000, 1'000'000, false));
+  EXPECT_TRUE(filter.testBytesRange("14", "14", false));
+  EXPECT_TRUE(filter.testBytesRange("a", "z", false));
+  EXPECT_TRUE(filter.clone(true)->testInt64Range(100'000, 100'010, true));
+
+  // Merging in either order keeps the bloom filter and the other filter.
+  auto range = between(0, 69);
+  std::vector<std::unique_ptr<Filter>> mergedRanges;
+  mergedRanges.push_back(filter.mergeWith(range.get()));
+  mergedRanges.push_back(range->mergeWith(&filter));
+  for (const auto& merged : mergedRanges) {
+    ASSERT_EQ(merged->kind(), FilterKind::kBloomFilter);
+    EXPECT_TRUE(merged->testInt64(63));
+    EXPECT_FALSE(merged->testInt64(70));
+    EXPECT_FALSE(merged->testInt64Range(100, 200, false));
+    EXPECT_FALSE(merged->testNull());
+  }
+  auto values = in(std::vector<std::string>{"7", "8", "700"});
+  auto merged = values->mergeWith(&filter);
+  ASSERT_EQ(merged->kind(), FilterKind::kBloomFilter);
+  EXPECT_TRUE(merged->testBytes("7", 1));
+  EXPECT_TRUE(merged->testBytes("700", 3));
+  EXPECT_FALSE(merged->testBytes("14", 2));
+
+  auto isNull = std::make_unique<IsNull>();
+  EXPECT_EQ(filter.mergeWith(isNull.get())->kind(), FilterKind::kAlwaysFalse);
+  EXPECT_EQ(
+      filter.clone(true)->mergeWith(isNull.get())->kind(),
+      FilterKind::kIsNull);
+}
+
 TEST(FilterTest, negatedBytesValues) {
   // create a filter
   std::vector<std::string> values(